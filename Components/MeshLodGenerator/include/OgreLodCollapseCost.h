@@ -33,6 +33,8 @@
 #include "OgreLodPrerequisites.h"
 #include "OgreLodData.h"
 
+#include <functional>
+
 namespace Ogre
 {
 /** \addtogroup Optional
@@ -44,9 +46,16 @@ namespace Ogre
 class _OgreLodExport LodCollapseCost {
 public:
     virtual ~LodCollapseCost() {}
-    /// This is called after the LodInputProvider has initialized LodData.
+    /** This is called after the LodInputProvider has initialized LodData.
+    @remarks The vertex costs are computed in parallel on the WorkQueue, so
+        computeVertexCollapseCost and computeEdgeCollapseCost must not modify
+        shared state. Afterwards initVertexCollapseCost is called serially in
+        vertex order for every used vertex.
+    */
     virtual void initCollapseCosts(LodData* data);
-    /// Called from initCollapseCosts for every edge.
+    /** Called from initCollapseCosts for every used vertex, adds it to the heap.
+    @remarks While initCollapseCosts runs, this uses the costs computed in parallel.
+    */
     virtual void initVertexCollapseCost(LodData* data, LodData::Vertex* vertex);
     /// Called when edge cost gets invalid.
     virtual void updateVertexCollapseCost(LodData* data, LodData::Vertex* vertex);
@@ -57,6 +66,10 @@ public:
 protected:
     // Helper functions:
     bool isBorderVertex(const LodData::Vertex* vertex) const;
+    /// Calls func(begin, end) for blocks of up to blockSize items, in parallel if a WorkQueue is available.
+    static void parallelForBlocks(size_t count, size_t blockSize, const std::function<void(size_t, size_t)>& func);
+    /// The minimal cost and collapse target of every vertex, only valid during initCollapseCosts.
+    std::vector<std::pair<Real, LodData::Vertex*> > mInitCosts;
 };
 /** @} */
 /** @} */
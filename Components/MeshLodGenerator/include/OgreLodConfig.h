@@ -161,6 +161,10 @@ struct _OgreLodExport LodConfig {
         /// If outsideWeight is enabled, this will set the angle how deep the algorithm can walk inside the mesh.
         /// This value is an acos number between -1 and 1. (by default it is 0 which means 90 degree)
         Ogre::Real outsideWalkAngle;
+        /// Reorder the triangles of all Lod levels and the vertices of the mesh for the post-transform
+        /// vertex cache after injecting, see Mesh::optimiseVertexCache. Compressed Lod levels keep their order.
+        /// (disabled by default)
+        bool optimiseVertexCache;
         /// If the algorithm makes errors, you can fix it, by adding the edge to the profile.
         LodProfile profile;
         Advanced();
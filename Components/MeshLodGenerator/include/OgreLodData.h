@@ -60,11 +60,11 @@ struct _OgreLodExport LodData {
     struct Triangle;
     struct VertexHash;
     struct VertexEqual;
+    class CollapseCostHeap;
 
     typedef std::vector<Vertex> VertexList;
     typedef std::vector<Triangle> TriangleList;
     typedef std::unordered_set<Vertex*, VertexHash, VertexEqual> UniqueVertexSet;
-    typedef std::multimap<Real, Vertex*> CollapseCostHeap;
 
     typedef VectorSet<Edge, 8> VEdges;
     typedef VectorSet<Triangle*, 7> VTriangles;
@@ -104,8 +104,9 @@ struct _OgreLodExport LodData {
         
         Vertex* collapseTo;
         bool seam;
-        CollapseCostHeap::iterator costHeapPosition; /// Iterator pointing to the position in the mCollapseCostSet, which allows fast remove.
+        size_t costHeapPosition; /// Position in mCollapseCostHeap, which allows fast update and remove.
 
+        Vertex();
         void addEdge(const Edge& edge);
         void removeEdge(const Edge& edge);
     };
@@ -131,6 +132,62 @@ struct _OgreLodExport LodData {
         bool isMalformed();
     };
 
+    /**
+     * @brief Flat binary min heap of the vertices by collapse cost.
+     *
+     * Each vertex knows its position, so its cost can be changed or it can be removed in place
+     * without the node allocations of a std::multimap. Vertices with the same cost are ordered
+     * by the time their cost was last set, which is the order a std::multimap would give.
+     */
+    class _OgreLodExport CollapseCostHeap {
+    public:
+        /// The position of vertices which are not in the heap.
+        static const size_t INVALID_POSITION;
+
+        struct Entry {
+            Real cost;
+            size_t sequence; /// Orders entries with equal cost.
+            Vertex* vertex;
+        };
+        typedef std::vector<Entry> EntryList;
+        typedef EntryList::const_iterator const_iterator;
+
+        CollapseCostHeap() : mSequence(0) {}
+
+        void clear() { mEntries.clear(); mSequence = 0; }
+        size_t size() const { return mEntries.size(); }
+        bool empty() const { return mEntries.empty(); }
+        /// The vertex with the smallest collapse cost.
+        const Entry& top() const { return mEntries.front(); }
+        const_iterator begin() const { return mEntries.begin(); }
+        const_iterator end() const { return mEntries.end(); }
+        void reserve(size_t count) { mEntries.reserve(count); }
+
+        /// Adds a vertex, which is not in the heap yet.
+        void push(Vertex* vertex, Real cost);
+        /// Sets the cost of a vertex, adding it if it is not in the heap.
+        void update(Vertex* vertex, Real cost);
+        /// Removes a vertex from the heap.
+        void erase(Vertex* vertex);
+        /// Returns the cost of a vertex in the heap or UNINITIALIZED_COLLAPSE_COST.
+        Real getCost(const Vertex* vertex) const;
+        bool contains(const Vertex* vertex) const { return vertex->costHeapPosition != INVALID_POSITION; }
+
+    private:
+        EntryList mEntries;
+        size_t mSequence;
+
+        static bool isLess(const Entry& a, const Entry& b) {
+            return a.cost < b.cost || (a.cost == b.cost && a.sequence < b.sequence);
+        }
+        void place(size_t pos, const Entry& entry) {
+            mEntries[pos] = entry;
+            entry.vertex->costHeapPosition = pos;
+        }
+        void siftUp(size_t pos);
+        void siftDown(size_t pos);
+    };
+
     union IndexBufferPointer {
         unsigned short* pshort;
         unsigned int* pint;
@@ -55,6 +55,15 @@ public:
 
     void clearPendingLodRequests();
 
+    /**
+     * @brief Processes the requests concurrently and waits for them to finish.
+     *
+     * The requests are spread over the threads of the WorkQueue, the caller takes part.
+     * The generated Lod levels are not injected, call LodOutputProvider::inject on the
+     * calling thread afterwards.
+     */
+    void processRequests(std::vector<LodWorkQueueRequest>& requests);
+
 protected:
     ushort mChannelID;
     WorkQueue::Response* handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ);
@@ -70,6 +70,17 @@ public:
      */
     virtual void generateLodLevels(LodConfig& lodConfig, LodCollapseCostPtr cost = LodCollapseCostPtr(), LodDataPtr data = LodDataPtr(), LodInputProviderPtr input = LodInputProviderPtr(), LodOutputProviderPtr output = LodOutputProviderPtr(), LodCollapserPtr collapser = LodCollapserPtr());
 
+    /**
+     * @brief Generates the Lod levels for several meshes at once.
+     *
+     * The meshes are processed concurrently through the LodWorkQueueWorker, using the
+     * buffer based input and output providers. The Lod levels are injected on the calling
+     * thread when all meshes are done, so useBackgroundQueue is ignored.
+     *
+     * @param lodConfigs Specifications of the requested Lod levels, one per mesh.
+     */
+    void generateLodLevels(std::vector<LodConfig>& lodConfigs);
+
     /**
      * @brief Generates the Lod levels for a mesh without configuring it.
      *
@@ -96,10 +96,14 @@ namespace Ogre
                 pOut->z = *(++pFloat);
                 vertex += vSize;
                 if(useVertexNormals){
-                    elemNormal->baseVertexPointerToElement(vNormal, &pFloat);
-                    pNormalOut->x = *pFloat;
-                    pNormalOut->y = *(++pFloat);
-                    pNormalOut->z = *(++pFloat);
+                    // normals may be packed, see Mesh::quantiseVertexData
+                    float normal[3];
+                    void* pNormal;
+                    elemNormal->baseVertexPointerToElement(vNormal, &pNormal);
+                    VertexElement::convertValue(elemNormal->getType(), pNormal, VET_FLOAT3, normal);
+                    pNormalOut->x = normal[0];
+                    pNormalOut->y = normal[1];
+                    pNormalOut->z = normal[2];
                     pNormalOut++;
                     vNormal += vNormalSize;
                 }
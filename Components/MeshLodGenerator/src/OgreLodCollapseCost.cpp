@@ -33,22 +33,53 @@ namespace Ogre
     void LodCollapseCost::initCollapseCosts( LodData* data )
     {
         data->mCollapseCostHeap.clear();
-        LodData::VertexList::iterator it = data->mVertexList.begin();
-        LodData::VertexList::iterator itEnd = data->mVertexList.end();
-        for (; it != itEnd; it++) {
-            if (!it->edges.empty()) {
-                initVertexCollapseCost(data, &*it);
+        data->mCollapseCostHeap.reserve(data->mVertexList.size());
+
+        // Every vertex only writes the costs of its own edges, so the costs can be
+        // computed concurrently. Filling the heap stays serial to keep the order.
+        size_t vertexCount = data->mVertexList.size();
+        mInitCosts.resize(vertexCount);
+        parallelForBlocks(vertexCount, 1024, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                LodData::Vertex* vertex = &data->mVertexList[i];
+                mInitCosts[i].first = LodData::UNINITIALIZED_COLLAPSE_COST;
+                mInitCosts[i].second = NULL;
+                if (!vertex->edges.empty()) {
+                    computeVertexCollapseCost(data, vertex, mInitCosts[i].first, mInitCosts[i].second);
+                }
+            }
+        });
+
+        for (size_t i = 0; i < vertexCount; i++) {
+            LodData::Vertex* vertex = &data->mVertexList[i];
+            vertex->costHeapPosition = LodData::CollapseCostHeap::INVALID_POSITION;
+            if (!vertex->edges.empty()) {
+                initVertexCollapseCost(data, vertex);
             } else {
 #if OGRE_DEBUG_MODE
                 LogManager::getSingleton().stream() << "In " << data->mMeshName << " never used vertex found with ID: " << data->mCollapseCostHeap.size() << ". "
                     << "Vertex position: ("
-                    << it->position.x << ", "
-                    << it->position.y << ", "
-                    << it->position.z << ") "
+                    << vertex->position.x << ", "
+                    << vertex->position.y << ", "
+                    << vertex->position.z << ") "
                     << "It will be excluded from Lod level calculations.";
 #endif
             }
         }
+        mInitCosts.clear();
+    }
+
+    void LodCollapseCost::parallelForBlocks( size_t count, size_t blockSize, const std::function<void(size_t, size_t)>& func )
+    {
+        size_t blocks = (count + blockSize - 1) / blockSize;
+        WorkQueue* wq = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL;
+        if (blocks < 2 || !wq) {
+            func(0, count);
+            return;
+        }
+        wq->parallelFor(blocks, [&](size_t block) {
+            func(block * blockSize, std::min(count, (block + 1) * blockSize));
+        });
     }
 
     void LodCollapseCost::computeVertexCollapseCost( LodData* data, LodData::Vertex* vertex, Real& collapseCost, LodData::Vertex*& collapseTo )
@@ -68,10 +99,17 @@ namespace Ogre
 
         Real collapseCost = LodData::UNINITIALIZED_COLLAPSE_COST;
         LodData::Vertex* collapseTo = NULL;
-        computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
+        if (!mInitCosts.empty()) {
+            // Computed in parallel by initCollapseCosts already.
+            size_t i = vertex - &data->mVertexList[0];
+            collapseCost = mInitCosts[i].first;
+            collapseTo = mInitCosts[i].second;
+        } else {
+            computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
+        }
 
         vertex->collapseTo = collapseTo;
-        vertex->costHeapPosition = data->mCollapseCostHeap.emplace(collapseCost, vertex);
+        data->mCollapseCostHeap.push(vertex, collapseCost);
     }
 
     void LodCollapseCost::updateVertexCollapseCost( LodData* data, LodData::Vertex* vertex )
@@ -80,16 +118,15 @@ namespace Ogre
         LodData::Vertex* collapseTo = NULL;
         computeVertexCollapseCost(data, vertex, collapseCost, collapseTo);
 
-        if (vertex->collapseTo != collapseTo || collapseCost != vertex->costHeapPosition->first) {
-            OgreAssert(vertex->costHeapPosition != data->mCollapseCostHeap.end(), "");
-            data->mCollapseCostHeap.erase(vertex->costHeapPosition);
+        if (vertex->collapseTo != collapseTo || collapseCost != data->mCollapseCostHeap.getCost(vertex)) {
+            OgreAssert(data->mCollapseCostHeap.contains(vertex), "");
             if (collapseCost != LodData::UNINITIALIZED_COLLAPSE_COST) {
                 vertex->collapseTo = collapseTo;
-                vertex->costHeapPosition = data->mCollapseCostHeap.emplace(collapseCost, vertex);
+                data->mCollapseCostHeap.update(vertex, collapseCost);
             } else {
+                data->mCollapseCostHeap.erase(vertex);
 #if OGRE_DEBUG_MODE
                 vertex->collapseTo = NULL;
-                vertex->costHeapPosition = data->mCollapseCostHeap.end();
 #endif
             }
         }
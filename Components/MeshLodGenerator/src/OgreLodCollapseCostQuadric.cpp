@@ -40,14 +40,19 @@ namespace Ogre
 
     void LodCollapseCostQuadric::initCollapseCosts( LodData* data )
     {
+        // Every triangle and vertex writes only its own quadric, so both passes run in parallel.
         mTrianglePlaneQuadricList.resize(data->mTriangleList.size());
-        for(size_t i=0;i<mTrianglePlaneQuadricList.size();i++){
-            computeTrianglePlaneQuadric(data, i);
-        }
+        parallelForBlocks(mTrianglePlaneQuadricList.size(), 1024, [&](size_t begin, size_t end) {
+            for(size_t i=begin;i<end;i++){
+                computeTrianglePlaneQuadric(data, i);
+            }
+        });
         mVertexQuadricList.resize(data->mVertexList.size());
-        for (size_t i=0;i<mVertexQuadricList.size();i++) {
-            computeVertexQuadric(data, i);
-        }
+        parallelForBlocks(mVertexQuadricList.size(), 1024, [&](size_t begin, size_t end) {
+            for (size_t i=begin;i<end;i++) {
+                computeVertexQuadric(data, i);
+            }
+        });
         LodCollapseCost::initCollapseCosts(data);
     }
 
@@ -32,6 +32,14 @@ namespace Ogre
 // Use float limits instead of Real limits, because LodConfigSerializer may convert them to float.
 const Real LodData::NEVER_COLLAPSE_COST = std::numeric_limits<float>::max();
 const Real LodData::UNINITIALIZED_COLLAPSE_COST = std::numeric_limits<float>::infinity();
+const size_t LodData::CollapseCostHeap::INVALID_POSITION = std::numeric_limits<size_t>::max();
+
+LodData::Vertex::Vertex() :
+    collapseTo(NULL),
+    seam(false),
+    costHeapPosition(CollapseCostHeap::INVALID_POSITION)
+{
+}
 
 void LodData::Vertex::addEdge( const LodData::Edge& edge )
 {
@@ -118,4 +126,94 @@ bool LodData::Edge::operator== (const LodData::Edge& other) const
     return dst == other.dst;
 }
 
+void LodData::CollapseCostHeap::push( Vertex* vertex, Real cost )
+{
+    OgreAssert(!contains(vertex), "");
+    Entry entry;
+    entry.cost = cost;
+    entry.sequence = mSequence++;
+    entry.vertex = vertex;
+    mEntries.push_back(entry);
+    vertex->costHeapPosition = mEntries.size() - 1;
+    siftUp(mEntries.size() - 1);
+}
+
+void LodData::CollapseCostHeap::update( Vertex* vertex, Real cost )
+{
+    if (!contains(vertex)) {
+        push(vertex, cost);
+        return;
+    }
+    size_t pos = vertex->costHeapPosition;
+    Entry& entry = mEntries[pos];
+    bool decreased = cost < entry.cost;
+    entry.cost = cost;
+    entry.sequence = mSequence++;
+    if (decreased) {
+        siftUp(pos);
+    } else {
+        // A newer sequence number makes the entry bigger even for the same cost.
+        siftDown(pos);
+    }
+}
+
+void LodData::CollapseCostHeap::erase( Vertex* vertex )
+{
+    OgreAssert(contains(vertex), "");
+    size_t pos = vertex->costHeapPosition;
+    vertex->costHeapPosition = INVALID_POSITION;
+    Entry last = mEntries.back();
+    mEntries.pop_back();
+    if (pos == mEntries.size()) {
+        return;
+    }
+    bool smaller = isLess(last, mEntries[pos]);
+    place(pos, last);
+    if (smaller) {
+        siftUp(pos);
+    } else {
+        siftDown(pos);
+    }
+}
+
+Real LodData::CollapseCostHeap::getCost( const Vertex* vertex ) const
+{
+    return contains(vertex) ? mEntries[vertex->costHeapPosition].cost : UNINITIALIZED_COLLAPSE_COST;
+}
+
+void LodData::CollapseCostHeap::siftUp( size_t pos )
+{
+    Entry entry = mEntries[pos];
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!isLess(entry, mEntries[parent])) {
+            break;
+        }
+        place(pos, mEntries[parent]);
+        pos = parent;
+    }
+    place(pos, entry);
+}
+
+void LodData::CollapseCostHeap::siftDown( size_t pos )
+{
+    Entry entry = mEntries[pos];
+    size_t count = mEntries.size();
+    for (;;) {
+        size_t child = pos * 2 + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && isLess(mEntries[child + 1], mEntries[child])) {
+            child++;
+        }
+        if (!isLess(mEntries[child], entry)) {
+            break;
+        }
+        place(pos, mEntries[child]);
+        pos = child;
+    }
+    place(pos, entry);
+}
+
 }
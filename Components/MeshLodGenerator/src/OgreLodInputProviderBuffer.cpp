@@ -114,8 +114,10 @@ namespace Ogre
         Vector3* pOut = vertexBuffer.vertexBuffer.get();
         Vector3* pEnd = pOut + vertexBuffer.vertexCount;
         for (; pOut < pEnd; pOut++) {
-            data->mVertexList.push_back({*pOut, *pNormalOut});
+            data->mVertexList.push_back(LodData::Vertex());
             LodData::Vertex* v = &data->mVertexList.back();
+            v->position = *pOut;
+            v->normal = *pNormalOut;
             std::pair<LodData::UniqueVertexSet::iterator, bool> ret;
             ret = data->mUniqueVertexSet.insert(v);
             if (!ret.second) {
@@ -135,7 +137,7 @@ namespace Ogre
                 }
             } else {
 #if OGRE_DEBUG_MODE
-                v->costHeapPosition = data->mCollapseCostHeap.end();
+                v->costHeapPosition = LodData::CollapseCostHeap::INVALID_POSITION;
 #endif
                 v->seam = false;
                 if(data->mUseVertexNormals){
@@ -162,14 +162,19 @@ namespace Ogre
             } else {
 #if OGRE_DEBUG_MODE
                 // Needed for an assert, don't remove it.
-                v->costHeapPosition = data->mCollapseCostHeap.end();
+                v->costHeapPosition = LodData::CollapseCostHeap::INVALID_POSITION;
 #endif
                 v->seam = false;
             }
             lookup.push_back(v);
 
             if(data->mUseVertexNormals){
-                elemNormal->baseVertexPointerToElement(vNormal, &pFloat);
+                // normals may be packed, see Mesh::quantiseVertexData
+                float normal[3];
+                void* pNormal;
+                elemNormal->baseVertexPointerToElement(vNormal, &pNormal);
+                VertexElement::convertValue(elemNormal->getType(), pNormal, VET_FLOAT3, normal);
+                pFloat = normal;
                 if (!ret.second) {
                     if(v->normal.x != pFloat[0]){
                         v->normal.x += pFloat[0];
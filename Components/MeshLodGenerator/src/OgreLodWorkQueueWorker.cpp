@@ -81,6 +81,15 @@ namespace Ogre
         wq->abortPendingRequestsByChannel(mChannelID);
     }
 
+    void LodWorkQueueWorker::processRequests(std::vector<LodWorkQueueRequest>& requests)
+    {
+        WorkQueue* wq = Root::getSingleton().getWorkQueue();
+        wq->parallelFor(requests.size(), [&](size_t i) {
+            LodWorkQueueRequest& request = requests[i];
+            MeshLodGenerator::getSingleton()._process(request.config, request.cost.get(), request.data.get(), request.input.get(), request.output.get(), request.collapser.get());
+        });
+    }
+
     WorkQueue::Response* LodWorkQueueWorker::handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
     {
         // Called on worker thread by WorkQueue.
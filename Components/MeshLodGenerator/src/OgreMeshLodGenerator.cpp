@@ -31,6 +31,19 @@
 namespace Ogre
 {
 
+namespace
+{
+bool hasGeneratedLodLevels(const LodConfig& lodConfig)
+{
+    for(size_t i = 0; i < lodConfig.levels.size(); i++) {
+        if(lodConfig.levels[i].manualMeshName.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+}
+
 template<> MeshLodGenerator* Singleton<MeshLodGenerator>::msSingleton = 0;
 MeshLodGenerator* MeshLodGenerator::getSingletonPtr()
 {
@@ -104,6 +117,8 @@ void MeshLodGenerator::_configureMeshLodUsage(const LodConfig& lodConfig)
     }
     // Remove skipped Lod levels
     lodConfig.mesh->_setLodInfo(n + 1);
+    if(lodConfig.advanced.optimiseVertexCache)
+        lodConfig.mesh->optimiseVertexCache();
     if(edgeListWasBuilt)
         lodConfig.mesh->buildEdgeList();
 }
@@ -197,14 +212,7 @@ void MeshLodGenerator::generateLodLevels(LodConfig& lodConfig,
                                          LodCollapserPtr collapser)
 {
     // If we don't have generated Lod levels, we can use _generateManualLodLevels.
-    bool hasGeneratedLevels = false;
-    for(size_t i = 0; i < lodConfig.levels.size(); i++) {
-        if(lodConfig.levels[i].manualMeshName.empty()) {
-            hasGeneratedLevels = true;
-            break;
-        }
-    }
-    if(hasGeneratedLevels || (LodWorkQueueInjector::getSingletonPtr() && LodWorkQueueInjector::getSingletonPtr()->getInjectorListener())) {
+    if(hasGeneratedLodLevels(lodConfig) || (LodWorkQueueInjector::getSingletonPtr() && LodWorkQueueInjector::getSingletonPtr()->getInjectorListener())) {
         _resolveComponents(lodConfig, cost, data, input, output, collapser);
         if(lodConfig.advanced.useBackgroundQueue) {
             _initWorkQueue();
@@ -217,6 +225,42 @@ void MeshLodGenerator::generateLodLevels(LodConfig& lodConfig,
     }
 }
 
+void MeshLodGenerator::generateLodLevels(std::vector<LodConfig>& lodConfigs)
+{
+    _initWorkQueue();
+    std::vector<LodWorkQueueRequest> requests;
+    std::vector<size_t> configIndices;
+    for(size_t i = 0; i < lodConfigs.size(); i++) {
+        if(!hasGeneratedLodLevels(lodConfigs[i])) {
+            _generateManualLodLevels(lodConfigs[i]);
+            continue;
+        }
+        LodWorkQueueRequest request;
+        request.config = lodConfigs[i];
+        // Buffer based providers read the mesh here and don't touch it on the workers.
+        request.config.advanced.useBackgroundQueue = true;
+        _resolveComponents(request.config, request.cost, request.data, request.input, request.output, request.collapser);
+        requests.push_back(request);
+        configIndices.push_back(i);
+    }
+
+    LodWorkQueueWorker::getSingleton().processRequests(requests);
+
+    LodWorkQueueInjectorListener* listener = LodWorkQueueInjector::getSingleton().getInjectorListener();
+    for(size_t i = 0; i < requests.size(); i++) {
+        LodConfig& lodConfig = lodConfigs[configIndices[i]];
+        lodConfig.levels = requests[i].config.levels;
+        if(listener && !listener->shouldInject(&requests[i])) {
+            continue;
+        }
+        requests[i].output->inject();
+        _configureMeshLodUsage(lodConfig);
+        if(listener) {
+            listener->injectionCompleted(&requests[i]);
+        }
+    }
+}
+
 void MeshLodGenerator::computeLods(LodConfig& lodConfig,
                                    LodData* data,
                                    LodCollapseCost* cost,
@@ -228,6 +228,9 @@ namespace Ogre
     */
     class _OgrePagingExport Grid2DPageStrategy : public PageStrategy
     {
+    protected:
+        /// Constructor for subclasses registering under a different name
+        Grid2DPageStrategy(const String& name, PageManager* manager);
     public:
         Grid2DPageStrategy(PageManager* manager);
 
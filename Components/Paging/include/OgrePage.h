@@ -57,7 +57,11 @@ namespace Ogre
         unsigned long mFrameLastHeld;
         ContentCollectionList mContentCollections;
         uint16 mWorkQueueChannel;
+        WorkQueue::RequestID mRequestID;
+        Real mPriority;
         bool mDeferredProcessInProgress;
+        bool mLoadPending;
+        bool mSynchronousLoad;
         bool mModified;
 
         SceneNode* mDebugNode;
@@ -67,6 +71,8 @@ namespace Ogre
         {
             ContentCollectionList collectionsToAdd;
         };
+        /// Prepared data waiting for _finaliseLoad, if finalisation was deferred
+        PageData* mPreparedData;
         /// Structure for holding background page requests
         struct PageRequest
         {
@@ -108,6 +114,21 @@ namespace Ogre
 
         /// If true, it's not safe to access this Page at this time, contents may be changing
         bool isDeferredProcessInProgress() const { return mDeferredProcessInProgress; }
+        /// If true, the load of this page is queued in its section but has not been started yet
+        bool isLoadPending() const { return mLoadPending; }
+        /// Internal method to notify the page that its load is (no longer) queued in the section
+        void _notifyLoadPending(bool pending) { mLoadPending = pending; }
+
+        /** Set the priority of loading this page.
+        @remarks
+            Pages with a higher priority have their background preparation
+            started and are finalised in the main thread before pages with a
+            lower priority. The priority can be changed at any time until the
+            page is finalised, usually by the PageStrategy every frame.
+        */
+        void setPriority(Real priority) { mPriority = priority; }
+        /// Get the priority of loading this page
+        Real getPriority() const { return mPriority; }
 
         /// Get the ID of this page, unique within the parent
         virtual PageID getID() const { return mID; }
@@ -129,6 +150,13 @@ namespace Ogre
         /** Unload this page. 
         */
         virtual void unload();
+        /** Finish loading this page in the main thread once it has been prepared.
+        @remarks
+            Normally this happens as soon as the background preparation completes.
+            When the PageManager has a finalisation time budget it is deferred,
+            and the PagedWorldSection calls this as the budget permits.
+        */
+        virtual void _finaliseLoad();
 
 
         /** Returns whether this page was 'held' in the last frame, that is
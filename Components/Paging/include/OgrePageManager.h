@@ -432,6 +432,39 @@ namespace Ogre
         /** Get whether paging operations are currently allowed to happen. */
         bool getPagingOperationsEnabled() const { return mPagingEnabled; }
 
+        /** Set the maximum number of page loads each PagedWorldSection may have
+            in progress at once (0 means no limit, the default).
+        @remarks
+            Once a page load has been handed to the WorkQueue it is processed in
+            the order it was submitted, so a low limit keeps most requests in
+            the section's own queue. There they are started in priority order
+            (see Page::setPriority), can be re-prioritised as the camera moves,
+            and are discarded without any work if the page is unloaded first.
+        */
+        void setPageRequestLimit(size_t limit) { mPageRequestLimit = limit; }
+        /** Get the maximum number of page loads each section may have in progress. */
+        size_t getPageRequestLimit() const { return mPageRequestLimit; }
+
+        /** Set the time in milliseconds which may be spent each frame finishing
+            the loading of prepared pages in the main thread (0 means no limit,
+            the default).
+        @remarks
+            Without a limit every page is finalised as soon as its background
+            preparation completes, which can cause a frame time spike when many
+            pages arrive at once. With a limit, prepared pages are queued and
+            finalised in priority order at the start of each frame until the
+            time is used up. The time is shared by all sections, but each section
+            with prepared pages finalises at least one page each frame.
+        */
+        void setPageFinaliseTimeBudget(Real ms) { mPageFinaliseTimeBudget = ms; }
+        /** Get the time which may be spent each frame finalising pages. */
+        Real getPageFinaliseTimeBudget() const { return mPageFinaliseTimeBudget; }
+
+        /// Internal method to get the time spent finalising pages this frame
+        Real _getPageFinaliseTimeUsed() const { return mPageFinaliseTimeUsed; }
+        /// Internal method to account for time spent finalising pages
+        void _notifyPageFinaliseTime(Real ms) { mPageFinaliseTimeUsed += ms; }
+
 
     protected:
 
@@ -466,9 +499,13 @@ namespace Ogre
         EventRouter mEventRouter;
         uint8 mDebugDisplayLvl;
         bool mPagingEnabled;
+        size_t mPageRequestLimit;
+        Real mPageFinaliseTimeBudget;
+        Real mPageFinaliseTimeUsed;
 
         Grid2DPageStrategy* mGrid2DPageStrategy;
         Grid3DPageStrategy* mGrid3DPageStrategy;
+        PredictiveGrid2DPageStrategy* mPredictiveGrid2DPageStrategy;
         SimplePageContentCollectionFactory* mSimpleCollectionFactory;
     };
 
@@ -70,6 +70,7 @@ namespace Ogre
     {
     public:
         typedef std::map<PageID, Page*> PageMap;
+        typedef std::vector<Page*> PageList;
     protected:
         String mName;
         AxisAlignedBox mAABB;
@@ -77,9 +78,18 @@ namespace Ogre
         PageStrategy* mStrategy;
         PageStrategyData* mStrategyData;
         PageMap mPages;
+        /// Pages whose load has been requested but not started, see PageManager::setPageRequestLimit
+        PageList mPendingPages;
+        /// Pages which have been prepared but not finalised, see PageManager::setPageFinaliseTimeBudget
+        PageList mPreparedPages;
         PageProvider* mPageProvider;
         SceneManager* mSceneMgr;
 
+        /// Start the loading of pending pages, highest priority first, within the request limit
+        virtual void processPendingPages();
+        /// Finalise prepared pages, highest priority first, within the time budget (at least one)
+        virtual void finalisePreparedPages();
+
         /// Load data specific to a subtype of this class (if any)
         virtual void loadSubtypeData(StreamSerialiser& ser) {}
         virtual void saveSubtypeData(StreamSerialiser& ser) {}
@@ -171,7 +181,9 @@ namespace Ogre
             charge of it usually.
             If this page is already loaded, this request will not load it again.
             If the page needs loading, then it may be an asynchronous process depending
-            on whether threading is enabled.
+            on whether threading is enabled. Asynchronous loads are queued and started
+            in priority order (see Page::setPriority) after the cameras have been
+            notified, subject to PageManager::setPageRequestLimit.
         @param pageID The page ID to load
         @param forceSynchronous If true, the page will always be loaded synchronously
         */
@@ -226,6 +238,14 @@ namespace Ogre
         */
         virtual bool _unprepareProceduralPage(Page* page);
 
+        /** Tell the section that a page has finished its background preparation.
+        @remarks
+            You should not call this method directly. 
+        @return true if the section will call Page::_finaliseLoad later, false
+            if the page should be finalised immediately
+        */
+        virtual bool _notifyPagePrepared(Page* page);
+
         /** Ask for a page to be kept in memory if it's loaded.
         @remarks
             This method indicates that a page should be retained if it's already
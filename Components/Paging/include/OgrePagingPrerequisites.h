@@ -47,6 +47,7 @@ namespace Ogre
     class PageManager;
     class PageStrategy;
     class PageStrategyData;
+    class PredictiveGrid2DPageStrategy;
     class PageProvider;
     class SimplePageContentCollection;
     class SimplePageContentCollectionFactory;
@@ -0,0 +1,214 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __Ogre_PredictiveGrid2DPageStrategy_H__
+#define __Ogre_PredictiveGrid2DPageStrategy_H__
+
+#include "OgrePagingPrerequisites.h"
+#include "OgreGrid2DPageStrategy.h"
+
+namespace Ogre
+{
+    /** \addtogroup Optional
+    *  @{
+    */
+    /** \addtogroup Paging
+    *  Some details on paging component
+    * @{ */
+
+    /** Specialisation of Grid2DPageStrategyData for PredictiveGrid2DPageStrategy.
+    @remarks
+        In addition to the grid definition this holds the look-ahead time and
+        the resident page budget, plus the runtime state the strategy tracks
+        per section: camera velocities, the last frame each page was requested
+        and the counters for the current frame. Only the settings are saved.
+    @par
+        The data format for this in a file is:<br/>
+        <b>PredictiveGrid2DPageStrategyData (Identifier 'PG2D')</b>\n
+        [Version 2]
+        <table>
+        <tr>
+            <td><b>Name</b></td>
+            <td><b>Type</b></td>
+            <td><b>Description</b></td>
+        </tr>
+        <tr>
+            <td>Grid data</td>
+            <td>Grid2DPageStrategyData chunk</td>
+            <td>The underlying grid definition</td>
+        </tr>
+        <tr>
+            <td>Look-ahead time</td>
+            <td>Real</td>
+            <td>How far into the future (in seconds) camera motion is extrapolated</td>
+        </tr>
+        <tr>
+            <td>Page budget</td>
+            <td>uint32</td>
+            <td>Maximum number of resident pages, 0 for no limit</td>
+        </tr>
+        <tr>
+            <td>Maximum look-ahead distance</td>
+            <td>Real</td>
+            <td>How far ahead of the camera (in cells) pages are requested (version 2)</td>
+        </tr>
+        <tr>
+            <td>Swept page limit</td>
+            <td>uint32</td>
+            <td>Maximum number of pages requested ahead of time per frame (version 2)</td>
+        </tr>
+        </table>
+    */
+    class _OgrePagingExport PredictiveGrid2DPageStrategyData : public Grid2DPageStrategyData
+    {
+    public:
+        /// Counters describing the paging activity of a single frame
+        struct FrameStats
+        {
+            /// Pages which were not resident and had a load requested
+            size_t pagesRequested;
+            /// Pages which were needed immediately but were not loaded yet
+            size_t pagesLoadedLate;
+            /// Pages which were unloaded to stay within the page budget
+            size_t pagesEvicted;
+
+            FrameStats() : pagesRequested(0), pagesLoadedLate(0), pagesEvicted(0) {}
+        };
+    protected:
+        struct CameraState
+        {
+            Vector2 lastPosition;
+            Vector2 velocity;
+            Real timeSinceUpdate;
+            unsigned long lastFrame;
+
+            CameraState(const Vector2& pos, unsigned long frame)
+                : lastPosition(pos), velocity(Vector2::ZERO), timeSinceUpdate(0), lastFrame(frame) {}
+        };
+        typedef std::map<Camera*, CameraState> CameraStateMap;
+        typedef std::map<PageID, unsigned long> PageFrameMap;
+
+        Real mLookAheadTime;
+        uint32 mPageBudget;
+        Real mMaxLookAheadCells;
+        uint32 mMaxSweptPages;
+
+        CameraStateMap mCameraStates;
+        PageFrameMap mPageLastRequested;
+        unsigned long mFrame;
+        FrameStats mFrameStats;
+
+        friend class PredictiveGrid2DPageStrategy;
+    public:
+        static const uint32 CHUNK_ID;
+        static const uint16 CHUNK_VERSION;
+
+        PredictiveGrid2DPageStrategyData();
+        ~PredictiveGrid2DPageStrategyData();
+
+        /** Set how far into the future (in seconds) the camera motion is
+            extrapolated when deciding which pages to request.
+        @remarks
+            Pages that the load radius will sweep over within this time are
+            requested ahead of time, nearest in time first. Set to 0 to get
+            the same behaviour as Grid2DPageStrategy.
+        */
+        void setLookAheadTime(Real seconds) { mLookAheadTime = seconds; }
+        /// Get how far into the future the camera motion is extrapolated
+        Real getLookAheadTime() const { return mLookAheadTime; }
+        /** Set the maximum distance (in cells) the camera motion is extrapolated.
+        @remarks
+            The predicted position is clamped to this distance from the camera,
+            however fast it moves. This bounds the number of cells scanned per frame.
+        */
+        void setMaxLookAheadCells(Real cells) { mMaxLookAheadCells = cells; }
+        /// Get the maximum distance (in cells) the camera motion is extrapolated
+        Real getMaxLookAheadCells() const { return mMaxLookAheadCells; }
+        /** Set the maximum number of pages outside the load range requested
+            ahead of time per frame and camera (0 means no limit).
+        @remarks
+            The ones needed soonest are requested, the others wait for a later frame.
+            Pages inside the load range are always requested.
+        */
+        void setMaxSweptPages(uint32 pages) { mMaxSweptPages = pages; }
+        /// Get the maximum number of pages requested ahead of time per frame
+        uint32 getMaxSweptPages() const { return mMaxSweptPages; }
+        /** Set the maximum number of pages requested by this strategy which may
+            be resident at once (0 means no limit).
+        @remarks
+            When the budget is exceeded at the end of a frame, pages which were
+            only held rather than requested that frame are unloaded, least
+            recently requested first. Pages inside the load range are never
+            evicted, so the budget should be at least the size of the load range.
+        */
+        void setPageBudget(uint32 pages) { mPageBudget = pages; }
+        /// Get the maximum number of resident pages
+        uint32 getPageBudget() const { return mPageBudget; }
+
+        /// Get the paging counters for the current frame
+        const FrameStats& getFrameStats() const { return mFrameStats; }
+        /// Get the current smoothed velocity of a camera in grid space (units per second)
+        Vector2 getCameraVelocity(Camera* cam) const;
+
+        /// Load this data from a stream (returns true if successful)
+        bool load(StreamSerialiser& stream);
+        /// Save this data to a stream
+        void save(StreamSerialiser& stream);
+    };
+
+    /** Page strategy which extends Grid2DPageStrategy by predicting camera motion.
+    @remarks
+        The velocity of each camera is estimated from its movement between
+        frames. A camera jumping further than the hold radius at once is taken
+        to have teleported, which resets its velocity. Pages are requested not only for the load range around the
+        camera, but also for every cell the load range will sweep over within
+        the look-ahead time, ordered by the estimated time until they are needed.
+        Page priorities are set in that order (see Page::setPriority), so pages
+        the camera is heading towards are prepared first.
+    @par
+        An optional page budget limits the number of resident pages, evicting
+        the least recently requested ones.
+    */
+    class _OgrePagingExport PredictiveGrid2DPageStrategy : public Grid2DPageStrategy
+    {
+    public:
+        PredictiveGrid2DPageStrategy(PageManager* manager);
+
+        ~PredictiveGrid2DPageStrategy();
+
+        // Overridden members
+        void frameStart(Real timeSinceLastFrame, PagedWorldSection* section);
+        void frameEnd(Real timeElapsed, PagedWorldSection* section);
+        void notifyCamera(Camera* cam, PagedWorldSection* section);
+        PageStrategyData* createData();
+    };
+
+    /** @} */
+    /** @} */
+}
+
+#endif
@@ -285,6 +285,12 @@ namespace Ogre
         : PageStrategy("Grid2D", manager)
     {
 
+    }
+    //---------------------------------------------------------------------
+    Grid2DPageStrategy::Grid2DPageStrategy(const String& name, PageManager* manager)
+        : PageStrategy(name, manager)
+    {
+
     }
     //---------------------------------------------------------------------
     Grid2DPageStrategy::~Grid2DPageStrategy()
@@ -338,8 +344,10 @@ namespace Ogre
                 PageID pageID = stratData->calculatePageID(cx, cy);
                 if (cx >= loadxmin && cx <= loadxmax && cy >= loadymin && cy <= loadymax)
                 {
-                    // in the 'load' range, request it
+                    // in the 'load' range, request it, nearest pages first
                     section->loadPage(pageID);
+                    if (Page* page = section->getPage(pageID))
+                        page->setPriority(-(Real)((cx - x) * (cx - x) + (cy - y) * (cy - y)));
                 }
                 else
                 {
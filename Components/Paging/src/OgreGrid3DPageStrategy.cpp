@@ -307,7 +307,12 @@ namespace Ogre
                         Ogre::AxisAlignedBox bbox(bl, bl+stratData->getCellSize());
 
                         if( cam->isVisible(bbox) )
+                        {
                             section->loadPage(pageID);
+                            // nearest pages first
+                            if (Page* page = section->getPage(pageID))
+                                page->setPriority(-bbox.getCenter().squaredDistance(pos));
+                        }
                         else
                             section->holdPage(pageID);
                     }
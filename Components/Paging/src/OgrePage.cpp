@@ -53,9 +53,14 @@ namespace Ogre
     Page::Page(PageID pageID, PagedWorldSection* parent)
         : mID(pageID)
         , mParent(parent)
+        , mRequestID(0)
+        , mPriority(0)
         , mDeferredProcessInProgress(false)
+        , mLoadPending(false)
+        , mSynchronousLoad(false)
         , mModified(false)
         , mDebugNode(0)
+        , mPreparedData(0)
     {
         WorkQueue* wq = Root::getSingleton().getWorkQueue();
         mWorkQueueChannel = wq->getChannel("Ogre/Page");
@@ -67,9 +72,22 @@ namespace Ogre
     Page::~Page()
     {
         WorkQueue* wq = Root::getSingleton().getWorkQueue();
+        // don't waste a background thread on a page which is no longer wanted
+        if (mDeferredProcessInProgress && !mPreparedData)
+            wq->abortPendingRequest(mRequestID);
         wq->removeRequestHandler(mWorkQueueChannel, this);
         wq->removeResponseHandler(mWorkQueueChannel, this);
 
+        if (mPreparedData)
+        {
+            for (ContentCollectionList::iterator i = mPreparedData->collectionsToAdd.begin();
+                i != mPreparedData->collectionsToAdd.end(); ++i)
+            {
+                delete *i;
+            }
+            OGRE_DELETE mPreparedData;
+        }
+
         destroyAllContentCollections();
         if (mDebugNode)
         {
@@ -184,7 +202,8 @@ namespace Ogre
             destroyAllContentCollections();
             PageRequest req(this);
             mDeferredProcessInProgress = true;
-            Root::getSingleton().getWorkQueue()->addRequest(mWorkQueueChannel, WORKQUEUE_PREPARE_REQUEST, 
+            mSynchronousLoad = synchronous;
+            mRequestID = Root::getSingleton().getWorkQueue()->addRequest(mWorkQueueChannel, WORKQUEUE_PREPARE_REQUEST, 
                 Any(req), 0, synchronous);
         }
 
@@ -256,16 +275,32 @@ namespace Ogre
         if (preq.srcPage!= this)
             return;
 
-        // final loading behaviour
-        if (res->succeeded())
+        if (!res->succeeded())
         {
-            if(!pres.pageData->collectionsToAdd.empty())
-                std::swap(mContentCollections, pres.pageData->collectionsToAdd);
-
-            loadImpl();
+            OGRE_DELETE pres.pageData;
+            mDeferredProcessInProgress = false;
+            return;
         }
 
-        OGRE_DELETE pres.pageData;
+        mPreparedData = pres.pageData;
+        // let the section spread the final loading over several frames if it has to
+        if (mSynchronousLoad || !mParent->_notifyPagePrepared(this))
+            _finaliseLoad();
+    }
+    //---------------------------------------------------------------------
+    void Page::_finaliseLoad()
+    {
+        if (!mPreparedData)
+            return;
+
+        // final loading behaviour
+        if(!mPreparedData->collectionsToAdd.empty())
+            std::swap(mContentCollections, mPreparedData->collectionsToAdd);
+
+        loadImpl();
+
+        OGRE_DELETE mPreparedData;
+        mPreparedData = 0;
 
         mDeferredProcessInProgress = false;
 
@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "OgrePagedWorld.h"
 #include "OgreGrid2DPageStrategy.h"
 #include "OgreGrid3DPageStrategy.h"
+#include "OgrePredictiveGrid2DPageStrategy.h"
 #include "OgreSimplePageContentCollection.h"
 #include "OgreStreamSerialiser.h"
 #include "OgreRoot.h"
@@ -48,8 +49,12 @@ namespace Ogre
         , mPageResourceGroup(ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME)
         , mDebugDisplayLvl(0)
         , mPagingEnabled(true)
+        , mPageRequestLimit(0)
+        , mPageFinaliseTimeBudget(0)
+        , mPageFinaliseTimeUsed(0)
         , mGrid2DPageStrategy(0)
         , mGrid3DPageStrategy(0)
+        , mPredictiveGrid2DPageStrategy(0)
         , mSimpleCollectionFactory(0)
     {
 
@@ -73,6 +78,7 @@ namespace Ogre
         }
         mCameraList.clear();
         
+        OGRE_DELETE mPredictiveGrid2DPageStrategy;
         OGRE_DELETE mGrid3DPageStrategy;
         OGRE_DELETE mGrid2DPageStrategy;
         OGRE_DELETE mSimpleCollectionFactory;
@@ -85,6 +91,9 @@ namespace Ogre
 
         mGrid3DPageStrategy = OGRE_NEW Grid3DPageStrategy(this);
         addStrategy(mGrid3DPageStrategy);
+
+        mPredictiveGrid2DPageStrategy = OGRE_NEW PredictiveGrid2DPageStrategy(this);
+        addStrategy(mPredictiveGrid2DPageStrategy);
     }
     //---------------------------------------------------------------------
     void PageManager::createStandardContentFactories()
@@ -520,6 +529,7 @@ namespace Ogre
         if(pWorldMap->empty())
             return true;
 
+        pManager->mPageFinaliseTimeUsed = 0;
         for(WorldMap::iterator i = pWorldMap->begin(); i != pWorldMap->end(); ++i)
         {
             i->second->frameStart(evt.timeSinceLastFrame);
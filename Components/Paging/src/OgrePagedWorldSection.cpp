@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "OgrePage.h"
 #include "OgreLogManager.h"
 #include "OgreRoot.h"
+#include "OgreTimer.h"
 
 namespace Ogre
 {
@@ -217,7 +218,14 @@ namespace Ogre
                     ret.first->second = page;
                 }
             }
-            page->load(sync);
+            if (sync)
+                page->load(true);
+            else
+            {
+                // started in priority order once the strategy has made all its requests
+                page->_notifyLoadPending(true);
+                mPendingPages.push_back(page);
+            }
         }
         else
             i->second->touch();
@@ -234,6 +242,13 @@ namespace Ogre
             Page* page = i->second;
             mPages.erase(i);
 
+            // cancel any load that hasn't completed yet
+            if (page->isLoadPending())
+                mPendingPages.erase(std::find(mPendingPages.begin(), mPendingPages.end(), page));
+            PageList::iterator p = std::find(mPreparedPages.begin(), mPreparedPages.end(), page);
+            if (p != mPreparedPages.end())
+                mPreparedPages.erase(p);
+
             page->unload();
 
             OGRE_DELETE page;
@@ -290,6 +305,78 @@ namespace Ogre
 
     }
     //---------------------------------------------------------------------
+    bool PagedWorldSection::_notifyPagePrepared(Page* page)
+    {
+        if (getManager()->getPageFinaliseTimeBudget() <= 0)
+            return false;
+
+        mPreparedPages.push_back(page);
+        return true;
+    }
+    //---------------------------------------------------------------------
+    namespace
+    {
+        bool pageHasHigherPriority(const Page* a, const Page* b)
+        {
+            return a->getPriority() > b->getPriority();
+        }
+    }
+    //---------------------------------------------------------------------
+    void PagedWorldSection::processPendingPages()
+    {
+        if (mPendingPages.empty() || !getManager()->getPagingOperationsEnabled())
+            return;
+
+        size_t count = mPendingPages.size();
+        size_t limit = getManager()->getPageRequestLimit();
+        if (limit)
+        {
+            size_t inProgress = 0;
+            for (PageMap::iterator i = mPages.begin(); i != mPages.end(); ++i)
+            {
+                if (i->second->isDeferredProcessInProgress())
+                    ++inProgress;
+            }
+            count = inProgress < limit ? std::min(count, limit - inProgress) : 0;
+        }
+        if (!count)
+            return;
+
+        // priorities may have changed since the pages were requested
+        std::stable_sort(mPendingPages.begin(), mPendingPages.end(), pageHasHigherPriority);
+
+        // detach the pages first, a synchronous WorkQueue finishes loading them right away
+        PageList toLoad(mPendingPages.begin(), mPendingPages.begin() + count);
+        mPendingPages.erase(mPendingPages.begin(), mPendingPages.begin() + count);
+        for (PageList::iterator i = toLoad.begin(); i != toLoad.end(); ++i)
+        {
+            (*i)->_notifyLoadPending(false);
+            (*i)->load(false);
+        }
+    }
+    //---------------------------------------------------------------------
+    void PagedWorldSection::finalisePreparedPages()
+    {
+        if (mPreparedPages.empty())
+            return;
+
+        PageManager* mgr = getManager();
+        Real budget = mgr->getPageFinaliseTimeBudget();
+        std::stable_sort(mPreparedPages.begin(), mPreparedPages.end(), pageHasHigherPriority);
+
+        Timer* timer = Root::getSingleton().getTimer();
+        size_t finalised = 0;
+        // the budget is shared by all sections, one page each keeps the later ones from starving
+        while (finalised < mPreparedPages.size() &&
+            (budget <= 0 || !finalised || mgr->_getPageFinaliseTimeUsed() < budget))
+        {
+            unsigned long start = timer->getMicroseconds();
+            mPreparedPages[finalised++]->_finaliseLoad();
+            mgr->_notifyPageFinaliseTime((timer->getMicroseconds() - start) * 0.001f);
+        }
+        mPreparedPages.erase(mPreparedPages.begin(), mPreparedPages.begin() + finalised);
+    }
+    //---------------------------------------------------------------------
     void PagedWorldSection::holdPage(PageID pageID)
     {
         PageMap::iterator i = mPages.find(pageID);
@@ -316,11 +403,15 @@ namespace Ogre
             OGRE_DELETE i->second;
         }
         mPages.clear();
+        mPendingPages.clear();
+        mPreparedPages.clear();
 
     }
     //---------------------------------------------------------------------
     void PagedWorldSection::frameStart(Real timeSinceLastFrame)
     {
+        finalisePreparedPages();
+
         mStrategy->frameStart(timeSinceLastFrame, this);
 
         for (PageMap::iterator i = mPages.begin(); i != mPages.end(); ++i)
@@ -343,11 +434,15 @@ namespace Ogre
                 p->frameEnd(timeElapsed);
         }
 
+        // pick up any loads requested outside of notifyCamera
+        processPendingPages();
+
     }
     //---------------------------------------------------------------------
     void PagedWorldSection::notifyCamera(Camera* cam)
     {
         mStrategy->notifyCamera(cam, this);
+        processPendingPages();
 
         for (PageMap::iterator i = mPages.begin(); i != mPages.end(); ++i)
             i->second->notifyCamera(cam);
@@ -0,0 +1,353 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgrePredictiveGrid2DPageStrategy.h"
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include "OgreStreamSerialiser.h"
+#include "OgreCamera.h"
+#include "OgrePagedWorldSection.h"
+#include "OgrePage.h"
+
+namespace Ogre
+{
+    //---------------------------------------------------------------------
+    const uint32 PredictiveGrid2DPageStrategyData::CHUNK_ID = StreamSerialiser::makeIdentifier("PG2D");
+    const uint16 PredictiveGrid2DPageStrategyData::CHUNK_VERSION = 2;
+    //---------------------------------------------------------------------
+    PredictiveGrid2DPageStrategyData::PredictiveGrid2DPageStrategyData()
+        : Grid2DPageStrategyData()
+        , mLookAheadTime(2)
+        , mPageBudget(0)
+        , mMaxLookAheadCells(16)
+        , mMaxSweptPages(64)
+        , mFrame(0)
+    {
+    }
+    //---------------------------------------------------------------------
+    PredictiveGrid2DPageStrategyData::~PredictiveGrid2DPageStrategyData()
+    {
+    }
+    //---------------------------------------------------------------------
+    Vector2 PredictiveGrid2DPageStrategyData::getCameraVelocity(Camera* cam) const
+    {
+        CameraStateMap::const_iterator i = mCameraStates.find(cam);
+        if (i != mCameraStates.end())
+            return i->second.velocity;
+        return Vector2::ZERO;
+    }
+    //---------------------------------------------------------------------
+    bool PredictiveGrid2DPageStrategyData::load(StreamSerialiser& ser)
+    {
+        const StreamSerialiser::Chunk* chunk =
+            ser.readChunkBegin(CHUNK_ID, CHUNK_VERSION, "PredictiveGrid2DPageStrategyData");
+        if (!chunk)
+            return false;
+
+        if (!Grid2DPageStrategyData::load(ser))
+        {
+            ser.readChunkEnd(CHUNK_ID);
+            return false;
+        }
+        ser.read(&mLookAheadTime);
+        ser.read(&mPageBudget);
+        if (chunk->version > 1)
+        {
+            ser.read(&mMaxLookAheadCells);
+            ser.read(&mMaxSweptPages);
+        }
+
+        ser.readChunkEnd(CHUNK_ID);
+
+        return true;
+    }
+    //---------------------------------------------------------------------
+    void PredictiveGrid2DPageStrategyData::save(StreamSerialiser& ser)
+    {
+        ser.writeChunkBegin(CHUNK_ID, CHUNK_VERSION);
+
+        Grid2DPageStrategyData::save(ser);
+        ser.write(&mLookAheadTime);
+        ser.write(&mPageBudget);
+        ser.write(&mMaxLookAheadCells);
+        ser.write(&mMaxSweptPages);
+
+        ser.writeChunkEnd(CHUNK_ID);
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    namespace
+    {
+        /// A page to be requested, with the time until the load range reaches it
+        struct PageCandidate
+        {
+            Real timeToLoad;
+            Real distanceSq;
+            PageID pageID;
+            bool immediate;
+            bool held;
+
+            bool operator<(const PageCandidate& rhs) const
+            {
+                if (timeToLoad != rhs.timeToLoad)
+                    return timeToLoad < rhs.timeToLoad;
+                return distanceSq < rhs.distanceSq;
+            }
+        };
+
+        /** Time interval in which a point at signed distance d along one axis
+            is within radius r of a position moving at speed v on that axis.
+        */
+        bool sweepInterval(Real d, Real v, Real r, Real& t0, Real& t1)
+        {
+            if (std::abs(v) < 1e-6f)
+            {
+                t0 = 0;
+                t1 = std::numeric_limits<Real>::max();
+                return std::abs(d) <= r;
+            }
+            t0 = (d - r) / v;
+            t1 = (d + r) / v;
+            if (t0 > t1)
+                std::swap(t0, t1);
+            return true;
+        }
+    }
+    //---------------------------------------------------------------------
+    PredictiveGrid2DPageStrategy::PredictiveGrid2DPageStrategy(PageManager* manager)
+        : Grid2DPageStrategy("PredictiveGrid2D", manager)
+    {
+
+    }
+    //---------------------------------------------------------------------
+    PredictiveGrid2DPageStrategy::~PredictiveGrid2DPageStrategy()
+    {
+
+    }
+    //---------------------------------------------------------------------
+    void PredictiveGrid2DPageStrategy::frameStart(Real timeSinceLastFrame, PagedWorldSection* section)
+    {
+        PredictiveGrid2DPageStrategyData* stratData =
+            static_cast<PredictiveGrid2DPageStrategyData*>(section->getStrategyData());
+
+        ++stratData->mFrame;
+        stratData->mFrameStats = PredictiveGrid2DPageStrategyData::FrameStats();
+
+        // forget cameras which weren't notified last frame, they may be gone
+        PredictiveGrid2DPageStrategyData::CameraStateMap& states = stratData->mCameraStates;
+        for (PredictiveGrid2DPageStrategyData::CameraStateMap::iterator i = states.begin(); i != states.end(); )
+        {
+            if (i->second.lastFrame + 1 < stratData->mFrame)
+                states.erase(i++);
+            else
+            {
+                i->second.timeSinceUpdate += timeSinceLastFrame;
+                ++i;
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    void PredictiveGrid2DPageStrategy::frameEnd(Real timeElapsed, PagedWorldSection* section)
+    {
+        PredictiveGrid2DPageStrategyData* stratData =
+            static_cast<PredictiveGrid2DPageStrategyData*>(section->getStrategyData());
+
+        PredictiveGrid2DPageStrategyData::PageFrameMap& pages = stratData->mPageLastRequested;
+        std::vector<std::pair<unsigned long, PageID> > evictable;
+        size_t resident = 0;
+        for (PredictiveGrid2DPageStrategyData::PageFrameMap::iterator i = pages.begin(); i != pages.end(); )
+        {
+            if (!section->getPage(i->first))
+            {
+                // unloaded by the section in the meantime
+                pages.erase(i++);
+                continue;
+            }
+            ++resident;
+            if (i->second != stratData->mFrame)
+                evictable.push_back(std::make_pair(i->second, i->first));
+            ++i;
+        }
+
+        uint32 budget = stratData->getPageBudget();
+        if (!budget || resident <= budget)
+            return;
+
+        size_t evictCount = std::min(resident - budget, evictable.size());
+        std::partial_sort(evictable.begin(), evictable.begin() + evictCount, evictable.end());
+        for (size_t i = 0; i < evictCount; ++i)
+        {
+            section->unloadPage(evictable[i].second);
+            pages.erase(evictable[i].second);
+        }
+        stratData->mFrameStats.pagesEvicted += evictCount;
+    }
+    //---------------------------------------------------------------------
+    void PredictiveGrid2DPageStrategy::notifyCamera(Camera* cam, PagedWorldSection* section)
+    {
+        PredictiveGrid2DPageStrategyData* stratData =
+            static_cast<PredictiveGrid2DPageStrategyData*>(section->getStrategyData());
+
+        const Vector3& pos = cam->getDerivedPosition();
+        Vector2 gridpos;
+        stratData->convertWorldToGridSpace(pos, gridpos);
+        int32 x, y;
+        stratData->determineGridLocation(gridpos, &x, &y);
+
+        // update the velocity estimate for this camera
+        PredictiveGrid2DPageStrategyData::CameraStateMap::iterator si = stratData->mCameraStates.find(cam);
+        if (si == stratData->mCameraStates.end())
+        {
+            si = stratData->mCameraStates.insert(std::make_pair(cam,
+                PredictiveGrid2DPageStrategyData::CameraState(gridpos, stratData->mFrame))).first;
+        }
+        PredictiveGrid2DPageStrategyData::CameraState& state = si->second;
+        Real cellSize = stratData->getCellSize();
+        Real loadRadius = stratData->getLoadRadiusInCells();
+        Real holdRadius = stratData->getHoldRadiusInCells();
+        if (state.timeSinceUpdate > 0)
+        {
+            Vector2 moved = gridpos - state.lastPosition;
+            if (moved.length() > holdRadius * cellSize)
+            {
+                // teleported (or placed after the first frame), nothing to extrapolate
+                state.velocity = Vector2::ZERO;
+            }
+            else
+            {
+                // smooth out frame time jitter
+                state.velocity = (state.velocity + moved / state.timeSinceUpdate) * 0.5f;
+            }
+            state.lastPosition = gridpos;
+            state.timeSinceUpdate = 0;
+        }
+        state.lastFrame = stratData->mFrame;
+
+        Real lookAhead = stratData->getLookAheadTime();
+        // camera position and velocity in cells, relative to the centre of cell (0,0)
+        Vector2 cellPos = (gridpos - stratData->mOrigin) / cellSize;
+        Vector2 cellVel = state.velocity / cellSize;
+        Real maxLookAhead = stratData->getMaxLookAheadCells();
+        Real speed = cellVel.length();
+        if (speed * lookAhead > maxLookAhead)
+            lookAhead = maxLookAhead / speed;
+        Vector2 predicted = cellPos + cellVel * lookAhead;
+
+        int32 minCellX = stratData->getCellRangeMinX();
+        int32 maxCellX = stratData->getCellRangeMaxX();
+        int32 minCellY = stratData->getCellRangeMinY();
+        int32 maxCellY = stratData->getCellRangeMaxY();
+
+        // the hold and load ranges are the same as Grid2DPageStrategy
+        // Round UP max, round DOWN min
+        int32 xmin = std::max(minCellX, (int32)std::floor(x - holdRadius));
+        int32 xmax = std::min(maxCellX, (int32)std::ceil(x + holdRadius));
+        int32 ymin = std::max(minCellY, (int32)std::floor(y - holdRadius));
+        int32 ymax = std::min(maxCellY, (int32)std::ceil(y + holdRadius));
+        int32 loadxmin = std::max(xmin, (int32)std::floor(x - loadRadius));
+        int32 loadxmax = std::min(xmax, (int32)std::ceil(x + loadRadius));
+        int32 loadymin = std::max(ymin, (int32)std::floor(y - loadRadius));
+        int32 loadymax = std::min(ymax, (int32)std::ceil(y + loadRadius));
+        // extend the scanned area by the range swept up to the predicted position
+        int32 scanxmin = std::max(minCellX, std::min(xmin, (int32)std::floor(predicted.x - loadRadius)));
+        int32 scanxmax = std::min(maxCellX, std::max(xmax, (int32)std::ceil(predicted.x + loadRadius)));
+        int32 scanymin = std::max(minCellY, std::min(ymin, (int32)std::floor(predicted.y - loadRadius)));
+        int32 scanymax = std::min(maxCellY, std::max(ymax, (int32)std::ceil(predicted.y + loadRadius)));
+
+        std::vector<PageCandidate> candidates;
+        for (int32 cy = scanymin; cy <= scanymax; ++cy)
+        {
+            for (int32 cx = scanxmin; cx <= scanxmax; ++cx)
+            {
+                PageCandidate c;
+                c.pageID = stratData->calculatePageID(cx, cy);
+                c.distanceSq = Vector2(cx - cellPos.x, cy - cellPos.y).squaredLength();
+                c.immediate = cx >= loadxmin && cx <= loadxmax && cy >= loadymin && cy <= loadymax;
+                c.timeToLoad = 0;
+                c.held = cx >= xmin && cx <= xmax && cy >= ymin && cy <= ymax;
+
+                bool swept = false;
+                if (!c.immediate && lookAhead > 0)
+                {
+                    // when will the load range first cover this cell?
+                    Real tx0, tx1, ty0, ty1;
+                    if (sweepInterval(cx - cellPos.x, cellVel.x, loadRadius, tx0, tx1) &&
+                        sweepInterval(cy - cellPos.y, cellVel.y, loadRadius, ty0, ty1))
+                    {
+                        c.timeToLoad = std::max((Real)0, std::max(tx0, ty0));
+                        swept = c.timeToLoad <= std::min(lookAhead, std::min(tx1, ty1));
+                    }
+                }
+
+                if (c.immediate || swept)
+                    candidates.push_back(c);
+                else if (c.held)
+                {
+                    // in the outer 'hold' range, keep it but don't actively load
+                    section->holdPage(c.pageID);
+                }
+                // other pages will by inference be marked for unloading
+            }
+        }
+
+        // request the pages in the order they will be needed
+        std::sort(candidates.begin(), candidates.end());
+        PredictiveGrid2DPageStrategyData::FrameStats& stats = stratData->mFrameStats;
+        uint32 maxSwept = stratData->getMaxSweptPages();
+        uint32 swept = 0;
+        for (std::vector<PageCandidate>::iterator i = candidates.begin(); i != candidates.end(); ++i)
+        {
+            if (!i->immediate && maxSwept && swept++ >= maxSwept)
+            {
+                // needed later than the ones requested, wait for a later frame
+                if (i->held)
+                    section->holdPage(i->pageID);
+                continue;
+            }
+            bool resident = section->getPage(i->pageID) != 0;
+            section->loadPage(i->pageID);
+            Page* page = section->getPage(i->pageID);
+            if (!page)
+                continue;
+
+            // earliest needed first
+            page->setPriority(-(Real)(i - candidates.begin()));
+            if (!resident)
+                ++stats.pagesRequested;
+            if (i->immediate && (page->isLoadPending() || page->isDeferredProcessInProgress()))
+                ++stats.pagesLoadedLate;
+            stratData->mPageLastRequested[i->pageID] = stratData->mFrame;
+        }
+    }
+    //---------------------------------------------------------------------
+    PageStrategyData* PredictiveGrid2DPageStrategy::createData()
+    {
+        return OGRE_NEW PredictiveGrid2DPageStrategyData();
+    }
+}
@@ -154,6 +154,9 @@ public:
     /** 
     Set the output shader cache path. Generated shader code will be written to this path.
     In case of empty cache path shaders will be generated directly from system memory.
+    The binaries of compiled shaders are kept in the "microcode" subfolder, if saving them is
+    enabled with GpuProgramManager::setSaveMicrocodesToCache, see
+    GpuProgramManager::setMicrocodeCacheLocation.
     @param cachePath The cache path of the shader.  
     The default is empty cache path.
     */
@@ -487,6 +490,10 @@ protected:
         /** Acquire the CPU/GPU programs for this pass. */
         void acquirePrograms();
 
+        /** Write the source code of the CPU programs for this pass, ahead of acquirePrograms.
+        Thread safe with respect to other passes. */
+        void writeSourceCode();
+
         /** Release the CPU/GPU programs of this pass. */
         void releasePrograms();
 
@@ -827,6 +834,11 @@ protected:
 
     /** Internal method that creates list of SGPass instances composing the given material. */
     SGPassList createSGPassList(Material* mat) const;
+
+    /** Write the shader source code of the given passes in parallel on the WorkQueue.
+    The GPU programs are created later on the calling thread by SGPass::acquirePrograms.
+    */
+    static void writeSourceCode(const SGPassList& passes);
 protected:  
     // Auto mutex.
     OGRE_AUTO_MUTEX;
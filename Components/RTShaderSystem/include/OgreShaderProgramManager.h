@@ -97,7 +97,7 @@ protected:
     //-----------------------------------------------------------------------------
     typedef std::set<Program*>                         ProgramList;
     typedef ProgramList::iterator                       ProgramListIterator;
-    typedef std::map<String, ProgramWriter*>           ProgramWriterMap;
+    typedef std::multimap<String, ProgramWriter*>      ProgramWriterMap;
     typedef ProgramWriterMap::iterator                  ProgramWriterIterator;
     typedef std::vector<ProgramWriterFactory*>         ProgramWriterFactoryList;
     
@@ -134,10 +134,27 @@ protected:
     */
     void destroyCpuProgram(Program* shaderProgram);
 
+    /** Prepare the CPU programs of the given program set for the target language and write
+    their source code.
+    @remarks
+    Unlike createGpuPrograms this is thread safe, so program sets can be written in parallel.
+    @param programSet The program set container.
+    */
+    void writeSourceCode(ProgramSet* programSet);
+
     /** Create GPU programs for the given program set based on the CPU programs it contains.
+    Writes the source code first, unless writeSourceCode was already called for the set.
     @param programSet The program set container.
     */
     void createGpuPrograms(ProgramSet* programSet);
+
+    /** Get an idle program writer for the given language, creating one if needed.
+    Writers are not thread safe, so each thread writing source code uses its own.
+    */
+    ProgramWriter* acquireProgramWriter(const String& language);
+
+    /** Return a writer obtained by acquireProgramWriter. */
+    void releaseProgramWriter(const String& language, ProgramWriter* programWriter);
         
     /** 
     Generates a unique hash from a string
@@ -149,14 +166,14 @@ protected:
 
     /** Create GPU program based on the give CPU program.
     @param shaderProgram The CPU program instance.
-    @param programWriter The program writer instance.
+    @param source The source code written for the CPU program.
     @param language The target shader language.
     @param profiles The profiles string for program compilation.
     @param profilesList The profiles string for program compilation as string list.
     @param cachePath The output path to write the program into.
     */
     GpuProgramPtr createGpuProgram(Program* shaderProgram, 
-        ProgramWriter* programWriter,
+        String source,
         const String& language,
         const String& profiles,
         const StringVector& profilesList,
@@ -191,8 +208,10 @@ protected:
     void synchronizePixelnToBeVertexOut(ProgramSet* programSet);
 
 protected:
-    // Map between target language and shader program writer.                   
+    // Map between target language and idle shader program writers.
     ProgramWriterMap mProgramWritersMap;
+    // Guards the program writers, source code is written on WorkQueue threads.
+    OGRE_WQ_MUTEX(mProgramWritersMutex);
     // Map between target language and shader program processor.    
     ProgramProcessorMap mProgramProcessorsMap;
     // Holds standard shader writer factories
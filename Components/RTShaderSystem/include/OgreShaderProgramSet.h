@@ -75,6 +75,9 @@ protected:
     GpuProgramPtr mVSGpuProgram;
     // Fragment shader CPU program.
     GpuProgramPtr mPSGpuProgram;
+    // Source code written for the CPU programs, until their GPU programs are created.
+    String mVSSource;
+    String mPSSource;
 
 private:
     friend class ProgramManager;
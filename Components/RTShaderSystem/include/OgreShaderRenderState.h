@@ -169,6 +169,12 @@ public:
     */
     void acquirePrograms(Pass* pass);
 
+    /** Create the CPU programs of this render state and write their source code.
+    Does not touch any Pass or GPU program, so it may run on a WorkQueue thread. A following
+    acquirePrograms call uses the written source code.
+    */
+    void _writeSourceCode();
+
     /** Release CPU/GPU programs set associated with the given render state and pass.
     @param pass The pass to release the programs from.
     */
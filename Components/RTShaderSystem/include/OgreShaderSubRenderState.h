@@ -91,6 +91,7 @@ public:
     One should use these program class API to create a representation of the sub state he wished to
     implement.
     @param programSet container class of CPU and GPU programs that this sub state will affect on.
+    @note May be called on a WorkQueue thread, concurrently with other render states.
     */
     virtual bool createCpuSubPrograms(ProgramSet* programSet);
 
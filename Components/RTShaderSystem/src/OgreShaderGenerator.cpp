@@ -25,6 +25,7 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreShaderPrecompiledHeaders.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
 
@@ -1358,6 +1359,7 @@ void ShaderGenerator::setShaderCachePath( const String& cachePath )
 
     if (mShaderCachePath != stdCachePath)
     {
+        String oldMicrocodePath = mShaderCachePath.empty() ? BLANKSTRING : mShaderCachePath + "microcode";
         mShaderCachePath = stdCachePath;
 
         // Case this is a valid file path -> add as resource location in order to make sure that
@@ -1379,6 +1381,15 @@ void ShaderGenerator::setShaderCachePath( const String& cachePath )
             outFile.close();
             remove(outTestFileName.c_str());
         }
+
+        // Keep the binaries of the generated programs next to their source, so they are
+        // not compiled again on the next run. Whether binaries are saved at all is left
+        // to the application, see GpuProgramManager::setSaveMicrocodesToCache.
+        GpuProgramManager& gpuProgramMgr = GpuProgramManager::getSingleton();
+        if (!mShaderCachePath.empty())
+            gpuProgramMgr.setMicrocodeCacheLocation(mShaderCachePath + "microcode");
+        else if (!oldMicrocodePath.empty() && gpuProgramMgr.getMicrocodeCacheLocation() == oldMicrocodePath)
+            gpuProgramMgr.setMicrocodeCacheLocation(BLANKSTRING);
     }
 }
 
@@ -1482,6 +1493,18 @@ ShaderGenerator::SGPassList ShaderGenerator::createSGPassList(Material* mat) con
     return passList;
 }
 
+//-----------------------------------------------------------------------------
+void ShaderGenerator::writeSourceCode(const SGPassList& passes)
+{
+    WorkQueue* workQueue = Root::getSingleton().getWorkQueue();
+
+    // otherwise each pass writes its source code when acquiring its programs
+    if (!workQueue || passes.size() < 2)
+        return;
+
+    workQueue->parallelFor(passes.size(), [&passes](size_t i) { passes[i]->writeSourceCode(); });
+}
+
 //-----------------------------------------------------------------------------
 ShaderGenerator::SGPass::SGPass(SGTechnique* parent, Pass* srcPass, Pass* dstPass, IlluminationStage stage)
 {
@@ -1552,6 +1575,13 @@ void ShaderGenerator::SGPass::acquirePrograms()
     mTargetRenderState->acquirePrograms(mDstPass);
 }
 
+//-----------------------------------------------------------------------------
+void ShaderGenerator::SGPass::writeSourceCode()
+{
+    if(!mTargetRenderState) return;
+    mTargetRenderState->_writeSourceCode();
+}
+
 //-----------------------------------------------------------------------------
 void ShaderGenerator::SGPass::releasePrograms()
 {
@@ -1913,6 +1943,23 @@ void ShaderGenerator::SGScheme::validate()
             curTechEntry->buildTargetRenderState();     
     }
 
+    // Write the source code of all passes in parallel.
+    SGPassList passes;
+    for (itTech = mTechniqueEntries.begin(); itTech != mTechniqueEntries.end(); ++itTech)
+    {
+        SGTechnique* curTechEntry = *itTech;
+
+        if (!curTechEntry->getBuildDestinationTechnique())
+            continue;
+
+        for (auto sgpass : curTechEntry->getPassList())
+        {
+            if (!sgpass->isIlluminationPass())
+                passes.push_back(sgpass);
+        }
+    }
+    writeSourceCode(passes);
+
     // Acquire GPU programs for each technique.
     for (itTech = mTechniqueEntries.begin(); itTech != mTechniqueEntries.end(); ++itTech)
     {
@@ -1998,6 +2045,15 @@ bool ShaderGenerator::SGScheme::validate(const String& materialName, const Strin
             // Build render state for each technique.
             curTechEntry->buildTargetRenderState();
 
+            // Write the source code of its passes in parallel.
+            SGPassList passes;
+            for (auto sgpass : curTechEntry->getPassList())
+            {
+                if (!sgpass->isIlluminationPass())
+                    passes.push_back(sgpass);
+            }
+            writeSourceCode(passes);
+
             // Acquire the CPU/GPU programs.
             curTechEntry->acquirePrograms();
 
@@ -196,7 +196,29 @@ void ProgramManager::destroyProgramWriters()
 }
 
 //-----------------------------------------------------------------------------
-void ProgramManager::createGpuPrograms(ProgramSet* programSet)
+ProgramWriter* ProgramManager::acquireProgramWriter(const String& language)
+{
+    OGRE_WQ_LOCK_MUTEX(mProgramWritersMutex);
+    ProgramWriterIterator itWriter = mProgramWritersMap.find(language);
+
+    // No idle writer found -> create new one.
+    if (itWriter == mProgramWritersMap.end())
+        return ProgramWriterManager::getSingletonPtr()->createProgramWriter(language);
+
+    ProgramWriter* programWriter = itWriter->second;
+    mProgramWritersMap.erase(itWriter);
+    return programWriter;
+}
+
+//-----------------------------------------------------------------------------
+void ProgramManager::releaseProgramWriter(const String& language, ProgramWriter* programWriter)
+{
+    OGRE_WQ_LOCK_MUTEX(mProgramWritersMutex);
+    mProgramWritersMap.insert(ProgramWriterMap::value_type(language, programWriter));
+}
+
+//-----------------------------------------------------------------------------
+void ProgramManager::writeSourceCode(ProgramSet* programSet)
 {
     // Before we start we need to make sure that the pixel shader input
     //  parameters are the same as the vertex output, this required by 
@@ -209,22 +231,7 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
         synchronizePixelnToBeVertexOut(programSet);
     }
 
-    // Grab the matching writer.
     const String& language = ShaderGenerator::getSingleton().getTargetLanguage();
-    ProgramWriterIterator itWriter = mProgramWritersMap.find(language);
-    ProgramWriter* programWriter = NULL;
-
-    // No writer found -> create new one.
-    if (itWriter == mProgramWritersMap.end())
-    {
-        programWriter = ProgramWriterManager::getSingletonPtr()->createProgramWriter(language);
-        mProgramWritersMap[language] = programWriter;
-    }
-    else
-    {
-        programWriter = itWriter->second;
-    }
-
     ProgramProcessorIterator itProcessor = mProgramProcessorsMap.find(language);
     ProgramProcessor* programProcessor = NULL;
 
@@ -232,7 +239,7 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
     {
         OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM,
             "Could not find processor for language '" + language,
-            "ProgramManager::createGpuPrograms");       
+            "ProgramManager::writeSourceCode");
     }
 
     programProcessor = itProcessor->second;
@@ -240,14 +247,36 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
     // Call the pre creation of GPU programs method.
     if (!programProcessor->preCreateGpuPrograms(programSet))
         OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "preCreateGpuPrograms failed");
-    
+
+    // Generate source code.
+    ProgramWriter* programWriter = acquireProgramWriter(language);
+    stringstream vsSource, psSource;
+    programWriter->writeSourceCode(vsSource, programSet->getCpuProgram(GPT_VERTEX_PROGRAM));
+    programWriter->writeSourceCode(psSource, programSet->getCpuProgram(GPT_FRAGMENT_PROGRAM));
+    releaseProgramWriter(language, programWriter);
+
+    programSet->mVSSource = vsSource.str();
+    programSet->mPSSource = psSource.str();
+}
+
+//-----------------------------------------------------------------------------
+void ProgramManager::createGpuPrograms(ProgramSet* programSet)
+{
+    if (programSet->mVSSource.empty())
+        writeSourceCode(programSet);
+
+    const String& language = ShaderGenerator::getSingleton().getTargetLanguage();
+    ProgramProcessor* programProcessor = mProgramProcessorsMap[language];
+
     // Create the shader programs
     for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
     {
-        auto gpuProgram = createGpuProgram(programSet->getCpuProgram(type), programWriter, language,
+        String& source = type == GPT_VERTEX_PROGRAM ? programSet->mVSSource : programSet->mPSSource;
+        auto gpuProgram = createGpuProgram(programSet->getCpuProgram(type), source, language,
                                            ShaderGenerator::getSingleton().getShaderProfiles(type),
                                            ShaderGenerator::getSingleton().getShaderProfilesList(type),
                                            ShaderGenerator::getSingleton().getShaderCachePath());
+        source.clear();
 
         OgreAssert(gpuProgram, "gpu program could not be created");
         programSet->setGpuProgram(gpuProgram);
@@ -264,18 +293,12 @@ void ProgramManager::createGpuPrograms(ProgramSet* programSet)
 
 //-----------------------------------------------------------------------------
 GpuProgramPtr ProgramManager::createGpuProgram(Program* shaderProgram, 
-                                               ProgramWriter* programWriter,
+                                               String source,
                                                const String& language,
                                                const String& profiles,
                                                const StringVector& profilesList,
                                                const String& cachePath)
 {
-    stringstream sourceCodeStringStream;
-
-    // Generate source code.
-    programWriter->writeSourceCode(sourceCodeStringStream, shaderProgram);
-    String source = sourceCodeStringStream.str();
-
     // Generate program name.
     String programName = generateHash(source, shaderProgram->getPreprocessorDefines());
 
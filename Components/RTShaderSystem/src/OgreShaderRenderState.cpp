@@ -157,10 +157,19 @@ void TargetRenderState::bindUniformParameters(Program* pCpuProgram, const GpuPro
     }
 }
 
-void TargetRenderState::acquirePrograms(Pass* pass)
+void TargetRenderState::_writeSourceCode()
 {
     createCpuPrograms();
 
+    ProgramManager::getSingleton().writeSourceCode(mProgramSet.get());
+}
+
+void TargetRenderState::acquirePrograms(Pass* pass)
+{
+    // source code might have been written already by ShaderGenerator::writeSourceCode
+    if (!mProgramSet || mProgramSet->mVSSource.empty())
+        _writeSourceCode();
+
     ProgramManager::getSingleton().createGpuPrograms(mProgramSet.get());
 
     for(auto type : {GPT_VERTEX_PROGRAM, GPT_FRAGMENT_PROGRAM})
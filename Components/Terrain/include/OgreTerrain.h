@@ -810,6 +810,19 @@ namespace Ogre
         */
         float getHeightAtTerrainPosition(Real x, Real y) const;
 
+        /** Get the height data for many terrain positions at once.
+        @remarks
+            Gives the same results as calling getHeightAtTerrainPosition for each
+            position, but samples the height data directly in a single pass.
+        @param positions Array of positions in terrain space, values from 0 to 1 left/right bottom/top
+        @param count The number of positions
+        @param outHeights Array of at least count heights to be filled in
+        @param outNormals Optional array of at least count normals to be filled in with
+            the normal of the triangle under each position, in local space
+        */
+        void getHeightsAtTerrainPositions(const Vector2* positions, size_t count,
+            float* outHeights, Vector3* outNormals = 0) const;
+
         /** Get the height data for a given world position (projecting the point
             down on to the terrain). 
         @param x, y,z Position in world space. Positions will be clamped to the edge
@@ -1276,6 +1289,9 @@ namespace Ogre
          @return A pair which contains whether the ray hit the terrain and, if so, where.
          @remarks This can be called from any thread as long as no parallel write to
          the heightmap data occurs.
+         @note Only quads the ray may touch are tested, based on a min/max height
+         pyramid. Changes made with setHeightAtPoint are taken into account once
+         updateDerivedData has started updating the derived data for them.
          */
         std::pair<bool, Vector3> rayIntersects(const Ray& ray, 
             bool cascadeToNeighbours = false, Real distanceLimit = 0); //const;
@@ -1862,6 +1878,32 @@ namespace Ogre
     private:
         /// Test a single quad of the terrain for ray intersection.
         OGRE_FORCE_INLINE std::pair<bool, Vector3> checkQuadIntersection(int x, int y, const Ray& ray) const;
+
+        /// Range of heights covered by a group of quads
+        struct HeightRange
+        {
+            float minimum;
+            float maximum;
+        };
+        /// Height ranges of the quads, level 0 holds one entry per quad, each further level halves the resolution
+        typedef std::vector<std::vector<HeightRange> > HeightPyramid;
+        /// Min / max pyramid of the height data, used to accelerate ray queries
+        HeightPyramid mHeightPyramid;
+        /// Changed vertices not in the height pyramid yet, as a derived data update was in progress
+        Rect mDirtyHeightPyramidRect;
+        /** Update the height pyramid for an area of changed height data.
+        @param rect The vertices which changed. The whole pyramid is built if it
+            does not match the terrain size yet.
+        @remarks While a derived data update is in progress, the change is held
+            back until it has finished, as the lightmap casts rays in the background.
+        */
+        void updateHeightPyramid(const Rect& rect);
+        /// Transform a world space ray into the local vertex space used by rayIntersects
+        Ray convertRayToVertexSpace(const Ray& ray) const;
+        /** Intersect a ray in local vertex space with this terrain only, between the
+            given distances, skipping all areas the ray passes above or below.
+        */
+        std::pair<bool, Vector3> rayIntersectsPyramid(const Ray& localRay, Real start, Real end) const;
     };
 
 
@@ -1897,6 +1939,7 @@ namespace Ogre
         Real mCompositeMapDistance;
         String mResourceGroup;
         bool mUseVertexCompressionWhenAvailable;
+        bool mCompressLodData;
 
     public:
         TerrainGlobalOptions();
@@ -2077,6 +2120,27 @@ namespace Ogre
          */
         void setUseVertexCompressionWhenAvailable(bool enable) { mUseVertexCompressionWhenAvailable = enable; }
 
+        /** Get whether the geometry data of each LOD level is compressed when
+            saving terrains.
+        */
+        bool getCompressLodData() const { return mCompressLodData; }
+
+        /** Set whether the geometry data of each LOD level is compressed when
+            saving terrains.
+        @remarks
+            Uncompressed LOD data takes more space on disk, but streaming in a LOD
+            level then only reads the data of that level, without inflating it.
+            This saves CPU time only: the heights are still copied into the height
+            data of the terrain, and the rest of the terrain (e.g. the blend maps)
+            is compressed regardless. From a plain file stream each level is read
+            through a temporary buffer; only a MemoryDataStream (as created for
+            terrain files by FileSystemArchiveFactory::setMemoryMapping) is read
+            in place.
+            Files saved without compression can not be read by versions of the
+            terrain component which predate this option. The default is true.
+        */
+        void setCompressLodData(bool compress) { mCompressLodData = compress; }
+
         /// @copydoc Singleton::getSingleton()
         static TerrainGlobalOptions& getSingleton(void);
         /// @copydoc Singleton::getSingleton()
@@ -419,6 +419,23 @@ namespace Ogre
         */
         float getHeightAtWorldPosition(const Vector3& pos, Terrain** ppTerrain = 0);
 
+        /** Get the height data for many world positions at once (projecting each
+        point down on to the terrain underneath).
+        @remarks
+            This is much cheaper per point than calling getHeightAtWorldPosition
+            repeatedly, e.g. when placing many objects on the ground. The points
+            are grouped by terrain slot internally, so they can be in any order.
+        @param positions Array of positions in world space
+        @param count The number of positions
+        @param outHeights Array of at least count heights to be filled in, 0 for
+            positions which are not over a loaded terrain
+        @param outNormals Optional array of at least count normals to be filled in,
+            in world space. Positions which are not over a loaded terrain get the
+            up axis of the group's alignment.
+        */
+        void getHeightsAtWorldPositions(const Vector3* positions, size_t count,
+            float* outHeights, Vector3* outNormals = 0) const;
+
         /** Test for intersection of a given ray with any terrain in the group. If the ray hits
          a terrain, the point of intersection and terrain instance is returned.
          @param ray The ray to test for intersection
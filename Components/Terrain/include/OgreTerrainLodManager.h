@@ -98,7 +98,9 @@ namespace Ogre
         virtual void handleResponse(const WorkQueue::Response* res, const WorkQueue* srcQ);
 
         void updateToLodLevel(int lodLevel, bool synchronous = false);
-        /// Save each LOD level separately compressed so seek is possible
+        /** Save each LOD level separately so seek is possible
+          @remarks The levels are compressed unless disabled with TerrainGlobalOptions::setCompressLodData
+          */
         static void saveLodData(StreamSerialiser& stream, Terrain* terrain);
 
         /** Copy geometry data from buffer to mHeightData/mDeltaData
@@ -111,8 +113,9 @@ namespace Ogre
         /** Read separated geometry data from file into allocated memory
           @param lowerLodBound Lower bound of LOD levels to load
           @param higherLodBound Upper bound of LOD levels to load
-          @remarks Geometry data are uncompressed using inflate() and stored into
-                allocated buffer
+          @remarks Compressed geometry data are uncompressed using inflate() and stored into
+                allocated buffer. Uncompressed data is used in place if the stream is
+                a MemoryDataStream, or else read without any conversion.
           */
         void readLodData(uint16 lowerLodBound, uint16 higherLodBound);
         void waitForDerivedProcesses();
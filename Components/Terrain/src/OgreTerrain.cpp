@@ -114,6 +114,7 @@ namespace Ogre
         , mCompositeMapDistance(4000)
         , mResourceGroup(ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME)
         , mUseVertexCompressionWhenAvailable(true)
+        , mCompressLodData(true)
     {
     }
     //---------------------------------------------------------------------
@@ -197,6 +198,7 @@ namespace Ogre
         , mLastViewportHeight(0)
         , mCustomGpuBufferAllocator(0)
         , mLodManager(0)
+        , mDirtyHeightPyramidRect(0, 0, 0, 0)
 
     {
         mRootNode = sm->getRootSceneNode()->createChildSceneNode();
@@ -790,6 +792,7 @@ namespace Ogre
         // Create & load quadtree
         mQuadTree = OGRE_NEW TerrainQuadTreeNode(this, 0, 0, 0, mSize, mNumLodLevels - 1, 0, 0);
         mQuadTree->prepare(stream);
+        updateHeightPyramid(Rect(0, 0, mSize, mSize));
 
         // stop uncompressing
         if(mainChunk->version > 1)
@@ -924,6 +927,7 @@ namespace Ogre
 
         mQuadTree = OGRE_NEW TerrainQuadTreeNode(this, 0, 0, 0, mSize, mNumLodLevels - 1, 0, 0);
         mQuadTree->prepare();
+        updateHeightPyramid(Rect(0, 0, mSize, mSize));
 
         // calculate entire terrain
         Rect rect;
@@ -1313,6 +1317,85 @@ namespace Ogre
         return (-plane.x * x - plane.y * y - plane.w) / plane.z;
     }
     //---------------------------------------------------------------------
+    void Terrain::getHeightsAtTerrainPositions(const Vector2* positions, size_t count,
+        float* outHeights, Vector3* outNormals) const
+    {
+        // while not all height data is there yet, let getHeightAtPoint interpolate it
+        bool partial = mLodManager->getHighestLodPrepared() > 0;
+
+        Real factor = (Real)mSize - 1.0f;
+        Real invScale = 1.0f / mScale;
+        for (size_t i = 0; i < count; ++i)
+        {
+            Real x = positions[i].x * factor;
+            Real y = positions[i].y * factor;
+            long startX = Math::Clamp(static_cast<long>(x), 0L, (long)mSize - 1L);
+            long startY = Math::Clamp(static_cast<long>(y), 0L, (long)mSize - 1L);
+            long endX = std::min(startX + 1, (long)mSize - 1L);
+            long endY = std::min(startY + 1, (long)mSize - 1L);
+            Real xParam = x - startX;
+            Real yParam = y - startY;
+
+            /* For even / odd tri strip rows, triangles are this shape:
+            even     odd
+            3---2   3---2
+            | / |   | \ |
+            0---1   0---1
+            */
+            Real h0, h1, h2, h3;
+            if (partial)
+            {
+                h0 = getHeightAtPoint(startX, startY);
+                h1 = getHeightAtPoint(endX, startY);
+                h2 = getHeightAtPoint(endX, endY);
+                h3 = getHeightAtPoint(startX, endY);
+            }
+            else
+            {
+                h0 = mHeightData[startY * mSize + startX];
+                h1 = mHeightData[startY * mSize + endX];
+                h2 = mHeightData[endY * mSize + endX];
+                h3 = mHeightData[endY * mSize + startX];
+            }
+
+            // the triangle's plane as h = base + dx * xParam + dy * yParam
+            Real base, dx, dy;
+            if (startY % 2)
+            {
+                // odd row
+                if ((1.0f - yParam) > xParam)
+                {
+                    base = h0; dx = h1 - h0; dy = h3 - h0;
+                }
+                else
+                {
+                    base = h1 + h3 - h2; dx = h2 - h3; dy = h2 - h1;
+                }
+            }
+            else
+            {
+                // even row
+                if (yParam > xParam)
+                {
+                    base = h0; dx = h2 - h3; dy = h3 - h0;
+                }
+                else
+                {
+                    base = h0; dx = h1 - h0; dy = h2 - h1;
+                }
+            }
+
+            outHeights[i] = base + dx * xParam + dy * yParam;
+
+            if (outNormals)
+            {
+                Vector3 normal(-dx * invScale, -dy * invScale, 1.0f);
+                normal.normalise();
+                outNormals[i] = convertTerrainToWorldAxes(normal);
+            }
+        }
+    }
+    //---------------------------------------------------------------------
     float Terrain::getHeightAtWorldPosition(Real x, Real y, Real z) const
     {
         Vector3 terrPos;
@@ -1970,6 +2053,11 @@ namespace Ogre
     void Terrain::updateDerivedDataImpl(const Rect& rect, const Rect& lightmapExtraRect, 
         bool synchronous, uint8 typeMask)
     {
+        // no background update is reading the height pyramid now, so bring it up
+        // to date before the next one starts
+        if (!rect.isNull())
+            updateHeightPyramid(rect);
+
         mDerivedDataUpdateInProgress = true;
         mDerivedUpdatePendingMask = 0;
 
@@ -2011,6 +2099,9 @@ namespace Ogre
         OGRE_DELETE mQuadTree;
         mQuadTree = 0;
 
+        mHeightPyramid.clear();
+        mDirtyHeightPyramidRect.setNull();
+
         if (mCpuTerrainNormalMap)
         {
             OGRE_FREE(mCpuTerrainNormalMap->data, MEMCATEGORY_GENERAL);
@@ -2100,13 +2191,29 @@ namespace Ogre
 
         mQuadTree->preDeltaCalculation(clampedRect);
 
+        // The work is split into bands of cell rows per target level, which are
+        // processed in parallel. Rather than telling the quadtree about every
+        // vertex, each band records the maximum delta per leaf sized block;
+        // every node covers whole blocks so this is equivalent, and the
+        // quadtree is only updated from this thread afterwards.
+        // Blocks are closed ranges, since leaf nodes share their edge vertices.
+        const long blockSize = mMaxBatchSize - 1;
+        const long blocksPerSide = (mSize - 1) / blockSize;
+
+        struct DeltaBand
+        {
+            int targetLevel;
+            long left, right;
+            long top, bottom;
+            long firstBlockRow;
+            std::vector<Real> blockMax;
+        };
+        std::vector<DeltaBand> bands;
+
         /// Iterate over target levels, 
         for (int targetLevel = 1; targetLevel < mNumLodLevels; ++targetLevel)
         {
-            int sourceLevel = targetLevel - 1;
-            int step = 1 << targetLevel;
-            // The step of the next higher LOD
-//          int higherstep = step >> 1;
+            long step = 1L << targetLevel;
 
             // need to widen the dirty rectangle since change will affect surrounding
             // vertices at lower LOD
@@ -2118,7 +2225,6 @@ namespace Ogre
 
             // keep a merge of the widest
             finalRect.merge(widenedRect);
-            
 
             // now round the rectangle at this level so that it starts & ends on 
             // the step boundaries
@@ -2130,115 +2236,144 @@ namespace Ogre
             if (lodRect.bottom % step)
                 lodRect.bottom += step - (lodRect.bottom % step);
 
-            for (long j = lodRect.top; j < lodRect.bottom - step; j += step )
+            // bands span at least one block row
+            long bandHeight = std::max(step, blockSize);
+            for (long top = lodRect.top; top < lodRect.bottom - step; top += bandHeight)
+            {
+                DeltaBand band;
+                band.targetLevel = targetLevel;
+                band.left = lodRect.left;
+                band.right = lodRect.right - step;
+                band.top = top;
+                band.bottom = std::min(top + bandHeight, lodRect.bottom - step);
+                // rows [top, bottom + step] may be touched
+                band.firstBlockRow = std::max(0L, top / blockSize - 1);
+                long lastBlockRow = std::min(blocksPerSide - 1, (band.bottom + step) / blockSize);
+                band.blockMax.resize((lastBlockRow - band.firstBlockRow + 1) * blocksPerSide,
+                                     -std::numeric_limits<Real>::max());
+                bands.push_back(band);
+            }
+        }
+
+        Root::getSingleton().getWorkQueue()->parallelFor(bands.size(), [&](size_t b) {
+            DeltaBand& band = bands[b];
+            long step = 1L << band.targetLevel;
+            long halfStep = step / 2;
+            Real invStep = 1.0f / step;
+
+            for (long j = band.top; j < band.bottom; j += step)
             {
-                for (long i = lodRect.left; i < lodRect.right - step; i += step )
+                // Form planes relating to the lower detail tris to be produced
+                // For even tri strip rows, they are this shape:
+                // 2---3
+                // | / |
+                // 0---1
+                // For odd tri strip rows, they are this shape:
+                // 2---3
+                // | \ |
+                // 0---1
+                // Odd or even in terms of target level
+                bool backwardTri = (j / step) % 2 != 0;
+                const float* row0 = mHeightData + j * mSize;
+                const float* row2 = mHeightData + (j + step) * mSize;
+
+                // include the bottommost row of vertices if this is the last row
+                long yubound = (j == (mSize - step)? step : step - 1);
+                for (long y = 0; y <= yubound; y++)
                 {
-                    // Form planes relating to the lower detail tris to be produced
-                    // For even tri strip rows, they are this shape:
-                    // 2---3
-                    // | / |
-                    // 0---1
-                    // For odd tri strip rows, they are this shape:
-                    // 2---3
-                    // | \ |
-                    // 0---1
-
-                    Vector3 v0, v1, v2, v3;
-                    getPointAlign(i, j, ALIGN_X_Y, &v0);
-                    getPointAlign(i + step, j, ALIGN_X_Y, &v1);
-                    getPointAlign(i, j + step, ALIGN_X_Y, &v2);
-                    getPointAlign(i + step, j + step, ALIGN_X_Y, &v3);
-
-                    Vector4 t1, t2;
-                    bool backwardTri = false;
-                    // Odd or even in terms of target level
-                    if ((j / step) % 2 == 0)
+                    long fulldetaily = j + y;
+                    const float* heights = mHeightData + fulldetaily * mSize;
+                    Real ypct = y * invStep;
+                    bool yOnStep = (y == 0 || y == step);
+                    bool yRemoved = (fulldetaily % step) == halfStep;
+                    bool yOnHalfStep = (fulldetaily % halfStep) == 0;
+
+                    // the blocks rows containing this vertex row
+                    long by0 = std::min(fulldetaily / blockSize, blocksPerSide - 1) - band.firstBlockRow;
+                    long by1 = (fulldetaily % blockSize == 0 && fulldetaily > 0) ?
+                        fulldetaily / blockSize - 1 - band.firstBlockRow : by0;
+                    Real* blocks0 = &band.blockMax[by0 * blocksPerSide];
+                    Real* blocks1 = &band.blockMax[by1 * blocksPerSide];
+
+                    for (long i = band.left; i < band.right; i += step)
                     {
-                        t1 = Math::calculateFaceNormalWithoutNormalize(v0, v1, v3);
-                        t2 = Math::calculateFaceNormalWithoutNormalize(v0, v3, v2);
-                    }
-                    else
-                    {
-                        t1 = Math::calculateFaceNormalWithoutNormalize(v1, v3, v2);
-                        t2 = Math::calculateFaceNormalWithoutNormalize(v0, v1, v2);
-                        backwardTri = true;
-                    }
+                        Real h0 = row0[i], h1 = row0[i + step];
+                        Real h2 = row2[i], h3 = row2[i + step];
+
+                        // plane equations of the two tris as h = c + dx * xpct + dy * ypct
+                        Real c1, dx1, dy1, c2, dx2, dy2;
+                        if (!backwardTri)
+                        {
+                            c1 = h0; dx1 = h1 - h0; dy1 = h3 - h1; // 0, 1, 3
+                            c2 = h0; dx2 = h3 - h2; dy2 = h2 - h0; // 0, 3, 2
+                        }
+                        else
+                        {
+                            c1 = h1 + h2 - h3; dx1 = h3 - h2; dy1 = h3 - h1; // 1, 3, 2
+                            c2 = h0; dx2 = h1 - h0; dy2 = h2 - h0; // 0, 1, 2
+                        }
+                        Real base1 = c1 + dy1 * ypct;
+                        Real base2 = c2 + dy2 * ypct;
 
-                    // include the bottommost row of vertices if this is the last row
-                    int yubound = (j == (mSize - step)? step : step - 1);
-                    for ( int y = 0; y <= yubound; y++ )
-                    {
                         // include the rightmost col of vertices if this is the last col
-                        int xubound = (i == (mSize - step)? step : step - 1);
-                        for ( int x = 0; x <= xubound; x++ )
+                        long xubound = (i == (mSize - step)? step : step - 1);
+                        for (long x = 0; x <= xubound; x++)
                         {
-                            int fulldetailx = static_cast<int>(i + x);
-                            int fulldetaily = static_cast<int>(j + y);
-                            if ( fulldetailx % step == 0 && 
-                                fulldetaily % step == 0 )
-                            {
-                                // Skip, this one is a vertex at this level
+                            // Skip, this one is a vertex at this level
+                            if (yOnStep && (x == 0 || x == step))
                                 continue;
-                            }
 
-                            Real ypct = (Real)y / (Real)step;
-                            Real xpct = (Real)x / (Real)step;
+                            long fulldetailx = i + x;
 
-                            //interpolated height
-                            Vector3 actualPos;
-                            getPointAlign(fulldetailx, fulldetaily, ALIGN_X_Y, &actualPos);
-                            Real interp_h;
                             // Determine which tri we're on 
-                            if ((xpct > ypct && !backwardTri) ||
-                                (xpct > (1-ypct) && backwardTri))
-                            {
-                                // Solve for x/z
-                                interp_h = 
-                                    (-t1.x * actualPos.x
-                                    - t1.y * actualPos.y
-                                    - t1.w) / t1.z;
-                            }
-                            else
-                            {
-                                // Second tri
-                                interp_h = 
-                                    (-t2.x * actualPos.x
-                                    - t2.y * actualPos.y
-                                    - t2.w) / t2.z;
-                            }
-
-                            Real actual_h = actualPos.z;
-                            Real delta = interp_h - actual_h;
+                            bool firstTri = backwardTri ? (x + y > step) : (x > y);
+                            Real interp_h = firstTri ?
+                                base1 + dx1 * (x * invStep) : base2 + dx2 * (x * invStep);
+                            Real delta = interp_h - heights[fulldetailx];
 
                             // max(delta) is the worst case scenario at this LOD
                             // compared to the original heightmap
-
-                            // tell the quadtree about this 
-                            mQuadTree->notifyDelta(fulldetailx, fulldetaily, sourceLevel, delta);
-
+                            long bx0 = std::min(fulldetailx / blockSize, blocksPerSide - 1);
+                            long bx1 = (fulldetailx % blockSize == 0 && fulldetailx > 0) ?
+                                fulldetailx / blockSize - 1 : bx0;
+                            blocks0[bx0] = std::max(blocks0[bx0], delta);
+                            blocks0[bx1] = std::max(blocks0[bx1], delta);
+                            blocks1[bx0] = std::max(blocks1[bx0], delta);
+                            blocks1[bx1] = std::max(blocks1[bx1], delta);
 
                             // If this vertex is being removed at this LOD, 
                             // then save the height difference since that's the move
                             // it will need to make. Vertices to be removed at this LOD
                             // are halfway between the steps, but exclude those that
                             // would have been eliminated at earlier levels
-                            int halfStep = step / 2;
-                            if (
-                             ((fulldetailx % step) == halfStep && (fulldetaily % halfStep) == 0) ||
-                             ((fulldetaily % step) == halfStep && (fulldetailx % halfStep) == 0))
+                            if ((fulldetailx % step == halfStep && yOnHalfStep) ||
+                                (yRemoved && fulldetailx % halfStep == 0))
                             {
                                 // Save height difference 
                                 mDeltaData[fulldetailx + (fulldetaily * mSize)] = delta;
                             }
-
                         }
-
                     }
-                } // i
-            } // j
+                }
+            }
+        });
 
-        } // targetLevel
+        // tell the quadtree about the deltas, using the centre of each block
+        // which is only contained by the nodes the whole block belongs to
+        for (const DeltaBand& band : bands)
+        {
+            uint16 sourceLevel = static_cast<uint16>(band.targetLevel - 1);
+            for (size_t b = 0; b < band.blockMax.size(); ++b)
+            {
+                if (band.blockMax[b] == -std::numeric_limits<Real>::max())
+                    continue;
+
+                long bx = b % blocksPerSide;
+                long by = b / blocksPerSide + band.firstBlockRow;
+                mQuadTree->notifyDelta(static_cast<uint16>(bx * blockSize + blockSize / 2),
+                    static_cast<uint16>(by * blockSize + blockSize / 2), sourceLevel, band.blockMax[b]);
+            }
+        }
 
         mQuadTree->postDeltaCalculation(clampedRect);
 
@@ -2346,104 +2481,21 @@ namespace Ogre
     {
         typedef std::pair<bool, Vector3> Result;
         // first step: convert the ray to a local vertex space
-        // we assume terrain to be in the x-z plane, with the [0,0] vertex
-        // at origin and a plane distance of 1 between vertices.
-        // This makes calculations easier.
-        Vector3 rayOrigin = ray.getOrigin() - getPosition();
-        Vector3 rayDirection = ray.getDirection();
-        // change alignment
-        Vector3 tmp;
-        switch (getAlignment())
-        {
-        case ALIGN_X_Y:
-            std::swap(rayOrigin.y, rayOrigin.z);
-            std::swap(rayDirection.y, rayDirection.z);
-            break;
-        case ALIGN_Y_Z:
-            // x = z, z = y, y = -x
-            tmp.x = rayOrigin.z; 
-            tmp.z = rayOrigin.y; 
-            tmp.y = -rayOrigin.x; 
-            rayOrigin = tmp;
-            tmp.x = rayDirection.z; 
-            tmp.z = rayDirection.y; 
-            tmp.y = -rayDirection.x; 
-            rayDirection = tmp;
-            break;
-        case ALIGN_X_Z:
-            // already in X/Z but values increase in -Z
-            rayOrigin.z = -rayOrigin.z;
-            rayDirection.z = -rayDirection.z;
-            break;
-        }
-        // readjust coordinate origin
-        rayOrigin.x += mWorldSize/2;
-        rayOrigin.z += mWorldSize/2;
-        // scale down to vertex level
-        rayOrigin.x /= mScale;
-        rayOrigin.z /= mScale;
-        rayDirection.x /= mScale;
-        rayDirection.z /= mScale;
-        rayDirection.normalise();
-        Ray localRay (rayOrigin, rayDirection);
+        Ray localRay = convertRayToVertexSpace(ray);
 
         // test if the ray actually hits the terrain's bounds
-        Real maxHeight = getMaxHeight();
-        Real minHeight = getMinHeight();
-
-        AxisAlignedBox aabb (Vector3(0, minHeight, 0), Vector3(mSize, maxHeight, mSize));
-        std::pair<bool, Real> aabbTest = localRay.intersects(aabb);
-        if (!aabbTest.first)
-        {
-            if (cascadeToNeighbours)
+        Result result(false, Vector3::ZERO);
+        Real start, end;
+        if (!mHeightPyramid.empty())
+        {
+            const HeightRange& bounds = mHeightPyramid.back()[0];
+            AxisAlignedBox aabb(Vector3(0, bounds.minimum, 0),
+                                Vector3((Real)mSize - 1, bounds.maximum, (Real)mSize - 1));
+            if (Math::intersects(localRay, aabb, &start, &end))
             {
-                OGRE_LOCK_RW_MUTEX_READ(mNeighbourMutex);
-                Terrain* neighbour = raySelectNeighbour(ray, distanceLimit);
-                if (neighbour)
-                    return neighbour->rayIntersects(ray, cascadeToNeighbours, distanceLimit);
+                // descend the height pyramid to the quads the ray may touch
+                result = rayIntersectsPyramid(localRay, start, end);
             }
-            return Result(false, Vector3());
-        }
-        // get intersection point and move inside
-        Vector3 cur = localRay.getPoint(aabbTest.second);
-
-        // now check every quad the ray touches
-        int quadX = std::min(std::max(static_cast<int>(cur.x), 0), (int)mSize-2);
-        int quadZ = std::min(std::max(static_cast<int>(cur.z), 0), (int)mSize-2);
-        int flipX = (rayDirection.x < 0 ? 0 : 1);
-        int flipZ = (rayDirection.z < 0 ? 0 : 1);
-        int xDir = (rayDirection.x < 0 ? -1 : 1);
-        int zDir = (rayDirection.z < 0 ? -1 : 1);
-
-        Result result(true, Vector3::ZERO);
-        Real dummyHighValue = (Real)mSize * 10000.0f;
-
-
-        while (cur.y >= (minHeight - 1e-3) && cur.y <= (maxHeight + 1e-3))
-        {
-            if (quadX < 0 || quadX >= (int)mSize-1 || quadZ < 0 || quadZ >= (int)mSize-1)
-                break;
-
-            result = checkQuadIntersection(quadX, quadZ, localRay);
-            if (result.first)
-                break;
-
-            // determine next quad to test
-            Real xDist = Math::RealEqual(rayDirection.x, 0.0) ? dummyHighValue : 
-                (quadX - cur.x + flipX) / rayDirection.x;
-            Real zDist = Math::RealEqual(rayDirection.z, 0.0) ? dummyHighValue : 
-                (quadZ - cur.z + flipZ) / rayDirection.z;
-            if (xDist < zDist)
-            {
-                quadX += xDir;
-                cur += rayDirection * xDist;
-            }
-            else
-            {
-                quadZ += zDir;
-                cur += rayDirection * zDist;
-            }
-
         }
 
         if (result.first)
@@ -2460,10 +2512,7 @@ namespace Ogre
                 break;
             case ALIGN_Y_Z:
                 // z = x, y = z, x = -y
-                tmp.x = -rayOrigin.y; 
-                tmp.y = rayOrigin.z; 
-                tmp.z = rayOrigin.x; 
-                rayOrigin = tmp;
+                result.second = Vector3(-result.second.y, result.second.z, result.second.x);
                 break;
             case ALIGN_X_Z:
                 result.second.z = -result.second.z;
@@ -2473,6 +2522,7 @@ namespace Ogre
         }
         else if (cascadeToNeighbours)
         {
+            OGRE_LOCK_RW_MUTEX_READ(mNeighbourMutex);
             Terrain* neighbour = raySelectNeighbour(ray, distanceLimit);
             if (neighbour)
                 result = neighbour->rayIntersects(ray, cascadeToNeighbours, distanceLimit);
@@ -2538,6 +2588,206 @@ namespace Ogre
         return std::pair<bool, Vector3>(false, Vector3());
     }
     //---------------------------------------------------------------------
+    void Terrain::updateHeightPyramid(const Rect& rect)
+    {
+        // the lightmap may be baking in the background, it casts rays against the
+        // pyramid, so leave it alone until that has finished
+        if (mDerivedDataUpdateInProgress)
+        {
+            mDirtyHeightPyramidRect.merge(rect);
+            return;
+        }
+
+        long quads = mSize - 1;
+        Rect cellRect;
+        if (mHeightPyramid.empty() || mHeightPyramid[0].size() != size_t(quads * quads))
+        {
+            mHeightPyramid.clear();
+            for (long cells = quads; cells > 0; cells /= 2)
+                mHeightPyramid.push_back(std::vector<HeightRange>(cells * cells));
+            cellRect = Rect(0, 0, quads, quads);
+        }
+        else
+        {
+            // all quads sharing a changed vertex
+            cellRect.left = std::max(0L, rect.left - 1);
+            cellRect.top = std::max(0L, rect.top - 1);
+            cellRect.right = std::min(quads, rect.right);
+            cellRect.bottom = std::min(quads, rect.bottom);
+            if (cellRect.width() <= 0 || cellRect.height() <= 0)
+                return;
+        }
+
+        // level 0 holds the height range of the corners of each quad
+        std::vector<HeightRange>& base = mHeightPyramid[0];
+        for (long z = cellRect.top; z < cellRect.bottom; ++z)
+        {
+            const float* row0 = mHeightData + z * mSize;
+            const float* row1 = row0 + mSize;
+            for (long x = cellRect.left; x < cellRect.right; ++x)
+            {
+                HeightRange& range = base[z * quads + x];
+                range.minimum = std::min(std::min(row0[x], row0[x + 1]), std::min(row1[x], row1[x + 1]));
+                range.maximum = std::max(std::max(row0[x], row0[x + 1]), std::max(row1[x], row1[x + 1]));
+            }
+        }
+
+        // each further level holds the range of 2x2 cells of the previous one
+        for (size_t level = 1; level < mHeightPyramid.size(); ++level)
+        {
+            long srcCells = quads >> (level - 1);
+            long cells = quads >> level;
+            cellRect.left /= 2;
+            cellRect.top /= 2;
+            cellRect.right = (cellRect.right + 1) / 2;
+            cellRect.bottom = (cellRect.bottom + 1) / 2;
+
+            const std::vector<HeightRange>& src = mHeightPyramid[level - 1];
+            std::vector<HeightRange>& dst = mHeightPyramid[level];
+            for (long z = cellRect.top; z < cellRect.bottom; ++z)
+            {
+                const HeightRange* row0 = &src[z * 2 * srcCells];
+                const HeightRange* row1 = row0 + srcCells;
+                for (long x = cellRect.left; x < cellRect.right; ++x)
+                {
+                    HeightRange& range = dst[z * cells + x];
+                    range.minimum = std::min(std::min(row0[x * 2].minimum, row0[x * 2 + 1].minimum),
+                                             std::min(row1[x * 2].minimum, row1[x * 2 + 1].minimum));
+                    range.maximum = std::max(std::max(row0[x * 2].maximum, row0[x * 2 + 1].maximum),
+                                             std::max(row1[x * 2].maximum, row1[x * 2 + 1].maximum));
+                }
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    std::pair<bool, Vector3> Terrain::rayIntersectsPyramid(const Ray& localRay, Real start, Real end) const
+    {
+        const Vector3& origin = localRay.getOrigin();
+        const Vector3& dir = localRay.getDirection();
+        const int topLevel = static_cast<int>(mHeightPyramid.size()) - 1;
+        const long quads = mSize - 1;
+        const Real heightPad = 1e-3f;
+        const long stepX = dir.x < 0 ? -1 : 1;
+        const long stepZ = dir.z < 0 ? -1 : 1;
+
+        // Walk the cells in integer grid coordinates rather than by advancing the
+        // distance, which no longer changes for distant rays once the step is
+        // below the float precision
+        int level = topLevel;
+        Vector3 cur = localRay.getPoint(start);
+        long cellX = Math::Clamp(static_cast<long>(cur.x), 0L, quads - 1) >> level;
+        long cellZ = Math::Clamp(static_cast<long>(cur.z), 0L, quads - 1) >> level;
+        Real t = start;
+        while (true)
+        {
+            long cellSize = 1L << level;
+            long cells = quads >> level;
+
+            // distances at which the ray leaves this cell on either axis
+            Real exitX = end, exitZ = end;
+            if (dir.x != 0)
+                exitX = ((cellX + (stepX > 0 ? 1 : 0)) * cellSize - origin.x) / dir.x;
+            if (dir.z != 0)
+                exitZ = ((cellZ + (stepZ > 0 ? 1 : 0)) * cellSize - origin.z) / dir.z;
+            Real cellEnd = std::min(std::min(exitX, exitZ), end);
+
+            // the ray is straight, so its extremes within the cell are at either end
+            Real startHeight = origin.y + dir.y * t;
+            Real endHeight = origin.y + dir.y * cellEnd;
+            const HeightRange& range = mHeightPyramid[level][cellZ * cells + cellX];
+            bool missesCell = std::min(startHeight, endHeight) > range.maximum + heightPad ||
+                std::max(startHeight, endHeight) < range.minimum - heightPad;
+
+            if (!missesCell && level > 0)
+            {
+                // the ray may touch the terrain, refine to the child cell it enters first
+                --level;
+                cur = localRay.getPoint(t);
+                cellX = Math::Clamp(static_cast<long>(cur.x) >> level, cellX * 2, cellX * 2 + 1);
+                cellZ = Math::Clamp(static_cast<long>(cur.z) >> level, cellZ * 2, cellZ * 2 + 1);
+                continue;
+            }
+
+            if (!missesCell)
+            {
+                std::pair<bool, Vector3> result = checkQuadIntersection(
+                    static_cast<int>(cellX), static_cast<int>(cellZ), localRay);
+                if (result.first)
+                    return result;
+            }
+
+            if (cellEnd >= end)
+                break;
+
+            // nothing in this cell, move on to the neighbour the ray crosses into
+            long prevX = cellX, prevZ = cellZ;
+            if (exitX < exitZ)
+                cellX += stepX;
+            else
+                cellZ += stepZ;
+            if (cellX < 0 || cellX >= cells || cellZ < 0 || cellZ >= cells)
+                break;
+            t = cellEnd;
+
+            // and try coarser cells again for as long as the ray just entered them
+            while (level < topLevel && ((cellX >> 1) != (prevX >> 1) || (cellZ >> 1) != (prevZ >> 1)))
+            {
+                cellX >>= 1;
+                cellZ >>= 1;
+                prevX >>= 1;
+                prevZ >>= 1;
+                ++level;
+            }
+        }
+
+        return std::pair<bool, Vector3>(false, Vector3());
+    }
+    //---------------------------------------------------------------------
+    Ray Terrain::convertRayToVertexSpace(const Ray& ray) const
+    {
+        // we assume terrain to be in the x-z plane, with the [0,0] vertex
+        // at origin and a plane distance of 1 between vertices.
+        // This makes calculations easier.
+        Vector3 rayOrigin = ray.getOrigin() - getPosition();
+        Vector3 rayDirection = ray.getDirection();
+        // change alignment
+        Vector3 tmp;
+        switch (getAlignment())
+        {
+        case ALIGN_X_Y:
+            std::swap(rayOrigin.y, rayOrigin.z);
+            std::swap(rayDirection.y, rayDirection.z);
+            break;
+        case ALIGN_Y_Z:
+            // x = z, z = y, y = -x
+            tmp.x = rayOrigin.z; 
+            tmp.z = rayOrigin.y; 
+            tmp.y = -rayOrigin.x; 
+            rayOrigin = tmp;
+            tmp.x = rayDirection.z; 
+            tmp.z = rayDirection.y; 
+            tmp.y = -rayDirection.x; 
+            rayDirection = tmp;
+            break;
+        case ALIGN_X_Z:
+            // already in X/Z but values increase in -Z
+            rayOrigin.z = -rayOrigin.z;
+            rayDirection.z = -rayDirection.z;
+            break;
+        }
+        // readjust coordinate origin
+        rayOrigin.x += mWorldSize/2;
+        rayOrigin.z += mWorldSize/2;
+        // scale down to vertex level
+        rayOrigin.x /= mScale;
+        rayOrigin.z /= mScale;
+        rayDirection.x /= mScale;
+        rayDirection.z /= mScale;
+        rayDirection.normalise();
+
+        return Ray(rayOrigin, rayDirection);
+    }
+    //---------------------------------------------------------------------
     const MaterialPtr& Terrain::getMaterial() const
     {
         if (!mMaterial || 
@@ -3237,6 +3487,13 @@ namespace Ogre
         
         mDerivedDataUpdateInProgress = false;
 
+        // apply height changes which were held back while rays were being cast
+        if (!mDirtyHeightPyramidRect.isNull())
+        {
+            updateHeightPyramid(mDirtyHeightPyramidRect);
+            mDirtyHeightPyramidRect.setNull();
+        }
+
         // Re-trigger another request if there are still things to do, or if
         // we had a new request since this one
         Rect newRect(0,0,0,0);
@@ -3355,47 +3612,73 @@ namespace Ogre
         //  4---P---0
         //  | / | \ |
         //  5---6---7
-
-        for (long y = widenedRect.top; y < widenedRect.bottom; ++y)
-        {
-            for (long x = widenedRect.left; x < widenedRect.right; ++x)
+        static const long offsetX[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+        static const long offsetY[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+
+        // Rows are processed in parallel bands. Interior points read the heights
+        // directly and work relative to P in terrain axes, since the rotation
+        // to local axes does not change the normal; only the edges need to
+        // consult the neighbours.
+        const long rowsPerBand = 16;
+        size_t numBands = (widenedRect.height() + rowsPerBand - 1) / rowsPerBand;
+
+        Root::getSingleton().getWorkQueue()->parallelFor(numBands, [&](size_t band) {
+            long top = widenedRect.top + band * rowsPerBand;
+            long bottom = std::min(top + rowsPerBand, widenedRect.bottom);
+            for (long y = top; y < bottom; ++y)
             {
-                Vector3 cumulativeNormal = Vector3::ZERO;
-
-                // Build points to sample
-                Vector3 centrePoint;
-                Vector3 adjacentPoints[8];
-                getPointFromSelfOrNeighbour(x  , y,   &centrePoint);
-                getPointFromSelfOrNeighbour(x+1, y,   &adjacentPoints[0]);
-                getPointFromSelfOrNeighbour(x+1, y+1, &adjacentPoints[1]);
-                getPointFromSelfOrNeighbour(x,   y+1, &adjacentPoints[2]);
-                getPointFromSelfOrNeighbour(x-1, y+1, &adjacentPoints[3]);
-                getPointFromSelfOrNeighbour(x-1, y,   &adjacentPoints[4]);
-                getPointFromSelfOrNeighbour(x-1, y-1, &adjacentPoints[5]);
-                getPointFromSelfOrNeighbour(x,   y-1, &adjacentPoints[6]);
-                getPointFromSelfOrNeighbour(x+1, y-1, &adjacentPoints[7]);
-
-                for (int i = 0; i < 8; ++i)
-                {
-                    cumulativeNormal += Math::calculateBasicFaceNormal(centrePoint, adjacentPoints[i], adjacentPoints[(i+1)%8]);
-                }
-
-                // normalise & store normal
-                cumulativeNormal.normalise();
-
-                // encode as RGB, object space
                 // invert the Y to deal with image space
-                long storeX = x - widenedRect.left;
                 long storeY = widenedRect.bottom - y - 1;
+                uint8* pStore = pData + storeY * widenedRect.width() * 3;
+                bool interiorRow = y > 0 && y < mSize - 1;
+
+                for (long x = widenedRect.left; x < widenedRect.right; ++x)
+                {
+                    Vector3 cumulativeNormal = Vector3::ZERO;
+
+                    if (interiorRow && x > 0 && x < mSize - 1)
+                    {
+                        const float* centre = mHeightData + y * mSize + x;
+                        Vector3 adjacentPoints[8];
+                        for (int i = 0; i < 8; ++i)
+                        {
+                            adjacentPoints[i].x = offsetX[i] * mScale;
+                            adjacentPoints[i].y = offsetY[i] * mScale;
+                            adjacentPoints[i].z = centre[offsetY[i] * mSize + offsetX[i]] - *centre;
+                        }
 
-                uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX) * 3;
-                *pStore++ = static_cast<uint8>((cumulativeNormal.x + 1.0f) * 0.5f * 255.0f);
-                *pStore++ = static_cast<uint8>((cumulativeNormal.y + 1.0f) * 0.5f * 255.0f);
-                *pStore++ = static_cast<uint8>((cumulativeNormal.z + 1.0f) * 0.5f * 255.0f);
+                        for (int i = 0; i < 8; ++i)
+                        {
+                            cumulativeNormal +=
+                                adjacentPoints[i].crossProduct(adjacentPoints[(i + 1) % 8]).normalisedCopy();
+                        }
+                        cumulativeNormal = convertTerrainToWorldAxes(cumulativeNormal);
+                    }
+                    else
+                    {
+                        // Build points to sample
+                        Vector3 centrePoint;
+                        Vector3 adjacentPoints[8];
+                        getPointFromSelfOrNeighbour(x, y, &centrePoint);
+                        for (int i = 0; i < 8; ++i)
+                            getPointFromSelfOrNeighbour(x + offsetX[i], y + offsetY[i], &adjacentPoints[i]);
+
+                        for (int i = 0; i < 8; ++i)
+                        {
+                            cumulativeNormal += Math::calculateBasicFaceNormal(centrePoint, adjacentPoints[i], adjacentPoints[(i+1)%8]);
+                        }
+                    }
 
+                    // normalise & store normal
+                    cumulativeNormal.normalise();
 
+                    // encode as RGB, object space
+                    *pStore++ = static_cast<uint8>((cumulativeNormal.x + 1.0f) * 0.5f * 255.0f);
+                    *pStore++ = static_cast<uint8>((cumulativeNormal.y + 1.0f) * 0.5f * 255.0f);
+                    *pStore++ = static_cast<uint8>((cumulativeNormal.z + 1.0f) * 0.5f * 255.0f);
+                }
             }
-        }
+        });
 
         finalRect = widenedRect;
 
@@ -3533,41 +3816,52 @@ namespace Ogre
 
         Real heightPad = (getMaxHeight() - getMinHeight()) * 1.0e-3f;
 
-        for (long y = widenedRect.top; y < widenedRect.bottom; ++y)
-        {
-            for (long x = widenedRect.left; x < widenedRect.right; ++x)
-            {
-                float litVal = 1.0f;
-
-                // convert to terrain space (not points, allow this to go between points)
-                float Tx = (float)x / (float)(mLightmapSizeActual-1);
-                float Ty = (float)y / (float)(mLightmapSizeActual-1);
-
-                // get world space point
-                // add a little height padding to stop shadowing self
-                Vector3 wpos = Vector3::ZERO;
-                getPosition(Tx, Ty, getHeightAtTerrainPosition(Tx, Ty) + heightPad, &wpos);
-                wpos += getPosition();
-                // build ray, cast backwards along light direction
-                Ray ray(wpos, -lightVec);
+        // texels are independent, so process square tiles in parallel
+        const long tileSize = 32;
+        long tilesX = (widenedRect.width() + tileSize - 1) / tileSize;
+        long tilesY = (widenedRect.height() + tileSize - 1) / tileSize;
 
-                // Cascade into neighbours when casting, but don't travel further
-                // than world size
-                std::pair<bool, Vector3> rayHit = rayIntersects(ray, true, mWorldSize);
-
-                if (rayHit.first)
-                    litVal = 0.0f;
-
-                // encode as L8
-                // invert the Y to deal with image space
-                long storeX = x - widenedRect.left;
-                long storeY = widenedRect.bottom - y - 1;
-
-                uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX);
-                *pStore = (unsigned char)(litVal * 255.0);
+        Root::getSingleton().getWorkQueue()->parallelFor(tilesX * tilesY, [&](size_t tile) {
+            long tileLeft = widenedRect.left + (tile % tilesX) * tileSize;
+            long tileTop = widenedRect.top + (tile / tilesX) * tileSize;
+            long tileRight = std::min(tileLeft + tileSize, widenedRect.right);
+            long tileBottom = std::min(tileTop + tileSize, widenedRect.bottom);
 
+            for (long y = tileTop; y < tileBottom; ++y)
+            {
+                for (long x = tileLeft; x < tileRight; ++x)
+                {
+                    float litVal = 1.0f;
+
+                    // convert to terrain space (not points, allow this to go between points)
+                    float Tx = (float)x / (float)(mLightmapSizeActual-1);
+                    float Ty = (float)y / (float)(mLightmapSizeActual-1);
+
+                    // get world space point
+                    // add a little height padding to stop shadowing self
+                    Vector3 wpos = Vector3::ZERO;
+                    getPosition(Tx, Ty, getHeightAtTerrainPosition(Tx, Ty) + heightPad, &wpos);
+                    wpos += getPosition();
+                    // build ray, cast backwards along light direction
+                    Ray ray(wpos, -lightVec);
+
+                    // Cascade into neighbours when casting, but don't travel further
+                    // than world size
+                    std::pair<bool, Vector3> rayHit = rayIntersects(ray, true, mWorldSize);
+
+                    if (rayHit.first)
+                        litVal = 0.0f;
+
+                    // encode as L8
+                    // invert the Y to deal with image space
+                    long storeX = x - widenedRect.left;
+                    long storeY = widenedRect.bottom - y - 1;
+
+                    uint8* pStore = pData + ((storeY * widenedRect.width()) + storeX);
+                    *pStore = (unsigned char)(litVal * 255.0);
+                }
             }
-        }
+        });
 
         return pixbox;
 
@@ -4594,6 +4888,7 @@ namespace Ogre
 
             mQuadTree = OGRE_NEW TerrainQuadTreeNode(this, 0, 0, 0, mSize, mNumLodLevels - 1, 0, 0);
             mQuadTree->prepare();
+            updateHeightPyramid(Rect(0, 0, mSize, mSize));
 
             // calculate entire terrain
             Rect rect;
@@ -512,6 +512,72 @@ namespace Ogre
         }
     }
     //---------------------------------------------------------------------
+    void TerrainGroup::getHeightsAtWorldPositions(const Vector3* positions, size_t count,
+        float* outHeights, Vector3* outNormals /*= 0*/) const
+    {
+        // find the slot of every point and its position in that slot's terrain space
+        std::vector<std::pair<uint32, size_t> > slotPoints(count);
+        std::vector<Vector2> terrainPositions(count);
+        Real offset = mTerrainWorldSize * 0.5f;
+        Real invWorldSize = 1.0f / mTerrainWorldSize;
+        for (size_t i = 0; i < count; ++i)
+        {
+            Vector3 terrainPos;
+            Terrain::convertWorldToTerrainAxes(mAlignment, positions[i] - mOrigin, &terrainPos);
+            Real tx = (terrainPos.x + offset) * invWorldSize;
+            Real ty = (terrainPos.y + offset) * invWorldSize;
+            long x = static_cast<long>(std::floor(tx));
+            long y = static_cast<long>(std::floor(ty));
+            terrainPositions[i] = Vector2(tx - x, ty - y);
+            slotPoints[i] = std::make_pair(packIndex(x, y), i);
+        }
+
+        // sample each terrain once for all of its points
+        std::sort(slotPoints.begin(), slotPoints.end());
+
+        Vector3 up;
+        Terrain::convertTerrainToWorldAxes(mAlignment, Vector3::UNIT_Z, &up);
+        std::vector<Vector2> batchPositions;
+        std::vector<float> batchHeights;
+        std::vector<Vector3> batchNormals;
+        for (size_t begin = 0, end; begin < count; begin = end)
+        {
+            uint32 key = slotPoints[begin].first;
+            for (end = begin + 1; end < count && slotPoints[end].first == key; ++end) {}
+            size_t num = end - begin;
+
+            TerrainSlotMap::const_iterator i = mTerrainSlots.find(key);
+            Terrain* terrain = i != mTerrainSlots.end() ? i->second->instance : 0;
+            if (!terrain || !terrain->isLoaded())
+            {
+                for (size_t p = begin; p < end; ++p)
+                {
+                    outHeights[slotPoints[p].second] = 0;
+                    if (outNormals)
+                        outNormals[slotPoints[p].second] = up;
+                }
+                continue;
+            }
+
+            batchPositions.resize(num);
+            batchHeights.resize(num);
+            if (outNormals)
+                batchNormals.resize(num);
+            for (size_t p = 0; p < num; ++p)
+                batchPositions[p] = terrainPositions[slotPoints[begin + p].second];
+
+            terrain->getHeightsAtTerrainPositions(&batchPositions[0], num, &batchHeights[0],
+                outNormals ? &batchNormals[0] : 0);
+
+            for (size_t p = 0; p < num; ++p)
+            {
+                outHeights[slotPoints[begin + p].second] = batchHeights[p];
+                if (outNormals)
+                    outNormals[slotPoints[begin + p].second] = batchNormals[p];
+            }
+        }
+    }
+    //---------------------------------------------------------------------
     TerrainGroup::RayResult TerrainGroup::rayIntersects(const Ray& ray, Real distanceLimit /* = 0*/) const 
     {
         long curr_x, curr_z;
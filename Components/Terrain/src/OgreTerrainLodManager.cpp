@@ -36,7 +36,7 @@ namespace Ogre
 {
     const uint16 TerrainLodManager::WORKQUEUE_LOAD_LOD_DATA_REQUEST = 1;
     const uint32 TerrainLodManager::TERRAINLODDATA_CHUNK_ID = StreamSerialiser::makeIdentifier("TLDA");
-    const uint16 TerrainLodManager::TERRAINLODDATA_CHUNK_VERSION = 1;
+    const uint16 TerrainLodManager::TERRAINLODDATA_CHUNK_VERSION = 2;
 
     TerrainLodManager::TerrainLodManager(Terrain* t, DataStreamPtr& stream)
         : mTerrain(t)
@@ -170,6 +170,7 @@ namespace Ogre
             {
                 mTerrain->dirty();
                 mTerrain->updateGeometryWithoutNotifyNeighbours();
+                mTerrain->updateHeightPyramid(Rect(0, 0, mTerrain->getSize(), mTerrain->getSize()));
             }
 
             // there are new requests
@@ -303,7 +304,7 @@ namespace Ogre
         }
     }
 
-    // save each LOD level separately compressed so seek is possible
+    // save each LOD level separately so seek is possible
     void TerrainLodManager::saveLodData(StreamSerialiser& stream, Terrain* terrain)
     {
         uint16 numLodLevels = terrain->getNumLodLevels();
@@ -312,12 +313,17 @@ namespace Ogre
         separateData(terrain->mHeightData, terrain->getSize(), numLodLevels, lods);
         separateData(terrain->mDeltaData, terrain->getSize(), numLodLevels, lods);
 
+        // version 1 chunks are compressed, version 2 chunks are stored as is so they
+        // can be read without inflating them
+        bool compress = TerrainGlobalOptions::getSingleton().getCompressLodData();
         for (int level = numLodLevels - 1; level >=0; level--)
         {
-            stream.writeChunkBegin(TERRAINLODDATA_CHUNK_ID, TERRAINLODDATA_CHUNK_VERSION);
-            stream.startDeflate();
+            stream.writeChunkBegin(TERRAINLODDATA_CHUNK_ID, compress ? 1 : TERRAINLODDATA_CHUNK_VERSION);
+            if (compress)
+                stream.startDeflate();
             stream.write(&(lods[level][0]), lods[level].size());
-            stream.stopDeflate();
+            if (compress)
+                stream.stopDeflate();
             stream.writeChunkEnd(TERRAINLODDATA_CHUNK_ID);
         }
     }
@@ -346,9 +352,13 @@ namespace Ogre
                 stream.readChunkEnd(TERRAINLODDATA_CHUNK_ID);
             }
 
-            // uncompress
+            // uncompressed data can be used in place if the whole file is in memory
+            MemoryDataStream* memStream = dynamic_cast<MemoryDataStream*>(mDataStream.get());
+            bool nativeEndian = (stream.getEndian() == StreamSerialiser::ENDIAN_BIG) ==
+                (OGRE_ENDIAN == OGRE_ENDIAN_BIG);
+
             uint maxSize = 2 * mTerrain->getGeoDataSizeAtLod(higherLodBound);
-            float *lodData = OGRE_ALLOC_T(float, maxSize, MEMCATEGORY_GENERAL);
+            float *lodData = 0;
 
             for(int level=lowerLodBound; level>=higherLodBound; level-- )
             {
@@ -358,12 +368,26 @@ namespace Ogre
                 // reach and read the target lod data
                 const StreamSerialiser::Chunk *c = stream.readChunkBegin(TERRAINLODDATA_CHUNK_ID,
                         TERRAINLODDATA_CHUNK_VERSION);
-                stream.startDeflate(c->length);
-                stream.read(lodData, dataSize);
-                stream.stopDeflate();
-                stream.readChunkEnd(TERRAINLODDATA_CHUNK_ID);
+                if (c->version > 1 && memStream && nativeEndian &&
+                    reinterpret_cast<size_t>(memStream->getCurrentPtr()) % sizeof(float) == 0)
+                {
+                    fillBufferAtLod(level, reinterpret_cast<const float*>(memStream->getCurrentPtr()), dataSize);
+                }
+                else
+                {
+                    if (!lodData)
+                        lodData = OGRE_ALLOC_T(float, maxSize, MEMCATEGORY_GENERAL);
+
+                    // version 1 is compressed, later versions are stored as is
+                    if (c->version == 1)
+                        stream.startDeflate(c->length);
+                    stream.read(lodData, dataSize);
+                    if (c->version == 1)
+                        stream.stopDeflate();
 
-                fillBufferAtLod(level, lodData, dataSize);
+                    fillBufferAtLod(level, lodData, dataSize);
+                }
+                stream.readChunkEnd(TERRAINLODDATA_CHUNK_ID);
             }
             stream.readChunkEnd(Terrain::TERRAIN_CHUNK_ID);
 
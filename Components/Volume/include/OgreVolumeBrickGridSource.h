@@ -0,0 +1,360 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __Ogre_Volume_BrickGridSource_H__
+#define __Ogre_Volume_BrickGridSource_H__
+
+#include <list>
+#include <map>
+
+#include "OgreVolumeGridSource.h"
+#include "Threading/OgreThreadHeaders.h"
+
+namespace Ogre {
+namespace Volume {
+    /** \addtogroup Optional
+    *  @{
+    */
+    /** \addtogroup Volume
+    *  @{
+    */
+    /** A sparse volume source from a 3D grid which is split into bricks of
+    BRICK_SIZE^3 voxels. Bricks with a single density value are collapsed to
+    that constant, all others are stored as 16 Bit floats or quantised to 8 Bit
+    relative to their own value range, optionally run length compressed. Encoded
+    bricks are decoded on demand into a LRU cache of limited size per sampling
+    thread, so even very big volumes only need a fraction of the memory of
+    HalfFloatGridSource.
+    */
+    class _OgreVolumeExport BrickGridSource : public GridSource
+    {
+    public:
+
+        /// The edge length of a brick in voxels.
+        static const size_t BRICK_SIZE = 16;
+
+        /// The amount of voxels in a brick.
+        static const size_t BRICK_VOXELS = BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;
+
+        /// How non uniform bricks are stored.
+        enum BrickFormat
+        {
+            /// 16 Bit float per voxel.
+            BF_HALF_FLOAT,
+            /// 8 Bit per voxel, quantised between the minimum and maximum value of the brick.
+            BF_QUANTISED_8
+        };
+
+    protected:
+
+        /// How a single brick is currently stored.
+        enum BrickEncoding
+        {
+            BE_CONSTANT,
+            BE_HALF_FLOAT,
+            BE_QUANTISED_8,
+            BE_RAW
+        };
+
+        /** A brick of the grid. Constant bricks only use mMinValue, raw bricks are
+        the ones being edited and hold uncompressed floats in mData.
+        */
+        struct Brick
+        {
+            /// The constant value or the minimum of a quantised brick.
+            float mMinValue;
+            /// The value range of a quantised brick.
+            float mRange;
+            /// The encoded data, 0 for constant bricks.
+            uint8 *mData;
+            /// The size of the encoded data in bytes.
+            uint32 mDataSize;
+            /// One of BrickEncoding.
+            uint8 mEncoding;
+            /// Whether mData is run length compressed.
+            bool mCompressed;
+        };
+
+        /// The bricks.
+        typedef std::vector<Brick> VecBrick;
+        VecBrick mBricks;
+
+        /// The amount of bricks in each direction.
+        size_t mBricksX, mBricksY, mBricksZ;
+
+        /// The format of non uniform bricks.
+        BrickFormat mFormat;
+
+        /// Whether to run length compress non uniform bricks.
+        bool mCompress;
+
+        /// The maximum absolute density value to be written into the data when combining.
+        Real mMaxClampedAbsoluteDensity;
+
+        /// The indices of the bricks which are currently raw because of editing.
+        std::vector<size_t> mRawBricks;
+
+        /// An entry of the decode cache.
+        struct CacheEntry
+        {
+            float *mValues;
+            std::list<size_t>::iterator mLruPosition;
+        };
+
+        /// The decoded bricks by index.
+        typedef std::map<size_t, CacheEntry> MapCache;
+
+        /** The decode cache of a single thread. Only its thread touches it while
+        sampling, so voxel lookups don't need any locking.
+        */
+        struct ThreadCache
+        {
+            /// Identifies the thread owning this cache.
+            const void *mThread;
+            /// The decoded bricks by index.
+            MapCache mCache;
+            /// The cached brick indices, most recently used first.
+            std::list<size_t> mLru;
+            /// The last brick which was looked up in the cache, speeding up coherent access.
+            size_t mLastBrick;
+            const float *mLastValues;
+        };
+
+        /// The decode caches of all threads which sampled this source.
+        typedef std::vector<ThreadCache*> VecThreadCache;
+        mutable VecThreadCache mThreadCaches;
+
+        /// Identifies this source in the per thread cache lookup.
+        size_t mId;
+
+        /// The maximum amount of decoded bricks in each cache.
+        size_t mCacheSize;
+
+        /// Guards the list of thread caches.
+        OGRE_WQ_MUTEX(mCacheMutex);
+
+        /** Sets up the dimensions and allocates the bricks as constant zero.
+        @param width
+            The width of the grid.
+        @param height
+            The height of the grid.
+        @param depth
+            The depth of the grid.
+        @param worldDimension
+            The size of the volume in world space.
+        */
+        void setupGrid(size_t width, size_t height, size_t depth, const Vector3 &worldDimension);
+
+        /** Gets the index of the brick containing a voxel.
+        */
+        inline size_t getBrickIndex(size_t x, size_t y, size_t z) const
+        {
+            return ((z / BRICK_SIZE) * mBricksY + y / BRICK_SIZE) * mBricksX + x / BRICK_SIZE;
+        }
+
+        /** Gets the index of a voxel inside of its brick.
+        */
+        inline size_t getVoxelIndex(size_t x, size_t y, size_t z) const
+        {
+            return ((z % BRICK_SIZE) * BRICK_SIZE + y % BRICK_SIZE) * BRICK_SIZE + x % BRICK_SIZE;
+        }
+
+        /** Encodes a brick, replacing its old data.
+        @param index
+            The index of the brick.
+        @param values
+            BRICK_VOXELS densities.
+        */
+        void encodeBrick(size_t index, const float *values);
+
+        /** Decodes a non constant brick.
+        @param brick
+            The brick to decode.
+        @param values
+            Receives BRICK_VOXELS densities.
+        */
+        void decodeBrick(const Brick &brick, float *values) const;
+
+        /** Gets the decode cache of the calling thread, creating it on first use.
+        @return
+            The cache of the calling thread.
+        */
+        ThreadCache *getThreadCache(void) const;
+
+        /** Gets the decoded values of a brick from a cache, decoding it on a miss.
+        @param cache
+            The cache of the calling thread.
+        @param index
+            The index of the brick.
+        @return
+            The BRICK_VOXELS densities of the brick.
+        */
+        const float *getCachedBrick(ThreadCache *cache, size_t index) const;
+
+        /** Removes a brick from the decode caches of all threads. Must not be
+        called while the source is sampled.
+        @param index
+            The index of the brick.
+        */
+        void uncacheBrick(size_t index);
+
+        /** Removes decoded bricks from a cache until it fits into the given size.
+        @param cache
+            The cache to shrink.
+        @param size
+            The amount of bricks to keep.
+        */
+        static void shrinkCache(ThreadCache *cache, size_t size);
+
+        /** Frees the encoded data of a brick.
+        @param brick
+            The brick.
+        */
+        static void freeBrickData(Brick &brick);
+
+        /** Overridden from GridSource.
+        */
+        virtual float getVolumeGridValue(size_t x, size_t y, size_t z) const;
+
+        /** Overridden from GridSource.
+        */
+        virtual void setVolumeGridValue(int x, int y, int z, float value);
+
+    public:
+
+        /** Constructor sampling another source.
+        @param src
+            The source to sample, from the origin to worldDimension.
+        @param worldDimension
+            The size of the volume in world space.
+        @param width
+            The width of the grid in voxels.
+        @param height
+            The height of the grid in voxels.
+        @param depth
+            The depth of the grid in voxels.
+        @param maxClampedAbsoluteDensity
+            The maximum absolute density value to store, also used when combining. Clamping
+            lets the bricks away from the surface collapse to constants. 0.0 to deactivate.
+        @param format
+            How to store non uniform bricks.
+        @param compress
+            Whether to run length compress non uniform bricks.
+        @param cacheSize
+            The maximum amount of decoded bricks to keep per sampling thread.
+        @param trilinearValue
+            Whether to use trilinear filtering (true) or nearest neighbour (false) for the value.
+        @param trilinearGradient
+            Whether to use trilinear filtering (true) or nearest neighbour (false) for the gradient.
+        @param sobelGradient
+            Whether to add a bit of blur to the gradient like in a sobel filter.
+        */
+        BrickGridSource(const Source *src, const Vector3 &worldDimension, size_t width, size_t height, size_t depth,
+            Real maxClampedAbsoluteDensity, BrickFormat format = BF_HALF_FLOAT, bool compress = true, size_t cacheSize = 2048,
+            const bool trilinearValue = true, const bool trilinearGradient = false, const bool sobelGradient = false);
+
+        /** Constructor loading a volume serialization. The grid is laid out like in
+        HalfFloatGridSource, but the file is streamed brick layer by brick layer so the
+        dense volume is never held in memory.
+        @param serializedVolumeFile
+            Which volume serialization to get the data from.
+        @param format
+            How to store non uniform bricks.
+        @param compress
+            Whether to run length compress non uniform bricks.
+        @param cacheSize
+            The maximum amount of decoded bricks to keep per sampling thread.
+        @param trilinearValue
+            Whether to use trilinear filtering (true) or nearest neighbour (false) for the value.
+        @param trilinearGradient
+            Whether to use trilinear filtering (true) or nearest neighbour (false) for the gradient.
+        @param sobelGradient
+            Whether to add a bit of blur to the gradient like in a sobel filter.
+        */
+        explicit BrickGridSource(const String &serializedVolumeFile,
+            BrickFormat format = BF_HALF_FLOAT, bool compress = true, size_t cacheSize = 2048,
+            const bool trilinearValue = true, const bool trilinearGradient = false, const bool sobelGradient = false);
+
+        /** Destructor.
+        */
+        ~BrickGridSource(void);
+
+        /** Overridden from GridSource. Re-encodes the edited bricks afterwards.
+        */
+        virtual void combineWithSource(CSGOperationSource *operation, Source *source, const Vector3 &center, Real radius);
+
+        /** Sets the maximum absolute density value to be written into the data when combining.
+        Set it to 0.0 to deactivate.
+        @param maxClampedAbsoluteDensity
+            The maximum absolute density value.
+        */
+        void setMaxClampedAbsoluteDensity(Real maxClampedAbsoluteDensity);
+
+        /** Gets the maximum absolute density value to be written into the data when combining.
+        @return
+            The maximum absolute density value, 0.0 when deactivated.
+        */
+        Real getMaxClampedAbsoluteDensity(void) const;
+
+        /** Sets the maximum amount of decoded bricks in the cache of each sampling
+        thread, each taking BRICK_VOXELS floats.
+        @param cacheSize
+            The amount of bricks, at least 1.
+        */
+        void setCacheSize(size_t cacheSize);
+
+        /** Gets the maximum amount of decoded bricks in the cache of each sampling thread.
+        @return
+            The amount of bricks.
+        */
+        size_t getCacheSize(void) const;
+
+        /** Gets the amount of bricks.
+        @return
+            The amount of bricks.
+        */
+        size_t getBrickCount(void) const;
+
+        /** Gets the amount of bricks collapsed to a constant value.
+        @return
+            The amount of constant bricks.
+        */
+        size_t getConstantBrickCount(void) const;
+
+        /** Gets the memory used by the bricks and the decode caches.
+        @return
+            The memory usage in bytes.
+        */
+        size_t getMemoryUsage(void) const;
+
+    };
+    /** @} */
+    /** @} */
+}
+}
+
+#endif
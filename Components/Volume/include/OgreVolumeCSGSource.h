@@ -71,6 +71,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *results, size_t count) const;
     };
 
     /** A plane.
@@ -102,6 +110,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *results, size_t count) const;
     };
 
     /** A not rotated cube.
@@ -166,6 +182,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *results, size_t count) const;
     };
 
     /** Abstract operation volume source holding two sources as operants.
@@ -244,6 +268,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *results, size_t count) const;
     };
 
     /** Builds the union between two sources.
@@ -271,6 +303,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *results, size_t count) const;
     };
 
     /** Builds the difference between two sources.
@@ -299,6 +339,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *results, size_t count) const;
     };
 
     /** Source which does a unary operation to another one.
@@ -359,6 +407,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *results, size_t count) const;
     };
 
     /** Scales the given volume source.
@@ -386,6 +442,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *results, size_t count) const;
     };
 
     class _OgreVolumeExport CSGNoiseSource: public CSGUnarySource
@@ -429,6 +493,16 @@ namespace Volume {
             return mSrc->getValue(position) + toAdd;
         }
 
+        /* Gets the density values of a batch of positions, see getInternalValue.
+        @param positions
+            The positions of the values.
+        @param results
+            Receives the values.
+        @param count
+            The amount of positions.
+        */
+        void getInternalValues(const Vector3 *positions, Real *results, size_t count) const;
+
     public:
         
         /** Constructor.
@@ -464,6 +538,14 @@ namespace Volume {
         /** Overridden from Source.
         */
         virtual Real getValue(const Vector3 &position) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const;
+
+        /** Overridden from Source.
+        */
+        virtual void getValues(const Vector3 *positions, Real *results, size_t count) const;
         
         /** Gets the initial seed.
         @return
@@ -32,6 +32,7 @@ THE SOFTWARE.
 
 #include "OgreVolumeSource.h"
 #include "OgreVolumePrerequisites.h"
+#include "Threading/OgreThreadHeaders.h"
 
 namespace Ogre {
 namespace Volume {
@@ -52,15 +53,30 @@ namespace Volume {
     bool _OgreVolumeExport operator<(const Vector3& a, const Vector3& b);
 
     /** A caching Source.
+    @remarks
+        The cache is locked, as chunks and batches of dual cells are evaluated
+        from the threads of the WorkQueue.
     */
     class _OgreVolumeExport CacheSource : public Source
     {
     protected:
         
+        /// Orders the positions with the operator above, Vector3::operator< is no strict weak ordering
+        struct PositionLess
+        {
+            bool operator()(const Vector3& a, const Vector3& b) const
+            {
+                return Volume::operator<(a, b);
+            }
+        };
+
         /// Map for the cache
-        typedef std::map<Vector3, Vector4> UMapPositionValue;
+        typedef std::map<Vector3, Vector4, PositionLess> UMapPositionValue;
         mutable UMapPositionValue mCache;
 
+        /// Guards mCache
+        OGRE_WQ_MUTEX(mCacheMutex);
+
         /// The source to cache.
         const Source *mSrc;
         
@@ -72,17 +88,18 @@ namespace Volume {
         */
         inline Vector4 getFromCache(const Vector3 &position) const
         {
-            Vector4 result;
-            std::map<Vector3, Vector4>::iterator it = mCache.find(position);
-            if (it == mCache.end())
-            {
-                result = mSrc->getValueAndGradient(position);
-                mCache[position] = result;
-            }
-            else
             {
-                result = it->second;
+                OGRE_WQ_LOCK_MUTEX(mCacheMutex);
+                UMapPositionValue::iterator it = mCache.find(position);
+                if (it != mCache.end())
+                {
+                    return it->second;
+                }
             }
+            // Evaluated without holding the lock, another thread might store the same value meanwhile.
+            Vector4 result = mSrc->getValueAndGradient(position);
+            OGRE_WQ_LOCK_MUTEX(mCacheMutex);
+            mCache[position] = result;
             return result;
         }
 
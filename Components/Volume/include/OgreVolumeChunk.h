@@ -96,12 +96,19 @@ namespace Volume {
         /// Whether to load the chunks async. if set to false, the call to load waits for the whole chunk. false is the default.
         bool async;
 
+        /** Whether the chunks keep their octree and triangles to speed up partial updates. An update then only
+        redoes the octree split decisions and the triangulation in the updated area instead of rebuilding the
+        affected chunks from scratch. The density must not have changed outside of the updated area. Costs
+        memory, false is the default.
+        */
+        bool incrementalUpdates;
+
         /** Constructor.
         */
         ChunkParameters(void) :
             sceneManager(0), src(0), baseError((Real)0.0), errorMultiplicator((Real)1.0), createOctreeVisualization(false),
             createDualGridVisualization(false), skirtFactor(0), lodCallback(0), scale((Real)1.0), maxScreenSpaceError(0), createGeometryFromLevel(0),
-            updateFrom(Vector3::ZERO), updateTo(Vector3::ZERO), async(false)
+            updateFrom(Vector3::ZERO), updateTo(Vector3::ZERO), async(false), incrementalUpdates(false)
         {
         }
     } ChunkParameters;
@@ -178,6 +185,18 @@ namespace Volume {
         /// Holds some shared data among all chunks of the tree.
         ChunkTreeSharedData *mShared;
 
+        /// The octree of the last generation if incremental updates are enabled.
+        OctreeNode *mCachedOctree;
+
+        /// The DualGridGenerator of the last generation if incremental updates are enabled.
+        DualGridGenerator *mCachedDualGridGenerator;
+
+        /// The MeshBuilder of the last generation if incremental updates are enabled.
+        MeshBuilder *mCachedMeshBuilder;
+
+        /// Counts the load requests of this chunk, only the data of the latest one is kept.
+        size_t mGeometryGeneration;
+
         /** Loads a single chunk of the tree.
         @param parent
             The parent scene node for the volume
@@ -259,6 +278,44 @@ namespace Volume {
         */
         virtual void prepareGeometry(size_t level, OctreeNode *root, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder, const Vector3 &totalFrom, const Vector3 &totalTo);
 
+        /** Updates the geometry of the last generation of this chunk in a changed area. To be called in a
+            different thread.
+        @param level
+            The current LOD level.
+        @param root
+            The octree of the last generation, gets split again in the updated area.
+        @param dualGridGenerator
+            The DualGridGenerator of the last generation.
+        @param meshBuilder
+            The MeshBuilder which will contain the geometry.
+        @param previousMeshBuilder
+            The MeshBuilder of the last generation.
+        @param updateFrom
+            The back lower left corner of the area where the density changed.
+        @param updateTo
+            The front upper right corner of the area where the density changed.
+        @param totalFrom
+            The back lower left corner of the world.
+        @param totalTo
+            The front upper rightcorner of the world.
+        */
+        virtual void updateGeometry(size_t level, OctreeNode *root, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder, const MeshBuilder *previousMeshBuilder,
+            const Vector3 &updateFrom, const Vector3 &updateTo, const Vector3 &totalFrom, const Vector3 &totalTo);
+
+        /** Keeps the data of a generation for the next incremental update, replacing the kept one.
+        @param root
+            The octree.
+        @param dualGridGenerator
+            The DualGridGenerator.
+        @param meshBuilder
+            The MeshBuilder.
+        */
+        void setCachedGeometryData(OctreeNode *root, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder);
+
+        /** Frees the data kept for incremental updates.
+        */
+        void deleteCachedGeometryData(void);
+
         /** Loads the actual geometry when the processing is done.
         @param meshBuilder
             The MeshBuilder holding the geometry.
@@ -78,6 +78,18 @@ namespace Volume {
 
         /// Whether this is an update of an existing tree
         bool isUpdate;
+
+        /// The MeshBuilder of the last generation if only the updated area is rebuilt, else null.
+        MeshBuilder *previousMeshBuilder;
+
+        /// The back lower left corner of the updated area.
+        Vector3 updateFrom;
+
+        /// The front upper right corner of the updated area.
+        Vector3 updateTo;
+
+        /// The generation of the origin chunk this request builds.
+        size_t generation;
         
         /** Stream operator <<.
         @param o
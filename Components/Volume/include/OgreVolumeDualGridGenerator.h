@@ -29,7 +29,9 @@ THE SOFTWARE.
 #define __Ogre_Volume_DualGridGenerator_H__
 
 #include <vector>
+#include <map>
 
+#include "OgreAxisAlignedBox.h"
 #include "OgreVolumeOctreeNode.h"
 #include "OgreVolumePrerequisites.h"
 #include "OgreVolumeIsoSurface.h"
@@ -101,6 +103,50 @@ namespace Volume {
         /// The total to.
         Vector3 mTotalTo;
 
+        /// The amount of pending dualcells after which they are triangulated.
+        static const size_t PENDING_CELLS_FLUSH_SIZE;
+
+        /// The amount of dualcells triangulated by one parallel task.
+        static const size_t CELL_BATCH_SIZE;
+
+        /// A dualcell waiting to be triangulated.
+        struct PendingDualCell
+        {
+            Vector3 corners[8];
+            Vector4 values[8];
+            bool hasValues;
+        };
+        typedef std::vector<PendingDualCell> VecPendingDualCell;
+
+        /// The dualcells waiting to be triangulated.
+        VecPendingDualCell mPendingCells;
+
+        /// Identifies a dualcell between two generations of the grid.
+        struct DualCellKey
+        {
+            Vector3 corners[8];
+            bool hasValues;
+            bool operator<(const DualCellKey &other) const;
+        };
+
+        /// Maps the dualcells which produced triangles to their index range in the MeshBuilder.
+        typedef std::map<DualCellKey, std::pair<size_t, size_t> > CellIndexRangeMap;
+
+        /// Whether to record the index ranges of the dualcells.
+        bool mRecordCells;
+
+        /// The index ranges of the dualcells in the current MeshBuilder.
+        CellIndexRangeMap mCellRanges;
+
+        /// The index ranges of the dualcells in the previous MeshBuilder while updating.
+        CellIndexRangeMap mPreviousCellRanges;
+
+        /// The MeshBuilder of the previous generation while updating, null otherwise.
+        const MeshBuilder *mPreviousMb;
+
+        /// The area where dualcells have to be triangulated again while updating.
+        AxisAlignedBox mChangedArea;
+
         /** Adds a dualcell.
          @param c0
             The first corner.
@@ -145,50 +191,140 @@ namespace Volume {
         inline void addDualCell(const Vector3 &c0, const Vector3 &c1, const Vector3 &c2, const Vector3 &c3, const Vector3 &c4, const Vector3 &c5, const Vector3 &c6, const Vector3 &c7,
             Vector4 *values)
         {
-
             if (mSaveDualCells)
             {
                 mDualCells.push_back(DualCell(c0, c1, c2, c3, c4, c5, c6, c7));
             }
-
-            Vector3 corners[8];
-            corners[0] = c0;
-            corners[1] = c1;
-            corners[2] = c2;
-            corners[3] = c3;
-            corners[4] = c4;
-            corners[5] = c5;
-            corners[6] = c6;
-            corners[7] = c7;
-            mIs->addMarchingCubesTriangles(corners, values, mMb);
-            Vector3 from = mRoot->getFrom();
-            Vector3 to = mRoot->getTo();
-            if (corners[0].z == from.z && corners[0].z != mTotalFrom.z)
+            mPendingCells.push_back(PendingDualCell());
+            PendingDualCell &cell = mPendingCells.back();
+            cell.corners[0] = c0;
+            cell.corners[1] = c1;
+            cell.corners[2] = c2;
+            cell.corners[3] = c3;
+            cell.corners[4] = c4;
+            cell.corners[5] = c5;
+            cell.corners[6] = c6;
+            cell.corners[7] = c7;
+            cell.hasValues = values != 0;
+            if (values)
             {
-                mIs->addMarchingSquaresTriangles(corners, values, IsoSurface::MS_CORNERS_BACK, mMaxMSDistance, mMb);
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    cell.values[i] = values[i];
+                }
             }
-            if (corners[2].z == to.z && corners[2].z != mTotalTo.z)
+            if (mPendingCells.size() >= PENDING_CELLS_FLUSH_SIZE)
             {
-                mIs->addMarchingSquaresTriangles(corners, values, IsoSurface::MS_CORNERS_FRONT, mMaxMSDistance, mMb);
-            }
-            if (corners[0].x == from.x && corners[0].x != mTotalFrom.x)
-            {
-                mIs->addMarchingSquaresTriangles(corners, values, IsoSurface::MS_CORNERS_LEFT, mMaxMSDistance, mMb);
-            }
-            if (corners[1].x == to.x && corners[1].x != mTotalTo.x)
-            {
-                mIs->addMarchingSquaresTriangles(corners, values, IsoSurface::MS_CORNERS_RIGHT, mMaxMSDistance, mMb);
-            }
-            if (corners[5].y == to.y && corners[5].y != mTotalTo.y)
-            {
-                mIs->addMarchingSquaresTriangles(corners, values, IsoSurface::MS_CORNERS_TOP, mMaxMSDistance, mMb);
-            }
-            if (corners[0].y == from.y && corners[0].y != mTotalFrom.y)
-            {
-                mIs->addMarchingSquaresTriangles(corners, values, IsoSurface::MS_CORNERS_BOTTOM, mMaxMSDistance, mMb);
+                if (mRecordCells)
+                {
+                    flushRecordedDualCells();
+                }
+                else
+                {
+                    flushDualCells();
+                }
             }
         }
 
+        /** Generates the dualgrid, see generateDualGrid, generateRecordedDualGrid and updateDualGrid.
+        @param root
+            The octree root node.
+        @param is
+            To contour the dualcells.
+        @param mb
+            To store the triangles of the contour.
+        @param maxMSDistance
+            The maximum distance to the isosurface where to generate skirts.
+        @param totalFrom
+            The global from.
+        @param totalTo
+            The global to.
+        @param saveDualCells
+            Whether to save the generated dualcells of the generated dual cells.
+        @param recordCells
+            Whether to record the index ranges of the dualcells.
+        @param previousMb
+            The MeshBuilder of the previous generation to copy unchanged dualcells from, may be null.
+        @param changed
+            The area where dualcells have to be triangulated again if previousMb is given.
+        */
+        void generateCells(const OctreeNode *root, IsoSurface *is, MeshBuilder *mb, Real maxMSDistance, const Vector3 &totalFrom, const Vector3 &totalTo, bool saveDualCells,
+            bool recordCells, const MeshBuilder *previousMb, const AxisAlignedBox &changed);
+
+        /** Triangulates all pending dualcells into the MeshBuilder. The cells are split into batches
+            which are triangulated in parallel into their own MeshBuilder and then appended in order,
+            so the result is the same as with a serial triangulation.
+        */
+        void flushDualCells(void);
+
+        /** Triangulates a range of the pending dualcells via Marching Cubes and adds the skirts
+            via Marching Squares. The corners of cells without precalculated values are evaluated
+            in one batch.
+        @param begin
+            The first pending cell.
+        @param end
+            One after the last pending cell.
+        @param mb
+            The MeshBuilder to add the triangles to.
+        */
+        void triangulateDualCells(size_t begin, size_t end, MeshBuilder *mb) const;
+
+        /// Where the triangles of a pending dualcell are to be found.
+        struct CellIndexRange
+        {
+            const MeshBuilder *mb;
+            size_t begin;
+            size_t end;
+            bool reused;
+        };
+        typedef std::vector<CellIndexRange> VecCellIndexRange;
+
+        /** Like flushDualCells, but records the index range of every dualcell and, while updating,
+            copies the triangles of unchanged dualcells from the previous MeshBuilder.
+        */
+        void flushRecordedDualCells(void);
+
+        /** Triangulates a range of the pending dualcells like triangulateDualCells, but skips the
+            reused ones and records the index ranges of the others.
+        @param begin
+            The first pending cell.
+        @param end
+            One after the last pending cell.
+        @param mb
+            The MeshBuilder to add the triangles to.
+        @param ranges
+            The index ranges of all pending cells.
+        */
+        void triangulateRecordedDualCells(size_t begin, size_t end, MeshBuilder *mb, VecCellIndexRange &ranges) const;
+
+        /** Triangulates a single dualcell.
+        @param cell
+            The cell.
+        @param values
+            The values at the corners, either cached ones or freshly evaluated.
+        @param mb
+            The MeshBuilder to add the triangles to.
+        */
+        void triangulateDualCell(const PendingDualCell &cell, const Vector4 *values, MeshBuilder *mb) const;
+
+        /** Evaluates the corners of all cells without cached values in a range at once.
+        @param begin
+            The first pending cell.
+        @param end
+            One after the last pending cell.
+        @param values
+            Receives eight values for every cell without cached values.
+        */
+        void evaluateDualCells(size_t begin, size_t end, std::vector<Vector4> &values) const;
+
+        /** Gets the key of a pending dualcell.
+        @param cell
+            The cell.
+        @return
+            The key.
+        */
+        static DualCellKey getKey(const PendingDualCell &cell);
+
         /* Startpoint for the creation recursion.
         @param n
             The node to start with.
@@ -322,6 +458,50 @@ namespace Volume {
         */
         void generateDualGrid(const OctreeNode *root, IsoSurface *is, MeshBuilder *mb, Real maxMSDistance, const Vector3 &totalFrom, const Vector3 &totalTo, bool saveDualCells);
 
+        /** Generates the dualgrid like generateDualGrid but remembers which triangles of the MeshBuilder
+            each dualcell produced, so a later updateDualGrid can reuse them.
+        @param root
+            The octree root node.
+        @param is
+            To contour the dualcells.
+        @param mb
+            To store the triangles of the contour.
+        @param maxMSDistance
+            The maximum distance to the isosurface where to generate skirts.
+        @param totalFrom
+            The global from.
+        @param totalTo
+            The global to.
+        @param saveDualCells
+            Whether to save the generated dualcells of the generated dual cells.
+        */
+        void generateRecordedDualGrid(const OctreeNode *root, IsoSurface *is, MeshBuilder *mb, Real maxMSDistance, const Vector3 &totalFrom, const Vector3 &totalTo, bool saveDualCells);
+
+        /** Regenerates the dualgrid after the octree has been updated via OctreeNode::resplit. Dualcells
+            outside of the changed area are not triangulated again but copied from the MeshBuilder of the
+            previous generateRecordedDualGrid or updateDualGrid call.
+        @param root
+            The octree root node.
+        @param is
+            To contour the dualcells.
+        @param mb
+            To store the triangles of the contour.
+        @param previousMb
+            The MeshBuilder filled by the previous generation of this instance.
+        @param changed
+            The area with changed densities, enlarged by the bounds of all changed leafs.
+        @param maxMSDistance
+            The maximum distance to the isosurface where to generate skirts.
+        @param totalFrom
+            The global from.
+        @param totalTo
+            The global to.
+        @param saveDualCells
+            Whether to save the generated dualcells of the generated dual cells.
+        */
+        void updateDualGrid(const OctreeNode *root, IsoSurface *is, MeshBuilder *mb, const MeshBuilder *previousMb, const AxisAlignedBox &changed,
+            Real maxMSDistance, const Vector3 &totalFrom, const Vector3 &totalTo, bool saveDualCells);
+
         /** Gets the lazily created entity of the dualgrid debug visualization.
         @param sceneManager
             The scenemanager creating the entity.
@@ -81,6 +81,15 @@ namespace Volume {
         static const size_t MS_CORNERS_BOTTOM[4];
 
         virtual ~IsoSurface(void);
+
+        /** Gets the source used to get the isovalue and normal.
+        @return
+            The source.
+        */
+        const Source* getSource(void) const
+        {
+            return mSrc;
+        }
         
         /** Adds triangles to a MeshBuilder via Marching Cubes.
         @param corners
@@ -301,6 +301,32 @@ namespace Volume {
             addVertex(Vertex(v2, n2));
         }
 
+        /** Appends the triangles of another MeshBuilder, reusing already existent vertices.
+            The result is the same as if the triangles had been added to this instance directly.
+        @param other
+            The MeshBuilder whose triangles are appended.
+        */
+        void append(const MeshBuilder &other);
+
+        /** Appends a range of the triangles of another MeshBuilder, reusing already existent vertices.
+        @param other
+            The MeshBuilder whose triangles are appended.
+        @param indexBegin
+            The first index of the range, the start of a triangle.
+        @param indexEnd
+            One after the last index of the range.
+        */
+        void append(const MeshBuilder &other, size_t indexBegin, size_t indexEnd);
+
+        /** Gets the amount of indices added so far, three per triangle.
+        @return
+            The amount of indices.
+        */
+        inline size_t getIndexCount(void) const
+        {
+            return mIndices.size();
+        }
+
         /** Generates the vertex- and indexbuffer of this mesh on the given
             RenderOperation.
         @param operation
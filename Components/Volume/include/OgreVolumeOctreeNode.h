@@ -80,6 +80,14 @@ namespace Volume {
             The manual object to add the lines to if this is a leaf in the octree.
         */
         void buildOctreeGridLines(ManualObject *manual) const;
+
+        /** Creates the eight children of this node without splitting them.
+        */
+        void createChildren(void);
+
+        /** Deletes the children of this node, making it a leaf.
+        */
+        void deleteChildren(void);
     public:
 
         /// Even in an OCtree, the amount of children should not be hardcoded.
@@ -146,6 +154,22 @@ namespace Volume {
         */
         void split(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError);
 
+        /** Redoes the split decisions of all nodes touching an area where the density changed. Nodes
+            not touching it keep their subdivision and center values, as a split of them would come to
+            the same result.
+        @param splitPolicy
+            Defines the policy deciding whether to split this node or not.
+        @param src
+            The volume source.
+        @param geometricError
+            The accepted geometric error.
+        @param dirty
+            The area where the density changed.
+        @param changed
+            Gets merged with the bounds of all leafs which are new or have been reevaluated.
+        */
+        void resplit(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError, const AxisAlignedBox &dirty, AxisAlignedBox &changed);
+
         /** Getter for the octree debug visualization of the octree starting with
             this node.
         @param sceneManager
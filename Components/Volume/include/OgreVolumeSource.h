@@ -101,6 +101,32 @@ namespace Volume {
         */
         virtual Real getValue(const Vector3 &position) const = 0;
 
+        /** Gets the density values and gradients of a batch of positions.
+        @remarks
+            The default implementation calls getValueAndGradient for each position. Sources
+            override this to evaluate the whole batch in a tight loop without the per sample
+            virtual call. The results must be identical to the single sample version.
+        @param positions
+            The positions.
+        @param results
+            Receives one vector per position with x, y, z containing the gradient and w containing the density.
+        @param count
+            The amount of positions.
+        */
+        virtual void getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const;
+
+        /** Gets the density values of a batch of positions.
+        @remarks
+            The default implementation calls getValue for each position.
+        @param positions
+            The positions.
+        @param results
+            Receives the density of each position.
+        @param count
+            The amount of positions.
+        */
+        virtual void getValues(const Vector3 *positions, Real *results, size_t count) const;
+
         /** Serializes a volume source to a discrete grid file with deflated
         compression. To achieve better compression, all density values are clamped
         within a maximum absolute value of (to - from).length() / 16.0. The values
@@ -0,0 +1,706 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreVolumeBrickGridSource.h"
+#include "OgreRoot.h"
+#include "OgreWorkQueue.h"
+#include "OgreDeflate.h"
+#include "OgreStreamSerialiser.h"
+#include "OgreBitwise.h"
+#include "OgreLogManager.h"
+#include "OgreTimer.h"
+#include "OgreAtomicScalar.h"
+
+namespace Ogre {
+namespace Volume {
+
+    const size_t BrickGridSource::BRICK_SIZE;
+    const size_t BrickGridSource::BRICK_VOXELS;
+
+    //-----------------------------------------------------------------------
+
+    namespace {
+        /// The id of the next brick grid source, 0 marks unused per thread lookup slots.
+        AtomicScalar<size_t> nextSourceId(1);
+
+        /** PackBits like run length encoding of elements with elementSize bytes. A control
+        byte below 128 is followed by control + 1 literal elements, otherwise by one element
+        repeated control - 126 times.
+        @return
+            The compressed size or 0 if it would not fit into dstCapacity.
+        */
+        size_t compressRuns(const uint8 *src, size_t count, size_t elementSize, uint8 *dst, size_t dstCapacity)
+        {
+            size_t out = 0;
+            size_t i = 0;
+            while (i < count)
+            {
+                size_t run = 1;
+                while (i + run < count && run < 129 && !memcmp(src + i * elementSize, src + (i + run) * elementSize, elementSize))
+                {
+                    ++run;
+                }
+                if (run > 1)
+                {
+                    if (out + 1 + elementSize > dstCapacity)
+                    {
+                        return 0;
+                    }
+                    dst[out++] = static_cast<uint8>(run + 126);
+                    memcpy(dst + out, src + i * elementSize, elementSize);
+                    out += elementSize;
+                    i += run;
+                    continue;
+                }
+                size_t j = i + 1;
+                while (j < count && j - i < 128 &&
+                    !(j + 1 < count && !memcmp(src + j * elementSize, src + (j + 1) * elementSize, elementSize)))
+                {
+                    ++j;
+                }
+                size_t literals = j - i;
+                if (out + 1 + literals * elementSize > dstCapacity)
+                {
+                    return 0;
+                }
+                dst[out++] = static_cast<uint8>(literals - 1);
+                memcpy(dst + out, src + i * elementSize, literals * elementSize);
+                out += literals * elementSize;
+                i = j;
+            }
+            return out;
+        }
+
+        /** Reverts compressRuns.
+        */
+        void decompressRuns(const uint8 *src, size_t size, size_t elementSize, uint8 *dst)
+        {
+            size_t in = 0;
+            while (in < size)
+            {
+                uint8 control = src[in++];
+                if (control < 128)
+                {
+                    size_t bytes = (control + 1) * elementSize;
+                    memcpy(dst, src + in, bytes);
+                    dst += bytes;
+                    in += bytes;
+                }
+                else
+                {
+                    for (size_t i = 0; i < (size_t)control - 126; ++i)
+                    {
+                        memcpy(dst, src + in, elementSize);
+                        dst += elementSize;
+                    }
+                    in += elementSize;
+                }
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void BrickGridSource::setupGrid(size_t width, size_t height, size_t depth, const Vector3 &worldDimension)
+    {
+        mWidth = width;
+        mHeight = height;
+        mDepth = depth;
+        mBricksX = (mWidth + BRICK_SIZE - 1) / BRICK_SIZE;
+        mBricksY = (mHeight + BRICK_SIZE - 1) / BRICK_SIZE;
+        mBricksZ = (mDepth + BRICK_SIZE - 1) / BRICK_SIZE;
+
+        mPosXScale = (Real)1.0 / (Real)worldDimension.x * (Real)mWidth;
+        mPosYScale = (Real)1.0 / (Real)worldDimension.y * (Real)mHeight;
+        mPosZScale = (Real)1.0 / (Real)worldDimension.z * (Real)mDepth;
+        mVolumeSpaceToWorldSpaceFactor = (Real)worldDimension.x * (Real)mWidth;
+
+        Brick empty;
+        empty.mMinValue = 0;
+        empty.mRange = 0;
+        empty.mData = 0;
+        empty.mDataSize = 0;
+        empty.mEncoding = BE_CONSTANT;
+        empty.mCompressed = false;
+        mBricks.assign(mBricksX * mBricksY * mBricksZ, empty);
+    }
+
+    //-----------------------------------------------------------------------
+
+    void BrickGridSource::encodeBrick(size_t index, const float *values)
+    {
+        uncacheBrick(index);
+        Brick &brick = mBricks[index];
+        freeBrickData(brick);
+
+        uint8 encoded[BRICK_VOXELS * sizeof(uint16)];
+        size_t elementSize;
+        bool uniform = true;
+        if (mFormat == BF_HALF_FLOAT)
+        {
+            uint16 *halfs = reinterpret_cast<uint16*>(encoded);
+            for (size_t i = 0; i < BRICK_VOXELS; ++i)
+            {
+                halfs[i] = Bitwise::floatToHalf(values[i]);
+                uniform = uniform && halfs[i] == halfs[0];
+            }
+            brick.mMinValue = Bitwise::halfToFloat(halfs[0]);
+            brick.mRange = 0;
+            brick.mEncoding = BE_HALF_FLOAT;
+            elementSize = sizeof(uint16);
+        }
+        else
+        {
+            float minValue = values[0];
+            float maxValue = values[0];
+            for (size_t i = 1; i < BRICK_VOXELS; ++i)
+            {
+                minValue = std::min(minValue, values[i]);
+                maxValue = std::max(maxValue, values[i]);
+            }
+            uniform = minValue == maxValue;
+            float range = maxValue - minValue;
+            float scale = uniform ? (float)0.0 : (float)255.0 / range;
+            for (size_t i = 0; i < BRICK_VOXELS; ++i)
+            {
+                encoded[i] = static_cast<uint8>((values[i] - minValue) * scale + (float)0.5);
+            }
+            brick.mMinValue = minValue;
+            brick.mRange = range;
+            brick.mEncoding = BE_QUANTISED_8;
+            elementSize = sizeof(uint8);
+        }
+
+        if (uniform)
+        {
+            brick.mEncoding = BE_CONSTANT;
+            brick.mRange = 0;
+            return;
+        }
+
+        size_t size = BRICK_VOXELS * elementSize;
+        const uint8 *data = encoded;
+        uint8 compressed[BRICK_VOXELS * sizeof(uint16)];
+        if (mCompress)
+        {
+            size_t compressedSize = compressRuns(encoded, BRICK_VOXELS, elementSize, compressed, size - 1);
+            if (compressedSize)
+            {
+                size = compressedSize;
+                data = compressed;
+                brick.mCompressed = true;
+            }
+        }
+        brick.mData = OGRE_ALLOC_T(uint8, size, MEMCATEGORY_GENERAL);
+        memcpy(brick.mData, data, size);
+        brick.mDataSize = static_cast<uint32>(size);
+    }
+
+    //-----------------------------------------------------------------------
+
+    void BrickGridSource::decodeBrick(const Brick &brick, float *values) const
+    {
+        switch (brick.mEncoding)
+        {
+        case BE_CONSTANT:
+            std::fill(values, values + BRICK_VOXELS, brick.mMinValue);
+            return;
+        case BE_RAW:
+            memcpy(values, brick.mData, BRICK_VOXELS * sizeof(float));
+            return;
+        default:
+            break;
+        }
+
+        const uint8 *data = brick.mData;
+        uint8 decompressed[BRICK_VOXELS * sizeof(uint16)];
+        if (brick.mCompressed)
+        {
+            decompressRuns(brick.mData, brick.mDataSize, brick.mEncoding == BE_HALF_FLOAT ? sizeof(uint16) : sizeof(uint8), decompressed);
+            data = decompressed;
+        }
+        if (brick.mEncoding == BE_HALF_FLOAT)
+        {
+            const uint16 *halfs = reinterpret_cast<const uint16*>(data);
+            for (size_t i = 0; i < BRICK_VOXELS; ++i)
+            {
+                values[i] = Bitwise::halfToFloat(halfs[i]);
+            }
+        }
+        else
+        {
+            float scale = brick.mRange / (float)255.0;
+            for (size_t i = 0; i < BRICK_VOXELS; ++i)
+            {
+                values[i] = brick.mMinValue + data[i] * scale;
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    BrickGridSource::ThreadCache *BrickGridSource::getThreadCache(void) const
+    {
+        // The caches the calling thread used last, by source id. Ids are never
+        // reused, so a stale slot of a destroyed source can't match.
+        static const size_t RECENT_CACHES = 4;
+        static thread_local std::pair<size_t, ThreadCache*> recentCaches[RECENT_CACHES];
+        static thread_local size_t nextRecentCache = 0;
+        for (size_t i = 0; i < RECENT_CACHES; ++i)
+        {
+            if (recentCaches[i].first == mId)
+            {
+                return recentCaches[i].second;
+            }
+        }
+
+        // The address of a thread local identifies the calling thread.
+        const void *thread = &nextRecentCache;
+        ThreadCache *cache = 0;
+        {
+            OGRE_WQ_LOCK_MUTEX(mCacheMutex);
+            for (VecThreadCache::const_iterator it = mThreadCaches.begin(); it != mThreadCaches.end(); ++it)
+            {
+                if ((*it)->mThread == thread)
+                {
+                    cache = *it;
+                    break;
+                }
+            }
+            if (!cache)
+            {
+                cache = OGRE_NEW_T(ThreadCache, MEMCATEGORY_GENERAL)();
+                cache->mThread = thread;
+                cache->mLastBrick = 0;
+                cache->mLastValues = 0;
+                mThreadCaches.push_back(cache);
+            }
+        }
+        recentCaches[nextRecentCache] = std::make_pair(mId, cache);
+        nextRecentCache = (nextRecentCache + 1) % RECENT_CACHES;
+        return cache;
+    }
+
+    //-----------------------------------------------------------------------
+
+    const float *BrickGridSource::getCachedBrick(ThreadCache *cache, size_t index) const
+    {
+        if (index == cache->mLastBrick && cache->mLastValues)
+        {
+            return cache->mLastValues;
+        }
+
+        MapCache::iterator it = cache->mCache.find(index);
+        if (it != cache->mCache.end())
+        {
+            cache->mLru.splice(cache->mLru.begin(), cache->mLru, it->second.mLruPosition);
+        }
+        else
+        {
+            shrinkCache(cache, mCacheSize - 1);
+            CacheEntry entry;
+            entry.mValues = OGRE_ALLOC_T(float, BRICK_VOXELS, MEMCATEGORY_GENERAL);
+            decodeBrick(mBricks[index], entry.mValues);
+            cache->mLru.push_front(index);
+            entry.mLruPosition = cache->mLru.begin();
+            it = cache->mCache.insert(MapCache::value_type(index, entry)).first;
+        }
+        cache->mLastBrick = index;
+        cache->mLastValues = it->second.mValues;
+        return cache->mLastValues;
+    }
+
+    //-----------------------------------------------------------------------
+
+    void BrickGridSource::uncacheBrick(size_t index)
+    {
+        OGRE_WQ_LOCK_MUTEX(mCacheMutex);
+        for (VecThreadCache::iterator cacheIt = mThreadCaches.begin(); cacheIt != mThreadCaches.end(); ++cacheIt)
+        {
+            ThreadCache *cache = *cacheIt;
+            MapCache::iterator it = cache->mCache.find(index);
+            if (it == cache->mCache.end())
+            {
+                continue;
+            }
+            OGRE_FREE(it->second.mValues, MEMCATEGORY_GENERAL);
+            cache->mLru.erase(it->second.mLruPosition);
+            cache->mCache.erase(it);
+            if (cache->mLastBrick == index)
+            {
+                cache->mLastValues = 0;
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void BrickGridSource::shrinkCache(ThreadCache *cache, size_t size)
+    {
+        while (cache->mCache.size() > size)
+        {
+            size_t index = cache->mLru.back();
+            cache->mLru.pop_back();
+            MapCache::iterator it = cache->mCache.find(index);
+            OGRE_FREE(it->second.mValues, MEMCATEGORY_GENERAL);
+            cache->mCache.erase(it);
+            if (cache->mLastBrick == index)
+            {
+                cache->mLastValues = 0;
+            }
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void BrickGridSource::freeBrickData(Brick &brick)
+    {
+        if (brick.mData)
+        {
+            OGRE_FREE(brick.mData, MEMCATEGORY_GENERAL);
+        }
+        brick.mData = 0;
+        brick.mDataSize = 0;
+        brick.mCompressed = false;
+    }
+
+    //-----------------------------------------------------------------------
+
+    float BrickGridSource::getVolumeGridValue(size_t x, size_t y, size_t z) const
+    {
+        x = x >= mWidth ? mWidth - 1 : x;
+        y = y >= mHeight ? mHeight - 1 : y;
+        z = z >= mDepth ? mDepth - 1 : z;
+        size_t index = getBrickIndex(x, y, z);
+        const Brick &brick = mBricks[index];
+        if (brick.mEncoding == BE_CONSTANT)
+        {
+            return brick.mMinValue;
+        }
+        size_t voxel = getVoxelIndex(x, y, z);
+        if (!brick.mCompressed)
+        {
+            // Uncompressed bricks are cheap enough to read in place.
+            switch (brick.mEncoding)
+            {
+            case BE_HALF_FLOAT:
+                return Bitwise::halfToFloat(reinterpret_cast<const uint16*>(brick.mData)[voxel]);
+            case BE_QUANTISED_8:
+                return brick.mMinValue + brick.mData[voxel] * (brick.mRange / (float)255.0);
+            default:
+                return reinterpret_cast<const float*>(brick.mData)[voxel];
+            }
+        }
+        return getCachedBrick(getThreadCache(), index)[voxel];
+    }
+
+    //-----------------------------------------------------------------------
+
+    void BrickGridSource::setVolumeGridValue(int x, int y, int z, float value)
+    {
+        // Clamp if wanted.
+        if (mMaxClampedAbsoluteDensity != (Real)0.0)
+        {
+            value = Math::Clamp<float>(value, (float)-mMaxClampedAbsoluteDensity, (float)mMaxClampedAbsoluteDensity);
+        }
+
+        size_t index = getBrickIndex(x, y, z);
+        Brick &brick = mBricks[index];
+        if (brick.mEncoding != BE_RAW)
+        {
+            // Decode the brick once and keep it raw until the edit is done.
+            uint8 *raw = OGRE_ALLOC_T(uint8, BRICK_VOXELS * sizeof(float), MEMCATEGORY_GENERAL);
+            decodeBrick(brick, reinterpret_cast<float*>(raw));
+            uncacheBrick(index);
+            freeBrickData(brick);
+            brick.mData = raw;
+            brick.mDataSize = static_cast<uint32>(BRICK_VOXELS * sizeof(float));
+            brick.mEncoding = BE_RAW;
+            mRawBricks.push_back(index);
+        }
+        reinterpret_cast<float*>(brick.mData)[getVoxelIndex(x, y, z)] = value;
+    }
+
+    //-----------------------------------------------------------------------
+
+    BrickGridSource::BrickGridSource(const Source *src, const Vector3 &worldDimension, size_t width, size_t height, size_t depth,
+        Real maxClampedAbsoluteDensity, BrickFormat format, bool compress, size_t cacheSize, const bool trilinearValue, const bool trilinearGradient, const bool sobelGradient) :
+        GridSource(trilinearValue, trilinearGradient, sobelGradient), mBricksX(0), mBricksY(0), mBricksZ(0),
+        mFormat(format), mCompress(compress), mMaxClampedAbsoluteDensity(maxClampedAbsoluteDensity), mId(nextSourceId++),
+        mCacheSize(std::max<size_t>(cacheSize, 1))
+    {
+        Timer t;
+        setupGrid(width, height, depth, worldDimension);
+
+        Real worldWidthScale = (Real)1.0 / mPosXScale;
+        Real worldHeightScale = (Real)1.0 / mPosYScale;
+        Real worldDepthScale = (Real)1.0 / mPosZScale;
+        // Each brick is sampled with one batch, voxels outside of the grid repeat the border.
+        auto sampleBrick = [&](size_t index) {
+            size_t bx = index % mBricksX;
+            size_t by = (index / mBricksX) % mBricksY;
+            size_t bz = index / (mBricksX * mBricksY);
+            std::vector<Vector3> positions(BRICK_VOXELS);
+            std::vector<Real> values(BRICK_VOXELS);
+            std::vector<float> brickValues(BRICK_VOXELS);
+            size_t i = 0;
+            for (size_t z = 0; z < BRICK_SIZE; ++z)
+            {
+                Real posZ = (Real)std::min(bz * BRICK_SIZE + z, mDepth - 1) * worldDepthScale;
+                for (size_t y = 0; y < BRICK_SIZE; ++y)
+                {
+                    Real posY = (Real)std::min(by * BRICK_SIZE + y, mHeight - 1) * worldHeightScale;
+                    for (size_t x = 0; x < BRICK_SIZE; ++x, ++i)
+                    {
+                        positions[i].x = (Real)std::min(bx * BRICK_SIZE + x, mWidth - 1) * worldWidthScale;
+                        positions[i].y = posY;
+                        positions[i].z = posZ;
+                    }
+                }
+            }
+            src->getValues(&positions[0], &values[0], BRICK_VOXELS);
+            for (i = 0; i < BRICK_VOXELS; ++i)
+            {
+                brickValues[i] = (float)values[i];
+                if (mMaxClampedAbsoluteDensity != (Real)0.0)
+                {
+                    brickValues[i] = Math::Clamp<float>(brickValues[i], (float)-mMaxClampedAbsoluteDensity, (float)mMaxClampedAbsoluteDensity);
+                }
+            }
+            encodeBrick(index, &brickValues[0]);
+        };
+
+        size_t count = mBricks.size();
+        WorkQueue *wq = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : 0;
+        if (count < 2 || !wq || OGRE_THREAD_HARDWARE_CONCURRENCY < 2)
+        {
+            for (size_t index = 0; index < count; ++index)
+            {
+                sampleBrick(index);
+            }
+        }
+        else
+        {
+            wq->parallelFor(count, sampleBrick);
+        }
+
+        LogManager::getSingleton().stream() << "Sampled brick grid in " << t.getMilliseconds() << "ms, "
+            << getConstantBrickCount() << " of " << count << " bricks constant, " << getMemoryUsage() << " bytes.";
+    }
+
+    //-----------------------------------------------------------------------
+
+    BrickGridSource::BrickGridSource(const String &serializedVolumeFile, BrickFormat format, bool compress, size_t cacheSize,
+        const bool trilinearValue, const bool trilinearGradient, const bool sobelGradient) :
+        GridSource(trilinearValue, trilinearGradient, sobelGradient), mBricksX(0), mBricksY(0), mBricksZ(0),
+        mFormat(format), mCompress(compress), mMaxClampedAbsoluteDensity(0), mId(nextSourceId++),
+        mCacheSize(std::max<size_t>(cacheSize, 1))
+    {
+        Timer t;
+        DataStreamPtr streamRead = Root::getSingleton().openFileStream(serializedVolumeFile);
+#if OGRE_NO_ZIP_ARCHIVE == 0
+        DataStreamPtr uncompressStream(OGRE_NEW DeflateStream(serializedVolumeFile, streamRead));
+        StreamSerialiser ser(uncompressStream);
+#else
+        StreamSerialiser ser(streamRead);
+#endif
+        if (!ser.readChunkBegin(VOLUME_CHUNK_ID, VOLUME_CHUNK_VERSION))
+        {
+            OGRE_EXCEPT(Exception::ERR_INVALID_STATE, "Invalid volume file given!");
+        }
+
+        // Read header
+        Vector3 readFrom, readTo;
+        ser.read(&readFrom);
+        ser.read(&readTo);
+        float voxelWidth;
+        ser.read<float>(&voxelWidth);
+        size_t width, height, depth;
+        ser.read<size_t>(&width);
+        ser.read<size_t>(&height);
+        ser.read<size_t>(&depth);
+        setupGrid(width, height, depth, readTo - readFrom);
+
+        // The file holds x-major slices with the grid z running backwards. Keep
+        // one layer of bricks worth of slices and encode the layer once its
+        // lowest slice arrived.
+        size_t sliceSize = mWidth * mHeight;
+        std::vector<uint16> slices(BRICK_SIZE * sliceSize);
+        WorkQueue *wq = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : 0;
+        bool parallel = wq && OGRE_THREAD_HARDWARE_CONCURRENCY > 1 && mBricksX * mBricksY > 1;
+        for (size_t fileZ = 0; fileZ < mDepth; ++fileZ)
+        {
+            size_t z = mDepth - fileZ - 1;
+            ser.read(&slices[(z % BRICK_SIZE) * sliceSize], sliceSize);
+            if (z % BRICK_SIZE != 0)
+            {
+                continue;
+            }
+
+            size_t bz = z / BRICK_SIZE;
+            auto encodeLayerBrick = [&](size_t layerIndex) {
+                size_t bx = layerIndex % mBricksX;
+                size_t by = layerIndex / mBricksX;
+                std::vector<float> brickValues(BRICK_VOXELS);
+                size_t i = 0;
+                for (size_t lz = 0; lz < BRICK_SIZE; ++lz)
+                {
+                    const uint16 *slice = &slices[(std::min(bz * BRICK_SIZE + lz, mDepth - 1) % BRICK_SIZE) * sliceSize];
+                    for (size_t ly = 0; ly < BRICK_SIZE; ++ly)
+                    {
+                        size_t y = std::min(by * BRICK_SIZE + ly, mHeight - 1);
+                        for (size_t lx = 0; lx < BRICK_SIZE; ++lx, ++i)
+                        {
+                            size_t x = std::min(bx * BRICK_SIZE + lx, mWidth - 1);
+                            brickValues[i] = Bitwise::halfToFloat(slice[x * mHeight + y]);
+                        }
+                    }
+                }
+                encodeBrick((bz * mBricksY + by) * mBricksX + bx, &brickValues[0]);
+            };
+            if (parallel)
+            {
+                wq->parallelFor(mBricksX * mBricksY, encodeLayerBrick);
+            }
+            else
+            {
+                for (size_t layerIndex = 0; layerIndex < mBricksX * mBricksY; ++layerIndex)
+                {
+                    encodeLayerBrick(layerIndex);
+                }
+            }
+        }
+
+        ser.readChunkEnd(VOLUME_CHUNK_ID);
+
+        LogManager::getSingleton().stream() << "Processed serialization in " << t.getMilliseconds() << "ms, "
+            << getConstantBrickCount() << " of " << mBricks.size() << " bricks constant, " << getMemoryUsage() << " bytes.";
+    }
+
+    //-----------------------------------------------------------------------
+
+    BrickGridSource::~BrickGridSource(void)
+    {
+        for (VecBrick::iterator it = mBricks.begin(); it != mBricks.end(); ++it)
+        {
+            freeBrickData(*it);
+        }
+        for (VecThreadCache::iterator it = mThreadCaches.begin(); it != mThreadCaches.end(); ++it)
+        {
+            shrinkCache(*it, 0);
+            OGRE_DELETE_T(*it, ThreadCache, MEMCATEGORY_GENERAL);
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    void BrickGridSource::combineWithSource(CSGOperationSource *operation, Source *source, const Vector3 &center, Real radius)
+    {
+        GridSource::combineWithSource(operation, source, center, radius);
+
+        // Encode the edited bricks again, maybe they even became uniform.
+        std::vector<float> values(BRICK_VOXELS);
+        for (std::vector<size_t>::const_iterator it = mRawBricks.begin(); it != mRawBricks.end(); ++it)
+        {
+            memcpy(&values[0], mBricks[*it].mData, BRICK_VOXELS * sizeof(float));
+            encodeBrick(*it, &values[0]);
+        }
+        mRawBricks.clear();
+    }
+
+    //-----------------------------------------------------------------------
+
+    void BrickGridSource::setMaxClampedAbsoluteDensity(Real maxClampedAbsoluteDensity)
+    {
+        mMaxClampedAbsoluteDensity = maxClampedAbsoluteDensity;
+    }
+
+    //-----------------------------------------------------------------------
+
+    Real BrickGridSource::getMaxClampedAbsoluteDensity(void) const
+    {
+        return mMaxClampedAbsoluteDensity;
+    }
+
+    //-----------------------------------------------------------------------
+
+    void BrickGridSource::setCacheSize(size_t cacheSize)
+    {
+        OGRE_WQ_LOCK_MUTEX(mCacheMutex);
+        mCacheSize = std::max<size_t>(cacheSize, 1);
+        for (VecThreadCache::iterator it = mThreadCaches.begin(); it != mThreadCaches.end(); ++it)
+        {
+            shrinkCache(*it, mCacheSize);
+        }
+    }
+
+    //-----------------------------------------------------------------------
+
+    size_t BrickGridSource::getCacheSize(void) const
+    {
+        return mCacheSize;
+    }
+
+    //-----------------------------------------------------------------------
+
+    size_t BrickGridSource::getBrickCount(void) const
+    {
+        return mBricks.size();
+    }
+
+    //-----------------------------------------------------------------------
+
+    size_t BrickGridSource::getConstantBrickCount(void) const
+    {
+        size_t count = 0;
+        for (VecBrick::const_iterator it = mBricks.begin(); it != mBricks.end(); ++it)
+        {
+            if (it->mEncoding == BE_CONSTANT)
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    //-----------------------------------------------------------------------
+
+    size_t BrickGridSource::getMemoryUsage(void) const
+    {
+        size_t usage = mBricks.capacity() * sizeof(Brick);
+        for (VecBrick::const_iterator it = mBricks.begin(); it != mBricks.end(); ++it)
+        {
+            usage += it->mDataSize;
+        }
+        OGRE_WQ_LOCK_MUTEX(mCacheMutex);
+        for (VecThreadCache::const_iterator it = mThreadCaches.begin(); it != mThreadCaches.end(); ++it)
+        {
+            usage += (*it)->mCache.size() * BRICK_VOXELS * sizeof(float);
+        }
+        return usage;
+    }
+}
+}
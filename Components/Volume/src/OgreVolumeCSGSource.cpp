@@ -30,6 +30,9 @@ THE SOFTWARE.
 namespace Ogre {
 namespace Volume {
 
+    /// The amount of positions evaluated at once when a batch needs temporary storage.
+    static const size_t BATCH_BLOCK_SIZE = 64;
+
     Vector3 CSGCubeSource::mBoxNormals[6] = {
         Vector3::UNIT_X,
         Vector3::UNIT_Y,
@@ -69,6 +72,26 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGSphereSource::getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = CSGSphereSource::getValueAndGradient(positions[i]);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGSphereSource::getValues(const Vector3 *positions, Real *results, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = mR - (positions[i] - mCenter).length();
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGPlaneSource::CSGPlaneSource(const Real d, const Vector3 &normal) : mD(d), mNormal(normal.normalisedCopy())
     {
     }
@@ -96,6 +119,26 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGPlaneSource::getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = Vector4(mNormal.x, mNormal.y, mNormal.z, mD - mNormal.dotProduct(positions[i]));
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGPlaneSource::getValues(const Vector3 *positions, Real *results, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = mD - mNormal.dotProduct(positions[i]);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGCubeSource::CSGCubeSource(const Vector3 &min, const Vector3 &max)
     {
         mBox.setExtents(min, max);
@@ -127,6 +170,26 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGCubeSource::getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = CSGCubeSource::getValueAndGradient(positions[i]);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGCubeSource::getValues(const Vector3 *positions, Real *results, size_t count) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = distanceTo(positions[i]);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGOperationSource::CSGOperationSource(const Source *a, const Source *b) : mA(a), mB(b)
     {
     }
@@ -165,6 +228,7 @@ namespace Volume {
         mB = b;
     }
 
+
     //-----------------------------------------------------------------------
 
     CSGIntersectionSource::CSGIntersectionSource(const Source *a, const Source *b) : CSGOperationSource(a, b)
@@ -205,6 +269,48 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGIntersectionSource::getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const
+    {
+        Vector4 valuesB[BATCH_BLOCK_SIZE];
+        mA->getValuesAndGradients(positions, results, count);
+        for (size_t start = 0; start < count; start += BATCH_BLOCK_SIZE)
+        {
+            size_t blockSize = std::min(BATCH_BLOCK_SIZE, count - start);
+            mB->getValuesAndGradients(positions + start, valuesB, blockSize);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                Vector4 valueB = valuesB[i];
+                if (!(results[start + i].w < valueB.w))
+                {
+                    results[start + i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGIntersectionSource::getValues(const Vector3 *positions, Real *results, size_t count) const
+    {
+        Real valuesB[BATCH_BLOCK_SIZE];
+        mA->getValues(positions, results, count);
+        for (size_t start = 0; start < count; start += BATCH_BLOCK_SIZE)
+        {
+            size_t blockSize = std::min(BATCH_BLOCK_SIZE, count - start);
+            mB->getValues(positions + start, valuesB, blockSize);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                Real valueB = valuesB[i];
+                if (!(results[start + i] < valueB))
+                {
+                    results[start + i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGUnionSource::CSGUnionSource(const Source *a, const Source *b) : CSGOperationSource(a, b)
     {
     }
@@ -243,6 +349,48 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGUnionSource::getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const
+    {
+        Vector4 valuesB[BATCH_BLOCK_SIZE];
+        mA->getValuesAndGradients(positions, results, count);
+        for (size_t start = 0; start < count; start += BATCH_BLOCK_SIZE)
+        {
+            size_t blockSize = std::min(BATCH_BLOCK_SIZE, count - start);
+            mB->getValuesAndGradients(positions + start, valuesB, blockSize);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                Vector4 valueB = valuesB[i];
+                if (!(results[start + i].w > valueB.w))
+                {
+                    results[start + i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGUnionSource::getValues(const Vector3 *positions, Real *results, size_t count) const
+    {
+        Real valuesB[BATCH_BLOCK_SIZE];
+        mA->getValues(positions, results, count);
+        for (size_t start = 0; start < count; start += BATCH_BLOCK_SIZE)
+        {
+            size_t blockSize = std::min(BATCH_BLOCK_SIZE, count - start);
+            mB->getValues(positions + start, valuesB, blockSize);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                Real valueB = valuesB[i];
+                if (!(results[start + i] > valueB))
+                {
+                    results[start + i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGDifferenceSource::CSGDifferenceSource(const Source *a, const Source *b) : CSGOperationSource(a, b)
     {
     }
@@ -281,6 +429,48 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGDifferenceSource::getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const
+    {
+        Vector4 valuesB[BATCH_BLOCK_SIZE];
+        mA->getValuesAndGradients(positions, results, count);
+        for (size_t start = 0; start < count; start += BATCH_BLOCK_SIZE)
+        {
+            size_t blockSize = std::min(BATCH_BLOCK_SIZE, count - start);
+            mB->getValuesAndGradients(positions + start, valuesB, blockSize);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                Vector4 valueB = (Real)-1.0 * valuesB[i];
+                if (!(results[start + i].w < valueB.w))
+                {
+                    results[start + i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGDifferenceSource::getValues(const Vector3 *positions, Real *results, size_t count) const
+    {
+        Real valuesB[BATCH_BLOCK_SIZE];
+        mA->getValues(positions, results, count);
+        for (size_t start = 0; start < count; start += BATCH_BLOCK_SIZE)
+        {
+            size_t blockSize = std::min(BATCH_BLOCK_SIZE, count - start);
+            mB->getValues(positions + start, valuesB, blockSize);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                Real valueB = (Real)-1.0 * valuesB[i];
+                if (!(results[start + i] < valueB))
+                {
+                    results[start + i] = valueB;
+                }
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGUnarySource::CSGUnarySource(const Source *src) : mSrc(src)
     {
     }
@@ -304,6 +494,7 @@ namespace Volume {
     {
         mSrc = a;
     }
+
     
     //-----------------------------------------------------------------------
 
@@ -333,6 +524,28 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGNegateSource::getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const
+    {
+        mSrc->getValuesAndGradients(positions, results, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = (Real)-1.0 * results[i];
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGNegateSource::getValues(const Vector3 *positions, Real *results, size_t count) const
+    {
+        mSrc->getValues(positions, results, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            results[i] = (Real)-1.0 * results[i];
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     CSGScaleSource::CSGScaleSource(const Source *src, const Real scale) : CSGUnarySource(src), mScale(scale)
     {
     }
@@ -353,6 +566,46 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGScaleSource::getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const
+    {
+        Vector3 scaled[BATCH_BLOCK_SIZE];
+        for (size_t start = 0; start < count; start += BATCH_BLOCK_SIZE)
+        {
+            size_t blockSize = std::min(BATCH_BLOCK_SIZE, count - start);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                scaled[i] = positions[start + i] / mScale;
+            }
+            mSrc->getValuesAndGradients(scaled, results + start, blockSize);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                results[start + i] = results[start + i] * mScale;
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGScaleSource::getValues(const Vector3 *positions, Real *results, size_t count) const
+    {
+        Vector3 scaled[BATCH_BLOCK_SIZE];
+        for (size_t start = 0; start < count; start += BATCH_BLOCK_SIZE)
+        {
+            size_t blockSize = std::min(BATCH_BLOCK_SIZE, count - start);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                scaled[i] = positions[start + i] / mScale;
+            }
+            mSrc->getValues(scaled, results + start, blockSize);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                results[start + i] = results[start + i] * mScale;
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     void CSGNoiseSource::setData(void)
     {
         mGradientOff = fabs(mFrequencies[0]);
@@ -403,6 +656,67 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void CSGNoiseSource::getInternalValues(const Vector3 *positions, Real *results, size_t count) const
+    {
+        mSrc->getValues(positions, results, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const Vector3 &position = positions[i];
+            Real toAdd = (Real)0.0;
+            for (size_t o = 0; o < mNumOctaves; ++o)
+            {
+                toAdd += mNoise.noise(position.x * mFrequencies[o], position.y * mFrequencies[o], position.z * mFrequencies[o]) * mAmplitudes[o];
+            }
+            results[i] += toAdd;
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGNoiseSource::getValuesAndGradients(const Vector3 *positions, Vector4 *results, size_t count) const
+    {
+        // The central differences of each position are evaluated together with it.
+        static const size_t SAMPLES = 7;
+        static const size_t POSITIONS_PER_BLOCK = BATCH_BLOCK_SIZE / SAMPLES;
+        Vector3 samples[POSITIONS_PER_BLOCK * SAMPLES];
+        Real values[POSITIONS_PER_BLOCK * SAMPLES];
+        for (size_t start = 0; start < count; start += POSITIONS_PER_BLOCK)
+        {
+            size_t blockSize = std::min(POSITIONS_PER_BLOCK, count - start);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                const Vector3 &position = positions[start + i];
+                Vector3 *sample = samples + i * SAMPLES;
+                sample[0] = Vector3(position.x + mGradientOff, position.y, position.z);
+                sample[1] = Vector3(position.x - mGradientOff, position.y, position.z);
+                sample[2] = Vector3(position.x, position.y + mGradientOff, position.z);
+                sample[3] = Vector3(position.x, position.y - mGradientOff, position.z);
+                sample[4] = Vector3(position.x, position.y, position.z + mGradientOff);
+                sample[5] = Vector3(position.x, position.y, position.z - mGradientOff);
+                sample[6] = position;
+            }
+            getInternalValues(samples, values, blockSize * SAMPLES);
+            for (size_t i = 0; i < blockSize; ++i)
+            {
+                const Real *value = values + i * SAMPLES;
+                results[start + i] = Vector4(
+                    -(value[0] - value[1]),
+                    -(value[2] - value[3]),
+                    -(value[4] - value[5]),
+                    value[6]);
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void CSGNoiseSource::getValues(const Vector3 *positions, Real *results, size_t count) const
+    {
+        getInternalValues(positions, results, count);
+    }
+    
+    //-----------------------------------------------------------------------
+
     long CSGNoiseSource::getSeed(void) const
     {
         return mSeed;
@@ -73,9 +73,27 @@ namespace Volume {
             req.isUpdate = mShared->parameters->updateFrom != Vector3::ZERO || mShared->parameters->updateTo != Vector3::ZERO;
 
             req.origin = this;
-            req.root = OGRE_NEW OctreeNode(from, to);
             req.meshBuilder = OGRE_NEW MeshBuilder();
-            req.dualGridGenerator = OGRE_NEW DualGridGenerator();
+            req.previousMeshBuilder = 0;
+            req.updateFrom = mShared->parameters->updateFrom;
+            req.updateTo = mShared->parameters->updateTo;
+            req.generation = ++mGeometryGeneration;
+            if (req.isUpdate && mShared->parameters->incrementalUpdates && mCachedOctree)
+            {
+                // Hand the last generation over to the request, only the updated area gets rebuilt.
+                req.root = mCachedOctree;
+                req.dualGridGenerator = mCachedDualGridGenerator;
+                req.previousMeshBuilder = mCachedMeshBuilder;
+                mCachedOctree = 0;
+                mCachedDualGridGenerator = 0;
+                mCachedMeshBuilder = 0;
+            }
+            else
+            {
+                deleteCachedGeometryData();
+                req.root = OGRE_NEW OctreeNode(from, to);
+                req.dualGridGenerator = OGRE_NEW DualGridGenerator();
+            }
 
             mChunkHandler.addRequest(req);
         }
@@ -181,6 +199,9 @@ namespace Volume {
         // Don't generate this chunk if it doesn't contribute to the whole volume.
         if (!contributesToVolumeMesh(from, to))
         {
+            // A kept generation would miss this update, as would one still being generated.
+            ++mGeometryGeneration;
+            deleteCachedGeometryData();
             return;
         }
     
@@ -199,13 +220,64 @@ namespace Volume {
         root->split(&policy, mShared->parameters->src, mError);
         Real maxMSDistance = (Real)level * mShared->parameters->errorMultiplicator * mShared->parameters->baseError * mShared->parameters->skirtFactor;
         IsoSurface *is = OGRE_NEW IsoSurfaceMC(mShared->parameters->src);
-        dualGridGenerator->generateDualGrid(root, is, meshBuilder, maxMSDistance, totalFrom, totalTo,
+        if (mShared->parameters->incrementalUpdates)
+        {
+            dualGridGenerator->generateRecordedDualGrid(root, is, meshBuilder, maxMSDistance, totalFrom, totalTo,
+                mShared->parameters->createDualGridVisualization);
+        }
+        else
+        {
+            dualGridGenerator->generateDualGrid(root, is, meshBuilder, maxMSDistance, totalFrom, totalTo,
+                mShared->parameters->createDualGridVisualization);
+        }
+        OGRE_DELETE is;
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void Chunk::updateGeometry(size_t level, OctreeNode *root, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder, const MeshBuilder *previousMeshBuilder,
+        const Vector3 &updateFrom, const Vector3 &updateTo, const Vector3 &totalFrom, const Vector3 &totalTo)
+    {
+        Real maxCellSize = mShared->parameters->errorMultiplicator * mShared->parameters->baseError;
+        OctreeNodeSplitPolicy policy(mShared->parameters->src, maxCellSize);
+        mError = (Real)level * mShared->parameters->errorMultiplicator * mShared->parameters->baseError;
+
+        // Grow the area by the finest cell size to cover the footprint of filtered gradients.
+        AxisAlignedBox dirty(updateFrom - maxCellSize, updateTo + maxCellSize);
+        AxisAlignedBox changed(dirty);
+        root->resplit(&policy, mShared->parameters->src, mError, dirty, changed);
+
+        Real maxMSDistance = (Real)level * mShared->parameters->errorMultiplicator * mShared->parameters->baseError * mShared->parameters->skirtFactor;
+        IsoSurface *is = OGRE_NEW IsoSurfaceMC(mShared->parameters->src);
+        dualGridGenerator->updateDualGrid(root, is, meshBuilder, previousMeshBuilder, changed, maxMSDistance, totalFrom, totalTo,
             mShared->parameters->createDualGridVisualization);
         OGRE_DELETE is;
     }
     
     //-----------------------------------------------------------------------
 
+    void Chunk::setCachedGeometryData(OctreeNode *root, DualGridGenerator *dualGridGenerator, MeshBuilder *meshBuilder)
+    {
+        deleteCachedGeometryData();
+        mCachedOctree = root;
+        mCachedDualGridGenerator = dualGridGenerator;
+        mCachedMeshBuilder = meshBuilder;
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void Chunk::deleteCachedGeometryData(void)
+    {
+        OGRE_DELETE mCachedOctree;
+        OGRE_DELETE mCachedDualGridGenerator;
+        OGRE_DELETE mCachedMeshBuilder;
+        mCachedOctree = 0;
+        mCachedDualGridGenerator = 0;
+        mCachedMeshBuilder = 0;
+    }
+    
+    //-----------------------------------------------------------------------
+
     void Chunk::loadGeometry(MeshBuilder *meshBuilder, DualGridGenerator *dualGridGenerator, OctreeNode *root, size_t level, bool isUpdate)
     {
         size_t chunkTriangles = meshBuilder->generateBuffers(mRenderOp);
@@ -251,7 +323,8 @@ namespace Volume {
     //-----------------------------------------------------------------------
 
     Chunk::Chunk(void) : mNode(0), mError(false), mDualGrid(0), mOctree(0), mChildren(0),
-        mInvisible(false), isRoot(false), mShared(0)
+        mInvisible(false), isRoot(false), mShared(0), mCachedOctree(0), mCachedDualGridGenerator(0), mCachedMeshBuilder(0),
+        mGeometryGeneration(0)
     {
     }
     
@@ -261,6 +334,7 @@ namespace Volume {
     {
         OGRE_DELETE mRenderOp.indexData;
         OGRE_DELETE mRenderOp.vertexData;
+        deleteCachedGeometryData();
 
         // Root might already be shutdown.
         if (Root::getSingletonPtr())
@@ -364,6 +438,7 @@ namespace Volume {
         bool trilinearGradient = StringConverter::parseBool(config.getSetting("trilinearGradient"));
         bool sobelGradient = StringConverter::parseBool(config.getSetting("sobelGradient"));
         bool async = StringConverter::parseBool(config.getSetting("async"));
+        bool incrementalUpdates = StringConverter::parseBool(config.getSetting("incrementalUpdates"));
 
         TextureSource *textureSource = new TextureSource(source, dimensions.x, dimensions.y, dimensions.z, trilinearValue, trilinearGradient, sobelGradient);
     
@@ -386,6 +461,7 @@ namespace Volume {
         parameters.createDualGridVisualization = StringConverter::parseBool(config.getSetting("createDualGridVisualization"));
         parameters.skirtFactor = StringConverter::parseReal(config.getSetting("skirtFactor"));
         parameters.async = async;
+        parameters.incrementalUpdates = incrementalUpdates;
     
         load(parent, from, to, level, &parameters);
         
@@ -88,7 +88,15 @@ namespace Volume {
     WorkQueue::Response* ChunkHandler::handleRequest(const WorkQueue::Request* req, const WorkQueue* srcQ)
     {
         ChunkRequest cReq = any_cast<ChunkRequest>(req->getData());
-        cReq.origin->prepareGeometry(cReq.level, cReq.root, cReq.dualGridGenerator, cReq.meshBuilder, cReq.totalFrom, cReq.totalTo);
+        if (cReq.previousMeshBuilder)
+        {
+            cReq.origin->updateGeometry(cReq.level, cReq.root, cReq.dualGridGenerator, cReq.meshBuilder, cReq.previousMeshBuilder,
+                cReq.updateFrom, cReq.updateTo, cReq.totalFrom, cReq.totalTo);
+        }
+        else
+        {
+            cReq.origin->prepareGeometry(cReq.level, cReq.root, cReq.dualGridGenerator, cReq.meshBuilder, cReq.totalFrom, cReq.totalTo);
+        }
         return OGRE_NEW WorkQueue::Response(req, true, Any());
     }
     
@@ -100,9 +108,18 @@ namespace Volume {
         {
             ChunkRequest cReq = any_cast<ChunkRequest>(res->getRequest()->getData());
             cReq.origin->loadGeometry(cReq.meshBuilder, cReq.dualGridGenerator, cReq.root, cReq.level, cReq.isUpdate);
-            OGRE_DELETE cReq.root;
-            OGRE_DELETE cReq.dualGridGenerator;
-            OGRE_DELETE cReq.meshBuilder;
+            OGRE_DELETE cReq.previousMeshBuilder;
+            // Only keep the latest generation, the chunk may have been loaded again meanwhile.
+            if (cReq.origin->mShared->parameters->incrementalUpdates && cReq.generation == cReq.origin->mGeometryGeneration)
+            {
+                cReq.origin->setCachedGeometryData(cReq.root, cReq.dualGridGenerator, cReq.meshBuilder);
+            }
+            else
+            {
+                OGRE_DELETE cReq.root;
+                OGRE_DELETE cReq.dualGridGenerator;
+                OGRE_DELETE cReq.meshBuilder;
+            }
         }
     }
 }
@@ -28,11 +28,251 @@ THE SOFTWARE.
 #include "OgreManualObject.h"
 #include "OgreSceneManager.h"
 #include "OgreVolumeMeshBuilder.h"
+#include "OgreVolumeSource.h"
+#include "OgreRoot.h"
+#include "OgreWorkQueue.h"
 
 namespace Ogre {
 namespace Volume {
 
     size_t DualGridGenerator::mDualGridI = 0;
+    const size_t DualGridGenerator::PENDING_CELLS_FLUSH_SIZE = 4096;
+    const size_t DualGridGenerator::CELL_BATCH_SIZE = 256;
+    
+    //-----------------------------------------------------------------------
+
+    void DualGridGenerator::flushDualCells(void)
+    {
+        size_t count = mPendingCells.size();
+        if (!count)
+        {
+            return;
+        }
+
+        size_t batches = (count + CELL_BATCH_SIZE - 1) / CELL_BATCH_SIZE;
+        WorkQueue *wq = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : 0;
+        if (batches < 2 || !wq || OGRE_THREAD_HARDWARE_CONCURRENCY < 2)
+        {
+            triangulateDualCells(0, count, mMb);
+        }
+        else
+        {
+            std::vector<MeshBuilder> builders(batches);
+            wq->parallelFor(batches, [&](size_t batch) {
+                triangulateDualCells(batch * CELL_BATCH_SIZE, std::min(count, (batch + 1) * CELL_BATCH_SIZE), &builders[batch]);
+            });
+            for (size_t batch = 0; batch < batches; ++batch)
+            {
+                mMb->append(builders[batch]);
+            }
+        }
+        mPendingCells.clear();
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void DualGridGenerator::triangulateDualCells(size_t begin, size_t end, MeshBuilder *mb) const
+    {
+        std::vector<Vector4> values;
+        evaluateDualCells(begin, end, values);
+        size_t valuesI = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            const PendingDualCell &cell = mPendingCells[i];
+            if (cell.hasValues)
+            {
+                triangulateDualCell(cell, cell.values, mb);
+            }
+            else
+            {
+                triangulateDualCell(cell, &values[valuesI], mb);
+                valuesI += 8;
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    bool DualGridGenerator::DualCellKey::operator<(const DualCellKey &other) const
+    {
+        int cmp = memcmp(corners, other.corners, sizeof(corners));
+        if (cmp != 0)
+        {
+            return cmp < 0;
+        }
+        return hasValues < other.hasValues;
+    }
+    
+    //-----------------------------------------------------------------------
+
+    DualGridGenerator::DualCellKey DualGridGenerator::getKey(const PendingDualCell &cell)
+    {
+        DualCellKey key;
+        for (size_t i = 0; i < 8; ++i)
+        {
+            key.corners[i] = cell.corners[i];
+        }
+        key.hasValues = cell.hasValues;
+        return key;
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void DualGridGenerator::flushRecordedDualCells(void)
+    {
+        size_t count = mPendingCells.size();
+        if (!count)
+        {
+            return;
+        }
+
+        // Find the cells which can be copied from the previous generation. A cell outside of the
+        // changed area only has unchanged leafs as corners, so it existed before with the same
+        // values. If it isn't recorded, it didn't produce any triangles.
+        VecCellIndexRange ranges(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            CellIndexRange &range = ranges[i];
+            range.mb = 0;
+            range.begin = 0;
+            range.end = 0;
+            range.reused = false;
+            if (mPreviousMb)
+            {
+                const PendingDualCell &cell = mPendingCells[i];
+                AxisAlignedBox cellBox(cell.corners[0], cell.corners[0]);
+                for (size_t j = 1; j < 8; ++j)
+                {
+                    cellBox.merge(cell.corners[j]);
+                }
+                if (!cellBox.intersects(mChangedArea))
+                {
+                    range.reused = true;
+                    CellIndexRangeMap::const_iterator it = mPreviousCellRanges.find(getKey(cell));
+                    if (it != mPreviousCellRanges.end())
+                    {
+                        range.mb = mPreviousMb;
+                        range.begin = it->second.first;
+                        range.end = it->second.second;
+                    }
+                }
+            }
+        }
+
+        size_t batches = (count + CELL_BATCH_SIZE - 1) / CELL_BATCH_SIZE;
+        std::vector<MeshBuilder> builders(batches);
+        WorkQueue *wq = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : 0;
+        if (batches < 2 || !wq || OGRE_THREAD_HARDWARE_CONCURRENCY < 2)
+        {
+            for (size_t batch = 0; batch < batches; ++batch)
+            {
+                triangulateRecordedDualCells(batch * CELL_BATCH_SIZE, std::min(count, (batch + 1) * CELL_BATCH_SIZE), &builders[batch], ranges);
+            }
+        }
+        else
+        {
+            wq->parallelFor(batches, [&](size_t batch) {
+                triangulateRecordedDualCells(batch * CELL_BATCH_SIZE, std::min(count, (batch + 1) * CELL_BATCH_SIZE), &builders[batch], ranges);
+            });
+        }
+
+        // Merge in the order of the cells so the result doesn't depend on the batches.
+        for (size_t i = 0; i < count; ++i)
+        {
+            const CellIndexRange &range = ranges[i];
+            if (range.end > range.begin)
+            {
+                size_t begin = mMb->getIndexCount();
+                mMb->append(*range.mb, range.begin, range.end);
+                mCellRanges[getKey(mPendingCells[i])] = std::make_pair(begin, mMb->getIndexCount());
+            }
+        }
+        mPendingCells.clear();
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void DualGridGenerator::triangulateRecordedDualCells(size_t begin, size_t end, MeshBuilder *mb, VecCellIndexRange &ranges) const
+    {
+        std::vector<Vector4> values;
+        evaluateDualCells(begin, end, values);
+        size_t valuesI = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            const PendingDualCell &cell = mPendingCells[i];
+            const Vector4 *cellValues = cell.values;
+            if (!cell.hasValues)
+            {
+                cellValues = &values[valuesI];
+                valuesI += 8;
+            }
+            CellIndexRange &range = ranges[i];
+            if (!range.reused)
+            {
+                range.mb = mb;
+                range.begin = mb->getIndexCount();
+                triangulateDualCell(cell, cellValues, mb);
+                range.end = mb->getIndexCount();
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void DualGridGenerator::evaluateDualCells(size_t begin, size_t end, std::vector<Vector4> &values) const
+    {
+        std::vector<Vector3> positions;
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (!mPendingCells[i].hasValues)
+            {
+                positions.insert(positions.end(), mPendingCells[i].corners, mPendingCells[i].corners + 8);
+            }
+        }
+        values.resize(positions.size());
+        if (!positions.empty())
+        {
+            mIs->getSource()->getValuesAndGradients(&positions[0], &values[0], positions.size());
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void DualGridGenerator::triangulateDualCell(const PendingDualCell &cell, const Vector4 *values, MeshBuilder *mb) const
+    {
+        const Vector3 *corners = cell.corners;
+        // Marching Squares only uses the density of cached values, so keep
+        // letting it evaluate the gradients itself where none were cached.
+        const Vector4 *msValues = cell.hasValues ? cell.values : 0;
+        Vector3 from = mRoot->getFrom();
+        Vector3 to = mRoot->getTo();
+
+        mIs->addMarchingCubesTriangles(corners, values, mb);
+        if (corners[0].z == from.z && corners[0].z != mTotalFrom.z)
+        {
+            mIs->addMarchingSquaresTriangles(corners, msValues, IsoSurface::MS_CORNERS_BACK, mMaxMSDistance, mb);
+        }
+        if (corners[2].z == to.z && corners[2].z != mTotalTo.z)
+        {
+            mIs->addMarchingSquaresTriangles(corners, msValues, IsoSurface::MS_CORNERS_FRONT, mMaxMSDistance, mb);
+        }
+        if (corners[0].x == from.x && corners[0].x != mTotalFrom.x)
+        {
+            mIs->addMarchingSquaresTriangles(corners, msValues, IsoSurface::MS_CORNERS_LEFT, mMaxMSDistance, mb);
+        }
+        if (corners[1].x == to.x && corners[1].x != mTotalTo.x)
+        {
+            mIs->addMarchingSquaresTriangles(corners, msValues, IsoSurface::MS_CORNERS_RIGHT, mMaxMSDistance, mb);
+        }
+        if (corners[5].y == to.y && corners[5].y != mTotalTo.y)
+        {
+            mIs->addMarchingSquaresTriangles(corners, msValues, IsoSurface::MS_CORNERS_TOP, mMaxMSDistance, mb);
+        }
+        if (corners[0].y == from.y && corners[0].y != mTotalFrom.y)
+        {
+            mIs->addMarchingSquaresTriangles(corners, msValues, IsoSurface::MS_CORNERS_BOTTOM, mMaxMSDistance, mb);
+        }
+    }
     
     //-----------------------------------------------------------------------
 
@@ -464,13 +704,22 @@ namespace Volume {
 
     //-----------------------------------------------------------------------
 
-    DualGridGenerator::DualGridGenerator(): mDualGrid(0), mRoot(0), mSaveDualCells(0), mIs(0), mMb(0), mMaxMSDistance(0)
+    DualGridGenerator::DualGridGenerator(): mDualGrid(0), mRoot(0), mSaveDualCells(0), mIs(0), mMb(0), mMaxMSDistance(0),
+        mRecordCells(false), mPreviousMb(0)
     {
     }
     
     //-----------------------------------------------------------------------
 
     void DualGridGenerator::generateDualGrid(const OctreeNode *root, IsoSurface *is, MeshBuilder *mb, Real maxMSDistance, const Vector3 &totalFrom, const Vector3 &totalTo, bool saveDualCells)
+    {
+        generateCells(root, is, mb, maxMSDistance, totalFrom, totalTo, saveDualCells, false, 0, AxisAlignedBox::BOX_NULL);
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void DualGridGenerator::generateCells(const OctreeNode *root, IsoSurface *is, MeshBuilder *mb, Real maxMSDistance, const Vector3 &totalFrom, const Vector3 &totalTo, bool saveDualCells,
+        bool recordCells, const MeshBuilder *previousMb, const AxisAlignedBox &changed)
     {
         mRoot = root;
         mIs = is;
@@ -479,6 +728,12 @@ namespace Volume {
         mTotalFrom = totalFrom;
         mTotalTo = totalTo;
         mSaveDualCells = saveDualCells;
+        mRecordCells = recordCells;
+        mPreviousMb = previousMb;
+        mChangedArea = changed;
+        // A reused instance starts a new visualization.
+        mDualCells.clear();
+        mDualGrid = 0;
 
         nodeProc(root);
 
@@ -503,6 +758,34 @@ namespace Volume {
             addDualCell(root->getCenterLeft(), root->getCenter(), root->getCenterFront(), root->getCenterFrontLeft(),
                 root->getCenterLeftTop(), root->getCenterTop(), root->getCenterFrontTop(), root->getCorner7());
         }
+
+        if (mRecordCells)
+        {
+            flushRecordedDualCells();
+        }
+        else
+        {
+            flushDualCells();
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void DualGridGenerator::generateRecordedDualGrid(const OctreeNode *root, IsoSurface *is, MeshBuilder *mb, Real maxMSDistance, const Vector3 &totalFrom, const Vector3 &totalTo, bool saveDualCells)
+    {
+        updateDualGrid(root, is, mb, 0, AxisAlignedBox::BOX_INFINITE, maxMSDistance, totalFrom, totalTo, saveDualCells);
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void DualGridGenerator::updateDualGrid(const OctreeNode *root, IsoSurface *is, MeshBuilder *mb, const MeshBuilder *previousMb, const AxisAlignedBox &changed,
+        Real maxMSDistance, const Vector3 &totalFrom, const Vector3 &totalTo, bool saveDualCells)
+    {
+        mPreviousCellRanges.clear();
+        mPreviousCellRanges.swap(mCellRanges);
+        generateCells(root, is, mb, maxMSDistance, totalFrom, totalTo, saveDualCells, true, previousMb, changed);
+        mPreviousCellRanges.clear();
+        mPreviousMb = 0;
     }
     
     //-----------------------------------------------------------------------
@@ -231,7 +231,6 @@ namespace Volume {
         // cells anyway.
         bool oldTrilinearValue = mTrilinearValue;
         mTrilinearValue = false;
-        float value;
         int x, y;
         Vector3 scaledCenter(center.x * mPosXScale, center.y * mPosYScale, center.z * mPosZScale);
         int xStart = Math::Clamp(static_cast<int>(scaledCenter.x - radius * mPosXScale), 0, static_cast<int>(mWidth));
@@ -240,18 +239,29 @@ namespace Volume {
         int yEnd = Math::Clamp(static_cast<int>(scaledCenter.y + radius * mPosYScale), 0, static_cast<int>(mHeight));
         int zStart = Math::Clamp(static_cast<int>(scaledCenter.z - radius * mPosZScale), 0, static_cast<int>(mDepth));
         int zEnd = Math::Clamp(static_cast<int>(scaledCenter.z + radius * mPosZScale), 0, static_cast<int>(mDepth));
-        Vector3 pos;
+        // Evaluate one x row at a time. With nearest neighbour lookups, each
+        // position only reads back its own cell, so the row can be batched.
+        size_t rowLength = xEnd > xStart ? (size_t)(xEnd - xStart) : 0;
+        std::vector<Vector3> row(rowLength);
+        std::vector<Real> rowValues(rowLength);
         for (int z = zStart; z < zEnd; ++z)
         {
             for (y = yStart; y < yEnd; ++y)
             {
                 for (x = xStart; x < xEnd; ++x)
                 {
+                    Vector3 &pos = row[x - xStart];
                     pos.x = x * worldWidthScale;
                     pos.y = y * worldHeightScale;
                     pos.z = z * worldDepthScale;
-                    value = operation->getValue(pos);
-                    setVolumeGridValue(x, y, z, value);
+                }
+                if (rowLength > 0)
+                {
+                    operation->getValues(&row[0], &rowValues[0], rowLength);
+                }
+                for (x = xStart; x < xEnd; ++x)
+                {
+                    setVolumeGridValue(x, y, z, (float)rowValues[x - xStart]);
                 }
             }
         }
@@ -65,6 +65,23 @@ namespace Volume {
     
     //-----------------------------------------------------------------------
 
+    void MeshBuilder::append(const MeshBuilder &other)
+    {
+        append(other, 0, other.mIndices.size());
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void MeshBuilder::append(const MeshBuilder &other, size_t indexBegin, size_t indexEnd)
+    {
+        for (size_t i = indexBegin; i < indexEnd; ++i)
+        {
+            addVertex(other.mVertices[other.mIndices[i]]);
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
     size_t MeshBuilder::generateBuffers(RenderOperation &operation)
     {
         // Early out if nothing to do.
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "OgreVolumeSource.h"
 #include "OgreVolumeOctreeNodeSplitPolicy.h"
 #include "OgreSceneManager.h"
+#include "OgreAxisAlignedBox.h"
 
 namespace Ogre {
 namespace Volume {
@@ -83,6 +84,38 @@ namespace Volume {
     //-----------------------------------------------------------------------
 
     OctreeNode::~OctreeNode(void)
+    {
+        deleteChildren();
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void OctreeNode::createChildren(void)
+    {
+        Vector3 newCenter, xWidth, yWidth, zWidth;
+        OctreeNode::getChildrenDimensions(mFrom, mTo, newCenter, xWidth, yWidth, zWidth);
+        /*
+           4 5
+          7 6
+           0 1
+          3 2
+          0 == from
+          6 == to
+        */
+        mChildren = new OctreeNode*[OCTREE_CHILDREN_COUNT];
+        mChildren[0] = createInstance(mFrom, newCenter);
+        mChildren[1] = createInstance(mFrom + xWidth, newCenter + xWidth);
+        mChildren[2] = createInstance(mFrom + xWidth + zWidth, newCenter + xWidth + zWidth);
+        mChildren[3] = createInstance(mFrom + zWidth, newCenter + zWidth);
+        mChildren[4] = createInstance(mFrom + yWidth, newCenter + yWidth);
+        mChildren[5] = createInstance(mFrom + yWidth + xWidth, newCenter + yWidth + xWidth);
+        mChildren[6] = createInstance(mFrom + yWidth + xWidth + zWidth, newCenter + yWidth + xWidth + zWidth);
+        mChildren[7] = createInstance(mFrom + yWidth + zWidth, newCenter + yWidth + zWidth);
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void OctreeNode::deleteChildren(void)
     {
         if (mChildren)
         {
@@ -91,6 +124,7 @@ namespace Volume {
                 OGRE_DELETE mChildren[i];
             }
             delete[] mChildren;
+            mChildren = 0;
         }
     }
     
@@ -107,40 +141,62 @@ namespace Volume {
     {
         if (splitPolicy->doSplit(this, geometricError))
         {
-            Vector3 newCenter, xWidth, yWidth, zWidth;
-            OctreeNode::getChildrenDimensions(mFrom, mTo, newCenter, xWidth, yWidth, zWidth);
-            /*
-               4 5
-              7 6
-               0 1
-              3 2
-              0 == from
-              6 == to
-            */
-            mChildren = new OctreeNode*[OCTREE_CHILDREN_COUNT];
-            mChildren[0] = createInstance(mFrom, newCenter);
-            mChildren[0]->split(splitPolicy, src, geometricError);
-            mChildren[1] = createInstance(mFrom + xWidth, newCenter + xWidth);
-            mChildren[1]->split(splitPolicy, src, geometricError);
-            mChildren[2] = createInstance(mFrom + xWidth + zWidth, newCenter + xWidth + zWidth);
-            mChildren[2]->split(splitPolicy, src, geometricError);
-            mChildren[3] = createInstance(mFrom + zWidth, newCenter + zWidth);
-            mChildren[3]->split(splitPolicy, src, geometricError);
-            mChildren[4] = createInstance(mFrom + yWidth, newCenter + yWidth);
-            mChildren[4]->split(splitPolicy, src, geometricError);
-            mChildren[5] = createInstance(mFrom + yWidth + xWidth, newCenter + yWidth + xWidth);
-            mChildren[5]->split(splitPolicy, src, geometricError);
-            mChildren[6] = createInstance(mFrom + yWidth + xWidth + zWidth, newCenter + yWidth + xWidth + zWidth);
-            mChildren[6]->split(splitPolicy, src, geometricError);
-            mChildren[7] = createInstance(mFrom + yWidth + zWidth, newCenter + yWidth + zWidth);
-            mChildren[7]->split(splitPolicy, src, geometricError);
+            createChildren();
+            for (size_t i = 0; i < OCTREE_CHILDREN_COUNT; ++i)
+            {
+                mChildren[i]->split(splitPolicy, src, geometricError);
+            }
+        }
+        else
+        {
+            if (mCenterValue.x == (Real)0.0 && mCenterValue.y == (Real)0.0 && mCenterValue.z == (Real)0.0 && mCenterValue.w == (Real)0.0)
+            {
+                setCenterValue(src->getValueAndGradient(getCenter()));
+            }
+        }
+    }
+    
+    //-----------------------------------------------------------------------
+
+    void OctreeNode::resplit(const OctreeNodeSplitPolicy *splitPolicy, const Source *src, const Real geometricError, const AxisAlignedBox &dirty, AxisAlignedBox &changed)
+    {
+        AxisAlignedBox bounds(mFrom, mTo);
+        // Touching counts, the split policy samples the borders of the cell, too.
+        if (!bounds.intersects(dirty))
+        {
+            return;
+        }
+
+        // The visualization and center value are outdated now.
+        mOctreeGrid = 0;
+        mCenterValue = Vector4(0.0, 0.0, 0.0, 0.0);
+        if (splitPolicy->doSplit(this, geometricError))
+        {
+            if (mChildren)
+            {
+                for (size_t i = 0; i < OCTREE_CHILDREN_COUNT; ++i)
+                {
+                    mChildren[i]->resplit(splitPolicy, src, geometricError, dirty, changed);
+                }
+            }
+            else
+            {
+                createChildren();
+                for (size_t i = 0; i < OCTREE_CHILDREN_COUNT; ++i)
+                {
+                    mChildren[i]->split(splitPolicy, src, geometricError);
+                }
+                changed.merge(bounds);
+            }
         }
         else
         {
+            deleteChildren();
             if (mCenterValue.x == (Real)0.0 && mCenterValue.y == (Real)0.0 && mCenterValue.z == (Real)0.0 && mCenterValue.w == (Real)0.0)
             {
                 setCenterValue(src->getValueAndGradient(getCenter()));
             }
+            changed.merge(bounds);
         }
     }
     
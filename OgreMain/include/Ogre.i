@@ -8,6 +8,7 @@
 #include "OgreVertexBoneAssignment.h"
 #include "OgreCodec.h"
 #include "OgreZip.h"
+#include "OgrePack.h"
 #include "OgreParticleIterator.h"
 #include "OgreParticleEmitterFactory.h"
 #include "OgreParticleAffectorFactory.h"
@@ -310,6 +311,8 @@ SHARED_PTR(FileHandleDataStream);
 %ignore Ogre::ZipArchiveFactory; // private
 %ignore Ogre::ZipDataStream; // private
 %include "OgreZip.h"
+%ignore Ogre::PackArchiveFactory; // private
+%include "OgrePack.h"
 %include "OgreArchiveManager.h"
 %include "OgreCodec.h"
 %include "OgreSerializer.h"
@@ -139,6 +139,8 @@ namespace Ogre {
         bool mVertexProgramInUse : 1;
         /// Has this entity been initialised yet?
         bool mInitialised : 1;
+        /// Flag indicating whether to draw only the visible meshlets of the SubMeshes.
+        bool mMeshletCulling : 1;
 
         /** Internal method - given vertex data which could be from the Mesh or
             any submesh, finds the temporary blend copy.
@@ -874,6 +876,23 @@ namespace Ogre {
             return mAlwaysUpdateMainSkeleton;
         }
 
+        /** Sets whether SubEntities draw only the meshlets which can be seen by the current camera.
+        @remarks
+            Only has an effect for SubMeshes with meshlets (see SubMesh::generateMeshlets) when the
+            full detail LOD is shown and the entity has no skeletal or vertex animation. The visible
+            meshlets are drawn as one index range, from the first to the last visible meshlet.
+            Enabled by default.
+        */
+        void setMeshletCullingEnabled(bool enabled) {
+            mMeshletCulling = enabled;
+        }
+
+        /** Gets whether SubEntities draw only the meshlets which can be seen by the current camera.
+        */
+        bool getMeshletCullingEnabled() const {
+            return mMeshletCulling;
+        }
+
         /** If true, the skeleton of the entity will be used to update the bounding box for culling.
             Useful if you have skeletal animations that move the bones away from the root.  Otherwise, the
             bounding box of the mesh in the binding pose will be used.
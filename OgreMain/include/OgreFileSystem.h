@@ -48,6 +48,9 @@ namespace Ogre {
     /// internal method to open a FileStreamDataStream
     DataStreamPtr _openFileStream(const String& path, std::ios::openmode mode, const String& name = "");
 
+    /// internal method to map a file read only into a MemoryDataStream, returns a null pointer if that is not possible
+    DataStreamPtr _openMappedFile(const String& path, const String& name = "");
+
     /** Specialisation of the ArchiveFactory to allow reading of files from
         filesystem folders / directories.
     */
@@ -70,6 +73,14 @@ namespace Ogre {
 
         /// Get whether hidden files are ignored during filesystem enumeration.
         static bool getIgnoreHidden();
+
+        /// Set whether files opened read only are memory mapped instead of streamed.
+        /// The returned streams are then MemoryDataStream instances, which e.g. Mesh
+        /// loads from without copying the file contents first. The default is false.
+        static void setMemoryMapping(bool enable);
+
+        /// Get whether files opened read only are memory mapped.
+        static bool getMemoryMapping();
     };
 
     class APKFileSystemArchiveFactory : public ArchiveFactory
@@ -59,9 +59,32 @@ namespace Ogre {
     protected:
 
         SharedParametersMap mSharedParametersMap;
-        std::map<uint32, Microcode> mMicrocodeCache;
+        mutable std::map<uint32, Microcode> mMicrocodeCache;
         bool mSaveMicrocodesToCache;
         bool mCacheDirty;           // When this is true the cache is 'dirty' and should be resaved to disk.
+
+        /// Files of the cache location with their file size, least recently used first
+        typedef std::list<std::pair<String, size_t> > CacheFileList;
+        mutable CacheFileList mCacheFiles;
+        mutable std::map<String, CacheFileList::iterator> mCacheFileIndex;
+        mutable size_t mCacheFilesSize;
+        size_t mCacheMaxSize;
+        Archive* mCacheArchive;
+        /// Identifies the driver the binaries were created with
+        mutable uint32 mCacheDriverHash;
+        /// The capabilities mCacheDriverHash was computed from
+        mutable const RenderSystemCapabilities* mCacheDriverCaps;
+
+        /** Gets the file name of a program in the cache location
+        @return false while the driver is not known yet, as the render system has no capabilities
+        */
+        bool getCacheFileName(uint32 id, String& name) const;
+        /// Reads the microcode of a program from the cache location, if present and valid
+        bool loadCacheFile(uint32 id) const;
+        void writeCacheFile(uint32 id, const Microcode& microcode);
+        void removeCacheFile(const String& name) const;
+        /// Removes the least recently used files until the cache fits mCacheMaxSize
+        void evictCacheFiles();
             
         static String addRenderSystemToName( const String &  name );
 
@@ -243,6 +266,27 @@ namespace Ogre {
         @param stream The source stream
         */
         void loadMicrocodeCache( DataStreamPtr stream );
+
+        /** Keeps the microcode of each program as a separate file in the given location.
+        @remarks
+            Unlike saveMicrocodeCache, microcodes are written as soon as they are added and
+            are only read when a program asks for them. Files are keyed by the program hash,
+            which covers source, defines and syntax, and by the render system, device and driver
+            version, so binaries of another driver are never loaded. Invalid files are removed.
+            The files are only used once the render system is initialised. Microcodes are only
+            created if enabled by setSaveMicrocodesToCache.
+        @param location A writeable folder, which is created if missing. An empty
+            string disables the cache location.
+        @param archiveType The archive type used to access the location
+        */
+        void setMicrocodeCacheLocation(const String& location, const String& archiveType = "FileSystem");
+        /// Returns the location set by setMicrocodeCacheLocation, or an empty string
+        const String& getMicrocodeCacheLocation() const;
+        /** Sets the total size of the cache location, above which the least recently
+            used files are removed. Default is 64MB, 0 disables the limit.
+        */
+        void setMicrocodeCacheMaxSize(size_t size);
+        size_t getMicrocodeCacheMaxSize() const { return mCacheMaxSize; }
         
 
 
@@ -157,7 +157,12 @@ namespace Ogre {
         VET_SHORT2_NORM = 31,  /// signed shorts (normalized to -1..1)
         VET_SHORT4_NORM = 32,
         VET_USHORT2_NORM = 33, /// unsigned shorts (normalized to 0..1)
-        VET_USHORT4_NORM = 34
+        VET_USHORT4_NORM = 34,
+        /// signed 10 bit x, y, z and 2 bit w packed in 32 bits (normalized to -1..1)
+        VET_INT_10_10_10_2_NORM = 35,
+        /// half precision floats
+        VET_HALF2 = 36,
+        VET_HALF4 = 37
     };
 
     /** This class declares the usage of a single vertex buffer as a component
@@ -236,6 +241,22 @@ namespace Ogre {
         /** Utility method to get the most appropriate packed colour vertex element format. */
         static VertexElementType getBestColourVertexElementType(void);
 
+        /** Utility method for converting a single value from one vertex element
+            type to another.
+        @remarks
+            The components go through float, with the normalised types mapping to
+            -1..1 or 0..1. Missing components are taken from (0, 0, 0, 1) and extra
+            ones are dropped, so e.g. a VET_FLOAT3 normal can be read from a
+            VET_INT_10_10_10_2_NORM element. Colour types are not supported, use
+            convertColourValue for those.
+        @param srcType The source type
+        @param pSrc Pointer to the source value
+        @param dstType The destination type
+        @param pDst Pointer to the destination value
+        */
+        static void convertValue(VertexElementType srcType, const void* pSrc,
+            VertexElementType dstType, void* pDst);
+
         inline bool operator== (const VertexElement& rhs) const
         {
             if (mType != rhs.mType ||
@@ -129,6 +129,9 @@ namespace Ogre {
 
         virtual size_t calculateSize(void) const;
 
+        /// @copydoc GpuProgram::_getHash
+        uint32 _getHash(uint32 seed = 0) const;
+
         /** Sets the preprocessor defines used to compile the program. */
         void setPreprocessorDefines(const String& defines) { mPreprocessorDefines = defines; }
         /** Gets the preprocessor defines used to compile the program. */
@@ -730,6 +730,47 @@ namespace Ogre {
         /** Destroys and frees the edge lists this mesh has built. */
         void freeEdgeList(void);
 
+        /** Reorders the geometry of this mesh for better vertex cache and vertex
+            fetch locality.
+        @remarks
+            The triangles of every triangle list submesh, including all generated
+            LOD levels, are reordered with IndexData::optimiseVertexCacheTriList.
+            LOD levels which share their index buffer with another level (as the
+            compressed levels of the MeshLodGenerator do) keep their order, and
+            triangles never leave their SubMesh::Meshlet.
+        @par
+            If reorderVertices is set, the vertices are then sorted by their first
+            use in the full detail index buffers, so the vertex fetches become
+            mostly sequential. This step is skipped for meshes with vertex or pose
+            animation and for meshes prepared for shadow volumes. Edge lists are
+            rebuilt if they were built before.
+        @param reorderVertices Whether to also reorder the vertex buffers
+        */
+        void optimiseVertexCache(bool reorderVertices = true);
+
+        /** Converts normals, tangents and texture coordinates to more compact
+            vertex element types.
+        @remarks
+            Normals, binormals and tangents stored as VET_FLOAT3 or VET_FLOAT4 are
+            converted to normalType and 2D texture coordinates stored as VET_FLOAT2
+            to texCoordType. Only the vertex buffers holding those elements are
+            recreated. Positions stay VET_FLOAT3, as shadow volumes and the software
+            animation paths work on them directly.
+        @par
+            VET_USHORT2_NORM can only hold texture coordinates in 0..1, sets using a
+            larger range are stored as VET_HALF2 instead. Normals of vertex data with
+            morph or pose animated normals are kept, as those are accumulated in the
+            normal buffer. Types the current render system does not support, see
+            RSC_VERTEX_FORMAT_INT_10_10_10_2 and RSC_VERTEX_FORMAT_HALF, keep the
+            float data.
+        @param normalType VET_INT_10_10_10_2_NORM, VET_SHORT4_NORM or VET_BYTE4_NORM;
+            VET_FLOAT3 keeps the normals
+        @param texCoordType VET_HALF2 or VET_USHORT2_NORM; VET_FLOAT2 keeps the texture
+            coordinates
+        */
+        void quantiseVertexData(VertexElementType normalType = VET_INT_10_10_10_2_NORM,
+                                VertexElementType texCoordType = VET_HALF2);
+
         /** This method prepares the mesh for generating a renderable shadow volume. 
         @remarks
             Preparing a mesh to generate a shadow volume involves firstly ensuring that the 
@@ -208,6 +208,18 @@ namespace Ogre {
             // unsigned short submesh_index;
             // float extremes [n_extremes][3];
 
+            // Optional submesh meshlet list chunk
+            M_TABLE_MESHLETS = 0xE100,
+            // unsigned short submesh_index;
+            // unsigned int meshletCount;
+            // repeat for meshletCount:
+            //   unsigned int indexStart;
+            //   unsigned int indexCount;
+            //   float center[3];
+            //   float radius;
+            //   float coneAxis[3];
+            //   float coneCutoff;
+
     /* Version 1.2 of the .mesh format (deprecated)
     enum MeshChunkID {
         M_HEADER                = 0x1000,
@@ -402,6 +402,18 @@ namespace Ogre {
         */
         MeshSerializerListener *getListener();
 
+        /** Sets the types normals, tangents and texture coordinates of loaded meshes are
+            quantised to, see Mesh::quantiseVertexData.
+        @remarks
+            Only affects meshes loaded afterwards. The default of VET_FLOAT3 and VET_FLOAT2
+            keeps the data as stored in the file.
+        */
+        void setImportQuantisation(VertexElementType normalType, VertexElementType texCoordType);
+        /// Gets the type normals of loaded meshes are quantised to
+        VertexElementType getImportNormalType() const { return mImportNormalType; }
+        /// Gets the type texture coordinates of loaded meshes are quantised to
+        VertexElementType getImportTexCoordType() const { return mImportTexCoordType; }
+
     protected:
 
         /// @copydoc ResourceManager::createImpl
@@ -471,6 +483,10 @@ namespace Ogre {
 
         // The listener to pass to serializers
         MeshSerializerListener *mListener;
+
+        // quantisation applied on import
+        VertexElementType mImportNormalType;
+        VertexElementType mImportTexCoordType;
     };
 
     /** @} */
@@ -44,6 +44,10 @@ namespace Ogre {
         /// Latest version available
         MESH_VERSION_LATEST,
         
+        /// OGRE version v1.12+, vertex and index data aligned for memory mapped loading
+        MESH_VERSION_1_12,
+        /// OGRE version v1.12+, submesh meshlets
+        MESH_VERSION_1_11,
         /// OGRE version v1.10+
         MESH_VERSION_1_10,
         /// OGRE version v1.8+
@@ -160,6 +164,12 @@ namespace Ogre {
         void setListener(MeshSerializerListener *listener);
         /// Returns the current listener
         MeshSerializerListener *getListener();
+
+        /** Quantises the vertex data of imported meshes, see Mesh::quantiseVertexData
+        @param normalType type for normals and tangents, VET_FLOAT3 (the default) keeps them
+        @param texCoordType type for 2D texture coordinates, VET_FLOAT2 (the default) keeps them
+        */
+        void setImportQuantisation(VertexElementType normalType, VertexElementType texCoordType);
         
     protected:
         typedef std::vector<MeshVersionData*> MeshVersionDataList;
@@ -167,6 +177,9 @@ namespace Ogre {
 
         MeshSerializerListener *mListener;
 
+        VertexElementType mImportNormalType;
+        VertexElementType mImportTexCoordType;
+
     };
 
     /** 
@@ -0,0 +1,140 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#ifndef __Pack_H__
+#define __Pack_H__
+
+#include "OgrePrerequisites.h"
+
+#include "OgreArchive.h"
+#include "OgreArchiveFactory.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre {
+
+    /** \addtogroup Core
+    *  @{
+    */
+    /** \addtogroup Resources
+    *  @{
+    */
+
+    /** Specialisation of the ArchiveFactory for packed resource files, as written
+        by PackArchiveWriter or the OgreResourcePacker tool.
+
+        The pack is memory mapped and files are looked up by binary search in
+        an index sorted on the hash of their name, so opening a file takes no
+        lock. Stored files are returned as MemoryDataStream over the mapping
+        without copying, compressed files are decoded block by block into a new
+        MemoryDataStream.
+
+        Unless OGRE_RESOURCEMANAGER_STRICT is set, lookup is case insensitive and
+        files can also be found by their basename, like with the Zip and FileSystem
+        archives.
+    */
+    class _OgreExport PackArchiveFactory : public ArchiveFactory
+    {
+    public:
+        /// @copydoc FactoryObj::getType
+        const String& getType(void) const;
+
+        using ArchiveFactory::createInstance;
+
+        Archive *createInstance( const String& name, bool readOnly );
+        /// @copydoc FactoryObj::destroyInstance
+        void destroyInstance(Archive* ptr) { OGRE_DELETE ptr; }
+    };
+
+    /** Writes files into the format read by PackArchiveFactory.
+
+        Files are written in the order they were added, each starting at a multiple
+        of the alignment, so stored payloads can be uploaded to the GPU straight
+        from the mapping. Compressed files are split into blocks that are decoded
+        independently; blocks that do not compress are kept stored. Files with the
+        same content are only written once, unless deduplication is disabled.
+    */
+    class _OgreExport PackArchiveWriter : public ArchiveAlloc
+    {
+    public:
+        enum Codec
+        {
+            /// no compression
+            CODEC_STORED = 0,
+            /// raw deflate, only available if OGRE is built with zlib
+            CODEC_DEFLATE = 1
+            // the format leaves room for further codecs like LZ4 or Zstd, which are
+            // not added as OGRE does not depend on either library
+        };
+
+        PackArchiveWriter();
+        ~PackArchiveWriter();
+
+        /// Sets the compression of subsequently added files, default is CODEC_STORED
+        void setCodec(Codec codec) { mCodec = codec; }
+        /** Sets the uncompressed size of the blocks compressed files are split into
+        @param size block size in bytes, 0 compresses every file as a single block
+        */
+        void setBlockSize(uint32 size) { mBlockSize = size; }
+        /// Sets the alignment of file data in bytes, a power of two. Default is 16
+        void setAlignment(uint32 alignment);
+        /// Sets whether files with the same content share their data. Default is true
+        void setDeduplicate(bool dedup) { mDeduplicate = dedup; }
+
+        /** Adds a file, which is read when writing the pack
+        @param name name of the file in the pack, including its path
+        @param stream content of the file
+        */
+        void addFile(const String& name, const DataStreamPtr& stream);
+
+        /// Adds all files in the given archive, recursively
+        void addArchive(Archive* source);
+
+        /// Writes the pack and returns the number of bytes written
+        size_t write(const String& filename);
+    private:
+        struct PendingFile
+        {
+            String name;
+            DataStreamPtr stream;
+            /// opened when writing, if set
+            Archive* archive;
+            Codec codec;
+        };
+        std::vector<PendingFile> mFiles;
+        Codec mCodec;
+        uint32 mBlockSize;
+        uint32 mAlignment;
+        bool mDeduplicate;
+    };
+    /** @} */
+    /** @} */
+
+}
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -120,6 +120,10 @@ namespace Ogre {
             false. If the event sets this to true, the script will be skipped and not
             parsed. Note that in this case the scriptParseEnded event will not be raised
             for this script.
+        @note
+            Scripts handled by the ScriptCompilerManager are parsed in parallel batches,
+            so several scriptParseStarted events may be raised before the matching
+            scriptParseEnded events, which then follow in the same order.
         */
         virtual void scriptParseStarted(const String& scriptName, bool& skipThisScript) {}
 
@@ -294,7 +298,20 @@ namespace Ogre {
         ResourceLoadingListener *mLoadingListener;
 
         /// Resource index entry, resourcename->location 
-        typedef std::map<String, Archive*> ResourceLocationIndex;
+        typedef std::unordered_map<String, Archive*> ResourceLocationIndex;
+
+        /// File list of a scanned location, as stored in the location index cache
+        struct CachedLocationIndex
+        {
+            /// Hash of the modification times the list was scanned at
+            uint32 stamp;
+            StringVectorPtr files;
+        };
+        typedef std::unordered_map<String, CachedLocationIndex> LocationIndexCache;
+        mutable LocationIndexCache mLocationIndexCache;
+        bool mLocationIndexCaching;
+        /// guards mLocationIndexCache, groups are indexed concurrently
+        OGRE_MUTEX(mLocationIndexCacheMutex);
 
         /// List of resources which can be loaded / unloaded
         typedef std::list<ResourcePtr> LoadUnloadResourceList;
@@ -319,6 +336,8 @@ namespace Ogre {
             Status groupStatus;
             /// List of possible locations to search
             LocationList locationList;
+            /// Locations that were added, but are not in the index yet
+            LocationList unindexedLocations;
             /// Index of resource names to locations, built for speedy access (case sensitive archives)
             ResourceLocationIndex resourceIndexCaseSensitive;
 #if !OGRE_RESOURCEMANAGER_STRICT
@@ -357,6 +376,8 @@ namespace Ogre {
             Called as part of initialiseResourceGroup
         */
         void parseResourceGroupScripts(ResourceGroup* grp) const;
+        /// Opens a script file and notifies the loading listener
+        DataStreamPtr openScript(const FileInfo& fi, ResourceGroup* grp) const;
         /** Create all the pre-declared resources.
         @remarks
             Called as part of initialiseResourceGroup
@@ -370,6 +391,15 @@ namespace Ogre {
         void dropGroupContents(ResourceGroup* grp);
         /** Delete a group for shutdown - don't notify ResourceManagers. */
         void deleteGroup(ResourceGroup* grp);
+        /** Scans the unindexed locations of the given groups and adds them to their index.
+        @remarks
+            The locations are scanned in parallel, but indexed in the order they
+            were added. Locations that fail to scan are removed from their group and
+            the first error is rethrown once the others are indexed.
+        */
+        void indexLocations(const std::vector<ResourceGroup*>& groups) const;
+        /// Scans a location, or takes its files from the location index cache
+        StringVectorPtr scanLocation(const ResourceLocation& loc, uint32& stamp) const;
         /// Internal find method for auto groups
         std::pair<Archive*, ResourceGroup*>
         resourceExistsInAnyGroupImpl(const String& filename) const;
@@ -587,6 +617,13 @@ namespace Ogre {
                 The default is to disable this so that resources in subdirectories
                 with the same name are still unique.
             @param readOnly whether the Archive is read only
+            @note The archive is loaded right away, so a missing or corrupt Zip or
+                Pack still throws here. The files of the location are however only
+                listed when the group is first searched or initialised, together with
+                any other location added in the meantime, so adding many locations in
+                a row scans them in parallel. If listing the files fails, the location
+                is removed from the group and the error is thrown by that search or
+                initialisation.
             @see @ref Resource-Management
         */
         void addResourceLocation(const String& name, const String& locType, 
@@ -976,6 +1013,32 @@ namespace Ogre {
         */      
         const LocationList& getResourceLocationList(const String& groupName) const;
 
+        /** Get if the file lists of scanned resource locations are kept, so they
+            can be saved with saveLocationIndexCache
+        */
+        bool getLocationIndexCaching() const { return mLocationIndexCaching; }
+        /** Set if the file lists of scanned resource locations are kept, so they
+            can be saved with saveLocationIndexCache
+        */
+        void setLocationIndexCaching(bool val);
+
+        /** Saves the file lists of all scanned resource locations
+        @remarks
+            Locations are scanned when they are first used, at the latest by
+            initialiseResourceGroup, so save the cache after initialising.
+        @param stream The destination stream
+        */
+        void saveLocationIndexCache(const DataStreamPtr& stream) const;
+        /** Loads file lists of resource locations saved by saveLocationIndexCache
+        @remarks
+            A location that is added afterwards uses the cached list instead of
+            scanning the archive, as long as the modification times of the
+            archive - and for folders of every subfolder holding resources - did
+            not change. Enables setLocationIndexCaching.
+        @param stream The source stream
+        */
+        void loadLocationIndexCache(const DataStreamPtr& stream);
+
         /// Sets a new loading listener
         void setLoadingListener(ResourceLoadingListener *listener);
         /// Returns the current loading listener
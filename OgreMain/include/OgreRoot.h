@@ -98,6 +98,7 @@ namespace Ogre
         std::unique_ptr<SkeletonManager> mSkeletonManager;
 
         std::unique_ptr<ArchiveFactory> mFileSystemArchiveFactory;
+        std::unique_ptr<ArchiveFactory> mPackArchiveFactory;
         std::unique_ptr<ArchiveFactory> mEmbeddedZipArchiveFactory;
         std::unique_ptr<ArchiveFactory> mZipArchiveFactory;
         std::unique_ptr<ArchiveManager> mArchiveManager;
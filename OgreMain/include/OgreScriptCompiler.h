@@ -412,6 +412,21 @@ namespace Ogre
 
         // the specific compiler instance used
         ScriptCompiler mScriptCompiler;
+
+        struct CachedScript
+        {
+            /// serialised concrete syntax tree
+            std::vector<uchar> nodes;
+            /// whether the script was parsed during this run
+            bool used;
+        };
+        // Parsed scripts, keyed on a hash of their content
+        typedef std::map<std::pair<uint64, uint64>, CachedScript> ScriptCache;
+        ScriptCache mScriptCache;
+        bool mScriptCaching;
+        bool mScriptCacheDirty;
+        // parsing may happen on WorkQueue threads
+        OGRE_WQ_MUTEX(mScriptCacheMutex);
     public:
         ScriptCompilerManager();
         virtual ~ScriptCompilerManager();
@@ -449,6 +464,39 @@ namespace Ogre
         const StringVector& getScriptPatterns(void) const;
         /// @copydoc ScriptLoader::parseScript
         void parseScript(DataStreamPtr& stream, const String& groupName);
+
+        /** Lexes and parses a script, or restores it from the script cache
+        @remarks
+            This is thread safe, so scripts can be parsed in parallel.
+        @param str The script content
+        @param source The name of the script, as stored in the nodes
+        */
+        ConcreteNodeListPtr _parse(const String& str, const String& source);
+        /** Compiles nodes returned by _parse
+        @remarks
+            Unlike _parse this must be called in script loading order, as
+            scripts may refer to objects defined in earlier scripts.
+        */
+        void _compile(const ConcreteNodeListPtr& nodes, const String& groupName);
+
+        /// Get if parsed scripts are kept, so they can be saved with saveScriptCache
+        bool getScriptCaching() const { return mScriptCaching; }
+        /// Set if parsed scripts are kept, so they can be saved with saveScriptCache
+        void setScriptCaching(bool val);
+        /// Returns true if scripts were added to the script cache during the run
+        bool isScriptCacheDirty() const { return mScriptCacheDirty; }
+
+        /** Saves the parse trees of all scripts parsed during the run
+        @param stream The destination stream
+        */
+        void saveScriptCache(const DataStreamPtr& stream) const;
+        /** Loads parse trees saved by saveScriptCache
+        @remarks
+            Scripts with the same content are then restored from the cache
+            instead of being lexed and parsed again. Enables setScriptCaching.
+        @param stream The source stream
+        */
+        void loadScriptCache(const DataStreamPtr& stream);
         /// @copydoc ScriptLoader::getLoadingOrder
         Real getLoadingOrder(void) const;
 
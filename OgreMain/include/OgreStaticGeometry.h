@@ -116,6 +116,12 @@ namespace Ogre {
     @note
         Warning: this class only works with indexed triangle lists at the moment,
         do not pass it triangle strips, fans or lines / points, or unindexed geometry.
+    @par
+        If the same SubMesh is repeated many times within a region (e.g. thousands
+        of rocks sharing one mesh), duplicating its geometry wastes a lot of memory.
+        You can set an instancing threshold with setInstancingThreshold, in which
+        case such SubMeshes are rendered through hardware instancing from the
+        original vertex data instead (@see InstancedGeometryBucket).
     */
     class _OgreExport StaticGeometry : public BatchedGeometryAlloc
     {
@@ -243,11 +249,40 @@ namespace Ogre {
             /** Try to assign geometry to this bucket.
             @return false if there is no room left in this bucket
             */
-            bool assign(QueuedGeometry* qsm);
+            virtual bool assign(QueuedGeometry* qsm);
             /// Build
-            void build(bool stencilShadows);
+            virtual void build(bool stencilShadows);
             /// Dump contents for diagnostics
-            void dump(std::ofstream& of) const;
+            virtual void dump(std::ofstream& of) const;
+        };
+        /** A GeometryBucket which renders many copies of a single SubMesh
+            using hardware instancing.
+        @remarks
+            Instead of pre-transforming and duplicating the vertices, the
+            original vertex & index buffers are referenced and an extra vertex
+            buffer holding one 3x4 world matrix per instance is bound, using
+            the same layout as InstanceBatchHW (3 additional float4 texture
+            coordinates). This means the material used must be written for
+            hardware instancing, just like with InstanceManager::HWInstancingBasic.
+        */
+        class _OgreExport InstancedGeometryBucket : public GeometryBucket
+        {
+        protected:
+            /// Buffer source holding the per instance world matrices
+            unsigned short mInstanceSource;
+        public:
+            InstancedGeometryBucket(MaterialBucket* parent, const String& formatString,
+                const VertexData* vData, const IndexData* iData);
+
+            /** Returns whether the given geometry can be rendered through an
+                InstancedGeometryBucket with the current RenderSystem. */
+            static bool isSupported(const SubMeshLodGeometryLink* geom);
+
+            void getRenderOperation(RenderOperation& op) override;
+            void getWorldTransforms(Matrix4* xform) const override;
+            bool assign(QueuedGeometry* qsm) override;
+            void build(bool stencilShadows) override;
+            void dump(std::ofstream& of) const override;
         };
         /** A MaterialBucket is a collection of smaller buckets with the same 
             Material (and implicitly the same LOD). */
@@ -271,8 +306,19 @@ namespace Ogre {
             // index to current Geometry Buckets for a given geometry format
             typedef std::map<String, GeometryBucket*> CurrentGeometryMap;
             CurrentGeometryMap mCurrentGeometryMap;
+            // index to current instanced Geometry Buckets for a given SubMesh LOD
+            typedef std::map<SubMeshLodGeometryLink*, GeometryBucket*> CurrentInstancedGeometryMap;
+            CurrentInstancedGeometryMap mCurrentInstancedGeometryMap;
+            /// Geometry held back until build, when instancing is enabled
+            QueuedGeometryList mDeferredGeometry;
             /// Get a packed string identifying the geometry format
             String getGeometryFormatString(SubMeshLodGeometryLink* geom);
+            /// Assign geometry to a GeometryBucket which duplicates the vertices
+            void assignToGeometryBucket(QueuedGeometry* qsm);
+            /// Assign geometry to an InstancedGeometryBucket
+            void assignToInstancedGeometryBucket(QueuedGeometry* qsm);
+            /// Distribute deferred geometry between instanced and regular buckets
+            void assignDeferredGeometry(bool stencilShadows);
             
         public:
             MaterialBucket(LODBucket* parent, const String& materialName);
@@ -498,6 +544,8 @@ namespace Ogre {
         bool mRenderQueueIDSet;
         /// Stores the visibility flags for the regions
         uint32 mVisibilityFlags;
+        /// Minimum number of repeats of a SubMesh within a region to use instancing
+        size_t mInstancingThreshold;
 
         QueuedSubMeshList mQueuedSubMeshes;
 
@@ -735,6 +783,31 @@ namespace Ogre {
         /** Gets the origin of this geometry. */
         virtual const Vector3& getOrigin(void) const { return mOrigin; }
 
+        /** Sets the number of repeats of the same SubMesh within a region from
+            which on it is rendered using hardware instancing.
+        @remarks
+            By default all geometry is duplicated into merged vertex buffers, so
+            memory usage grows linearly with the number of entities added. When
+            a region contains at least this many copies of a SubMesh (with the
+            same material), an InstancedGeometryBucket referencing the
+            original vertex data is used instead, only storing a world matrix
+            per copy. Culling is still performed per region.
+        @par
+            Instancing is only used if the RenderSystem supports
+            RSC_VERTEX_BUFFER_INSTANCE_DATA, the geometry has 3 free texture
+            coordinates and neither stencil shadows nor camera relative
+            rendering are in use; otherwise the geometry is duplicated as usual.
+            The materials of the instanced SubMeshes must use a vertex program
+            taking the world matrix from the instance data (see
+            InstanceManager::HWInstancingBasic).
+        @note Must be called before 'build'.
+        @param threshold Number of repeats required, 0 (the default) disables
+            instancing.
+        */
+        void setInstancingThreshold(size_t threshold) { mInstancingThreshold = threshold; }
+        /** Gets the number of repeats from which on a SubMesh is instanced. */
+        size_t getInstancingThreshold(void) const { return mInstancingThreshold; }
+
         /// Sets the visibility flags of all the regions at once
         void setVisibilityFlags(uint32 flags);
         /// Returns the visibility flags of the regions
@@ -122,10 +122,19 @@ namespace Ogre {
         mutable Real mCachedCameraDist;
         /// The camera for which the cached distance is valid
         mutable const Camera *mCachedCamera;
+        /// Index range of the meshlets visible to the current camera
+        std::unique_ptr<IndexData> mMeshletIndexData;
+        /// Whether to draw mMeshletIndexData instead of the full index data
+        bool mMeshletRangeActive;
+        /// Whether any meshlet is visible to the current camera
+        bool mMeshletsVisible;
 
         /** Internal method for preparing this Entity for use in animation. */
         void prepareTempBlendBuffers(void);
 
+        /** Internal method to find the meshlets visible to the camera, called by Entity::_notifyCurrentCamera. */
+        void updateVisibleMeshlets(const Camera* cam);
+
     public:
         /** Gets the name of the Material in use by this instance.
         */
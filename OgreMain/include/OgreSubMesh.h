@@ -132,6 +132,38 @@ namespace Ogre {
          */
         std::vector<Vector3> extremityPoints;
 
+        /** A group of neighbouring triangles of the full detail geometry.
+            @remarks
+                The triangles of a meshlet are stored contiguously in indexData, so
+                any run of meshlets can be drawn with a single index range. The
+                bounding sphere and normal cone let Entity skip the meshlets which
+                are outside of the view frustum or face away from the camera.
+        */
+        struct Meshlet
+        {
+            /// First index of the meshlet in indexData
+            uint32 indexStart;
+            /// Number of indexes in the meshlet
+            uint32 indexCount;
+            /// Centre of the bounding sphere, in mesh space
+            Vector3 center;
+            /// Radius of the bounding sphere
+            Real radius;
+            /// Average direction of the triangle normals
+            Vector3 coneAxis;
+            /// Sine of the normal cone angle, 1 if the meshlet can not be back face culled
+            Real coneCutoff;
+        };
+        typedef std::vector<Meshlet> MeshletList;
+
+        /** The meshlets of the full detail geometry (optional).
+            @remarks
+                Empty unless generated with generateMeshlets() or loaded from the
+                .mesh file. Entity uses them to draw only the part of the index
+                buffer which can be seen by the current camera.
+        */
+        MeshletList meshlets;
+
         /// Reference to parent Mesh (not a smart pointer so child does not keep parent alive).
         Mesh* parent;
 
@@ -250,6 +282,16 @@ namespace Ogre {
         */
         void generateExtremes(size_t count);
 
+        /** Split the full detail triangle list into meshlets (@see meshlets).
+        @remarks
+            Triangles are grouped by growing each meshlet over neighbouring
+            triangles, then indexData is rewritten in meshlet order. Generated
+            LOD levels are not touched. Only triangle lists are supported.
+        @param maxTriangles
+            Maximum number of triangles per meshlet, 0 removes the meshlets.
+        */
+        void generateMeshlets(size_t maxTriangles = 128);
+
         /** Returns true(by default) if the submesh should be included in the mesh EdgeList, otherwise returns false.
         */      
         bool isBuildEdgesEnabled(void) const { return mBuildEdgesEnabled; }
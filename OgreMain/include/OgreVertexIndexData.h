@@ -272,6 +272,10 @@ namespace Ogre {
             Can only be used for index data which consists of triangle lists.
             It would in fact be pointless to use it on triangle strips or fans
             in any case.
+        @par
+            Uses Tom Forsyth's linear-speed optimiser, so it is cheap enough
+            to run on large meshes and generated LOD levels. Only the range
+            [indexStart, indexStart + indexCount) is reordered.
         */
         void optimiseVertexCacheTriList(void);
     
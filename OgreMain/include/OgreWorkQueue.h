@@ -273,6 +273,27 @@ namespace Ogre
         virtual RequestID addRequest(uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount = 0, 
             bool forceSynchronous = false, bool idleThread = false) = 0;
 
+        /** Add a task to be executed by a worker thread.
+        @remarks
+            Tasks are a lightweight alternative to requests for work which
+            needs neither a RequestHandler nor a Response. The default
+            implementation executes the task immediately on the calling thread.
+        @param task The function to execute. It must be thread safe.
+        */
+        virtual void addTask(std::function<void()> task) { task(); }
+
+        /** Call a function for every index in [0, count), distributing the
+            calls over the worker threads.
+        @remarks
+            The calling thread processes indices too, so this can safely be
+            used from within a RequestHandler and does not depend on a worker
+            being available. Returns once all calls have completed. If any call
+            throws, the first exception is rethrown here.
+        @param count The number of indices to process
+        @param func The function to call with each index. It must be thread safe.
+        */
+        void parallelFor(size_t count, const std::function<void(size_t)>& func);
+
         /** Abort a previously issued request.
         If the request is still waiting to be processed, it will be 
         removed from the queue.
@@ -443,6 +464,8 @@ namespace Ogre
         /// @copydoc WorkQueue::addRequest
         virtual RequestID addRequest(uint16 channel, uint16 requestType, const Any& rData, uint8 retryCount = 0, 
             bool forceSynchronous = false, bool idleThread = false);
+        /// @copydoc WorkQueue::addTask
+        virtual void addTask(std::function<void()> task);
         /// @copydoc WorkQueue::abortRequest
         virtual void abortRequest(RequestID id);
         /// @copydoc WorkQueue::abortPendingRequest
@@ -474,6 +497,14 @@ namespace Ogre
         bool mIsRunning;
         unsigned long mResposeTimeLimitMS;
 
+        /// Tasks are queued as requests on an internal channel
+        struct TaskRequest
+        {
+            std::function<void()> task;
+            friend std::ostream& operator<<(std::ostream& o, const TaskRequest&) { return o; }
+        };
+        uint16 mTaskChannel;
+
         typedef std::deque<Request*> RequestQueue;
         typedef std::deque<Response*> ResponseQueue;
         RequestQueue mRequestQueue; // Guarded by mRequestMutex
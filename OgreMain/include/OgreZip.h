@@ -50,7 +50,14 @@ namespace Ogre {
         format source archive.
 
         This archive format supports all archives compressed in the standard
-        zip format, including iD pk3 files.
+        zip format, including iD pk3 files. Stored and deflated entries are
+        supported, as are zip64 archives, but not encryption.
+
+        The file is memory mapped and its central directory indexed once on
+        load. Stored entries are then opened as MemoryDataStream over the
+        mapping without copying, deflated ones are inflated into buffers
+        reused between streams. Files can be opened from several threads
+        at once.
     */
     class _OgreExport ZipArchiveFactory : public ArchiveFactory
     {
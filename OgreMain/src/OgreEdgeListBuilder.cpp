@@ -300,11 +300,11 @@ namespace Ogre {
 
                 // Retrieve the vertex position
                 unsigned char* pVertex = pBaseVertex + (index[i] * vbuf->getVertexSize());
-                float* pFloat;
-                posElem->baseVertexPointerToElement(pVertex, &pFloat);
-                v[i].x = *pFloat++;
-                v[i].y = *pFloat++;
-                v[i].z = *pFloat++;
+                void* pPos;
+                float pos[3];
+                posElem->baseVertexPointerToElement(pVertex, &pPos);
+                VertexElement::convertValue(posElem->getType(), pPos, VET_FLOAT3, pos);
+                v[i] = Vector3(pos[0], pos[1], pos[2]);
                 // find this vertex in the existing vertex map, or create it
                 tri.sharedVertIndex[i] = 
                     findOrCreateCommonVertex(v[i], vertexSet, indexSet, index[i]);
@@ -50,6 +50,7 @@ namespace Ogre {
           mUpdateBoundingBoxFromSkeleton(false),
           mVertexProgramInUse(false),
           mInitialised(false),
+          mMeshletCulling(true),
           mHardwarePoseCount(0),
           mNumBoneMatrices(0),
           mBoneWorldMatrices(NULL),
@@ -446,6 +447,7 @@ namespace Ogre {
 #endif
                 // Also invalidate any camera distance cache
                 (*i)->_invalidateCameraCache ();
+                (*i)->updateVisibleMeshlets(cam);
             }
 
 
@@ -643,7 +645,7 @@ namespace Ogre {
         iend = displayEntity->mSubEntityList.end();
         for (i = displayEntity->mSubEntityList.begin(); i != iend; ++i)
         {
-            if((*i)->isVisible())
+            if((*i)->isVisible() && (*i)->mMeshletsVisible)
             {
                 // Order: first use subentity queue settings, if available
                 //        if not then use entity queue settings, if available
@@ -35,6 +35,10 @@ THE SOFTWARE.
     OGRE_PLATFORM == OGRE_PLATFORM_EMSCRIPTEN
 #   include "OgreSearchOps.h"
 #   include <sys/param.h>
+#   include <sys/mman.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#   define _OGRE_FILESYSTEM_ARCHIVE_MMAP
 #endif
 
 #if OGRE_PLATFORM == OGRE_PLATFORM_WIN32 || OGRE_PLATFORM == OGRE_PLATFORM_WINRT
@@ -116,6 +120,7 @@ namespace {
     };
 
     bool gIgnoreHidden = true;
+    bool gMemoryMapping = false;
 }
 
     //-----------------------------------------------------------------------
@@ -326,6 +331,84 @@ namespace {
         // nothing to see here, move along
     }
     //-----------------------------------------------------------------------
+namespace {
+    /** MemoryDataStream over a read only mapping of a file.
+    */
+    class MappedFileDataStream : public MemoryDataStream
+    {
+    public:
+        MappedFileDataStream(const String& name, void* pMem, size_t size)
+            : MemoryDataStream(name, pMem, size, false, true)
+        {
+        }
+
+        ~MappedFileDataStream() { close(); }
+
+        void close(void)
+        {
+            if (mData)
+            {
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+                UnmapViewOfFile(mData);
+#elif defined(_OGRE_FILESYSTEM_ARCHIVE_MMAP)
+                munmap(mData, mSize);
+#endif
+                mData = 0;
+            }
+            MemoryDataStream::close();
+        }
+    };
+}
+    //-----------------------------------------------------------------------
+    DataStreamPtr _openMappedFile(const String& full_path, const String& name)
+    {
+        void* pMem = NULL;
+        size_t size = 0;
+#if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
+#ifdef _OGRE_FILESYSTEM_ARCHIVE_UNICODE
+        HANDLE file = CreateFileW(to_wpath(full_path).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#else
+        HANDLE file = CreateFileA(full_path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#endif
+        if (file == INVALID_HANDLE_VALUE)
+            return DataStreamPtr();
+
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+        {
+            size = size_t(fileSize.QuadPart);
+            // the view keeps the mapping alive
+            HANDLE mapping = CreateFileMapping(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (mapping)
+            {
+                pMem = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+#elif defined(_OGRE_FILESYSTEM_ARCHIVE_MMAP)
+        int fd = ::open(full_path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return DataStreamPtr();
+
+        struct stat tagStat;
+        if (fstat(fd, &tagStat) == 0 && tagStat.st_size > 0)
+        {
+            size = tagStat.st_size;
+            pMem = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (pMem == MAP_FAILED)
+                pMem = NULL;
+        }
+        ::close(fd);
+#endif
+        if (!pMem)
+            return DataStreamPtr();
+
+        return DataStreamPtr(OGRE_NEW MappedFileDataStream(name.empty() ? full_path : name, pMem, size));
+    }
+    //-----------------------------------------------------------------------
     DataStreamPtr FileSystemArchive::open(const String& filename, bool readOnly) const
     {
         if (!readOnly && isReadOnly())
@@ -339,7 +422,16 @@ namespace {
 
         if(!readOnly) mode |= std::ios::out;
 
-        return _openFileStream(concatenate_path(mName, filename), mode, filename);
+        String full_path = concatenate_path(mName, filename);
+        if (readOnly && gMemoryMapping)
+        {
+            // falls back to streaming e.g. empty files
+            DataStreamPtr stream = _openMappedFile(full_path, filename);
+            if (stream)
+                return stream;
+        }
+
+        return _openFileStream(full_path, mode, filename);
     }
     DataStreamPtr _openFileStream(const String& full_path, std::ios::openmode mode, const String& name)
     {
@@ -573,4 +665,14 @@ namespace {
     {
         return gIgnoreHidden;
     }
+
+    void FileSystemArchiveFactory::setMemoryMapping(bool enable)
+    {
+        gMemoryMapping = enable;
+    }
+
+    bool FileSystemArchiveFactory::getMemoryMapping()
+    {
+        return gMemoryMapping;
+    }
 }
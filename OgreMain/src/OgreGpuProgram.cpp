@@ -88,6 +88,7 @@ namespace Ogre
     {
         // include filename as same source can be used with different defines & entry points
         uint32 hash = FastHash(mName.c_str(), mName.size(), seed);
+        hash = FastHash(mSyntaxCode.c_str(), mSyntaxCode.size(), hash);
         return FastHash(mSource.c_str(), mSource.size(), hash);
     }
 
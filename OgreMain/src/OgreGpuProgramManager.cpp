@@ -29,9 +29,12 @@ THE SOFTWARE.
 #include "OgreGpuProgramManager.h"
 #include "OgreHighLevelGpuProgramManager.h"
 #include "OgreStreamSerialiser.h"
+#include "OgreArchiveManager.h"
+#include "OgreFileSystemLayer.h"
 
 namespace Ogre {
     static uint32 CACHE_CHUNK_ID = StreamSerialiser::makeIdentifier("OGPC"); // Ogre Gpu Program cache
+    static uint32 CACHE_FILE_CHUNK_ID = StreamSerialiser::makeIdentifier("OGPF"); // Ogre Gpu Program cache File
 
     /// default implementation for RenderSystems without assembly shader support
     class UnsupportedGpuProgram : public GpuProgram
@@ -114,6 +117,11 @@ namespace Ogre {
         mResourceType = "GpuProgram";
         mSaveMicrocodesToCache = false;
         mCacheDirty = false;
+        mCacheFilesSize = 0;
+        mCacheMaxSize = 64 * 1024 * 1024;
+        mCacheArchive = NULL;
+        mCacheDriverHash = 0;
+        mCacheDriverCaps = NULL;
 
         // subclasses should register with resource group manager
     }
@@ -304,12 +312,19 @@ namespace Ogre {
     //---------------------------------------------------------------------
     bool GpuProgramManager::isMicrocodeAvailableInCache( uint32 id ) const
     {
-        return mMicrocodeCache.find(id) != mMicrocodeCache.end();
+        return mMicrocodeCache.find(id) != mMicrocodeCache.end() || loadCacheFile(id);
     }
     //---------------------------------------------------------------------
     const GpuProgramManager::Microcode & GpuProgramManager::getMicrocodeFromCache( uint32 id ) const
     {
-        return mMicrocodeCache.find(id)->second;
+        auto it = mMicrocodeCache.find(id);
+        if (it == mMicrocodeCache.end() && loadCacheFile(id))
+            it = mMicrocodeCache.find(id);
+
+        if (it == mMicrocodeCache.end())
+            OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, "No microcode in the cache for the given id");
+
+        return it->second;
     }
     //---------------------------------------------------------------------
     GpuProgramManager::Microcode GpuProgramManager::createMicrocode( size_t size ) const
@@ -331,6 +346,9 @@ namespace Ogre {
             foundIter->second = microcode;
 
         }       
+
+        if (mCacheArchive)
+            writeCacheFile(id, microcode);
     }
     //---------------------------------------------------------------------
     void GpuProgramManager::removeMicrocodeFromCache( uint32 id )
@@ -342,6 +360,10 @@ namespace Ogre {
             mMicrocodeCache.erase( foundIter );
             mCacheDirty = true;
         }
+
+        String name;
+        if (mCacheArchive && getCacheFileName(id, name))
+            removeCacheFile(name);
     }
     //---------------------------------------------------------------------
     void GpuProgramManager::saveMicrocodeCache( DataStreamPtr stream ) const
@@ -430,5 +452,193 @@ namespace Ogre {
         
     }
     //---------------------------------------------------------------------
+    void GpuProgramManager::setMicrocodeCacheLocation(const String& location, const String& archiveType)
+    {
+        // the archive may be shared with resource locations, so it is left to the ArchiveManager
+        mCacheArchive = NULL;
+        mCacheFiles.clear();
+        mCacheFileIndex.clear();
+        mCacheFilesSize = 0;
+
+        if (location.empty())
+            return;
+
+        if (archiveType == "FileSystem")
+            FileSystemLayer::createDirectory(location);
+
+        Archive* arch = ArchiveManager::getSingleton().load(location, archiveType, false);
+
+        // oldest first, as we cannot track use across runs
+        std::vector<std::pair<time_t, FileInfo> > files;
+        FileInfoListPtr fileInfos = arch->findFileInfo("*.bin", false);
+        for (const auto& fi : *fileInfos)
+            files.push_back(std::make_pair(arch->getModifiedTime(fi.filename), fi));
+        std::stable_sort(files.begin(), files.end(),
+                         [](const std::pair<time_t, FileInfo>& a, const std::pair<time_t, FileInfo>& b) {
+                             return a.first < b.first;
+                         });
+
+        for (const auto& f : files)
+        {
+            mCacheFileIndex[f.second.filename] =
+                mCacheFiles.insert(mCacheFiles.end(), std::make_pair(f.second.filename, f.second.uncompressedSize));
+            mCacheFilesSize += f.second.uncompressedSize;
+        }
+
+        mCacheArchive = arch;
+        evictCacheFiles();
+    }
+    //---------------------------------------------------------------------
+    const String& GpuProgramManager::getMicrocodeCacheLocation() const
+    {
+        return mCacheArchive ? mCacheArchive->getName() : BLANKSTRING;
+    }
+    //---------------------------------------------------------------------
+    void GpuProgramManager::setMicrocodeCacheMaxSize(size_t size)
+    {
+        mCacheMaxSize = size;
+        if (mCacheArchive)
+            evictCacheFiles();
+    }
+    //---------------------------------------------------------------------
+    bool GpuProgramManager::getCacheFileName(uint32 id, String& name) const
+    {
+        // without a render system nothing is compiled, so the driver part stays zero
+        RenderSystem* rs = Root::getSingleton().getRenderSystem();
+        const RenderSystemCapabilities* caps = rs ? rs->getCapabilities() : NULL;
+        if (rs && !caps)
+            return false;
+
+        if (caps != mCacheDriverCaps)
+        {
+            mCacheDriverHash = 0;
+            if (caps)
+            {
+                String driver = rs->getName() + "|" + caps->getDeviceName() + "|" +
+                                caps->getDriverVersion().toString() + "|" +
+                                RenderSystemCapabilities::vendorToString(caps->getVendor());
+                mCacheDriverHash = FastHash(driver.c_str(), driver.size());
+            }
+            mCacheDriverCaps = caps;
+        }
+
+        name = StringUtil::format("%08x%08x.bin", mCacheDriverHash, id);
+        return true;
+    }
+    //---------------------------------------------------------------------
+    bool GpuProgramManager::loadCacheFile(uint32 id) const
+    {
+        String name;
+        if (!mCacheArchive || !getCacheFileName(id, name))
+            return false;
+
+        auto indexIt = mCacheFileIndex.find(name);
+        if (indexIt == mCacheFileIndex.end())
+            return false;
+
+        Microcode microcode;
+        try
+        {
+            StreamSerialiser serialiser(mCacheArchive->open(name));
+            const StreamSerialiser::Chunk* chunk = serialiser.readChunkBegin();
+
+            uint32 fileId = 0, driverHash = 0, checksum = 0, microcodeLength = 0;
+            if (chunk->id == CACHE_FILE_CHUNK_ID && chunk->version == 1)
+            {
+                serialiser.read(&fileId);
+                serialiser.read(&driverHash);
+                serialiser.read(&checksum);
+                serialiser.read(&microcodeLength);
+            }
+
+            // a truncated file reads short, so the checksum catches it too
+            if (fileId == id && driverHash == mCacheDriverHash && microcodeLength > 0 &&
+                microcodeLength <= chunk->length)
+            {
+                microcode.reset(OGRE_NEW MemoryDataStream(microcodeLength));
+                serialiser.readData(microcode->getPtr(), 1, microcodeLength);
+                if (FastHash((const char*)microcode->getPtr(), microcodeLength) != checksum)
+                    microcode.reset();
+                else
+                    serialiser.readChunkEnd(CACHE_FILE_CHUNK_ID);
+            }
+        }
+        catch (const Exception&)
+        {
+            microcode.reset();
+        }
+
+        if (!microcode)
+        {
+            LogManager::getSingleton().logWarning("Invalid microcode cache file " + name);
+            removeCacheFile(name);
+            return false;
+        }
+
+        // most recently used
+        mCacheFiles.splice(mCacheFiles.end(), mCacheFiles, indexIt->second);
+        mMicrocodeCache[id] = microcode;
+        return true;
+    }
+    //---------------------------------------------------------------------
+    void GpuProgramManager::writeCacheFile(uint32 id, const Microcode& microcode)
+    {
+        String name;
+        if (!getCacheFileName(id, name))
+            return;
+
+        uint32 microcodeLength = static_cast<uint32>(microcode->size());
+        uint32 checksum = FastHash((const char*)microcode->getPtr(), microcodeLength);
+
+        // accounted like the files found by setMicrocodeCacheLocation, header included
+        size_t fileSize = 0;
+        try
+        {
+            removeCacheFile(name);
+
+            DataStreamPtr stream = mCacheArchive->create(name);
+            StreamSerialiser serialiser(stream);
+            serialiser.writeChunkBegin(CACHE_FILE_CHUNK_ID, 1);
+            serialiser.write(&id);
+            serialiser.write(&mCacheDriverHash);
+            serialiser.write(&checksum);
+            serialiser.write(&microcodeLength);
+            serialiser.writeData(microcode->getPtr(), 1, microcodeLength);
+            serialiser.writeChunkEnd(CACHE_FILE_CHUNK_ID);
+            fileSize = stream->tell();
+        }
+        catch (const Exception& e)
+        {
+            // the program still works, it just gets compiled again next time
+            LogManager::getSingleton().logWarning("Could not write microcode cache file " + name + ": " +
+                                                  e.getDescription());
+            return;
+        }
+
+        mCacheFileIndex[name] = mCacheFiles.insert(mCacheFiles.end(), std::make_pair(name, fileSize));
+        mCacheFilesSize += fileSize;
+        evictCacheFiles();
+    }
+    //---------------------------------------------------------------------
+    void GpuProgramManager::removeCacheFile(const String& name) const
+    {
+        auto indexIt = mCacheFileIndex.find(name);
+        if (indexIt == mCacheFileIndex.end())
+            return;
+
+        // name may refer to the list entry, so remove the file first
+        mCacheArchive->remove(name);
+        mCacheFilesSize -= indexIt->second->second;
+        mCacheFiles.erase(indexIt->second);
+        mCacheFileIndex.erase(indexIt);
+    }
+    //---------------------------------------------------------------------
+    void GpuProgramManager::evictCacheFiles()
+    {
+        // keep the newest file, even if it alone exceeds the limit
+        while (mCacheMaxSize && mCacheFilesSize > mCacheMaxSize && mCacheFiles.size() > 1)
+            removeCacheFile(mCacheFiles.front().first);
+    }
+    //---------------------------------------------------------------------
 
 }
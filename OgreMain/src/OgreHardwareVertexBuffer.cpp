@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgreHardwareVertexBuffer.h"
 #include "OgreDefaultHardwareBufferManager.h"
+#include "OgreBitwise.h"
 
 namespace Ogre {
 
@@ -73,7 +74,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void HardwareVertexBuffer::setIsInstanceData( const bool val )
     {
-        if (val && !checkIfVertexInstanceDataIsSupported())
+        // buffers of the DefaultHardwareBufferManager are used without a render system
+        if (val && Root::getSingleton().getRenderSystem() && !checkIfVertexInstanceDataIsSupported())
         {
             OGRE_EXCEPT(Exception::ERR_RENDERINGAPI_ERROR, 
                 "vertex instance data is not supported by the render system.", 
@@ -174,7 +176,12 @@ namespace Ogre {
         case VET_BYTE4_NORM:
         case VET_UBYTE4:
         case VET_UBYTE4_NORM:
+        case VET_INT_10_10_10_2_NORM:
             return sizeof(char)*4;
+        case VET_HALF2:
+            return sizeof(uint16)*2;
+        case VET_HALF4:
+            return sizeof(uint16)*4;
         }
         return 0;
     }
@@ -201,6 +208,7 @@ namespace Ogre {
         case VET_UINT2:
         case VET_INT2:
         case VET_DOUBLE2:
+        case VET_HALF2:
             return 2;
         case VET_FLOAT3:
         case VET_SHORT3:
@@ -221,6 +229,8 @@ namespace Ogre {
         case VET_UBYTE4:
         case VET_BYTE4_NORM:
         case VET_UBYTE4_NORM:
+        case VET_INT_10_10_10_2_NORM:
+        case VET_HALF4:
             return 4;
         }
         OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Invalid type", 
@@ -271,10 +281,18 @@ namespace Ogre {
             }
             return VET_USHORT4_NORM;
 
+        case VET_HALF2:
+            if ( count <= 2 )
+            {
+                return VET_HALF2;
+            }
+            return VET_HALF4;
+
         case VET_BYTE4:
         case VET_BYTE4_NORM:
         case VET_UBYTE4:
         case VET_UBYTE4_NORM:
+        case VET_INT_10_10_10_2_NORM:
             return baseType;
 
         default:
@@ -333,6 +351,160 @@ namespace Ogre {
         };
 
     }
+    //--------------------------------------------------------------------------
+    template<typename T> static void readRaw(const void* pSrc, float* pDst, unsigned short count)
+    {
+        const T* p = static_cast<const T*>(pSrc);
+        for (unsigned short i = 0; i < count; ++i)
+            pDst[i] = float(p[i]);
+    }
+    template<typename T> static void readNorm(const void* pSrc, float* pDst, unsigned short count,
+                                              float scale)
+    {
+        // signed types map both -MAX and -MAX-1 to -1
+        const T* p = static_cast<const T*>(pSrc);
+        for (unsigned short i = 0; i < count; ++i)
+            pDst[i] = std::max(p[i] / scale, -1.0f);
+    }
+    template<typename T> static void writeRaw(const float* pSrc, void* pDst, unsigned short count)
+    {
+        T* p = static_cast<T*>(pDst);
+        for (unsigned short i = 0; i < count; ++i)
+            p[i] = static_cast<T>(std::floor(pSrc[i] + 0.5f));
+    }
+    template<typename T> static void writeNorm(const float* pSrc, void* pDst, unsigned short count,
+                                               float scale, float minValue)
+    {
+        T* p = static_cast<T*>(pDst);
+        for (unsigned short i = 0; i < count; ++i)
+            p[i] = static_cast<T>(std::floor(Math::Clamp(pSrc[i], minValue, 1.0f) * scale + 0.5f));
+    }
+    //--------------------------------------------------------------------------
+    void VertexElement::convertValue(VertexElementType srcType, const void* pSrc,
+        VertexElementType dstType, void* pDst)
+    {
+        if (srcType == dstType)
+        {
+            memcpy(pDst, pSrc, getTypeSize(srcType));
+            return;
+        }
+
+        float v[4] = {0, 0, 0, 1};
+        unsigned short count = getTypeCount(srcType);
+        switch (getBaseType(srcType))
+        {
+        case VET_FLOAT1:
+            memcpy(v, pSrc, count * sizeof(float));
+            break;
+        case VET_DOUBLE1:
+            readRaw<double>(pSrc, v, count);
+            break;
+        case VET_SHORT1:
+            readRaw<int16>(pSrc, v, count);
+            break;
+        case VET_USHORT1:
+            readRaw<uint16>(pSrc, v, count);
+            break;
+        case VET_INT1:
+            readRaw<int32>(pSrc, v, count);
+            break;
+        case VET_UINT1:
+            readRaw<uint32>(pSrc, v, count);
+            break;
+        case VET_BYTE4:
+            readRaw<int8>(pSrc, v, count);
+            break;
+        case VET_UBYTE4:
+            readRaw<uint8>(pSrc, v, count);
+            break;
+        case VET_SHORT2_NORM:
+            readNorm<int16>(pSrc, v, count, 32767.0f);
+            break;
+        case VET_USHORT2_NORM:
+            readNorm<uint16>(pSrc, v, count, 65535.0f);
+            break;
+        case VET_BYTE4_NORM:
+            readNorm<int8>(pSrc, v, count, 127.0f);
+            break;
+        case VET_UBYTE4_NORM:
+            readNorm<uint8>(pSrc, v, count, 255.0f);
+            break;
+        case VET_HALF2:
+            for (unsigned short i = 0; i < count; ++i)
+                v[i] = Bitwise::halfToFloat(static_cast<const uint16*>(pSrc)[i]);
+            break;
+        case VET_INT_10_10_10_2_NORM:
+        {
+            // x in the lowest bits, sign extended by shifting up and back down
+            uint32 packed = *static_cast<const uint32*>(pSrc);
+            for (int i = 0; i < 3; ++i)
+                v[i] = std::max((int32(packed << (22 - 10 * i)) >> 22) / 511.0f, -1.0f);
+            v[3] = std::max(float(int32(packed) >> 30), -1.0f);
+            break;
+        }
+        default:
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Cannot convert from this type",
+                        "VertexElement::convertValue");
+        }
+
+        count = getTypeCount(dstType);
+        switch (getBaseType(dstType))
+        {
+        case VET_FLOAT1:
+            memcpy(pDst, v, count * sizeof(float));
+            break;
+        case VET_DOUBLE1:
+            for (unsigned short i = 0; i < count; ++i)
+                static_cast<double*>(pDst)[i] = v[i];
+            break;
+        case VET_SHORT1:
+            writeRaw<int16>(v, pDst, count);
+            break;
+        case VET_USHORT1:
+            writeRaw<uint16>(v, pDst, count);
+            break;
+        case VET_INT1:
+            writeRaw<int32>(v, pDst, count);
+            break;
+        case VET_UINT1:
+            writeRaw<uint32>(v, pDst, count);
+            break;
+        case VET_BYTE4:
+            writeRaw<int8>(v, pDst, count);
+            break;
+        case VET_UBYTE4:
+            writeRaw<uint8>(v, pDst, count);
+            break;
+        case VET_SHORT2_NORM:
+            writeNorm<int16>(v, pDst, count, 32767.0f, -1.0f);
+            break;
+        case VET_USHORT2_NORM:
+            writeNorm<uint16>(v, pDst, count, 65535.0f, 0.0f);
+            break;
+        case VET_BYTE4_NORM:
+            writeNorm<int8>(v, pDst, count, 127.0f, -1.0f);
+            break;
+        case VET_UBYTE4_NORM:
+            writeNorm<uint8>(v, pDst, count, 255.0f, 0.0f);
+            break;
+        case VET_HALF2:
+            for (unsigned short i = 0; i < count; ++i)
+                static_cast<uint16*>(pDst)[i] = Bitwise::floatToHalf(v[i]);
+            break;
+        case VET_INT_10_10_10_2_NORM:
+        {
+            int32 c[4];
+            writeNorm<int32>(v, c, 3, 511.0f, -1.0f);
+            writeNorm<int32>(v + 3, c + 3, 1, 1.0f, -1.0f);
+            *static_cast<uint32*>(pDst) = (c[0] & 0x3FF) | (c[1] & 0x3FF) << 10 |
+                                          (c[2] & 0x3FF) << 20 | uint32(c[3] & 0x3) << 30;
+            break;
+        }
+        default:
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Cannot convert to this type",
+                        "VertexElement::convertValue");
+        }
+    }
     //-----------------------------------------------------------------------------
     VertexElementType VertexElement::getBaseType(VertexElementType multiType)
     {
@@ -388,6 +560,11 @@ namespace Ogre {
                 return VET_UBYTE4;
             case VET_UBYTE4_NORM:
                 return VET_UBYTE4_NORM;
+            case VET_INT_10_10_10_2_NORM:
+                return VET_INT_10_10_10_2_NORM;
+            case VET_HALF2:
+            case VET_HALF4:
+                return VET_HALF2;
         };
         // To keep compiler happy
         return VET_FLOAT1;
@@ -110,6 +110,13 @@ namespace Ogre
         return memSize;
     }
 
+    uint32 HighLevelGpuProgram::_getHash(uint32 seed) const
+    {
+        // the same source compiles differently with other defines
+        uint32 hash = GpuProgram::_getHash(seed);
+        return FastHash(mPreprocessorDefines.c_str(), mPreprocessorDefines.size(), hash);
+    }
+
     std::vector<std::pair<const char*, const char*>> HighLevelGpuProgram::parseDefines(String& defines)
     {
         std::vector<std::pair<const char*, const char*>> ret;
@@ -209,8 +209,9 @@ namespace Ogre {
             ResourceGroupManager::getSingleton().openResource(
                 mName, mGroup, this);
  
-        // fully prebuffer into host RAM
-        mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
+        // fully prebuffer into host RAM, unless it already is (e.g. a memory mapped file)
+        if (!dynamic_cast<MemoryDataStream*>(mFreshFromDisk.get()))
+            mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
     }
     //-----------------------------------------------------------------------
     void Mesh::unprepareImpl()
@@ -221,6 +222,8 @@ namespace Ogre {
     {
         MeshSerializer serializer;
         serializer.setListener(MeshManager::getSingleton().getListener());
+        serializer.setImportQuantisation(MeshManager::getSingleton().getImportNormalType(),
+                                         MeshManager::getSingleton().getImportTexCoordType());
 
         // If the only copy is local on the stack, it will be cleaned
         // up reliably in case of exceptions, etc
@@ -1593,7 +1596,7 @@ namespace Ogre {
                 if (!sourceElem)
                 {
                     // We're still looking for the source texture coords
-                    if (testElem->getType() == VET_FLOAT2)
+                    if (VertexElement::getTypeCount(testElem->getType()) == 2)
                     {
                         // Ok, we found it
                         sourceElem = testElem;
@@ -1849,6 +1852,402 @@ namespace Ogre {
         mEdgeListsBuilt = false;
     }
     //---------------------------------------------------------------------
+    namespace
+    {
+        const uint32 UNUSED_VERTEX = ~static_cast<uint32>(0);
+
+        /// Assigns new vertex indices in order of first use in the given index data
+        void collectFirstUse(const IndexData* indexData, std::vector<uint32>& oldToNew,
+                             std::vector<uint32>& newToOld)
+        {
+            if (!indexData->indexBuffer || indexData->indexCount == 0)
+                return;
+
+            const HardwareIndexBufferSharedPtr& ibuf = indexData->indexBuffer;
+            HardwareBufferLockGuard indexLock(ibuf, indexData->indexStart * ibuf->getIndexSize(),
+                                              indexData->indexCount * ibuf->getIndexSize(),
+                                              HardwareBuffer::HBL_READ_ONLY);
+            bool use32bit = ibuf->getType() == HardwareIndexBuffer::IT_32BIT;
+            for (size_t i = 0; i < indexData->indexCount; ++i)
+            {
+                uint32 index = use32bit ? static_cast<const uint32*>(indexLock.pData)[i]
+                                        : static_cast<const uint16*>(indexLock.pData)[i];
+                if (index < oldToNew.size() && oldToNew[index] == UNUSED_VERTEX)
+                {
+                    oldToNew[index] = static_cast<uint32>(newToOld.size());
+                    newToOld.push_back(index);
+                }
+            }
+        }
+
+        /// Rewrites all indices in the buffer which address the remapped vertex range
+        void remapIndexBuffer(HardwareIndexBuffer* ibuf, const std::vector<uint32>& oldToNew)
+        {
+            HardwareBufferLockGuard indexLock(ibuf, HardwareBuffer::HBL_NORMAL);
+            size_t count = ibuf->getNumIndexes();
+            if (ibuf->getType() == HardwareIndexBuffer::IT_32BIT)
+            {
+                uint32* indices = static_cast<uint32*>(indexLock.pData);
+                for (size_t i = 0; i < count; ++i)
+                    if (indices[i] < oldToNew.size())
+                        indices[i] = oldToNew[indices[i]];
+            }
+            else
+            {
+                uint16* indices = static_cast<uint16*>(indexLock.pData);
+                for (size_t i = 0; i < count; ++i)
+                    if (indices[i] < oldToNew.size())
+                        indices[i] = static_cast<uint16>(oldToNew[indices[i]]);
+            }
+        }
+
+        /// Moves the vertices of every buffer bound to vertexData into their new order
+        void permuteVertexData(VertexData* vertexData, const std::vector<uint32>& newToOld)
+        {
+            std::set<HardwareVertexBuffer*> done;
+            std::vector<unsigned char> scratch;
+
+            const VertexBufferBinding::VertexBufferBindingMap& bindings =
+                vertexData->vertexBufferBinding->getBindings();
+            VertexBufferBinding::VertexBufferBindingMap::const_iterator it;
+            for (it = bindings.begin(); it != bindings.end(); ++it)
+            {
+                HardwareVertexBuffer* vbuf = it->second.get();
+                if (!done.insert(vbuf).second)
+                    continue;
+
+                size_t vertexSize = vbuf->getVertexSize();
+                HardwareBufferLockGuard vertexLock(vbuf, vertexData->vertexStart * vertexSize,
+                                                   newToOld.size() * vertexSize,
+                                                   HardwareBuffer::HBL_NORMAL);
+                unsigned char* data = static_cast<unsigned char*>(vertexLock.pData);
+                scratch.assign(data, data + newToOld.size() * vertexSize);
+                for (size_t v = 0; v < newToOld.size(); ++v)
+                    memcpy(data + v * vertexSize, &scratch[newToOld[v] * vertexSize], vertexSize);
+            }
+        }
+
+        void remapBoneAssignments(Mesh::VertexBoneAssignmentList& assignments,
+                                  const std::vector<uint32>& oldToNew)
+        {
+            Mesh::VertexBoneAssignmentList remapped;
+            Mesh::VertexBoneAssignmentList::const_iterator it;
+            for (it = assignments.begin(); it != assignments.end(); ++it)
+            {
+                VertexBoneAssignment vba = it->second;
+                if (vba.vertexIndex < oldToNew.size())
+                    vba.vertexIndex = oldToNew[vba.vertexIndex];
+                remapped.insert(Mesh::VertexBoneAssignmentList::value_type(vba.vertexIndex, vba));
+            }
+            assignments.swap(remapped);
+        }
+
+        /** Sorts the vertices of vertexData by first use in the full detail geometry
+            of the given submeshes and fixes up all references to them. */
+        void sortVerticesByFirstUse(VertexData* vertexData, const std::vector<SubMesh*>& users,
+                             Mesh::VertexBoneAssignmentList& assignments)
+        {
+            size_t vertexCount = vertexData->vertexCount;
+            if (vertexCount == 0 || users.empty())
+                return;
+
+            std::vector<uint32> oldToNew(vertexCount, UNUSED_VERTEX);
+            std::vector<uint32> newToOld;
+            newToOld.reserve(vertexCount);
+            for (size_t i = 0; i < users.size(); ++i)
+                collectFirstUse(users[i]->indexData, oldToNew, newToOld);
+
+            // Keep vertices no face refers to at the end
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                if (oldToNew[v] == UNUSED_VERTEX)
+                {
+                    oldToNew[v] = static_cast<uint32>(newToOld.size());
+                    newToOld.push_back(static_cast<uint32>(v));
+                }
+            }
+
+            bool identity = true;
+            for (size_t v = 0; v < vertexCount && identity; ++v)
+                identity = newToOld[v] == v;
+            if (identity)
+                return;
+
+            std::set<HardwareIndexBuffer*> indexBuffers;
+            for (size_t i = 0; i < users.size(); ++i)
+            {
+                if (users[i]->indexData->indexBuffer)
+                    indexBuffers.insert(users[i]->indexData->indexBuffer.get());
+                for (size_t l = 0; l < users[i]->mLodFaceList.size(); ++l)
+                {
+                    if (users[i]->mLodFaceList[l]->indexBuffer)
+                        indexBuffers.insert(users[i]->mLodFaceList[l]->indexBuffer.get());
+                }
+            }
+
+            std::set<HardwareIndexBuffer*>::iterator ib;
+            for (ib = indexBuffers.begin(); ib != indexBuffers.end(); ++ib)
+                remapIndexBuffer(*ib, oldToNew);
+
+            permuteVertexData(vertexData, newToOld);
+            remapBoneAssignments(assignments, oldToNew);
+        }
+
+        bool isInUnitRange(const VertexData* vertexData, const VertexElement& elem)
+        {
+            const HardwareVertexBufferSharedPtr& vbuf =
+                vertexData->vertexBufferBinding->getBuffer(elem.getSource());
+            HardwareBufferLockGuard vertexLock(vbuf, HardwareBuffer::HBL_READ_ONLY);
+            unsigned char* pBase = static_cast<unsigned char*>(vertexLock.pData);
+            size_t count = VertexElement::getTypeCount(elem.getType());
+            for (size_t v = 0; v < vbuf->getNumVertices(); ++v, pBase += vbuf->getVertexSize())
+            {
+                float* pFloat;
+                elem.baseVertexPointerToElement(pBase, &pFloat);
+                for (size_t c = 0; c < count; ++c)
+                {
+                    if (pFloat[c] < 0 || pFloat[c] > 1)
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        /** Changes the element types of vertexData to the given ones, in declaration order.
+            Only the buffers containing a changed element are recreated, with their elements
+            packed in the original order. */
+        void convertElementTypes(VertexData* vertexData, const std::vector<VertexElementType>& types,
+                                 HardwareBufferManagerBase* mgr)
+        {
+            VertexDeclaration* decl = vertexData->vertexDeclaration;
+            const VertexBufferBinding::VertexBufferBindingMap& bindings =
+                vertexData->vertexBufferBinding->getBindings();
+            VertexBufferBinding::VertexBufferBindingMap::const_iterator it;
+            for (it = bindings.begin(); it != bindings.end(); ++it)
+            {
+                // copy, as the declaration is modified below
+                const VertexDeclaration::VertexElementList oldElems = decl->getElements();
+                std::vector<std::pair<size_t, unsigned short> > elems; // (offset, element index)
+                bool changed = false;
+                VertexDeclaration::VertexElementList::const_iterator e = oldElems.begin();
+                for (unsigned short i = 0; e != oldElems.end(); ++e, ++i)
+                {
+                    if (e->getSource() != it->first)
+                        continue;
+                    elems.push_back(std::make_pair(e->getOffset(), i));
+                    changed = changed || types[i] != e->getType();
+                }
+                if (!changed)
+                    continue;
+                std::sort(elems.begin(), elems.end());
+
+                std::vector<const VertexElement*> srcElems;
+                std::vector<VertexElement> newElems;
+                size_t vertexSize = 0;
+                for (size_t i = 0; i < elems.size(); ++i)
+                {
+                    e = oldElems.begin();
+                    std::advance(e, elems[i].second);
+                    srcElems.push_back(&*e);
+                    newElems.push_back(VertexElement(it->first, vertexSize, types[elems[i].second],
+                                                     e->getSemantic(), e->getIndex()));
+                    vertexSize += newElems.back().getSize();
+                }
+
+                const HardwareVertexBufferSharedPtr& srcBuf = it->second;
+                HardwareVertexBufferSharedPtr dstBuf =
+                    mgr->createVertexBuffer(vertexSize, srcBuf->getNumVertices(), srcBuf->getUsage(),
+                                            srcBuf->hasShadowBuffer());
+                {
+                    HardwareBufferLockGuard srcLock(srcBuf, HardwareBuffer::HBL_READ_ONLY);
+                    HardwareBufferLockGuard dstLock(dstBuf, HardwareBuffer::HBL_DISCARD);
+                    unsigned char* pSrc = static_cast<unsigned char*>(srcLock.pData);
+                    unsigned char* pDst = static_cast<unsigned char*>(dstLock.pData);
+                    for (size_t v = 0; v < srcBuf->getNumVertices(); ++v)
+                    {
+                        for (size_t i = 0; i < elems.size(); ++i)
+                        {
+                            void *pSrcElem, *pDstElem;
+                            srcElems[i]->baseVertexPointerToElement(pSrc, &pSrcElem);
+                            newElems[i].baseVertexPointerToElement(pDst, &pDstElem);
+                            VertexElement::convertValue(srcElems[i]->getType(), pSrcElem,
+                                                        newElems[i].getType(), pDstElem);
+                        }
+                        pSrc += srcBuf->getVertexSize();
+                        pDst += vertexSize;
+                    }
+                }
+
+                for (size_t i = 0; i < elems.size(); ++i)
+                {
+                    const VertexElement& elem = newElems[i];
+                    decl->modifyElement(elems[i].second, elem.getSource(), elem.getOffset(),
+                                        elem.getType(), elem.getSemantic(), elem.getIndex());
+                }
+                // replaces the entry 'it' points at, the map itself is unchanged
+                vertexData->vertexBufferBinding->setBinding(it->first, dstBuf);
+            }
+        }
+
+        /// Whether the current render system can read the type, true without one
+        bool isVertexTypeSupported(VertexElementType type)
+        {
+            RenderSystem* rs = Root::getSingletonPtr() ? Root::getSingleton().getRenderSystem() : NULL;
+            const RenderSystemCapabilities* caps = rs ? rs->getCapabilities() : NULL;
+            if (!caps)
+                return true; // e.g. converting offline
+            switch (type)
+            {
+            case VET_INT_10_10_10_2_NORM:
+                return caps->hasCapability(RSC_VERTEX_FORMAT_INT_10_10_10_2);
+            case VET_HALF2:
+            case VET_HALF4:
+                return caps->hasCapability(RSC_VERTEX_FORMAT_HALF);
+            default:
+                return true;
+            }
+        }
+
+        void quantiseVertexElements(VertexData* vertexData, VertexElementType normalType,
+                                VertexElementType texCoordType, HardwareBufferManagerBase* mgr)
+        {
+            const VertexDeclaration::VertexElementList& elems =
+                vertexData->vertexDeclaration->getElements();
+            std::vector<VertexElementType> types;
+            VertexDeclaration::VertexElementList::const_iterator e;
+            for (e = elems.begin(); e != elems.end(); ++e)
+            {
+                VertexElementType type = e->getType();
+                switch (e->getSemantic())
+                {
+                case VES_NORMAL:
+                case VES_BINORMAL:
+                case VES_TANGENT:
+                    // keeps the parity of 4D tangents
+                    if ((type == VET_FLOAT3 || type == VET_FLOAT4) &&
+                        VertexElement::getTypeCount(normalType) >= VertexElement::getTypeCount(type))
+                        type = normalType;
+                    break;
+                case VES_TEXTURE_COORDINATES:
+                    if (type == VET_FLOAT2)
+                    {
+                        type = texCoordType;
+                        if (type == VET_USHORT2_NORM && !isInUnitRange(vertexData, *e))
+                            type = VET_HALF2;
+                    }
+                    break;
+                default:
+                    break;
+                }
+                if (!isVertexTypeSupported(type))
+                    type = e->getType();
+                types.push_back(type);
+            }
+            convertElementTypes(vertexData, types, mgr);
+        }
+    }
+    //---------------------------------------------------------------------
+    void Mesh::optimiseVertexCache(bool reorderVertices)
+    {
+        bool rebuildEdgeList = mEdgeListsBuilt;
+        freeEdgeList();
+
+        // Compressed LOD levels share one index buffer between several ranges,
+        // reordering one of those would break the other
+        std::map<HardwareIndexBuffer*, size_t> bufferUsers;
+        SubMeshList::iterator i;
+        for (i = mSubMeshList.begin(); i != mSubMeshList.end(); ++i)
+        {
+            ++bufferUsers[(*i)->indexData->indexBuffer.get()];
+            for (size_t l = 0; l < (*i)->mLodFaceList.size(); ++l)
+                ++bufferUsers[(*i)->mLodFaceList[l]->indexBuffer.get()];
+        }
+
+        for (i = mSubMeshList.begin(); i != mSubMeshList.end(); ++i)
+        {
+            SubMesh* sm = *i;
+            if (sm->operationType != RenderOperation::OT_TRIANGLE_LIST)
+                continue;
+
+            if (sm->indexData->indexBuffer && bufferUsers[sm->indexData->indexBuffer.get()] == 1)
+            {
+                if (sm->meshlets.empty())
+                {
+                    sm->indexData->optimiseVertexCacheTriList();
+                }
+                else
+                {
+                    // keep the triangles inside of their meshlet
+                    IndexData range;
+                    range.indexBuffer = sm->indexData->indexBuffer;
+                    for (size_t m = 0; m < sm->meshlets.size(); ++m)
+                    {
+                        range.indexStart = sm->meshlets[m].indexStart;
+                        range.indexCount = sm->meshlets[m].indexCount;
+                        range.optimiseVertexCacheTriList();
+                    }
+                }
+            }
+            for (size_t l = 0; l < sm->mLodFaceList.size(); ++l)
+            {
+                IndexData* lodData = sm->mLodFaceList[l];
+                if (lodData->indexBuffer && bufferUsers[lodData->indexBuffer.get()] == 1)
+                    lodData->optimiseVertexCacheTriList();
+            }
+        }
+
+        if (reorderVertices && !hasVertexAnimation() && mPoseList.empty() && !mPreparedForShadowVolumes)
+        {
+            std::vector<SubMesh*> sharedUsers;
+            for (i = mSubMeshList.begin(); i != mSubMeshList.end(); ++i)
+            {
+                if ((*i)->useSharedVertices)
+                {
+                    sharedUsers.push_back(*i);
+                }
+                else if ((*i)->vertexData)
+                {
+                    std::vector<SubMesh*> users(1, *i);
+                    sortVerticesByFirstUse((*i)->vertexData, users, (*i)->mBoneAssignments);
+                }
+            }
+
+            if (sharedVertexData)
+                sortVerticesByFirstUse(sharedVertexData, sharedUsers, mBoneAssignments);
+        }
+
+        if (rebuildEdgeList)
+            buildEdgeList();
+    }
+    //---------------------------------------------------------------------
+    void Mesh::quantiseVertexData(VertexElementType normalType, VertexElementType texCoordType)
+    {
+        OgreAssert(VertexElement::getTypeCount(normalType) >= 3, "normalType needs 3 components");
+        OgreAssert(VertexElement::getTypeCount(texCoordType) == 2, "texCoordType needs 2 components");
+
+        // morph and pose animation accumulate float normals
+        _determineAnimationTypes();
+        bool poseNormals = false;
+        for (PoseList::iterator p = mPoseList.begin(); p != mPoseList.end(); ++p)
+            poseNormals = poseNormals || !(*p)->getNormals().empty();
+
+        if (sharedVertexData)
+        {
+            bool keepNormals = poseNormals || mSharedVertexDataAnimationIncludesNormals;
+            quantiseVertexElements(sharedVertexData, keepNormals ? VET_FLOAT3 : normalType,
+                                   texCoordType, getHardwareBufferManager());
+        }
+        for (SubMeshList::iterator i = mSubMeshList.begin(); i != mSubMeshList.end(); ++i)
+        {
+            SubMesh* sm = *i;
+            if (sm->useSharedVertices || !sm->vertexData)
+                continue;
+            bool keepNormals = poseNormals || sm->getVertexAnimationIncludesNormals();
+            quantiseVertexElements(sm->vertexData, keepNormals ? VET_FLOAT3 : normalType,
+                                   texCoordType, getHardwareBufferManager());
+        }
+    }
+    //---------------------------------------------------------------------
     void Mesh::prepareForShadowVolume(void)
     {
         if (mPreparedForShadowVolumes)
@@ -2025,16 +2424,44 @@ namespace Ogre {
             destElemNorm->baseVertexPointerToElement(destNormBuf != destPosBuf ? destNormLock.pData : destPosLock.pData, &pDestNorm);
         }
 
+        // The skinning kernels work on floats, packed normals (see quantiseVertexData)
+        // go through temporary float copies
+        size_t vertexCount = targetVertexData->vertexCount;
+        std::vector<float> srcNormals, destNormals;
+        if (includeNormals && srcElemNorm->getType() != VET_FLOAT3)
+        {
+            srcNormals.resize(vertexCount * 3);
+            const unsigned char* pSrc = reinterpret_cast<const unsigned char*>(pSrcNorm);
+            for (size_t v = 0; v < vertexCount; ++v, pSrc += srcNormStride)
+                VertexElement::convertValue(srcElemNorm->getType(), pSrc, VET_FLOAT3, &srcNormals[v * 3]);
+            pSrcNorm = &srcNormals[0];
+            srcNormStride = sizeof(float) * 3;
+        }
+        float* pPackedDestNorm = 0;
+        if (includeNormals && destElemNorm->getType() != VET_FLOAT3)
+        {
+            destNormals.resize(vertexCount * 3);
+            pPackedDestNorm = pDestNorm;
+            pDestNorm = &destNormals[0];
+        }
+
         OptimisedUtil::getImplementation()->softwareVertexSkinning(
             pSrcPos, pDestPos,
             pSrcNorm, pDestNorm,
             pBlendWeight, pBlendIdx,
             blendMatrices,
             srcPosStride, destPosStride,
-            srcNormStride, destNormStride,
+            srcNormStride, pPackedDestNorm ? sizeof(float) * 3 : destNormStride,
             blendWeightStride, blendIdxStride,
             numWeightsPerVertex,
-            targetVertexData->vertexCount);
+            vertexCount);
+
+        if (pPackedDestNorm)
+        {
+            unsigned char* pDest = reinterpret_cast<unsigned char*>(pPackedDestNorm);
+            for (size_t v = 0; v < vertexCount; ++v, pDest += destNormStride)
+                VertexElement::convertValue(VET_FLOAT3, &destNormals[v * 3], destElemNorm->getType(), pDest);
+        }
     }
     //---------------------------------------------------------------------
     void Mesh::softwareVertexMorph(Real t,
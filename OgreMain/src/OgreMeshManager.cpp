@@ -44,7 +44,8 @@ namespace Ogre
     }
     //-----------------------------------------------------------------------
     MeshManager::MeshManager():
-    mBoundsPaddingFactor(0.01), mListener(0)
+    mBoundsPaddingFactor(0.01), mListener(0), mImportNormalType(VET_FLOAT3),
+    mImportTexCoordType(VET_FLOAT2)
     {
         mBlendWeightsBaseElementType = VET_FLOAT1;
         mPrepAllMeshesForShadowVolumes = false;
@@ -343,6 +344,13 @@ namespace Ogre
     {
         return mListener;
     }
+    //-------------------------------------------------------------------------
+    void MeshManager::setImportQuantisation(VertexElementType normalType,
+                                            VertexElementType texCoordType)
+    {
+        mImportNormalType = normalType;
+        mImportTexCoordType = texCoordType;
+    }
     //-----------------------------------------------------------------------
     void MeshManager::PrefabLoader::loadResource(Resource* res)
     {
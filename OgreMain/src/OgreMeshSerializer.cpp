@@ -47,18 +47,26 @@ namespace Ogre {
     const unsigned short HEADER_CHUNK_ID = 0x1000;
     //---------------------------------------------------------------------
     MeshSerializer::MeshSerializer()
-        :mListener(0)
+        :mListener(0), mImportNormalType(VET_FLOAT3), mImportTexCoordType(VET_FLOAT2)
     {
         // Init implementations
         // String identifiers have not always been 100% unified with OGRE version
         
         // Note MUST be added in reverse order so latest is first in the list
 
+        mVersionData.push_back(OGRE_NEW MeshVersionData(
+            MESH_VERSION_1_12, "[MeshSerializer_v1.120]",
+            OGRE_NEW MeshSerializerImpl()));
+
+        mVersionData.push_back(OGRE_NEW MeshVersionData(
+            MESH_VERSION_1_11, "[MeshSerializer_v1.110]",
+            OGRE_NEW MeshSerializerImpl_v1_11()));
+
         // This one is a little ugly, 1.10 is used for version 1.1 legacy meshes.
         // So bump up to 1.100
         mVersionData.push_back(OGRE_NEW MeshVersionData(
             MESH_VERSION_1_10, "[MeshSerializer_v1.100]", 
-            OGRE_NEW MeshSerializerImpl()));
+            OGRE_NEW MeshSerializerImpl_v1_10()));
 
         mVersionData.push_back(OGRE_NEW MeshVersionData(
             MESH_VERSION_1_8, "[MeshSerializer_v1.8]", 
@@ -200,6 +208,9 @@ namespace Ogre {
                 " using the OgreMeshUpgrade tool.");
         }
 
+        if (mImportNormalType != VET_FLOAT3 || mImportTexCoordType != VET_FLOAT2)
+            pDest->quantiseVertexData(mImportNormalType, mImportTexCoordType);
+
         if(mListener)
             mListener->processMeshCompleted(pDest);
     }
@@ -213,5 +224,12 @@ namespace Ogre {
     {
         return mListener;
     }
+    //-------------------------------------------------------------------------
+    void MeshSerializer::setImportQuantisation(VertexElementType normalType,
+                                               VertexElementType texCoordType)
+    {
+        mImportNormalType = normalType;
+        mImportTexCoordType = texCoordType;
+    }
 }
 
@@ -33,6 +33,7 @@ THE SOFTWARE.
 #include "OgreAnimationTrack.h"
 #include "OgreLodStrategyManager.h"
 #include "OgreDistanceLodStrategy.h"
+#include "OgreWorkQueue.h"
 
 #if OGRE_COMPILER == OGRE_COMPILER_MSVC
 // Disable conversion warnings, we do a lot of them, intentionally
@@ -48,7 +49,8 @@ namespace Ogre {
     MeshSerializerImpl::MeshSerializerImpl()
     {
         // Version number
-        mVersion = "[MeshSerializer_v1.100]";
+        mVersion = "[MeshSerializer_v1.120]";
+        mDataAlignment = 16;
     }
     //---------------------------------------------------------------------
     MeshSerializerImpl::~MeshSerializerImpl()
@@ -205,6 +207,9 @@ namespace Ogre {
 
         // Write submesh extremes
         writeExtremes(pMesh);
+
+        // Write submesh meshlets
+        writeMeshlets(pMesh);
             popInnerChunk(mStream);
         }
     }
@@ -258,6 +263,7 @@ namespace Ogre {
             // unsigned short* faceVertexIndices ((indexCount)
             HardwareIndexBufferSharedPtr ibuf = s->indexData->indexBuffer;
             HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::HBL_READ_ONLY);
+            uint8 padding = writeDataPadding();
             if (idx32bit)
             {
                 unsigned int* pIdx32 = static_cast<unsigned int*>(ibufLock.pData);
@@ -268,6 +274,7 @@ namespace Ogre {
                 unsigned short* pIdx16 = static_cast<unsigned short*>(ibufLock.pData);
                 writeShorts(pIdx16, s->indexData->indexCount);
             }
+            writeDataPaddingEnd(padding);
         }
 
         pushInnerChunk(mStream);
@@ -358,6 +365,55 @@ namespace Ogre {
         return MSTREAM_OVERHEAD_SIZE + sizeof (unsigned short) +
             s->extremityPoints.size() * sizeof (float)* 3;
     }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeMeshlets(const Mesh *pMesh)
+    {
+        for (unsigned short i = 0; i < pMesh->getNumSubMeshes(); ++i)
+        {
+            const SubMesh *sm = pMesh->getSubMesh(i);
+            if (!sm->meshlets.empty())
+                writeSubMeshMeshlets(i, sm);
+        }
+    }
+    //---------------------------------------------------------------------
+    size_t MeshSerializerImpl::calcMeshletsSize(const Mesh* pMesh)
+    {
+        size_t size = 0;
+        for (unsigned short i = 0; i < pMesh->getNumSubMeshes(); ++i)
+        {
+            const SubMesh *sm = pMesh->getSubMesh(i);
+            if (!sm->meshlets.empty())
+                size += calcSubMeshMeshletsSize(i, sm);
+        }
+        return size;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeSubMeshMeshlets(unsigned short idx, const SubMesh* s)
+    {
+        writeChunkHeader(M_TABLE_MESHLETS, calcSubMeshMeshletsSize(idx, s));
+
+        writeShorts(&idx, 1);
+        uint32 count = static_cast<uint32>(s->meshlets.size());
+        writeInts(&count, 1);
+
+        for (SubMesh::MeshletList::const_iterator i = s->meshlets.begin(); i != s->meshlets.end(); ++i)
+        {
+            writeInts(&i->indexStart, 1);
+            writeInts(&i->indexCount, 1);
+            writeObject(i->center);
+            writeFloats(&i->radius, 1);
+            writeObject(i->coneAxis);
+            writeFloats(&i->coneCutoff, 1);
+        }
+    }
+    //---------------------------------------------------------------------
+    size_t MeshSerializerImpl::calcSubMeshMeshletsSize(unsigned short idx, const SubMesh* s)
+    {
+        // indexStart, indexCount, center, radius, coneAxis, coneCutoff
+        size_t meshletSize = sizeof(uint32) * 2 + sizeof(float) * 8;
+        return MSTREAM_OVERHEAD_SIZE + sizeof(unsigned short) + sizeof(uint32) +
+            s->meshlets.size() * meshletSize;
+    }
 
 
     //---------------------------------------------------------------------
@@ -451,7 +507,7 @@ namespace Ogre {
         {
             const HardwareVertexBufferSharedPtr& vbuf = vbi->second;
             size_t vbufSizeInBytes = vbuf->getVertexSize() * vertexData->vertexCount; // vbuf->getSizeInBytes() is too large for meshes prepared for shadow volumes
-            size = (MSTREAM_OVERHEAD_SIZE * 2) + (sizeof(unsigned short) * 2) + vbufSizeInBytes;
+            size = (MSTREAM_OVERHEAD_SIZE * 2) + (sizeof(unsigned short) * 2) + vbufSizeInBytes + calcDataPaddingSize();
             writeChunkHeader(M_GEOMETRY_VERTEX_BUFFER,  size);
             // unsigned short bindIndex;    // Index to bind this buffer to
                 unsigned short tmp = vbi->first;
@@ -462,9 +518,10 @@ namespace Ogre {
                 pushInnerChunk(mStream);
                 {
             // Data
-            size = MSTREAM_OVERHEAD_SIZE + vbufSizeInBytes;
+            size = MSTREAM_OVERHEAD_SIZE + vbufSizeInBytes + calcDataPaddingSize();
             writeChunkHeader(M_GEOMETRY_VERTEX_BUFFER_DATA, size);
             HardwareBufferLockGuard vbufLock(vbuf, HardwareBuffer::HBL_READ_ONLY);
+            uint8 padding = writeDataPadding();
 
             if (mFlipEndian)
             {
@@ -484,6 +541,7 @@ namespace Ogre {
             {
                 writeData(vbufLock.pData, vbuf->getVertexSize(), vertexData->vertexCount);
             }
+            writeDataPaddingEnd(padding);
         }
                 popInnerChunk(mStream);
             }
@@ -568,6 +626,8 @@ namespace Ogre {
 
         size += calcExtremesSize(pMesh);
 
+        size += calcMeshletsSize(pMesh);
+
         return size;
     }
     //---------------------------------------------------------------------
@@ -592,6 +652,8 @@ namespace Ogre {
             size += sizeof(unsigned int) * pSub->indexData->indexCount;
         else
             size += sizeof(unsigned short) * pSub->indexData->indexCount;
+        if (pSub->indexData->indexCount > 0)
+            size += calcDataPaddingSize();
 
         // Geometry
         if (!pSub->useSharedVertices)
@@ -651,7 +713,7 @@ namespace Ogre {
         size += MSTREAM_OVERHEAD_SIZE + elemList.size() * (MSTREAM_OVERHEAD_SIZE + sizeof(unsigned short)* 5);
         
         // Buffers and bindings
-        size += bindings.size() * ((MSTREAM_OVERHEAD_SIZE * 2) + (sizeof(unsigned short)* 2));
+        size += bindings.size() * ((MSTREAM_OVERHEAD_SIZE * 2) + (sizeof(unsigned short)* 2) + calcDataPaddingSize());
 
         // Buffer data
         VertexBufferBinding::VertexBufferBindingMap::const_iterator vbi, vbiend;
@@ -812,15 +874,20 @@ namespace Ogre {
             dest->vertexCount,
             pMesh->mVertexBufferUsage,
             pMesh->mVertexBufferShadowBuffer);
-        HardwareBufferLockGuard vbufLock(vbuf, HardwareBuffer::HBL_DISCARD);
-        stream->read(vbufLock.pData, dest->vertexCount * vertexSize);
-
-        // endian conversion for OSX
-        flipFromLittleEndian(
-            vbufLock.pData,
-            dest->vertexCount,
-            vertexSize,
-            dest->vertexDeclaration->findElementsBySource(bindIndex));
+        uint8 padding = readDataPadding(stream);
+        if (!readBufferData(stream, vbuf.get(), dest->vertexCount * vertexSize))
+        {
+            HardwareBufferLockGuard vbufLock(vbuf, HardwareBuffer::HBL_DISCARD);
+            stream->read(vbufLock.pData, dest->vertexCount * vertexSize);
+
+            // endian conversion for OSX
+            flipFromLittleEndian(
+                vbufLock.pData,
+                dest->vertexCount,
+                vertexSize,
+                dest->vertexDeclaration->findElementsBySource(bindIndex));
+        }
+        readDataPaddingEnd(stream, padding);
 
         // Set binding
         dest->vertexBufferBinding->setBinding(bindIndex, vbuf);
@@ -908,7 +975,8 @@ namespace Ogre {
                  streamID == M_EDGE_LISTS ||
                  streamID == M_POSES ||
                  streamID == M_ANIMATIONS ||
-                 streamID == M_TABLE_EXTREMES))
+                 streamID == M_TABLE_EXTREMES ||
+                 streamID == M_TABLE_MESHLETS))
             {
                 switch(streamID)
                 {
@@ -956,6 +1024,9 @@ namespace Ogre {
                 case M_TABLE_EXTREMES:
                     readExtremes(stream, pMesh);
                     break;
+                case M_TABLE_MESHLETS:
+                    readMeshlets(stream, pMesh);
+                    break;
                 }
 
                 if (!stream->eof())
@@ -1000,27 +1071,21 @@ namespace Ogre {
         readBools(stream, &idx32bit, 1);
         if (indexCount > 0)
         {
-            if (idx32bit)
-            {
-                ibuf = pMesh->getHardwareBufferManager()->createIndexBuffer(
-                        HardwareIndexBuffer::IT_32BIT,
-                        sm->indexData->indexCount,
-                        pMesh->mIndexBufferUsage,
-                        pMesh->mIndexBufferShadowBuffer);
-                HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::HBL_DISCARD);
-                readInts(stream, static_cast<unsigned int*>(ibufLock.pData), sm->indexData->indexCount);
-
-            }
-            else // 16-bit
+            ibuf = pMesh->getHardwareBufferManager()->createIndexBuffer(
+                    idx32bit ? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT,
+                    sm->indexData->indexCount,
+                    pMesh->mIndexBufferUsage,
+                    pMesh->mIndexBufferShadowBuffer);
+            uint8 padding = readDataPadding(stream);
+            if (!readBufferData(stream, ibuf.get(), ibuf->getSizeInBytes()))
             {
-                ibuf = pMesh->getHardwareBufferManager()->createIndexBuffer(
-                        HardwareIndexBuffer::IT_16BIT,
-                        sm->indexData->indexCount,
-                        pMesh->mIndexBufferUsage,
-                        pMesh->mIndexBufferShadowBuffer);
                 HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::HBL_DISCARD);
-                readShorts(stream, static_cast<unsigned short*>(ibufLock.pData), sm->indexData->indexCount);
+                if (idx32bit)
+                    readInts(stream, static_cast<unsigned int*>(ibufLock.pData), sm->indexData->indexCount);
+                else // 16-bit
+                    readShorts(stream, static_cast<unsigned short*>(ibufLock.pData), sm->indexData->indexCount);
             }
+            readDataPaddingEnd(stream, padding);
         }
         sm->indexData->indexBuffer = ibuf;
 
@@ -1263,16 +1328,13 @@ namespace Ogre {
 
             if (bufIndexCount > 0)
             {
+                HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::HBL_READ_ONLY);
+                uint8 padding = writeDataPadding();
                 if (is32BitIndices)
-                {
-                    HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::HBL_READ_ONLY);
                     writeInts(static_cast<unsigned int*>(ibufLock.pData), bufIndexCount);
-                }
                 else
-                {
-                    HardwareBufferLockGuard ibufLock(ibuf, HardwareBuffer::HBL_READ_ONLY);
                     writeShorts(static_cast<unsigned short*>(ibufLock.pData), bufIndexCount);
-                }
+                writeDataPaddingEnd(padding);
             }
         }
     }
@@ -1355,6 +1417,8 @@ namespace Ogre {
             size += sizeof(bool); // bool indexes32Bit
             size += sizeof(unsigned int); // unsigned int ibuf->getNumIndexes()
             size += !ibuf ? 0 : static_cast<unsigned long>(ibuf->getIndexSize() * ibuf->getNumIndexes()); // faces
+            if (ibuf && ibuf->getNumIndexes() > 0)
+                size += calcDataPaddingSize();
         }
         return size;
     }
@@ -1574,20 +1638,99 @@ namespace Ogre {
                 indexData->indexBuffer = pMesh->getHardwareBufferManager()->createIndexBuffer(
                     idx32Bit ? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT,
                     buffIndexCount, pMesh->mIndexBufferUsage, pMesh->mIndexBufferShadowBuffer);
-                HardwareBufferLockGuard ibufLock(indexData->indexBuffer, HardwareBuffer::HBL_DISCARD);
-
-                if (idx32Bit)
-                {
-                    readInts(stream, (uint32*)ibufLock.pData, buffIndexCount);
-                }
-                else
+                if (buffIndexCount > 0)
                 {
-                    readShorts(stream, (uint16*)ibufLock.pData, buffIndexCount);
+                    uint8 padding = readDataPadding(stream);
+                    if (!readBufferData(stream, indexData->indexBuffer.get(), indexData->indexBuffer->getSizeInBytes()))
+                    {
+                        HardwareBufferLockGuard ibufLock(indexData->indexBuffer, HardwareBuffer::HBL_DISCARD);
+                        if (idx32Bit)
+                            readInts(stream, (uint32*)ibufLock.pData, buffIndexCount);
+                        else
+                            readShorts(stream, (uint16*)ibufLock.pData, buffIndexCount);
+                    }
+                    readDataPaddingEnd(stream, padding);
                 }
             }
         }
     }
 #endif
+    //---------------------------------------------------------------------
+    uint8 MeshSerializerImpl::writeDataPadding()
+    {
+        if (!mDataAlignment)
+            return 0;
+
+        // uint8 padding, followed by padding zero bytes, so that the data starts aligned
+        static const uchar zeros[256] = {0};
+        uint8 padding = uint8((mDataAlignment - (mStream->tell() + 1) % mDataAlignment) % mDataAlignment);
+        writeData(&padding, 1, 1);
+        writeData(zeros, 1, padding);
+        return padding;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::writeDataPaddingEnd(uint8 padding)
+    {
+        if (!mDataAlignment)
+            return;
+
+        // pad to a total of mDataAlignment bytes, so the chunk sizes do not depend on the position
+        static const uchar zeros[256] = {0};
+        writeData(zeros, 1, mDataAlignment - 1 - padding);
+    }
+    //---------------------------------------------------------------------
+    uint8 MeshSerializerImpl::readDataPadding(DataStreamPtr& stream)
+    {
+        if (!mDataAlignment)
+            return 0;
+
+        uint8 padding;
+        stream->read(&padding, 1);
+        stream->skip(padding);
+        return padding;
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::readDataPaddingEnd(DataStreamPtr& stream, uint8 padding)
+    {
+        if (mDataAlignment)
+            stream->skip(mDataAlignment - 1 - padding);
+    }
+    //---------------------------------------------------------------------
+    bool MeshSerializerImpl::readBufferData(DataStreamPtr& stream, HardwareBuffer* buf, size_t size)
+    {
+        // Already in host memory, so hand the data to the buffer without
+        // an intermediate copy through a locked buffer
+        MemoryDataStream* memStream = dynamic_cast<MemoryDataStream*>(stream.get());
+        if (!memStream || mFlipEndian || memStream->size() - memStream->tell() < size)
+            return false;
+
+        buf->writeData(0, size, memStream->getCurrentPtr(), true);
+        stream->skip(size);
+        return true;
+    }
+    //---------------------------------------------------------------------
+    bool MeshSerializerImpl::canReadChunksParallel(const DataStreamPtr& stream) const
+    {
+        // Chunks are read through views of the memory, which is what Mesh::load provides
+        Root* root = Root::getSingletonPtr();
+        return root && root->getWorkQueue() && dynamic_cast<MemoryDataStream*>(stream.get());
+    }
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::readChunksParallel(DataStreamPtr& stream, const ChunkList& chunks,
+        const std::function<void(MeshSerializerImpl&, DataStreamPtr&, size_t)>& func)
+    {
+        uchar* data = static_cast<MemoryDataStream*>(stream.get())->getPtr();
+        Root::getSingleton().getWorkQueue()->parallelFor(chunks.size(), [&](size_t i) {
+            // The chunk tracking state of a serializer must not be shared between threads
+            std::unique_ptr<MeshSerializerImpl> worker(clone());
+#if OGRE_SERIALIZER_VALIDATE_CHUNKSIZE
+            worker->mChunkSizeStack.clear();
+#endif
+
+            DataStreamPtr chunk(OGRE_NEW MemoryDataStream(data + chunks[i].first, chunks[i].second));
+            func(*worker, chunk, i);
+        });
+    }
     //---------------------------------------------------------------------
     void MeshSerializerImpl::flipFromLittleEndian(void* pData, size_t vertexCount,
         size_t vertexSize, const VertexDeclaration::VertexElementList& elems)
@@ -1622,6 +1765,7 @@ namespace Ogre {
                 (*ei).baseVertexPointerToElement(pBase, &pElem);
                 // Flip the endian based on the type
                 size_t typeSize = 0;
+                size_t typeCount = VertexElement::getTypeCount((*ei).getType());
                 switch (VertexElement::getBaseType((*ei).getType()))
                 {
                     case VET_FLOAT1:
@@ -1631,11 +1775,21 @@ namespace Ogre {
                         typeSize = sizeof(double);
                         break;
                     case VET_SHORT1:
+                    case VET_SHORT2_NORM:
                         typeSize = sizeof(short);
                         break;
                     case VET_USHORT1:
+                    case VET_USHORT2_NORM:
                         typeSize = sizeof(unsigned short);
                         break;
+                    case VET_HALF2:
+                        typeSize = sizeof(uint16);
+                        break;
+                    case VET_INT_10_10_10_2_NORM:
+                        // all components are packed into a single 32 bit value
+                        typeSize = sizeof(uint32);
+                        typeCount = 1;
+                        break;
                     case VET_INT1:
                         typeSize = sizeof(int);
                         break;
@@ -1648,13 +1802,15 @@ namespace Ogre {
                         typeSize = sizeof(RGBA);
                         break;
                     case VET_UBYTE4:
+                    case VET_UBYTE4_NORM:
+                    case VET_BYTE4:
+                    case VET_BYTE4_NORM:
                         typeSize = 0; // NO FLIPPING
                         break;
                     default:
                         assert(false); // Should never happen
                 };
-				Bitwise::bswapChunks(pElem, typeSize,
-                    VertexElement::getTypeCount((*ei).getType()));
+				Bitwise::bswapChunks(pElem, typeSize, typeCount);
 
             }
 
@@ -1855,8 +2011,42 @@ namespace Ogre {
         popInnerChunk(mStream);
     }
     //---------------------------------------------------------------------
+    static void resolveEdgeGroupVertexData(Mesh* pMesh, EdgeData* edgeData)
+    {
+        // Postprocessing edge groups
+        EdgeData::EdgeGroupList::iterator egi, egend;
+        egend = edgeData->edgeGroups.end();
+        for (egi = edgeData->edgeGroups.begin(); egi != egend; ++egi)
+        {
+            EdgeData::EdgeGroup& edgeGroup = *egi;
+            // Populate edgeGroup.vertexData pointers
+            // If there is shared vertex data, vertexSet 0 is that,
+            // otherwise 0 is first dedicated
+            if (pMesh->sharedVertexData)
+            {
+                if (edgeGroup.vertexSet == 0)
+                {
+                    edgeGroup.vertexData = pMesh->sharedVertexData;
+                }
+                else
+                {
+                    edgeGroup.vertexData = pMesh->getSubMesh(
+                        (unsigned short)edgeGroup.vertexSet-1)->vertexData;
+                }
+            }
+            else
+            {
+                edgeGroup.vertexData = pMesh->getSubMesh(
+                    (unsigned short)edgeGroup.vertexSet)->vertexData;
+            }
+        }
+    }
+    //---------------------------------------------------------------------
     void MeshSerializerImpl::readEdgeList(DataStreamPtr& stream, Mesh* pMesh)
     {
+        bool parallel = canReadChunksParallel(stream);
+        ChunkList chunks;
+        std::vector<EdgeData*> chunkEdgeData;
         if (!stream->eof())
         {
             pushInnerChunk(stream);
@@ -1887,35 +2077,20 @@ namespace Ogre {
 
                     usage.edgeData = OGRE_NEW EdgeData();
 
-                    // Read detail information of the edge list
-                    readEdgeListLodInfo(stream, usage.edgeData);
-
-                    // Postprocessing edge groups
-                    EdgeData::EdgeGroupList::iterator egi, egend;
-                    egend = usage.edgeData->edgeGroups.end();
-                    for (egi = usage.edgeData->edgeGroups.begin(); egi != egend; ++egi)
+                    if (parallel)
                     {
-                        EdgeData::EdgeGroup& edgeGroup = *egi;
-                        // Populate edgeGroup.vertexData pointers
-                        // If there is shared vertex data, vertexSet 0 is that,
-                        // otherwise 0 is first dedicated
-                        if (pMesh->sharedVertexData)
-                        {
-                            if (edgeGroup.vertexSet == 0)
-                            {
-                                edgeGroup.vertexData = pMesh->sharedVertexData;
-                            }
-                            else
-                            {
-                                edgeGroup.vertexData = pMesh->getSubMesh(
-                                    (unsigned short)edgeGroup.vertexSet-1)->vertexData;
-                            }
-                        }
-                        else
-                        {
-                            edgeGroup.vertexData = pMesh->getSubMesh(
-                                (unsigned short)edgeGroup.vertexSet)->vertexData;
-                        }
+                        // Remember where the detail information is, it is read below
+                        size_t size = mCurrentstreamLen - MSTREAM_OVERHEAD_SIZE -
+                            sizeof(unsigned short) - sizeof(bool);
+                        chunks.push_back(std::make_pair(stream->tell(), size));
+                        chunkEdgeData.push_back(usage.edgeData);
+                        stream->skip(size);
+                    }
+                    else
+                    {
+                        // Read detail information of the edge list
+                        readEdgeListLodInfo(stream, usage.edgeData);
+                        resolveEdgeGroupVertexData(pMesh, usage.edgeData);
                     }
                 }
 
@@ -1933,6 +2108,16 @@ namespace Ogre {
             popInnerChunk(stream);
         }
 
+        if (!chunks.empty())
+        {
+            // Read detail information of all LODs at once
+            readChunksParallel(stream, chunks,
+                [pMesh, &chunkEdgeData](MeshSerializerImpl& worker, DataStreamPtr& chunk, size_t i) {
+                    worker.readEdgeListLodInfo(chunk, chunkEdgeData[i]);
+                    resolveEdgeGroupVertexData(pMesh, chunkEdgeData[i]);
+                });
+        }
+
         pMesh->mEdgeListsBuilt = true;
     }
     //---------------------------------------------------------------------
@@ -2386,6 +2571,8 @@ namespace Ogre {
     //---------------------------------------------------------------------
     void MeshSerializerImpl::readPoses(DataStreamPtr& stream, Mesh* pMesh)
     {
+        bool parallel = canReadChunksParallel(stream);
+        ChunkList chunks;
         // Find all substreams
         if (!stream->eof())
         {
@@ -2397,7 +2584,17 @@ namespace Ogre {
                 switch(streamID)
                 {
                 case M_POSE:
-                    readPose(stream, pMesh);
+                    if (parallel)
+                    {
+                        // Remember where the pose is, it is read below
+                        size_t size = mCurrentstreamLen - MSTREAM_OVERHEAD_SIZE;
+                        chunks.push_back(std::make_pair(stream->tell(), size));
+                        stream->skip(size);
+                    }
+                    else
+                    {
+                        pMesh->mPoseList.push_back(readPose(stream));
+                    }
                     break;
 
                 }
@@ -2415,9 +2612,29 @@ namespace Ogre {
             }
             popInnerChunk(stream);
         }
+
+        if (!chunks.empty())
+        {
+            // Poses are referenced by index, so keep the file order
+            std::vector<Pose*> poses(chunks.size());
+            try
+            {
+                readChunksParallel(stream, chunks,
+                    [&poses](MeshSerializerImpl& worker, DataStreamPtr& chunk, size_t i) {
+                        poses[i] = worker.readPose(chunk);
+                    });
+            }
+            catch (...)
+            {
+                for (size_t i = 0; i < poses.size(); ++i)
+                    OGRE_DELETE poses[i];
+                throw;
+            }
+            pMesh->mPoseList.insert(pMesh->mPoseList.end(), poses.begin(), poses.end());
+        }
     }
     //---------------------------------------------------------------------
-    void MeshSerializerImpl::readPose(DataStreamPtr& stream, Mesh* pMesh)
+    Pose* MeshSerializerImpl::readPose(DataStreamPtr& stream)
     {
         // char* name (may be blank)
         String name = readString(stream);
@@ -2429,7 +2646,7 @@ namespace Ogre {
         bool includesNormals;
         readBools(stream, &includesNormals, 1);
         
-        Pose* pose = pMesh->createPose(target, name);
+        Pose* pose = OGRE_NEW Pose(target, name);
 
         // Find all substreams
         if (!stream->eof())
@@ -2478,7 +2695,7 @@ namespace Ogre {
             }
             popInnerChunk(stream);
         }
-
+        return pose;
     }
     //---------------------------------------------------------------------
     void MeshSerializerImpl::readAnimations(DataStreamPtr& stream, Mesh* pMesh)
@@ -2716,6 +2933,32 @@ namespace Ogre {
         OGRE_FREE(vert, MEMCATEGORY_GEOMETRY);
     }
 
+    //---------------------------------------------------------------------
+    void MeshSerializerImpl::readMeshlets(DataStreamPtr& stream, Mesh *pMesh)
+    {
+        unsigned short idx;
+        readShorts(stream, &idx, 1);
+        uint32 count;
+        readInts(stream, &count, 1);
+
+        if (idx >= pMesh->getNumSubMeshes())
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
+                "Invalid submesh index " + StringConverter::toString(idx) + " in meshlet chunk of " +
+                pMesh->getName(), "MeshSerializerImpl::readMeshlets");
+
+        SubMesh *sm = pMesh->getSubMesh(idx);
+        sm->meshlets.resize(count);
+        for (SubMesh::MeshletList::iterator i = sm->meshlets.begin(); i != sm->meshlets.end(); ++i)
+        {
+            readInts(stream, &i->indexStart, 1);
+            readInts(stream, &i->indexCount, 1);
+            readObject(stream, i->center);
+            readFloats(stream, &i->radius, 1);
+            readObject(stream, i->coneAxis);
+            readFloats(stream, &i->coneCutoff, 1);
+        }
+    }
+
     void MeshSerializerImpl::enableValidation()
     {
 #if OGRE_SERIALIZER_VALIDATE_CHUNKSIZE
@@ -2724,6 +2967,31 @@ namespace Ogre {
     }
 
 
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    MeshSerializerImpl_v1_11::MeshSerializerImpl_v1_11()
+    {
+        // Version number
+        mVersion = "[MeshSerializer_v1.110]";
+        mDataAlignment = 0;
+    }
+    //---------------------------------------------------------------------
+    MeshSerializerImpl_v1_11::~MeshSerializerImpl_v1_11()
+    {
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    MeshSerializerImpl_v1_10::MeshSerializerImpl_v1_10()
+    {
+        // Version number
+        mVersion = "[MeshSerializer_v1.100]";
+    }
+    //---------------------------------------------------------------------
+    MeshSerializerImpl_v1_10::~MeshSerializerImpl_v1_10()
+    {
+    }
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
     //---------------------------------------------------------------------
@@ -3242,7 +3510,7 @@ namespace Ogre {
         popInnerChunk(mStream);
     }
     //---------------------------------------------------------------------
-    void MeshSerializerImpl_v1_41::readPose(DataStreamPtr& stream, Mesh* pMesh)
+    Pose* MeshSerializerImpl_v1_41::readPose(DataStreamPtr& stream)
     {
         // char* name (may be blank)
         String name = readString(stream);
@@ -3250,7 +3518,7 @@ namespace Ogre {
         unsigned short target;
         readShorts(stream, &target, 1);
 
-        Pose* pose = pMesh->createPose(target, name);
+        Pose* pose = OGRE_NEW Pose(target, name);
 
         // Find all substreams
         if (!stream->eof())
@@ -3289,6 +3557,7 @@ namespace Ogre {
             }
             popInnerChunk(stream);
         }
+        return pose;
     }
     //---------------------------------------------------------------------
     size_t MeshSerializerImpl_v1_41::calcPoseSize(const Pose* pose)
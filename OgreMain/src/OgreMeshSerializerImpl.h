@@ -54,7 +54,8 @@ namespace Ogre {
     will remain to load the latest version.
 
      @note
-        This mesh format was used from Ogre v1.10.
+        This mesh format was used from Ogre v1.12. Vertex and index data are aligned
+        to mDataAlignment bytes from the start of the stream.
 
     */
     class _OgrePrivate MeshSerializerImpl : public Serializer
@@ -112,6 +113,8 @@ namespace Ogre {
         virtual void writePoseKeyframePoseRef(const VertexPoseKeyFrame::PoseRef& poseRef);
         virtual void writeExtremes(const Mesh *pMesh);
         virtual void writeSubMeshExtremes(unsigned short idx, const SubMesh* s);
+        virtual void writeMeshlets(const Mesh *pMesh);
+        virtual void writeSubMeshMeshlets(unsigned short idx, const SubMesh* s);
 
         virtual size_t calcMeshSize(const Mesh* pMesh);
         virtual size_t calcSubMeshSize(const SubMesh* pSub);
@@ -140,6 +143,8 @@ namespace Ogre {
         virtual size_t calcBoundsInfoSize(const Mesh* pMesh);
         virtual size_t calcExtremesSize(const Mesh* pMesh);
         virtual size_t calcSubMeshExtremesSize(unsigned short idx, const SubMesh* s);
+        virtual size_t calcMeshletsSize(const Mesh* pMesh);
+        virtual size_t calcSubMeshMeshletsSize(unsigned short idx, const SubMesh* s);
 
         virtual void readTextureLayer(DataStreamPtr& stream, Mesh* pMesh, MaterialPtr& pMat);
         virtual void readSubMeshNameTable(DataStreamPtr& stream, Mesh* pMesh);
@@ -165,7 +170,8 @@ namespace Ogre {
         virtual void readEdgeList(DataStreamPtr& stream, Mesh* pMesh);
         virtual void readEdgeListLodInfo(DataStreamPtr& stream, EdgeData* edgeData);
         virtual void readPoses(DataStreamPtr& stream, Mesh* pMesh);
-        virtual void readPose(DataStreamPtr& stream, Mesh* pMesh);
+        /// Reads a pose, which is not added to a Mesh yet
+        virtual Pose* readPose(DataStreamPtr& stream);
         virtual void readAnimations(DataStreamPtr& stream, Mesh* pMesh);
         virtual void readAnimation(DataStreamPtr& stream, Mesh* pMesh);
         virtual void readAnimationTrack(DataStreamPtr& stream, Animation* anim, 
@@ -173,6 +179,35 @@ namespace Ogre {
         virtual void readMorphKeyFrame(DataStreamPtr& stream, Mesh* pMesh, VertexAnimationTrack* track);
         virtual void readPoseKeyFrame(DataStreamPtr& stream, VertexAnimationTrack* track);
         virtual void readExtremes(DataStreamPtr& stream, Mesh *pMesh);
+        virtual void readMeshlets(DataStreamPtr& stream, Mesh *pMesh);
+
+        /// Size of the padding written around vertex and index data
+        size_t calcDataPaddingSize() const { return mDataAlignment; }
+        /// Pads the stream so the following data is aligned, returns the amount of padding
+        uint8 writeDataPadding();
+        /// Writes the padding which completes the one started by writeDataPadding
+        void writeDataPaddingEnd(uint8 padding);
+        /// Skips the padding in front of vertex or index data, returns the amount of padding
+        uint8 readDataPadding(DataStreamPtr& stream);
+        /// Skips the padding behind vertex or index data
+        void readDataPaddingEnd(DataStreamPtr& stream, uint8 padding);
+        /** Fills a hardware buffer straight from a stream held in memory, e.g. a mapped file.
+        @return false if the data has to be read and endian flipped the regular way
+        */
+        bool readBufferData(DataStreamPtr& stream, HardwareBuffer* buf, size_t size);
+
+        /// Creates a serializer for the same version, to decode chunks on another thread
+        virtual MeshSerializerImpl* clone() const { return OGRE_NEW MeshSerializerImpl(*this); }
+        /// Offset and size of chunks to decode in parallel
+        typedef std::vector<std::pair<size_t, size_t> > ChunkList;
+        /// Whether independent chunks of the stream can be decoded in parallel
+        bool canReadChunksParallel(const DataStreamPtr& stream) const;
+        /** Decodes chunks of a memory backed stream using the WorkQueue.
+        @param func Called for each chunk with a serializer private to the task, a stream
+            over the chunk data and the index of the chunk. It must be thread safe.
+        */
+        void readChunksParallel(DataStreamPtr& stream, const ChunkList& chunks,
+            const std::function<void(MeshSerializerImpl&, DataStreamPtr&, size_t)>& func);
 
 
         /// Flip an entire vertex buffer from little endian
@@ -187,18 +222,48 @@ namespace Ogre {
         virtual void enableValidation();
 
         ushort exportedLodCount; // Needed to limit exported Edge data, when exporting
+        /// Alignment of vertex and index data in the stream, 0 if the format does not pad them
+        size_t mDataAlignment;
+    };
+
+    /** Class for providing backwards-compatibility for loading version 1.110 of the .mesh format.
+     This mesh format was used from Ogre v1.12, without aligned vertex and index data.
+     */
+    class _OgrePrivate MeshSerializerImpl_v1_11 : public MeshSerializerImpl
+    {
+    public:
+        MeshSerializerImpl_v1_11();
+        ~MeshSerializerImpl_v1_11();
+    protected:
+        MeshSerializerImpl* clone() const { return OGRE_NEW MeshSerializerImpl_v1_11(*this); }
+    };
+
+    /** Class for providing backwards-compatibility for loading version 1.100 of the .mesh format.
+     This mesh format was used from Ogre v1.10.
+     */
+    class _OgrePrivate MeshSerializerImpl_v1_10 : public MeshSerializerImpl_v1_11
+    {
+    public:
+        MeshSerializerImpl_v1_10();
+        ~MeshSerializerImpl_v1_10();
+    protected:
+        MeshSerializerImpl* clone() const { return OGRE_NEW MeshSerializerImpl_v1_10(*this); }
+        // Meshlets were added in v1.110
+        virtual size_t calcMeshletsSize(const Mesh* pMesh) { return 0; }
+        virtual void writeMeshlets(const Mesh* pMesh) {}
     };
 
 
     /** Class for providing backwards-compatibility for loading version 1.8 of the .mesh format. 
      This mesh format was used from Ogre v1.8.
      */
-    class _OgrePrivate MeshSerializerImpl_v1_8 : public MeshSerializerImpl
+    class _OgrePrivate MeshSerializerImpl_v1_8 : public MeshSerializerImpl_v1_10
     {
     public:
         MeshSerializerImpl_v1_8();
         ~MeshSerializerImpl_v1_8();
     protected:
+        MeshSerializerImpl* clone() const { return OGRE_NEW MeshSerializerImpl_v1_8(*this); }
         // In the past we could select to use manual or automatic generated Lod levels,
         // but now we can mix them. If it is mixed, we can't export it to older mesh formats.
         String compatibleLodStrategyName(String lodStrategyName);
@@ -230,10 +295,11 @@ namespace Ogre {
         MeshSerializerImpl_v1_41();
         ~MeshSerializerImpl_v1_41();
     protected:
+        MeshSerializerImpl* clone() const { return OGRE_NEW MeshSerializerImpl_v1_41(*this); }
         void writeMorphKeyframe(const VertexMorphKeyFrame* kf, size_t vertexCount);
         void readMorphKeyFrame(DataStreamPtr& stream, Mesh* pMesh, VertexAnimationTrack* track);
         void writePose(const Pose* pose);
-        void readPose(DataStreamPtr& stream, Mesh* pMesh);
+        Pose* readPose(DataStreamPtr& stream);
         size_t calcMorphKeyframeSize(const VertexMorphKeyFrame* kf, size_t vertexCount);
         size_t calcPoseSize(const Pose* pose);
         size_t calcPoseVertexSize(void);
@@ -249,6 +315,7 @@ namespace Ogre {
         MeshSerializerImpl_v1_4();
         ~MeshSerializerImpl_v1_4();
     protected:
+        MeshSerializerImpl* clone() const { return OGRE_NEW MeshSerializerImpl_v1_4(*this); }
         virtual size_t calcLodLevelSize(const Mesh* pMesh);
         virtual void readMeshLodLevel(DataStreamPtr& stream, Mesh* pMesh);
 #if !OGRE_NO_MESHLOD
@@ -266,6 +333,7 @@ namespace Ogre {
         MeshSerializerImpl_v1_3();
         ~MeshSerializerImpl_v1_3();
     protected:
+        MeshSerializerImpl* clone() const { return OGRE_NEW MeshSerializerImpl_v1_3(*this); }
         virtual void readEdgeListLodInfo(DataStreamPtr& stream, EdgeData* edgeData);
 
         /// Reorganise triangles of the edge list to group by vertex set
@@ -285,6 +353,7 @@ namespace Ogre {
         MeshSerializerImpl_v1_2();
         ~MeshSerializerImpl_v1_2();
     protected:
+        MeshSerializerImpl* clone() const { return OGRE_NEW MeshSerializerImpl_v1_2(*this); }
         virtual void readMesh(DataStreamPtr& stream, Mesh* pMesh, MeshSerializerListener *listener);
         virtual void readGeometry(DataStreamPtr& stream, Mesh* pMesh, VertexData* dest);
         virtual void readGeometryPositions(unsigned short bindIdx, DataStreamPtr& stream, 
@@ -306,6 +375,7 @@ namespace Ogre {
         MeshSerializerImpl_v1_1();
         ~MeshSerializerImpl_v1_1();
     protected:
+        MeshSerializerImpl* clone() const { return OGRE_NEW MeshSerializerImpl_v1_1(*this); }
         void readGeometryTexCoords(unsigned short bindIdx, DataStreamPtr& stream, 
             Mesh* pMesh, VertexData* dest, unsigned short set);
     };
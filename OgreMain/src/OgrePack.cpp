@@ -0,0 +1,693 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include "OgreStableHeaders.h"
+
+#include "OgrePack.h"
+#include "OgreFileSystem.h"
+#include "OgreMurmurHash3.h"
+
+#include <sys/stat.h>
+
+#if OGRE_NO_ZIP_ARCHIVE == 0
+#include <zlib.h>
+#endif
+
+namespace Ogre {
+namespace {
+    /* Pack layout, all fields little endian
+
+       header
+         0 magic, 8 version, 12 file count, 16 block size, 20 reserved,
+         24 index offset, 32 names offset, 40 names size
+       index entry, sorted on name hash and then name
+         0 name hash, 8 data offset, 16 stored size, 24 size,
+         32 name offset, 36 name length (16 bit), 38 codec (8 bit), 39 reserved
+       compressed data
+         block count, stored size of each block, blocks
+         a block is kept uncompressed when its stored size equals its size
+    */
+    const char PACK_MAGIC[8] = {'O', 'G', 'R', 'E', 'P', 'A', 'C', 'K'};
+    const uint32 PACK_VERSION = 1;
+    const size_t PACK_HEADER_SIZE = 48;
+    const size_t PACK_ENTRY_SIZE = 40;
+
+    uint16 readUInt16(const uchar* p) { return uint16(p[0] | (p[1] << 8)); }
+    uint32 readUInt32(const uchar* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (uint32(p[3]) << 24); }
+    uint64 readUInt64(const uchar* p) { return readUInt32(p) | (uint64(readUInt32(p + 4)) << 32); }
+
+    void writeUInt16(uchar* p, uint16 v) { p[0] = uchar(v); p[1] = uchar(v >> 8); }
+    void writeUInt32(uchar* p, uint32 v) { writeUInt16(p, uint16(v)); writeUInt16(p + 2, uint16(v >> 16)); }
+    void writeUInt64(uchar* p, uint64 v) { writeUInt32(p, uint32(v)); writeUInt32(p + 4, uint32(v >> 32)); }
+
+    /// FNV-1a, independent of the host byte order
+    uint64 hashName(const char* name, size_t len)
+    {
+        uint64 hash = 0xcbf29ce484222325ULL;
+        for (size_t i = 0; i < len; i++)
+            hash = (hash ^ uchar(name[i])) * 0x100000001b3ULL;
+        return hash;
+    }
+
+    struct PackEntry
+    {
+        uint64 hash;
+        uint64 offset;
+        uint64 storedSize;
+        uint64 size;
+        uint32 nameOffset;
+        uint16 nameLength;
+        uint8 codec;
+    };
+
+    bool operator<(const PackEntry& a, uint64 hash) { return a.hash < hash; }
+
+    /// decodes all blocks of a compressed file, returns false if the data is invalid
+    bool decodeBlocks(const uchar* src, size_t storedSize, uchar* dst, size_t size, size_t blockSize,
+                      uint8 codec)
+    {
+        if (storedSize < 4)
+            return false;
+
+        if (blockSize == 0)
+            blockSize = std::max<size_t>(size, 1);
+        size_t count = readUInt32(src);
+        if (count != (size + blockSize - 1) / blockSize || count > (storedSize - 4) / 4)
+            return false;
+
+        const uchar* block = src + 4 + 4 * count;
+        const uchar* end = src + storedSize;
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t in = readUInt32(src + 4 + 4 * i);
+            size_t out = std::min(blockSize, size - i * blockSize);
+            if (in > size_t(end - block))
+                return false;
+
+            if (in == out)
+            {
+                memcpy(dst, block, out);
+            }
+            else if (codec == PackArchiveWriter::CODEC_DEFLATE)
+            {
+#if OGRE_NO_ZIP_ARCHIVE == 0
+                z_stream zs;
+                memset(&zs, 0, sizeof(zs));
+                zs.next_in = const_cast<uchar*>(block);
+                zs.avail_in = uInt(in);
+                zs.next_out = dst;
+                zs.avail_out = uInt(out);
+
+                int ret = inflateInit2(&zs, -MAX_WBITS);
+                if (ret == Z_OK)
+                {
+                    ret = inflate(&zs, Z_FINISH);
+                    inflateEnd(&zs);
+                }
+                if (ret != Z_STREAM_END || zs.total_out != out)
+                    return false;
+#else
+                return false;
+#endif
+            }
+            else
+            {
+                return false;
+            }
+
+            block += in;
+            dst += out;
+        }
+        return true;
+    }
+
+    class PackArchive : public Archive
+    {
+    protected:
+        /// the whole pack, usually a mapping of the file
+        DataStreamPtr mData;
+        /// Index, sorted on the name hash
+        std::vector<PackEntry> mEntries;
+        /// Same order as mEntries
+        FileInfoList mFileList;
+        /// The names block of the pack
+        const char* mNames;
+        size_t mBlockSize;
+#if !OGRE_RESOURCEMANAGER_STRICT
+        /// Lower case names and basenames, ambiguous basenames map to -1
+        std::unordered_map<String, size_t> mLooseIndex;
+#endif
+
+        /// open() and the listing methods only read the index, this guards load and unload
+        OGRE_AUTO_MUTEX;
+
+        size_t findEntry(const String& filename) const;
+    public:
+        PackArchive(const String& name, const String& archType);
+        ~PackArchive();
+
+        /// @copydoc Archive::isCaseSensitive
+        bool isCaseSensitive(void) const { return OGRE_RESOURCEMANAGER_STRICT != 0; }
+
+        /// @copydoc Archive::load
+        void load();
+        /// @copydoc Archive::unload
+        void unload();
+
+        /// @copydoc Archive::open
+        DataStreamPtr open(const String& filename, bool readOnly = true) const;
+
+        /// @copydoc Archive::create
+        DataStreamPtr create(const String& filename);
+
+        /// @copydoc Archive::remove
+        void remove(const String& filename);
+
+        /// @copydoc Archive::list
+        StringVectorPtr list(bool recursive = true, bool dirs = false) const;
+
+        /// @copydoc Archive::listFileInfo
+        FileInfoListPtr listFileInfo(bool recursive = true, bool dirs = false) const;
+
+        /// @copydoc Archive::find
+        StringVectorPtr find(const String& pattern, bool recursive = true,
+            bool dirs = false) const;
+
+        /// @copydoc Archive::findFileInfo
+        FileInfoListPtr findFileInfo(const String& pattern, bool recursive = true,
+            bool dirs = false) const;
+
+        /// @copydoc Archive::exists
+        bool exists(const String& filename) const;
+
+        /// @copydoc Archive::getModifiedTime
+        time_t getModifiedTime(const String& filename) const;
+    };
+
+    /** Stored file served straight from the pack memory.
+        Keeps the pack memory alive, so it may outlive the archive.
+    */
+    class PackStoredDataStream : public MemoryDataStream
+    {
+        DataStreamPtr mPackData;
+    public:
+        PackStoredDataStream(const String& name, const DataStreamPtr& packData, const uchar* pMem, size_t size)
+            : MemoryDataStream(name, const_cast<uchar*>(pMem), size, false, true), mPackData(packData)
+        {
+        }
+
+        void close(void)
+        {
+            MemoryDataStream::close();
+            mPackData.reset();
+        }
+    };
+
+    bool matchesFilter(const FileInfo& info, const String& pattern, bool recursive, bool fullMatch)
+    {
+        // the filename is just the basename, unless OGRE_RESOURCEMANAGER_STRICT
+        return (recursive || fullMatch || info.path.empty()) &&
+               StringUtil::match(fullMatch ? info.path + info.basename : info.basename, pattern,
+                                 OGRE_RESOURCEMANAGER_STRICT != 0);
+    }
+}
+    //-----------------------------------------------------------------------
+    PackArchive::PackArchive(const String& name, const String& archType)
+        : Archive(name, archType), mNames(0), mBlockSize(0)
+    {
+    }
+    //-----------------------------------------------------------------------
+    PackArchive::~PackArchive()
+    {
+        unload();
+    }
+    //-----------------------------------------------------------------------
+    void PackArchive::load()
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+        if (mData)
+            return;
+
+        DataStreamPtr data = _openMappedFile(mName);
+        if (!data) // mapping not possible here, read it into memory instead
+        {
+            DataStreamPtr file = _openFileStream(mName, std::ios::in | std::ios::binary);
+            data.reset(OGRE_NEW MemoryDataStream(file, true, true));
+        }
+
+        MemoryDataStream* mem = static_cast<MemoryDataStream*>(data.get());
+        const uchar* base = mem->getPtr();
+        size_t size = mem->size();
+
+        String corrupted = "Corrupted pack '" + mName + "'";
+        if (size < PACK_HEADER_SIZE || memcmp(base, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Not a pack file '" + mName + "'");
+        if (readUInt32(base + 8) != PACK_VERSION)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Unsupported pack version in '" + mName + "'");
+
+        size_t count = readUInt32(base + 12);
+        mBlockSize = readUInt32(base + 16);
+        uint64 indexOffset = readUInt64(base + 24);
+        uint64 namesOffset = readUInt64(base + 32);
+        uint64 namesSize = readUInt64(base + 40);
+        if (indexOffset > size || count > (size - indexOffset) / PACK_ENTRY_SIZE || namesOffset > size ||
+            namesSize > size - namesOffset)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, corrupted);
+
+        mEntries.resize(count);
+        mFileList.resize(count);
+        const char* names = reinterpret_cast<const char*>(base + namesOffset);
+        for (size_t i = 0; i < count; i++)
+        {
+            const uchar* p = base + indexOffset + i * PACK_ENTRY_SIZE;
+            PackEntry& e = mEntries[i];
+            e.hash = readUInt64(p);
+            e.offset = readUInt64(p + 8);
+            e.storedSize = readUInt64(p + 16);
+            e.size = readUInt64(p + 24);
+            e.nameOffset = readUInt32(p + 32);
+            e.nameLength = readUInt16(p + 36);
+            e.codec = p[38];
+            if (e.offset > size || e.storedSize > size - e.offset || e.nameOffset + e.nameLength > namesSize ||
+                (i > 0 && e.hash < mEntries[i - 1].hash))
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, corrupted);
+
+            FileInfo& info = mFileList[i];
+            info.archive = this;
+            info.filename.assign(names + e.nameOffset, e.nameLength);
+            StringUtil::splitFilename(info.filename, info.basename, info.path);
+            info.compressedSize = size_t(e.storedSize);
+            info.uncompressedSize = size_t(e.size);
+#if !OGRE_RESOURCEMANAGER_STRICT
+            String key = info.filename;
+            StringUtil::toLowerCase(key);
+            mLooseIndex[key] = i;
+
+            // lookup by basename, unless it is ambiguous
+            key = info.basename;
+            StringUtil::toLowerCase(key);
+            std::pair<std::unordered_map<String, size_t>::iterator, bool> ret =
+                mLooseIndex.insert(std::make_pair(key, i));
+            if (!ret.second && ret.first->second != i)
+                ret.first->second = size_t(-1);
+
+            info.filename = info.basename;
+#endif
+        }
+
+        mNames = names;
+        mData = data;
+    }
+    //-----------------------------------------------------------------------
+    void PackArchive::unload()
+    {
+        OGRE_LOCK_AUTO_MUTEX;
+        // open streams keep the memory alive
+        mData.reset();
+        mEntries.clear();
+        mFileList.clear();
+        mNames = 0;
+#if !OGRE_RESOURCEMANAGER_STRICT
+        mLooseIndex.clear();
+#endif
+    }
+    //-----------------------------------------------------------------------
+    size_t PackArchive::findEntry(const String& filename) const
+    {
+        uint64 hash = hashName(filename.c_str(), filename.size());
+        std::vector<PackEntry>::const_iterator it = std::lower_bound(mEntries.begin(), mEntries.end(), hash);
+        for (; it != mEntries.end() && it->hash == hash; ++it)
+        {
+            if (it->nameLength == filename.size() &&
+                memcmp(mNames + it->nameOffset, filename.data(), filename.size()) == 0)
+                return it - mEntries.begin();
+        }
+#if !OGRE_RESOURCEMANAGER_STRICT
+        String key = filename;
+        StringUtil::toLowerCase(key);
+        std::unordered_map<String, size_t>::const_iterator loose = mLooseIndex.find(key);
+        if (loose == mLooseIndex.end()) // Try if we find the file
+        {
+            String basename, path;
+            StringUtil::splitFilename(key, basename, path);
+            loose = mLooseIndex.find(basename);
+        }
+        if (loose != mLooseIndex.end())
+            return loose->second;
+#endif
+        return size_t(-1);
+    }
+    //-----------------------------------------------------------------------
+    DataStreamPtr PackArchive::open(const String& filename, bool readOnly) const
+    {
+        if (!readOnly)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Cannot open a file in read-write mode in a pack");
+
+        // the index does not change once loaded, so concurrent opens need no lock
+        size_t i = findEntry(filename);
+        if (i == size_t(-1))
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "File '" + filename + "' not in pack '" + mName + "'");
+
+        const PackEntry& e = mEntries[i];
+        const uchar* src = static_cast<MemoryDataStream*>(mData.get())->getPtr() + e.offset;
+        if (e.codec == PackArchiveWriter::CODEC_STORED)
+        {
+            if (e.storedSize != e.size)
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Corrupted pack '" + mName + "'");
+            return DataStreamPtr(OGRE_NEW PackStoredDataStream(filename, mData, src, size_t(e.size)));
+        }
+
+        MemoryDataStream* stream = OGRE_NEW MemoryDataStream(filename, size_t(e.size), true, true);
+        DataStreamPtr ret(stream);
+        if (!decodeBlocks(src, size_t(e.storedSize), stream->getPtr(), size_t(e.size), mBlockSize, e.codec))
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                        "Cannot decode '" + filename + "' in pack '" + mName + "'");
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    DataStreamPtr PackArchive::create(const String& filename)
+    {
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "Modification of packs is not supported, use PackArchiveWriter");
+    }
+    //-----------------------------------------------------------------------
+    void PackArchive::remove(const String& filename)
+    {
+        OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "Modification of packs is not supported, use PackArchiveWriter");
+    }
+    //-----------------------------------------------------------------------
+    StringVectorPtr PackArchive::list(bool recursive, bool dirs) const
+    {
+        StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        // packs only hold files
+        if (dirs)
+            return ret;
+
+        ret->reserve(mFileList.size());
+        for (FileInfoList::const_iterator i = mFileList.begin(); i != mFileList.end(); ++i)
+            if (recursive || i->path.empty())
+                ret->push_back(i->filename);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    FileInfoListPtr PackArchive::listFileInfo(bool recursive, bool dirs) const
+    {
+        FileInfoListPtr ret = FileInfoListPtr(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        if (dirs)
+            return ret;
+
+        ret->reserve(mFileList.size());
+        for (FileInfoList::const_iterator i = mFileList.begin(); i != mFileList.end(); ++i)
+            if (recursive || i->path.empty())
+                ret->push_back(*i);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    StringVectorPtr PackArchive::find(const String& pattern, bool recursive, bool dirs) const
+    {
+        StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        if (dirs)
+            return ret;
+
+        // If pattern contains a directory name, do a full match
+        bool fullMatch = pattern.find('/') != String::npos;
+        for (FileInfoList::const_iterator i = mFileList.begin(); i != mFileList.end(); ++i)
+            if (matchesFilter(*i, pattern, recursive, fullMatch))
+                ret->push_back(i->filename);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    FileInfoListPtr PackArchive::findFileInfo(const String& pattern, bool recursive, bool dirs) const
+    {
+        FileInfoListPtr ret = FileInfoListPtr(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+        if (dirs)
+            return ret;
+
+        bool fullMatch = pattern.find('/') != String::npos;
+        for (FileInfoList::const_iterator i = mFileList.begin(); i != mFileList.end(); ++i)
+            if (matchesFilter(*i, pattern, recursive, fullMatch))
+                ret->push_back(*i);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    bool PackArchive::exists(const String& filename) const
+    {
+        return findEntry(filename) != size_t(-1);
+    }
+    //-----------------------------------------------------------------------
+    time_t PackArchive::getModifiedTime(const String& filename) const
+    {
+        // files in a pack share the time of the pack
+        struct stat tagStat;
+        if (stat(mName.c_str(), &tagStat) == 0)
+            return tagStat.st_mtime;
+        return 0;
+    }
+    //-----------------------------------------------------------------------
+    //  PackArchiveFactory
+    //-----------------------------------------------------------------------
+    Archive *PackArchiveFactory::createInstance( const String& name, bool readOnly )
+    {
+        if (!readOnly)
+            return NULL;
+
+        return OGRE_NEW PackArchive(name, getType());
+    }
+    //-----------------------------------------------------------------------
+    const String& PackArchiveFactory::getType(void) const
+    {
+        static String name = "Pack";
+        return name;
+    }
+    //-----------------------------------------------------------------------
+    //  PackArchiveWriter
+    //-----------------------------------------------------------------------
+    PackArchiveWriter::PackArchiveWriter()
+        : mCodec(CODEC_STORED), mBlockSize(256 * 1024), mAlignment(16), mDeduplicate(true)
+    {
+    }
+    //-----------------------------------------------------------------------
+    PackArchiveWriter::~PackArchiveWriter()
+    {
+    }
+    //-----------------------------------------------------------------------
+    void PackArchiveWriter::setAlignment(uint32 alignment)
+    {
+        OgreAssert(alignment && (alignment & (alignment - 1)) == 0, "alignment must be a power of two");
+        mAlignment = alignment;
+    }
+    //-----------------------------------------------------------------------
+    void PackArchiveWriter::addFile(const String& name, const DataStreamPtr& stream)
+    {
+        OgreAssert(!name.empty() && name.size() <= 0xFFFF, "invalid file name");
+        PendingFile file = {name, stream, NULL, mCodec};
+        mFiles.push_back(file);
+    }
+    //-----------------------------------------------------------------------
+    void PackArchiveWriter::addArchive(Archive* source)
+    {
+        // opened when writing, so we do not hold every file open
+        StringVectorPtr names = source->list(true);
+        for (size_t i = 0; i < names->size(); i++)
+        {
+            PendingFile file = {names->at(i), DataStreamPtr(), source, mCodec};
+            mFiles.push_back(file);
+        }
+    }
+    //-----------------------------------------------------------------------
+    size_t PackArchiveWriter::write(const String& filename)
+    {
+#if OGRE_NO_ZIP_ARCHIVE != 0
+        for (size_t i = 0; i < mFiles.size(); i++)
+            if (mFiles[i].codec == CODEC_DEFLATE)
+                OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "Deflate compression needs OGRE built with zlib");
+#endif
+        std::ofstream out(filename.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+        if (!out)
+            OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE, "Cannot open file: " + filename);
+
+        uchar header[PACK_HEADER_SIZE] = {0};
+        out.write(reinterpret_cast<const char*>(header), PACK_HEADER_SIZE);
+        uint64 pos = PACK_HEADER_SIZE;
+
+        std::vector<PackEntry> entries(mFiles.size());
+        String names;
+        // content hash and size -> entry with that content
+        std::map<std::pair<std::pair<uint64, uint64>, uint64>, size_t> written;
+        std::vector<uchar> content, packed;
+        const char padding[256] = {0};
+
+        for (size_t i = 0; i < mFiles.size(); i++)
+        {
+            const PendingFile& file = mFiles[i];
+            DataStreamPtr stream = file.archive ? file.archive->open(file.name) : file.stream;
+
+            content.clear();
+            uchar buf[OGRE_STREAM_TEMP_SIZE];
+            while (!stream->eof())
+            {
+                size_t n = stream->read(buf, sizeof(buf));
+                if (n == 0)
+                    break;
+                content.insert(content.end(), buf, buf + n);
+            }
+
+            PackEntry& e = entries[i];
+            e.hash = hashName(file.name.c_str(), file.name.size());
+            e.size = content.size();
+            e.nameOffset = uint32(names.size());
+            e.nameLength = uint16(file.name.size());
+            names += file.name;
+
+            std::pair<std::pair<uint64, uint64>, uint64> key;
+            if (mDeduplicate)
+            {
+                uint64 h[2];
+                MurmurHash3_x64_128(content.data(), content.size(), 0, h);
+                key = std::make_pair(std::make_pair(h[0], h[1]), e.size);
+                std::map<std::pair<std::pair<uint64, uint64>, uint64>, size_t>::iterator it = written.find(key);
+                if (it != written.end())
+                {
+                    const PackEntry& same = entries[it->second];
+                    e.offset = same.offset;
+                    e.storedSize = same.storedSize;
+                    e.codec = same.codec;
+                    continue;
+                }
+            }
+
+            const uchar* data = content.data();
+            e.codec = CODEC_STORED;
+            e.storedSize = e.size;
+#if OGRE_NO_ZIP_ARCHIVE == 0
+            if (file.codec == CODEC_DEFLATE && !content.empty())
+            {
+                size_t blockSize = mBlockSize ? mBlockSize : content.size();
+                size_t count = (content.size() + blockSize - 1) / blockSize;
+                packed.assign(4 + 4 * count, 0);
+                writeUInt32(&packed[0], uint32(count));
+                for (size_t b = 0; b < count; b++)
+                {
+                    const uchar* in = data + b * blockSize;
+                    size_t inSize = std::min(blockSize, content.size() - b * blockSize);
+
+                    z_stream zs;
+                    memset(&zs, 0, sizeof(zs));
+                    deflateInit2(&zs, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+                    size_t start = packed.size();
+                    packed.resize(start + deflateBound(&zs, uLong(inSize)));
+                    zs.next_in = const_cast<uchar*>(in);
+                    zs.avail_in = uInt(inSize);
+                    zs.next_out = &packed[start];
+                    zs.avail_out = uInt(packed.size() - start);
+                    int ret = deflate(&zs, Z_FINISH);
+                    deflateEnd(&zs);
+
+                    size_t outSize = zs.total_out;
+                    if (ret != Z_STREAM_END || outSize >= inSize)
+                    {
+                        // keep incompressible blocks as they are
+                        memcpy(&packed[start], in, inSize);
+                        outSize = inSize;
+                    }
+                    packed.resize(start + outSize);
+                    writeUInt32(&packed[4 + 4 * b], uint32(outSize));
+                }
+
+                if (packed.size() < content.size())
+                {
+                    data = packed.data();
+                    e.codec = CODEC_DEFLATE;
+                    e.storedSize = packed.size();
+                }
+            }
+#endif
+            uint64 aligned = (pos + mAlignment - 1) & ~uint64(mAlignment - 1);
+            for (; pos < aligned; pos += std::min<uint64>(aligned - pos, sizeof(padding)))
+                out.write(padding, std::streamsize(std::min<uint64>(aligned - pos, sizeof(padding))));
+
+            e.offset = pos;
+            out.write(reinterpret_cast<const char*>(data), std::streamsize(e.storedSize));
+            pos += e.storedSize;
+
+            if (mDeduplicate)
+                written[key] = i;
+        }
+
+        // sort on the name hash, for lookup by binary search
+        std::vector<size_t> order(entries.size());
+        for (size_t i = 0; i < order.size(); i++)
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [&entries, this](size_t a, size_t b) {
+            if (entries[a].hash != entries[b].hash)
+                return entries[a].hash < entries[b].hash;
+            return mFiles[a].name < mFiles[b].name;
+        });
+
+        uint64 indexOffset = (pos + 7) & ~uint64(7);
+        out.write(padding, std::streamsize(indexOffset - pos));
+        pos = indexOffset;
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            if (i > 0 && mFiles[order[i]].name == mFiles[order[i - 1]].name)
+                OGRE_EXCEPT(Exception::ERR_DUPLICATE_ITEM, "File '" + mFiles[order[i]].name + "' added twice");
+
+            const PackEntry& e = entries[order[i]];
+            uchar p[PACK_ENTRY_SIZE] = {0};
+            writeUInt64(p, e.hash);
+            writeUInt64(p + 8, e.offset);
+            writeUInt64(p + 16, e.storedSize);
+            writeUInt64(p + 24, e.size);
+            writeUInt32(p + 32, e.nameOffset);
+            writeUInt16(p + 36, e.nameLength);
+            p[38] = e.codec;
+            out.write(reinterpret_cast<const char*>(p), PACK_ENTRY_SIZE);
+        }
+        pos += entries.size() * PACK_ENTRY_SIZE;
+
+        uint64 namesOffset = pos;
+        out.write(names.data(), std::streamsize(names.size()));
+        pos += names.size();
+
+        memcpy(header, PACK_MAGIC, sizeof(PACK_MAGIC));
+        writeUInt32(header + 8, PACK_VERSION);
+        writeUInt32(header + 12, uint32(entries.size()));
+        writeUInt32(header + 16, mBlockSize);
+        writeUInt64(header + 24, indexOffset);
+        writeUInt64(header + 32, namesOffset);
+        writeUInt64(header + 40, names.size());
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(header), PACK_HEADER_SIZE);
+
+        if (!out)
+            OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE, "Cannot write file: " + filename);
+        return size_t(pos);
+    }
+}
@@ -213,6 +213,12 @@ namespace Ogre {
         pLog->logMessage(
             " * VET_UBYTE4 vertex element type: "
             + StringConverter::toString(hasCapability(RSC_VERTEX_FORMAT_UBYTE4), true));
+        pLog->logMessage(
+            " * VET_INT_10_10_10_2_NORM vertex element type: "
+            + StringConverter::toString(hasCapability(RSC_VERTEX_FORMAT_INT_10_10_10_2), true));
+        pLog->logMessage(
+            " * VET_HALF2 and VET_HALF4 vertex element types: "
+            + StringConverter::toString(hasCapability(RSC_VERTEX_FORMAT_HALF), true));
         pLog->logMessage(
             " * Infinite far plane projection: "
             + StringConverter::toString(hasCapability(RSC_INFINITE_FAR_PLANE), true));
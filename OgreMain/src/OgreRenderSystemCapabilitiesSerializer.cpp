@@ -383,6 +383,8 @@ namespace Ogre
         addCapabilitiesMapping("hwocclusion", RSC_HWOCCLUSION);
         addCapabilitiesMapping("user_clip_planes", RSC_USER_CLIP_PLANES);
         addCapabilitiesMapping("vertex_format_ubyte4", RSC_VERTEX_FORMAT_UBYTE4);
+        addCapabilitiesMapping("vertex_format_int_10_10_10_2", RSC_VERTEX_FORMAT_INT_10_10_10_2);
+        addCapabilitiesMapping("vertex_format_half", RSC_VERTEX_FORMAT_HALF);
         addCapabilitiesMapping("infinite_far_plane", RSC_INFINITE_FAR_PLANE);
         addCapabilitiesMapping("hwrender_to_texture", RSC_HWRENDER_TO_TEXTURE);
         addCapabilitiesMapping("texture_float", RSC_TEXTURE_FLOAT);
@@ -27,8 +27,50 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 #include "OgreScriptLoader.h"
+#include "OgreScriptCompiler.h"
+#include "OgreStreamSerialiser.h"
 
 namespace Ogre {
+namespace {
+    uint32 CACHE_CHUNK_ID = StreamSerialiser::makeIdentifier("ORLI"); // Ogre Resource Location Index
+    /// number of scripts parsed in parallel, bounds the number of open streams
+    const size_t SCRIPT_PARSE_BATCH_SIZE = 64;
+
+    String locationCacheKey(const ResourceGroupManager::ResourceLocation& loc)
+    {
+        return loc.archive->getType() + ":" + loc.archive->getName() + (loc.recursive ? ":r" : "");
+    }
+
+    /// hash of the modification times that tell whether the file list of a location is still valid
+    uint32 locationStamp(Archive* arch, const StringVector& files)
+    {
+        time_t t = arch->getModifiedTime("");
+        uint32 stamp = FastHash((const char*)&t, sizeof(t));
+        if (arch->getType() != "FileSystem")
+            return stamp;
+
+        // adding or removing a file only touches its folder, so check every folder holding
+        // resources and their parents
+        std::set<String> dirs;
+        for (StringVector::const_iterator f = files.begin(); f != files.end(); ++f)
+        {
+            size_t pos = f->rfind('/');
+            if (pos == String::npos)
+                continue;
+
+            String dir = f->substr(0, pos);
+            while (dirs.insert(dir).second && (pos = dir.rfind('/')) != String::npos)
+                dir.resize(pos);
+        }
+
+        for (std::set<String>::const_iterator d = dirs.begin(); d != dirs.end(); ++d)
+        {
+            t = arch->getModifiedTime(*d);
+            stamp = FastHash((const char*)&t, sizeof(t), stamp);
+        }
+        return stamp;
+    }
+}
 
     //-----------------------------------------------------------------------
     template<> ResourceGroupManager* Singleton<ResourceGroupManager>::msSingleton = 0;
@@ -55,7 +97,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
     ResourceGroupManager::ResourceGroupManager()
-        : mLoadingListener(0), mCurrentGroup(0)
+        : mLoadingListener(0), mLocationIndexCaching(false), mCurrentGroup(0)
     {
         // Create the 'General' group
         createResourceGroup(DEFAULT_RESOURCE_GROUP_NAME, true); // the "General" group is synonymous to global pool
@@ -112,6 +154,8 @@ namespace Ogre {
 
         if (grp->groupStatus == ResourceGroup::UNINITIALSED)
         {
+            // a failing scan leaves the group uninitialised
+            indexLocations(std::vector<ResourceGroup*>(1, grp));
             // in the process of initialising
             grp->groupStatus = ResourceGroup::INITIALISING;
             // Set current group
@@ -130,10 +174,19 @@ namespace Ogre {
     {
             OGRE_LOCK_AUTO_MUTEX;
 
-        // Intialise all declared resource groups
+        // Scan the locations of all groups at once
+        std::vector<ResourceGroup*> groups;
         ResourceGroupMap::iterator i, iend;
         iend = mResourceGroupMap.end();
         for (i = mResourceGroupMap.begin(); i != iend; ++i)
+        {
+            if (i->second->groupStatus == ResourceGroup::UNINITIALSED)
+                groups.push_back(i->second);
+        }
+        indexLocations(groups);
+
+        // Intialise all declared resource groups
+        for (i = mResourceGroupMap.begin(); i != iend; ++i)
         {
             ResourceGroup* grp = i->second;
             OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex
@@ -534,7 +587,6 @@ namespace Ogre {
         // Add to location list
 
         ResourceLocation loc = {pArch, recursive};
-        StringVectorPtr vec = pArch->find("*", recursive);
 
         ResourceGroup* grp = getResourceGroup(resGroup);
         if (!grp)
@@ -545,11 +597,9 @@ namespace Ogre {
 
         OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex
         grp->locationList.push_back(loc);
+        // Index resources on first use, see indexLocations
+        grp->unindexedLocations.push_back(loc);
 
-        // Index resources
-        for( StringVector::iterator it = vec->begin(); it != vec->end(); ++it )
-            grp->addToIndex(*it, pArch);
-        
         StringStream msg;
         msg << "Added resource location '" << name << "' of type '" << locType
             << "' to resource group '" << resGroup << "'";
@@ -583,6 +633,15 @@ namespace Ogre {
                 grp->removeFromIndex(pArch);
                 grp->locationList.erase(li);
 
+                for (li = grp->unindexedLocations.begin(); li != grp->unindexedLocations.end(); ++li)
+                {
+                    if (li->archive == pArch)
+                    {
+                        grp->unindexedLocations.erase(li);
+                        break;
+                    }
+                }
+
                 break;
             }
 
@@ -758,6 +817,8 @@ namespace Ogre {
 
         OGRE_LOCK_AUTO_MUTEX;
         OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex
+        if (!grp->unindexedLocations.empty())
+            indexLocations(std::vector<ResourceGroup*>(1, grp));
         
         for (LocationList::iterator li = grp->locationList.begin(); 
             li != grp->locationList.end(); ++li)
@@ -988,33 +1049,77 @@ namespace Ogre {
         // Fire scripting event
         fireResourceGroupScriptingStarted(grp->name, scriptCount);
 
+        ScriptCompilerManager* compilerMgr = ScriptCompilerManager::getSingletonPtr();
+        WorkQueue* workQueue = Root::getSingletonPtr() ? Root::getSingleton().getWorkQueue() : NULL;
+
         // Iterate over scripts and parse
         // Note we respect original ordering
         for (ScriptLoaderFileList::iterator slfli = scriptLoaderFileList.begin();
             slfli != scriptLoaderFileList.end(); ++slfli)
         {
             ScriptLoader* su = slfli->first;
-            // Iterate over each item in the list
-            for (FileInfoList::iterator fii = slfli->second.begin(); fii != slfli->second.end(); ++fii)
+            const FileInfoList& files = slfli->second;
+
+            // lexing and parsing of compiler scripts is independent, so it runs in parallel
+            // on batches of scripts, which are then compiled in order
+            bool parallel = su == compilerMgr && workQueue;
+            size_t batchSize = parallel ? SCRIPT_PARSE_BATCH_SIZE : 1;
+
+            for (size_t first = 0; first < files.size(); first += batchSize)
             {
-                bool skipScript = false;
-                fireScriptStarted(fii->filename, skipScript);
-                if(skipScript)
+                size_t count = std::min(batchSize, files.size() - first);
+                std::vector<ConcreteNodeListPtr> nodes(count);
+                std::vector<std::exception_ptr> errors(count);
+                if (parallel)
                 {
-                    LogManager::getSingleton().logMessage(
-                        "Skipping script " + fii->filename);
+                    // the listener may skip a script only once its turn comes, so the whole
+                    // batch is parsed and the result of skipped scripts is dropped
+                    std::vector<DataStreamPtr> streams(count);
+                    for (size_t i = 0; i < count; i++)
+                        streams[i] = openScript(files[first + i], grp);
+
+                    workQueue->parallelFor(count, [&](size_t i) {
+                        if (!streams[i])
+                            return;
+                        // keep the error, so it is raised in script order
+                        try
+                        {
+                            nodes[i] = compilerMgr->_parse(streams[i]->getAsString(), streams[i]->getName());
+                        }
+                        catch (...)
+                        {
+                            errors[i] = std::current_exception();
+                        }
+                        streams[i].reset();
+                    });
                 }
-                else
+
+                // events are paired around each script, in order and on this thread
+                for (size_t i = 0; i < count; i++)
                 {
-                    LogManager::getSingleton().logMessage(
-                        "Parsing script " + fii->filename);
-                    DataStreamPtr stream = fii->archive->open(fii->filename);
-                    if (stream)
+                    const FileInfo& fi = files[first + i];
+                    bool skipScript = false;
+                    fireScriptStarted(fi.filename, skipScript);
+                    if(skipScript)
                     {
-                        if (mLoadingListener)
-                            mLoadingListener->resourceStreamOpened(fii->filename, grp->name, 0, stream);
+                        LogManager::getSingleton().logMessage(
+                            "Skipping script " + fi.filename);
+                        fireScriptEnded(fi.filename, skipScript);
+                        continue;
+                    }
 
-                        if(fii->archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024)
+                    LogManager::getSingleton().logMessage(
+                        "Parsing script " + fi.filename);
+                    if (parallel)
+                    {
+                        if (errors[i])
+                            std::rethrow_exception(errors[i]);
+                        if (nodes[i])
+                            compilerMgr->_compile(nodes[i], grp->name);
+                    }
+                    else if (DataStreamPtr stream = openScript(fi, grp))
+                    {
+                        if(fi.archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024)
                         {
                             DataStreamPtr cachedCopy(OGRE_NEW MemoryDataStream(stream->getName(), stream));
                             su->parseScript(cachedCopy, grp->name);
@@ -1022,8 +1127,8 @@ namespace Ogre {
                         else
                             su->parseScript(stream, grp->name);
                     }
+                    fireScriptEnded(fi.filename, skipScript);
                 }
-                fireScriptEnded(fii->filename, skipScript);
             }
         }
 
@@ -1032,6 +1137,14 @@ namespace Ogre {
             "Finished parsing scripts for resource group " + grp->name);
     }
     //-----------------------------------------------------------------------
+    DataStreamPtr ResourceGroupManager::openScript(const FileInfo& fi, ResourceGroup* grp) const
+    {
+        DataStreamPtr stream = fi.archive->open(fi.filename);
+        if (stream && mLoadingListener)
+            mLoadingListener->resourceStreamOpened(fi.filename, grp->name, 0, stream);
+        return stream;
+    }
+    //-----------------------------------------------------------------------
     void ResourceGroupManager::createDeclaredResources(ResourceGroup* grp)
     {
 
@@ -1571,6 +1684,8 @@ namespace Ogre {
     {
 
             OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex
+        if (!grp->unindexedLocations.empty())
+            indexLocations(std::vector<ResourceGroup*>(1, grp));
 
         // Try indexes first
         ResourceLocationIndex::iterator rit = grp->resourceIndexCaseSensitive.find(resourceName);
@@ -1608,6 +1723,216 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    StringVectorPtr ResourceGroupManager::scanLocation(const ResourceLocation& loc, uint32& stamp) const
+    {
+        if (mLocationIndexCaching)
+        {
+            CachedLocationIndex entry = {0, StringVectorPtr()};
+            {
+                OGRE_LOCK_MUTEX(mLocationIndexCacheMutex);
+                LocationIndexCache::const_iterator it = mLocationIndexCache.find(locationCacheKey(loc));
+                if (it != mLocationIndexCache.end())
+                    entry = it->second;
+            }
+
+            if (entry.files && locationStamp(loc.archive, *entry.files) == entry.stamp)
+            {
+                stamp = entry.stamp;
+                return entry.files;
+            }
+        }
+
+        StringVectorPtr files = loc.archive->find("*", loc.recursive);
+        if (mLocationIndexCaching)
+            stamp = locationStamp(loc.archive, *files);
+        return files;
+    }
+    //-----------------------------------------------------------------------
+    void ResourceGroupManager::indexLocations(const std::vector<ResourceGroup*>& groups) const
+    {
+        // take the unindexed locations, so scanning needs no group lock
+        typedef std::pair<ResourceGroup*, ResourceLocation> GroupLocation;
+        std::vector<GroupLocation> locations;
+        for (size_t i = 0; i < groups.size(); i++)
+        {
+            ResourceGroup* grp = groups[i];
+            OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex
+            for (size_t j = 0; j < grp->unindexedLocations.size(); j++)
+                locations.push_back(GroupLocation(grp, grp->unindexedLocations[j]));
+            grp->unindexedLocations.clear();
+        }
+
+        if (locations.empty())
+            return;
+
+        std::vector<StringVectorPtr> files(locations.size());
+        std::vector<uint32> stamps(locations.size());
+        std::vector<std::exception_ptr> errors(locations.size());
+        auto scan = [&](size_t i) {
+            try
+            {
+                files[i] = scanLocation(locations[i].second, stamps[i]);
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        };
+
+        Root* root = Root::getSingletonPtr();
+        if (root && root->getWorkQueue())
+            root->getWorkQueue()->parallelFor(locations.size(), scan);
+        else
+            for (size_t i = 0; i < locations.size(); i++)
+                scan(i);
+
+        // index in the order the locations were added, so earlier locations take precedence
+        for (size_t first = 0, last = 0; first < locations.size(); first = last)
+        {
+            ResourceGroup* grp = locations[first].first;
+            size_t count = 0;
+            for (; last < locations.size() && locations[last].first == grp; last++)
+            {
+                if (files[last])
+                    count += files[last]->size();
+            }
+
+            OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex
+            grp->resourceIndexCaseSensitive.reserve(grp->resourceIndexCaseSensitive.size() + count);
+#if !OGRE_RESOURCEMANAGER_STRICT
+            grp->resourceIndexCaseInsensitive.reserve(grp->resourceIndexCaseInsensitive.size() + count);
+#endif
+            for (size_t i = first; i < last; i++)
+            {
+                // as if it was never added, like when scanning in addResourceLocation
+                if (errors[i])
+                {
+                    Archive* arch = locations[i].second.archive;
+                    for (LocationList::iterator li = grp->locationList.begin(); li != grp->locationList.end(); ++li)
+                    {
+                        if (li->archive == arch)
+                        {
+                            grp->locationList.erase(li);
+                            break;
+                        }
+                    }
+                    continue;
+                }
+
+                Archive* arch = locations[i].second.archive;
+                for (StringVector::iterator it = files[i]->begin(); it != files[i]->end(); ++it)
+                    grp->addToIndex(*it, arch);
+            }
+        }
+
+        if (mLocationIndexCaching)
+        {
+            OGRE_LOCK_MUTEX(mLocationIndexCacheMutex);
+            for (size_t i = 0; i < locations.size(); i++)
+            {
+                if (errors[i])
+                    continue;
+                CachedLocationIndex entry = {stamps[i], files[i]};
+                mLocationIndexCache[locationCacheKey(locations[i].second)] = entry;
+            }
+        }
+
+        for (size_t i = 0; i < errors.size(); i++)
+        {
+            if (errors[i])
+                std::rethrow_exception(errors[i]);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ResourceGroupManager::setLocationIndexCaching(bool val)
+    {
+        mLocationIndexCaching = val;
+        if (!val)
+        {
+            OGRE_LOCK_MUTEX(mLocationIndexCacheMutex);
+            mLocationIndexCache.clear();
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ResourceGroupManager::saveLocationIndexCache(const DataStreamPtr& stream) const
+    {
+        if (!stream->isWriteable())
+        {
+            OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE,
+                "Unable to write to stream " + stream->getName());
+        }
+
+        OGRE_LOCK_MUTEX(mLocationIndexCacheMutex);
+
+        StreamSerialiser serialiser(stream);
+        serialiser.writeChunkBegin(CACHE_CHUNK_ID, 1);
+
+        uint32 numLocations = static_cast<uint32>(mLocationIndexCache.size());
+        serialiser.write(&numLocations);
+        for (const auto& entry : mLocationIndexCache)
+        {
+            serialiser.write(&entry.first);
+            serialiser.write(&entry.second.stamp);
+
+            const StringVector& files = *entry.second.files;
+            uint32 numFiles = static_cast<uint32>(files.size());
+            serialiser.write(&numFiles);
+            for (const String& f : files)
+                serialiser.write(&f);
+        }
+
+        serialiser.writeChunkEnd(CACHE_CHUNK_ID);
+    }
+    //-----------------------------------------------------------------------
+    void ResourceGroupManager::loadLocationIndexCache(const DataStreamPtr& stream)
+    {
+        OGRE_LOCK_MUTEX(mLocationIndexCacheMutex);
+        mLocationIndexCaching = true;
+        mLocationIndexCache.clear();
+
+        StreamSerialiser serialiser(stream);
+        const StreamSerialiser::Chunk* chunk;
+
+        try
+        {
+            chunk = serialiser.readChunkBegin();
+        }
+        catch (const InvalidStateException& e)
+        {
+            LogManager::getSingleton().logWarning("Could not load Resource Location Index Cache: " +
+                                                  e.getDescription());
+            return;
+        }
+
+        if (chunk->id != CACHE_CHUNK_ID || chunk->version != 1)
+        {
+            LogManager::getSingleton().logWarning("Invalid Resource Location Index Cache");
+            return;
+        }
+
+        uint32 numLocations = 0;
+        serialiser.read(&numLocations);
+        mLocationIndexCache.reserve(numLocations);
+        for (uint32 i = 0; i < numLocations; i++)
+        {
+            String key;
+            serialiser.read(&key);
+
+            CachedLocationIndex entry;
+            serialiser.read(&entry.stamp);
+
+            uint32 numFiles = 0;
+            serialiser.read(&numFiles);
+            entry.files.reset(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(numFiles), SPFM_DELETE_T);
+            for (uint32 j = 0; j < numFiles; j++)
+                serialiser.read(&entry.files->at(j));
+
+            mLocationIndexCache[key] = entry;
+        }
+
+        serialiser.readChunkEnd(CACHE_CHUNK_ID);
+    }
+    //-----------------------------------------------------------------------
     time_t ResourceGroupManager::resourceModifiedTime(const String& groupName, const String& resourceName) const
     {
         // Try to find in resource index first
@@ -178,6 +178,8 @@ namespace Ogre {
 
         mFileSystemArchiveFactory.reset(new FileSystemArchiveFactory());
         ArchiveManager::getSingleton().addArchiveFactory( mFileSystemArchiveFactory.get() );
+        mPackArchiveFactory.reset(new PackArchiveFactory());
+        ArchiveManager::getSingleton().addArchiveFactory( mPackArchiveFactory.get() );
 #   if OGRE_NO_ZIP_ARCHIVE == 0
         mZipArchiveFactory.reset(new ZipArchiveFactory());
         ArchiveManager::getSingleton().addArchiveFactory( mZipArchiveFactory.get() );
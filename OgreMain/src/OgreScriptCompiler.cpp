@@ -30,9 +30,73 @@ THE SOFTWARE.
 #include "OgreScriptParser.h"
 #include "OgreBuiltinScriptTranslators.h"
 #include "OgreComponents.h"
+#include "OgreMurmurHash3.h"
+#include "OgreStreamSerialiser.h"
 
 namespace Ogre
 {
+namespace
+{
+    uint32 SCRIPT_CACHE_CHUNK_ID = StreamSerialiser::makeIdentifier("OSCC"); // Ogre Script Compiler Cache
+
+    void writeUInt32(std::vector<uchar>& out, uint32 v)
+    {
+        out.insert(out.end(), (const uchar*)&v, (const uchar*)&v + sizeof(v));
+    }
+
+    /// flattens the concrete nodes, the file name is not stored as it is the same for all nodes
+    void writeNodes(std::vector<uchar>& out, const ConcreteNodeList& nodes)
+    {
+        writeUInt32(out, uint32(nodes.size()));
+        for (ConcreteNodeList::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+        {
+            const ConcreteNode& node = **i;
+            writeUInt32(out, uint32(node.token.size()));
+            out.insert(out.end(), node.token.begin(), node.token.end());
+            writeUInt32(out, node.line);
+            out.push_back(uchar(node.type));
+            writeNodes(out, node.children);
+        }
+    }
+
+    bool readUInt32(const uchar*& p, const uchar* end, uint32& v)
+    {
+        if (size_t(end - p) < sizeof(v))
+            return false;
+        memcpy(&v, p, sizeof(v));
+        p += sizeof(v);
+        return true;
+    }
+
+    bool readNodes(const uchar*& p, const uchar* end, ConcreteNodeList& nodes, ConcreteNode* parent,
+                   const String& file)
+    {
+        uint32 count;
+        if (!readUInt32(p, end, count))
+            return false;
+
+        for (uint32 i = 0; i < count; i++)
+        {
+            ConcreteNodePtr node(OGRE_NEW ConcreteNode());
+            uint32 len;
+            if (!readUInt32(p, end, len) || size_t(end - p) < len)
+                return false;
+            node->token.assign((const char*)p, len);
+            p += len;
+
+            if (!readUInt32(p, end, node->line) || p == end || *p > CNT_COLON)
+                return false;
+            node->type = ConcreteNodeType(*p++);
+            node->file = file;
+            node->parent = parent;
+
+            if (!readNodes(p, end, node->children, node.get(), file))
+                return false;
+            nodes.push_back(node);
+        }
+        return true;
+    }
+}
     // AbstractNode
     AbstractNode::AbstractNode(AbstractNode *ptr)
         :line(0), type(ANT_UNKNOWN), parent(ptr)
@@ -562,7 +626,9 @@ namespace Ogre
             if (!stream)
                 return retval;
 
-            nodes = ScriptParser::parse(ScriptLexer::tokenize(stream->getAsString(), name));
+            ScriptCompilerManager* mgr = ScriptCompilerManager::getSingletonPtr();
+            String str = stream->getAsString();
+            nodes = mgr ? mgr->_parse(str, name) : ScriptParser::parse(ScriptLexer::tokenize(str, name));
         }
 
         if(nodes)
@@ -1570,6 +1636,9 @@ namespace Ogre
 
         mBuiltinTranslatorManager = OGRE_NEW BuiltinScriptTranslatorManager();
         mManagers.push_back(mBuiltinTranslatorManager);
+
+        mScriptCaching = false;
+        mScriptCacheDirty = false;
     }
     //-----------------------------------------------------------------------
     ScriptCompilerManager::~ScriptCompilerManager()
@@ -1653,13 +1722,146 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void ScriptCompilerManager::parseScript(DataStreamPtr& stream, const String& groupName)
     {
-        ConcreteNodeListPtr nodes =
-            ScriptParser::parse(ScriptLexer::tokenize(stream->getAsString(), stream->getName()));
+        _compile(_parse(stream->getAsString(), stream->getName()), groupName);
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::_compile(const ConcreteNodeListPtr& nodes, const String& groupName)
+    {
+        // compile is not reentrant
+        OGRE_LOCK_AUTO_MUTEX;
+        mScriptCompiler.compile(nodes, groupName);
+    }
+    //-----------------------------------------------------------------------
+    ConcreteNodeListPtr ScriptCompilerManager::_parse(const String& str, const String& source)
+    {
+        if (!mScriptCaching)
+            return ScriptParser::parse(ScriptLexer::tokenize(str, source));
+
+        uint64 hash[2];
+        MurmurHash3_x64_128(str.data(), str.size(), 0, hash);
+        std::pair<uint64, uint64> key(hash[0], hash[1]);
+
+        // copied, as other threads may drop an invalid entry while we read it
+        std::vector<uchar> data;
         {
-            // compile is not reentrant
-            OGRE_LOCK_AUTO_MUTEX;
-            mScriptCompiler.compile(nodes, groupName);
+            OGRE_WQ_LOCK_MUTEX(mScriptCacheMutex);
+            ScriptCache::iterator it = mScriptCache.find(key);
+            if (it != mScriptCache.end())
+            {
+                it->second.used = true;
+                data = it->second.nodes;
+            }
+        }
+
+        if (!data.empty())
+        {
+            const uchar* p = data.data();
+            const uchar* end = p + data.size();
+            ConcreteNodeListPtr nodes(OGRE_NEW_T(ConcreteNodeList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
+            if (readNodes(p, end, *nodes, NULL, source) && p == end)
+                return nodes;
+
+            LogManager::getSingleton().logWarning("Invalid entry for '" + source + "' in the script cache");
+            OGRE_WQ_LOCK_MUTEX(mScriptCacheMutex);
+            mScriptCache.erase(key);
+        }
+
+        // parse errors throw, so only valid scripts are cached
+        ConcreteNodeListPtr nodes = ScriptParser::parse(ScriptLexer::tokenize(str, source));
+
+        std::vector<uchar> serialised;
+        writeNodes(serialised, *nodes);
+
+        OGRE_WQ_LOCK_MUTEX(mScriptCacheMutex);
+        CachedScript& entry = mScriptCache[key];
+        entry.nodes.swap(serialised);
+        entry.used = true;
+        mScriptCacheDirty = true;
+        return nodes;
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::setScriptCaching(bool val)
+    {
+        OGRE_WQ_LOCK_MUTEX(mScriptCacheMutex);
+        mScriptCaching = val;
+        if (!val)
+            mScriptCache.clear();
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::saveScriptCache(const DataStreamPtr& stream) const
+    {
+        if (!stream->isWriteable())
+        {
+            OGRE_EXCEPT(Exception::ERR_CANNOT_WRITE_TO_FILE,
+                "Unable to write to stream " + stream->getName());
+        }
+
+        OGRE_WQ_LOCK_MUTEX(mScriptCacheMutex);
+
+        // scripts that were not parsed during this run are dropped
+        uint32 numScripts = 0;
+        for (const auto& entry : mScriptCache)
+            numScripts += entry.second.used;
+
+        StreamSerialiser serialiser(stream);
+        serialiser.writeChunkBegin(SCRIPT_CACHE_CHUNK_ID, 1);
+        serialiser.write(&numScripts);
+        for (const auto& entry : mScriptCache)
+        {
+            if (!entry.second.used)
+                continue;
+
+            serialiser.write(&entry.first.first);
+            serialiser.write(&entry.first.second);
+            uint32 size = static_cast<uint32>(entry.second.nodes.size());
+            serialiser.write(&size);
+            serialiser.writeData(entry.second.nodes.data(), 1, size);
+        }
+        serialiser.writeChunkEnd(SCRIPT_CACHE_CHUNK_ID);
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::loadScriptCache(const DataStreamPtr& stream)
+    {
+        OGRE_WQ_LOCK_MUTEX(mScriptCacheMutex);
+        mScriptCaching = true;
+        mScriptCache.clear();
+
+        StreamSerialiser serialiser(stream);
+        const StreamSerialiser::Chunk* chunk;
+
+        try
+        {
+            chunk = serialiser.readChunkBegin();
+        }
+        catch (const InvalidStateException& e)
+        {
+            LogManager::getSingleton().logWarning("Could not load Script Cache: " + e.getDescription());
+            return;
+        }
+
+        if (chunk->id != SCRIPT_CACHE_CHUNK_ID || chunk->version != 1)
+        {
+            LogManager::getSingleton().logWarning("Invalid Script Cache");
+            return;
+        }
+
+        uint32 numScripts = 0;
+        serialiser.read(&numScripts);
+        for (uint32 i = 0; i < numScripts; i++)
+        {
+            std::pair<uint64, uint64> key;
+            serialiser.read(&key.first);
+            serialiser.read(&key.second);
+
+            uint32 size = 0;
+            serialiser.read(&size);
+            CachedScript& entry = mScriptCache[key];
+            entry.nodes.resize(size);
+            serialiser.readData(entry.nodes.data(), 1, size);
+            entry.used = false;
         }
+        serialiser.readChunkEnd(SCRIPT_CACHE_CHUNK_ID);
+        mScriptCacheDirty = false;
     }
 
     //-------------------------------------------------------------------------
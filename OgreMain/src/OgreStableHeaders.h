@@ -70,6 +70,7 @@ THE SOFTWARE.
 #include "OgreMeshSerializer.h"
 #include "OgreMovableObject.h"
 #include "OgreNode.h"
+#include "OgrePack.h"
 #include "OgreParticleSystemManager.h"
 #include "OgrePass.h"
 #include "OgrePlane.h"
@@ -54,7 +54,8 @@ namespace Ogre {
         mVisible(true),
         mRenderQueueID(RENDER_QUEUE_MAIN),
         mRenderQueueIDSet(false),
-        mVisibilityFlags(Ogre::MovableObject::getDefaultVisibilityFlags())
+        mVisibilityFlags(Ogre::MovableObject::getDefaultVisibilityFlags()),
+        mInstancingThreshold(0)
     {
     }
     //--------------------------------------------------------------------------
@@ -650,6 +651,7 @@ namespace Ogre {
         of << "Origin: " << mOrigin << std::endl;
         of << "Max distance: " << mUpperDistance << std::endl;
         of << "Casts shadows?: " << mCastShadows << std::endl;
+        of << "Instancing threshold: " << mInstancingThreshold << std::endl;
         of << std::endl;
         for (RegionMap::const_iterator ri = mRegionMap.begin();
             ri != mRegionMap.end(); ++ri)
@@ -1246,6 +1248,18 @@ namespace Ogre {
     }
     //--------------------------------------------------------------------------
     void StaticGeometry::MaterialBucket::assign(QueuedGeometry* qgeom)
+    {
+        if (mParent->getParent()->getParent()->getInstancingThreshold() > 0)
+        {
+            // We can only tell how often the geometry repeats once everything
+            // has been assigned, so hold it back until build
+            mDeferredGeometry.push_back(qgeom);
+            return;
+        }
+        assignToGeometryBucket(qgeom);
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::MaterialBucket::assignToGeometryBucket(QueuedGeometry* qgeom)
     {
         // Look up any current geometry
         String formatString = getGeometryFormatString(qgeom->geometry);
@@ -1277,6 +1291,70 @@ namespace Ogre {
         }
     }
     //--------------------------------------------------------------------------
+    void StaticGeometry::MaterialBucket::assignToInstancedGeometryBucket(QueuedGeometry* qgeom)
+    {
+        CurrentInstancedGeometryMap::iterator gi =
+            mCurrentInstancedGeometryMap.find(qgeom->geometry);
+        if (gi != mCurrentInstancedGeometryMap.end() && gi->second->assign(qgeom))
+            return;
+
+        // No bucket yet or the current one is full
+        GeometryBucket* gbucket = OGRE_NEW InstancedGeometryBucket(this,
+            getGeometryFormatString(qgeom->geometry), qgeom->geometry->vertexData,
+            qgeom->geometry->indexData);
+        mGeometryBucketList.push_back(gbucket);
+        mCurrentInstancedGeometryMap[qgeom->geometry] = gbucket;
+        if (!gbucket->assign(qgeom))
+        {
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                "Somehow we couldn't fit the requested geometry even in a "
+                "brand new InstancedGeometryBucket!! Must be a bug, please report.",
+                "StaticGeometry::MaterialBucket::assignToInstancedGeometryBucket");
+        }
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::MaterialBucket::assignDeferredGeometry(bool stencilShadows)
+    {
+        if (mDeferredGeometry.empty())
+            return;
+
+        Region* region = mParent->getParent();
+        size_t threshold = region->getParent()->getInstancingThreshold();
+
+        // Instanced geometry is not part of the region edge list and
+        // the instance matrices are not camera relative
+        bool allowInstancing = !stencilShadows &&
+            !region->mSceneMgr->getCameraRelativeRendering();
+
+        // Count the repeats of each SubMesh (at this LOD)
+        typedef std::map<SubMeshLodGeometryLink*, size_t> RepeatCountMap;
+        RepeatCountMap repeatCounts;
+        if (allowInstancing)
+        {
+            for (QueuedGeometryList::iterator qi = mDeferredGeometry.begin();
+                qi != mDeferredGeometry.end(); ++qi)
+            {
+                ++repeatCounts[(*qi)->geometry];
+            }
+        }
+
+        for (QueuedGeometryList::iterator qi = mDeferredGeometry.begin();
+            qi != mDeferredGeometry.end(); ++qi)
+        {
+            QueuedGeometry* qgeom = *qi;
+            if (allowInstancing && repeatCounts[qgeom->geometry] >= threshold &&
+                InstancedGeometryBucket::isSupported(qgeom->geometry))
+            {
+                assignToInstancedGeometryBucket(qgeom);
+            }
+            else
+            {
+                assignToGeometryBucket(qgeom);
+            }
+        }
+        mDeferredGeometry.clear();
+    }
+    //--------------------------------------------------------------------------
     void StaticGeometry::MaterialBucket::build(bool stencilShadows)
     {
         mTechnique = 0;
@@ -1288,6 +1366,7 @@ namespace Ogre {
                 "StaticGeometry::MaterialBucket::build");
         }
         mMaterial->load();
+        assignDeferredGeometry(stencilShadows);
         // tell the geometry buckets to build
         for (GeometryBucketList::iterator i = mGeometryBucketList.begin();
             i != mGeometryBucketList.end(); ++i)
@@ -1626,21 +1705,22 @@ namespace Ogre {
                         case VES_NORMAL:
                         case VES_TANGENT:
                         case VES_BINORMAL:
-                            tmp.x = *pSrcReal++;
-                            tmp.y = *pSrcReal++;
-                            tmp.z = *pSrcReal++;
+                        {
+                            // may be packed, w holds the parity of tangents
+                            float n[4];
+                            VertexElement::convertValue(elem.getType(), pSrcReal, VET_FLOAT4, n);
+                            tmp = Vector3(n[0], n[1], n[2]);
                             // scale (invert)
                             tmp = tmp / geom->scale;
                             tmp.normalise();
                             // rotation
                             tmp = geom->orientation * tmp;
-                            *pDstReal++ = tmp.x;
-                            *pDstReal++ = tmp.y;
-                            *pDstReal++ = tmp.z;
-                            // copy parity for tangent.
-                            if (elem.getType() == Ogre::VET_FLOAT4)
-                                *pDstReal = *pSrcReal;
+                            n[0] = tmp.x;
+                            n[1] = tmp.y;
+                            n[2] = tmp.z;
+                            VertexElement::convertValue(VET_FLOAT4, n, elem.getType(), pDstReal);
                             break;
+                        }
                         default:
                             // just raw copy
                             memcpy(pDstReal, pSrcReal,
@@ -1721,6 +1801,109 @@ namespace Ogre {
 
     }
     //--------------------------------------------------------------------------
+    //--------------------------------------------------------------------------
+    StaticGeometry::InstancedGeometryBucket::InstancedGeometryBucket(
+        MaterialBucket* parent, const String& formatString,
+        const VertexData* vData, const IndexData* iData)
+        : GeometryBucket(parent, formatString, vData, iData)
+    {
+        // Unlike the regular bucket we keep referencing the source buffers
+        mVertexData->vertexStart = vData->vertexStart;
+        mVertexData->vertexCount = vData->vertexCount;
+        mIndexData->indexStart = iData->indexStart;
+        mIndexData->indexCount = iData->indexCount;
+
+        // Add an extra source holding a 3x4 world matrix per instance,
+        // same layout as InstanceBatchHW
+        VertexDeclaration* dcl = mVertexData->vertexDeclaration;
+        mInstanceSource = dcl->getMaxSource() + 1;
+        unsigned short nextTexCoord = dcl->getNextFreeTextureCoordinate();
+        size_t offset = 0;
+        for (int i = 0; i < 3; ++i)
+        {
+            dcl->addElement(mInstanceSource, offset, VET_FLOAT4,
+                VES_TEXTURE_COORDINATES, nextTexCoord++);
+            offset += VertexElement::getTypeSize(VET_FLOAT4);
+        }
+    }
+    //--------------------------------------------------------------------------
+    bool StaticGeometry::InstancedGeometryBucket::isSupported(
+        const SubMeshLodGeometryLink* geom)
+    {
+        RenderSystem* rend = Root::getSingleton().getRenderSystem();
+        const RenderSystemCapabilities* caps = rend ? rend->getCapabilities() : NULL;
+        if (!caps || !caps->hasCapability(RSC_VERTEX_BUFFER_INSTANCE_DATA))
+            return false;
+
+        // The world matrix takes 3 more attributes, passed as texture coordinates
+        const VertexDeclaration* dcl = geom->vertexData->vertexDeclaration;
+        return dcl->getElementCount() + 3 <= caps->getNumVertexAttributes() &&
+               dcl->getNextFreeTextureCoordinate() + 3 <= OGRE_MAX_TEXTURE_COORD_SETS;
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::InstancedGeometryBucket::getRenderOperation(RenderOperation& op)
+    {
+        GeometryBucket::getRenderOperation(op);
+        op.numberOfInstances = mQueuedGeometry.size();
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::InstancedGeometryBucket::getWorldTransforms(Matrix4* xform) const
+    {
+        // the instance data is relative to the region centre, like the
+        // vertices of the regular buckets
+        *xform = mParent->getParent()->getParent()->_getParentNodeFullTransform();
+    }
+    //--------------------------------------------------------------------------
+    bool StaticGeometry::InstancedGeometryBucket::assign(QueuedGeometry* qgeom)
+    {
+        // This value is arbitrary, same as InstanceBatchHW::calculateMaxNumInstances
+        if (mQueuedGeometry.size() >= 65535)
+            return false;
+
+        mQueuedGeometry.push_back(qgeom);
+        return true;
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::InstancedGeometryBucket::build(bool stencilShadows)
+    {
+        HardwareVertexBufferSharedPtr vbuf =
+            HardwareBufferManager::getSingleton().createVertexBuffer(
+                mVertexData->vertexDeclaration->getVertexSize(mInstanceSource),
+                mQueuedGeometry.size(),
+                HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+        vbuf->setIsInstanceData(true);
+        vbuf->setInstanceDataStepRate(1);
+        mVertexData->vertexBufferBinding->setBinding(mInstanceSource, vbuf);
+
+        Vector3 regionCentre = mParent->getParent()->getParent()->getCentre();
+        HardwareBufferLockGuard vbufLock(vbuf, HardwareBuffer::HBL_DISCARD);
+        float* pDest = static_cast<float*>(vbufLock.pData);
+        for (QueuedGeometryList::iterator gi = mQueuedGeometry.begin();
+            gi != mQueuedGeometry.end(); ++gi)
+        {
+            QueuedGeometry* geom = *gi;
+            Affine3 xform(geom->position - regionCentre, geom->orientation, geom->scale);
+            for (int r = 0; r < 3; ++r)
+            {
+                for (int c = 0; c < 4; ++c)
+                {
+                    *pDest++ = static_cast<float>(xform[r][c]);
+                }
+            }
+        }
+    }
+    //--------------------------------------------------------------------------
+    void StaticGeometry::InstancedGeometryBucket::dump(std::ofstream& of) const
+    {
+        of << "Instanced Geometry Bucket" << std::endl;
+        of << "-------------------------" << std::endl;
+        of << "Format string: " << mFormatString << std::endl;
+        of << "Instances: " << mQueuedGeometry.size() << std::endl;
+        of << "Vertex count: " << mVertexData->vertexCount << std::endl;
+        of << "Index count: " << mIndexData->indexCount << std::endl;
+        of << "-------------------------" << std::endl;
+    }
+    //--------------------------------------------------------------------------
 
 }
 
@@ -45,6 +45,8 @@ namespace Ogre {
         mHardwarePoseCount = 0;
         mIndexStart = 0;
         mIndexEnd = 0;
+        mMeshletRangeActive = false;
+        mMeshletsVisible = true;
         setMaterial(MaterialManager::getSingleton().getDefaultMaterial());
     }
     SubEntity::~SubEntity() = default; // ensure unique_ptr destructors are in cpp
@@ -115,6 +117,76 @@ namespace Ogre {
             op.indexData->indexStart = mIndexStart;
             op.indexData->indexCount = mIndexEnd;
         }
+        else if(mMeshletRangeActive)
+        {
+            // Only draw the range spanned by the visible meshlets
+            op.indexData = mMeshletIndexData.get();
+        }
+    }
+    //-----------------------------------------------------------------------
+    void SubEntity::updateVisibleMeshlets(const Camera* cam)
+    {
+        mMeshletRangeActive = false;
+        mMeshletsVisible = true;
+
+        // The bounds are only valid for the full detail, undeformed geometry
+        const SubMesh::MeshletList& meshlets = mSubMesh->meshlets;
+        if (meshlets.empty() || !mParentEntity->getMeshletCullingEnabled() ||
+            mParentEntity->mMeshLodIndex != 0 || mIndexStart != mIndexEnd ||
+            mParentEntity->hasSkeleton() || mParentEntity->hasVertexAnimation())
+            return;
+
+        const Affine3& xform = mParentEntity->_getParentNodeFullTransform();
+        const Vector3& scale = mParentEntity->getParentNode()->_getDerivedScale();
+        Real radiusScale = std::max(std::abs(scale.x), std::max(std::abs(scale.y), std::abs(scale.z)));
+
+        // Back face culling needs the winding the material culls, and a uniform
+        // scale so the normal cone keeps its shape
+        bool coneCulling = !cam->isReflected() && scale.x > 0 &&
+            Math::RealEqual(scale.x, scale.y) && Math::RealEqual(scale.x, scale.z) &&
+            cam->getSceneManager()->_getCurrentRenderStage() != SceneManager::IRS_RENDER_TO_TEXTURE;
+        Technique* tech = getTechnique();
+        coneCulling = coneCulling && tech;
+        if (coneCulling)
+        {
+            const Technique::Passes& passes = tech->getPasses();
+            for (size_t i = 0; i < passes.size() && coneCulling; ++i)
+                coneCulling = passes[i]->getCullingMode() == CULL_CLOCKWISE;
+        }
+        const Vector3& cameraPosition = cam->getDerivedPosition();
+
+        size_t first = meshlets.size(), last = 0;
+        for (size_t i = 0; i < meshlets.size(); ++i)
+        {
+            const SubMesh::Meshlet& meshlet = meshlets[i];
+            Sphere bounds(xform * meshlet.center, meshlet.radius * radiusScale);
+            if (!cam->isVisible(bounds))
+                continue;
+
+            if (coneCulling && meshlet.coneCutoff < 1)
+            {
+                Vector3 axis = xform.linear() * meshlet.coneAxis / scale.x;
+                Vector3 toCenter = bounds.getCenter() - cameraPosition;
+                if (toCenter.dotProduct(axis) >= meshlet.coneCutoff * toCenter.length() + bounds.getRadius())
+                    continue;
+            }
+
+            first = std::min(first, i);
+            last = i;
+        }
+
+        if (first == meshlets.size())
+        {
+            mMeshletsVisible = false;
+            return;
+        }
+
+        if (!mMeshletIndexData)
+            mMeshletIndexData.reset(OGRE_NEW IndexData());
+        mMeshletIndexData->indexBuffer = mSubMesh->indexData->indexBuffer;
+        mMeshletIndexData->indexStart = meshlets[first].indexStart;
+        mMeshletIndexData->indexCount = meshlets[last].indexStart + meshlets[last].indexCount - meshlets[first].indexStart;
+        mMeshletRangeActive = true;
     }
     //-----------------------------------------------------------------------
     void SubEntity::setIndexDataStartIndex(size_t start_index)
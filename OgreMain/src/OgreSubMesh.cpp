@@ -429,6 +429,195 @@ namespace Ogre {
         vbuf->unlock ();
     }
     //---------------------------------------------------------------------
+    void SubMesh::generateMeshlets(size_t maxTriangles)
+    {
+        meshlets.clear();
+
+        size_t triangleCount = indexData->indexCount / 3;
+        if (maxTriangles == 0 || triangleCount == 0 || !indexData->indexBuffer)
+            return;
+
+        OgreAssert(operationType == RenderOperation::OT_TRIANGLE_LIST,
+                   "Meshlets can only be generated for triangle lists");
+
+        VertexData *vert = useSharedVertices ? parent->sharedVertexData : vertexData;
+        const VertexElement *poselem = vert->vertexDeclaration->findElementBySemantic(VES_POSITION);
+        HardwareVertexBufferSharedPtr vbuf = vert->vertexBufferBinding->getBuffer(poselem->getSource());
+
+        std::vector<Vector3> positions(vert->vertexCount);
+        {
+            HardwareBufferLockGuard vertexLock(vbuf, HardwareBuffer::HBL_READ_ONLY);
+            size_t vsz = vbuf->getVertexSize();
+            uint8 *vdata = static_cast<uint8*>(vertexLock.pData) + vert->vertexStart * vsz;
+            for (size_t v = 0; v < positions.size(); ++v, vdata += vsz)
+            {
+                float *p;
+                poselem->baseVertexPointerToElement(vdata, &p);
+                positions[v] = Vector3(p[0], p[1], p[2]);
+            }
+        }
+
+        const HardwareIndexBufferSharedPtr& ibuf = indexData->indexBuffer;
+        bool use32bit = ibuf->getType() == HardwareIndexBuffer::IT_32BIT;
+        HardwareBufferLockGuard indexLock(ibuf, indexData->indexStart * ibuf->getIndexSize(),
+                                          triangleCount * 3 * ibuf->getIndexSize(), HardwareBuffer::HBL_NORMAL);
+        std::vector<uint32> indices(triangleCount * 3);
+        if (use32bit)
+            memcpy(&indices[0], indexLock.pData, indices.size() * sizeof(uint32));
+        else
+            std::copy(static_cast<uint16*>(indexLock.pData), static_cast<uint16*>(indexLock.pData) + indices.size(),
+                      indices.begin());
+
+        for (size_t i = 0; i < indices.size(); ++i)
+            OgreAssert(indices[i] < positions.size(), "Index out of range");
+
+        // Triangles sharing each vertex, in one flat array
+        std::vector<uint32> firstTriangle(positions.size() + 1, 0);
+        for (size_t i = 0; i < indices.size(); ++i)
+            ++firstTriangle[indices[i] + 1];
+        for (size_t v = 0; v < positions.size(); ++v)
+            firstTriangle[v + 1] += firstTriangle[v];
+        std::vector<uint32> adjacency(indices.size());
+        std::vector<uint32> fill(firstTriangle.begin(), firstTriangle.end() - 1);
+        for (size_t i = 0; i < indices.size(); ++i)
+            adjacency[fill[indices[i]]++] = static_cast<uint32>(i / 3);
+
+        std::vector<Vector3> centroids(triangleCount), normals(triangleCount);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            const Vector3& a = positions[indices[t * 3]];
+            const Vector3& b = positions[indices[t * 3 + 1]];
+            const Vector3& c = positions[indices[t * 3 + 2]];
+            centroids[t] = (a + b + c) / 3;
+            normals[t] = (b - a).crossProduct(c - a);
+            normals[t].normalise();
+        }
+
+        const uint32 NONE = ~static_cast<uint32>(0);
+        std::vector<uint32> meshletOf(triangleCount, NONE);
+        std::vector<uint32> candidateOf(triangleCount, NONE);
+        std::vector<uint32> order;
+        std::vector<uint32> candidates;
+        order.reserve(triangleCount);
+
+        for (size_t seed = 0; seed < triangleCount; ++seed)
+        {
+            if (meshletOf[seed] != NONE)
+                continue;
+
+            // Grow the meshlet over the neighbouring triangle closest to its centre
+            uint32 id = static_cast<uint32>(meshlets.size());
+            size_t first = order.size();
+            Vector3 centroidSum = Vector3::ZERO;
+            candidates.clear();
+            uint32 next = static_cast<uint32>(seed);
+            while (next != NONE)
+            {
+                meshletOf[next] = id;
+                order.push_back(next);
+                centroidSum += centroids[next];
+                if (order.size() - first == maxTriangles)
+                    break;
+
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    uint32 v = indices[next * 3 + k];
+                    for (uint32 j = firstTriangle[v]; j < firstTriangle[v + 1]; ++j)
+                    {
+                        uint32 t = adjacency[j];
+                        if (meshletOf[t] == NONE && candidateOf[t] != id)
+                        {
+                            candidateOf[t] = id;
+                            candidates.push_back(t);
+                        }
+                    }
+                }
+
+                Vector3 centre = centroidSum / Real(order.size() - first);
+                Real bestDistance = 0;
+                size_t best = candidates.size();
+                for (size_t c = 0; c < candidates.size(); ++c)
+                {
+                    Real distance = centre.squaredDistance(centroids[candidates[c]]);
+                    if (best == candidates.size() || distance < bestDistance)
+                    {
+                        best = c;
+                        bestDistance = distance;
+                    }
+                }
+
+                next = NONE;
+                if (best != candidates.size())
+                {
+                    next = candidates[best];
+                    candidates[best] = candidates.back();
+                    candidates.pop_back();
+                }
+            }
+
+            // Bounding sphere around the box centre and the cone of the normals
+            AxisAlignedBox box;
+            Vector3 normalSum = Vector3::ZERO;
+            for (size_t i = first; i < order.size(); ++i)
+            {
+                for (size_t k = 0; k < 3; ++k)
+                    box.merge(positions[indices[order[i] * 3 + k]]);
+                normalSum += normals[order[i]];
+            }
+
+            Meshlet meshlet;
+            meshlet.indexStart = static_cast<uint32>(indexData->indexStart + first * 3);
+            meshlet.indexCount = static_cast<uint32>((order.size() - first) * 3);
+            meshlet.center = box.getCenter();
+            meshlet.radius = 0;
+            for (size_t i = first; i < order.size(); ++i)
+            {
+                for (size_t k = 0; k < 3; ++k)
+                    meshlet.radius = std::max(meshlet.radius,
+                                              meshlet.center.distance(positions[indices[order[i] * 3 + k]]));
+            }
+
+            meshlet.coneAxis = normalSum;
+            meshlet.coneCutoff = 1;
+            if (meshlet.coneAxis.normalise() > Real(1e-6))
+            {
+                Real minDot = 1;
+                for (size_t i = first; i < order.size(); ++i)
+                    minDot = std::min(minDot, meshlet.coneAxis.dotProduct(normals[order[i]]));
+                // A cone wider than a hemisphere always has front faces
+                if (minDot > 0)
+                    meshlet.coneCutoff = Math::Sqrt(1 - minDot * minDot);
+            }
+            meshlets.push_back(meshlet);
+        }
+
+        // write the triangles back in meshlet order
+        if (use32bit)
+        {
+            uint32* dest = static_cast<uint32*>(indexLock.pData);
+            for (size_t i = 0; i < order.size(); ++i, dest += 3)
+                memcpy(dest, &indices[order[i] * 3], 3 * sizeof(uint32));
+        }
+        else
+        {
+            uint16* dest = static_cast<uint16*>(indexLock.pData);
+            for (size_t i = 0; i < order.size(); ++i)
+            {
+                for (size_t k = 0; k < 3; ++k)
+                    *dest++ = static_cast<uint16>(indices[order[i] * 3 + k]);
+            }
+        }
+
+        indexLock.unlock();
+
+        // Edge lists refer to triangles by position
+        if (parent && parent->isEdgeListBuilt())
+        {
+            parent->freeEdgeList();
+            parent->buildEdgeList();
+        }
+    }
+    //---------------------------------------------------------------------
     void SubMesh::setBuildEdgesEnabled(bool b)
     {
         mBuildEdgesEnabled = b;
@@ -454,6 +643,7 @@ namespace Ogre {
         newSub->operationType = this->operationType;
         newSub->useSharedVertices = this->useSharedVertices;
         newSub->extremityPoints = this->extremityPoints;
+        newSub->meshlets = this->meshlets;
 
         if (!this->useSharedVertices)
         {
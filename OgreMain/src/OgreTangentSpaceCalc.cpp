@@ -533,7 +533,7 @@ namespace Ogre
         const VertexElement* uvElem = dcl->findElementBySemantic(
             VES_TEXTURE_COORDINATES, sourceTexCoordSet);
 
-        if (!uvElem || uvElem->getType() != VET_FLOAT2)
+        if (!uvElem || VertexElement::getTypeCount(uvElem->getType()) != 2)
         {
             OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
                 "No 2D texture coordinates with selected index, cannot calculate tangents.",
@@ -603,28 +603,26 @@ namespace Ogre
         mVertexArray.clear();
         mVertexArray.resize(mVData->vertexCount);
 
-        float* pFloat;
+        // converted to float, so packed normals and texture coordinates work too
+        void* pElem;
+        float values[3];
         VertexInfo* vInfo = &(mVertexArray[0]);
         for (size_t v = 0; v < mVData->vertexCount; ++v, ++vInfo)
         {
-            posElem->baseVertexPointerToElement(pPosBase, &pFloat);
-            vInfo->pos.x = *pFloat++;
-            vInfo->pos.y = *pFloat++;
-            vInfo->pos.z = *pFloat++;
+            posElem->baseVertexPointerToElement(pPosBase, &pElem);
+            VertexElement::convertValue(posElem->getType(), pElem, VET_FLOAT3, values);
+            vInfo->pos = Vector3(values[0], values[1], values[2]);
             pPosBase += posInc;
 
-            normElem->baseVertexPointerToElement(pNormBase, &pFloat);
-            vInfo->norm.x = *pFloat++;
-            vInfo->norm.y = *pFloat++;
-            vInfo->norm.z = *pFloat++;
+            normElem->baseVertexPointerToElement(pNormBase, &pElem);
+            VertexElement::convertValue(normElem->getType(), pElem, VET_FLOAT3, values);
+            vInfo->norm = Vector3(values[0], values[1], values[2]);
             pNormBase += normInc;
 
-            uvElem->baseVertexPointerToElement(pUvBase, &pFloat);
-            vInfo->uv.x = *pFloat++;
-            vInfo->uv.y = *pFloat++;
+            uvElem->baseVertexPointerToElement(pUvBase, &pElem);
+            VertexElement::convertValue(uvElem->getType(), pElem, VET_FLOAT2, values);
+            vInfo->uv = Vector2(values[0], values[1]);
             pUvBase += uvInc;
-
-
         }
 
         // unlock buffers
@@ -656,7 +654,7 @@ namespace Ogre
         { // no tex coords with index 1
             needsToBeCreated = true ;
         }
-        else if (tangentsElem->getType() != tangentsType)
+        else if (VertexElement::getTypeCount(tangentsElem->getType()) < VertexElement::getTypeCount(tangentsType))
         {
             //  buffer exists, but not 3D
             OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS,
@@ -727,15 +725,13 @@ namespace Ogre
                 memcpy(pDest, pSrc, origVertSize);
                 pSrc += origVertSize;
             }
-            // Write in the tangent
-            float* pTangent;
+            // Write in the tangent, existing elements may use a packed format
+            void* pTangent;
             tangentsElem->baseVertexPointerToElement(pDest, &pTangent);
             VertexInfo& vertInfo = mVertexArray[v];
-            *pTangent++ = vertInfo.tangent.x;
-            *pTangent++ = vertInfo.tangent.y;
-            *pTangent++ = vertInfo.tangent.z;
-            if (mStoreParityInW)
-                *pTangent++ = (float)vertInfo.parity;
+            float tangent[4] = {vertInfo.tangent.x, vertInfo.tangent.y, vertInfo.tangent.z,
+                                (float)vertInfo.parity};
+            VertexElement::convertValue(tangentsType, tangent, tangentsElem->getType(), pTangent);
 
             // Next target vertex
             pDest += newVertSize;
@@ -732,211 +732,247 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
-    // Local Utility class for vertex cache optimizer
-    class Triangle
+    // Local utilities for the vertex cache optimiser
+    namespace
     {
-    public:
-        enum EdgeMatchType {
-            AB, BC, CA, ANY, NONE
-        };
-
-        uint32 a, b, c;     
-
-        inline Triangle()
-        {
-        }
-
-        inline Triangle( uint32 ta, uint32 tb, uint32 tc ) 
-            : a( ta ), b( tb ), c( tc )
-        {
-        }
-
-        inline Triangle( uint32 t[3] )
-            : a( t[0] ), b( t[1] ), c( t[2] )
-        {
-        }
-
-        inline Triangle( const Triangle& t )
-            : a( t.a ), b( t.b ), c( t.c )
-        {
-        }
+        /** Linear-speed vertex cache optimisation as described by Tom Forsyth.
 
-        inline Triangle& operator=(const Triangle& rhs) {
-            a = rhs.a;
-            b = rhs.b;
-            c = rhs.c;
-            return *this;
-        }
-
-        inline bool sharesEdge(const Triangle& t) const
+            Triangles are emitted greedily by score, where the score of a
+            triangle is the sum of the scores of its vertices. Vertices score
+            higher when they sit near the front of a simulated LRU cache and
+            when few unprocessed triangles still reference them, so isolated
+            triangles are finished off before they get evicted.
+        */
+        class ForsythOptimiser
         {
-            return( (a == t.a && b == t.c) ||
-                    (a == t.b && b == t.a) ||
-                    (a == t.c && b == t.b) ||
-                    (b == t.a && c == t.c) ||
-                    (b == t.b && c == t.a) ||
-                    (b == t.c && c == t.b) ||
-                    (c == t.a && a == t.c) ||
-                    (c == t.b && a == t.a) ||
-                    (c == t.c && a == t.b) );
-        }
+        public:
+            ForsythOptimiser(const uint32* indices, size_t triangleCount, size_t vertexCount)
+                : mIndices(indices), mTriangleCount(triangleCount)
+                , mVertices(vertexCount), mTriangleAdded(triangleCount, false)
+            {
+                // Build the vertex->triangle adjacency in one flat array
+                for (size_t i = 0; i < triangleCount * 3; ++i)
+                    ++mVertices[indices[i]].remaining;
 
-        inline bool sharesEdge(const uint32 ea, const uint32 eb, const Triangle& t) const
-        {
-            return( (ea == t.a && eb == t.c) ||
-                    (ea == t.b && eb == t.a) ||
-                    (ea == t.c && eb == t.b) ); 
-        }
+                size_t offset = 0;
+                for (size_t v = 0; v < vertexCount; ++v)
+                {
+                    mVertices[v].firstTriangle = offset;
+                    offset += mVertices[v].remaining;
+                    mVertices[v].remaining = 0;
+                }
 
-        inline bool sharesEdge(const EdgeMatchType edge, const Triangle& t) const
-        {
-            if (edge == AB)
-                return sharesEdge(a, b, t);
-            else if (edge == BC)
-                return sharesEdge(b, c, t);
-            else if (edge == CA)
-                return sharesEdge(c, a, t);
-            else
-                return (edge == ANY) == sharesEdge(t);
-        }
+                mAdjacency.resize(offset);
+                for (size_t t = 0; t < triangleCount; ++t)
+                {
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        Vertex& vert = mVertices[indices[t * 3 + k]];
+                        mAdjacency[vert.firstTriangle + vert.remaining++] = static_cast<uint32>(t);
+                    }
+                }
 
-        inline EdgeMatchType endoSharedEdge(const Triangle& t) const
-        {
-            if (sharesEdge(a, b, t)) return AB;
-            if (sharesEdge(b, c, t)) return BC;
-            if (sharesEdge(c, a, t)) return CA;
-            return NONE;
-        }
+                for (size_t v = 0; v < vertexCount; ++v)
+                    mVertices[v].score = vertexScore(mVertices[v]);
+            }
 
-        inline EdgeMatchType exoSharedEdge(const Triangle& t) const
-        {
-            return t.endoSharedEdge(*this);
-        }
+            /// Writes the new triangle order (as triangle indices) into order
+            void optimise(std::vector<uint32>& order)
+            {
+                order.clear();
+                order.reserve(mTriangleCount);
 
-        inline void shiftClockwise()
-        {
-            uint32 t = a;
-            a = c;
-            c = b;
-            b = t;
-        }
+                size_t cursor = 0;
+                size_t best = findBestUnadded(cursor);
 
-        inline void shiftCounterClockwise()
-        {
-            uint32 t = a;
-            a = b;
-            b = c;
-            c = t;
-        }
-    };
-    //-----------------------------------------------------------------------
-    //-----------------------------------------------------------------------
-    void IndexData::optimiseVertexCacheTriList(void)
-    {
-        if (indexBuffer->isLocked()) return;
+                while (best != INVALID)
+                {
+                    order.push_back(static_cast<uint32>(best));
+                    best = addTriangle(best);
 
-        void *buffer = indexBuffer->lock(HardwareBuffer::HBL_NORMAL);
+                    // Nothing next to the cache any more, restart elsewhere
+                    if (best == INVALID)
+                        best = findBestUnadded(cursor);
+                }
+            }
 
-        Triangle* triangles;
+        private:
+            static const size_t INVALID = ~static_cast<size_t>(0);
+            static const int CACHE_SIZE = 32;
 
-        size_t nIndexes = indexCount;
-        size_t nTriangles = nIndexes / 3;
-        size_t i, j;
-        uint16 *source = 0;
+            struct Vertex
+            {
+                size_t firstTriangle;
+                uint32 remaining;
+                int cachePosition;
+                float score;
 
-        if (indexBuffer->getType() == HardwareIndexBuffer::IT_16BIT)
-        {
-            triangles = OGRE_ALLOC_T(Triangle, nTriangles, MEMCATEGORY_GEOMETRY);
-            source = (uint16 *)buffer;
-            uint32 *dest = (uint32 *)triangles;
-            for (i = 0; i < nIndexes; ++i) dest[i] = source[i];
-        }
-        else
-            triangles = static_cast<Triangle*>(buffer);
+                Vertex() : firstTriangle(0), remaining(0), cachePosition(-1), score(0.0f) {}
+            };
 
-        // sort triangles based on shared edges
-        uint32 *destlist = OGRE_ALLOC_T(uint32, nTriangles, MEMCATEGORY_GEOMETRY);
-        unsigned char *visited = OGRE_ALLOC_T(unsigned char, nTriangles, MEMCATEGORY_GEOMETRY);
+            static float vertexScore(const Vertex& v)
+            {
+                if (v.remaining == 0)
+                    return -1.0f;
 
-        for (i = 0; i < nTriangles; ++i) visited[i] = 0;
+                float score = 0.0f;
+                if (v.cachePosition >= 0)
+                {
+                    // The last triangle's vertices get a fixed score, so the
+                    // optimiser does not prefer strip-like orders
+                    if (v.cachePosition < 3)
+                        score = 0.75f;
+                    else
+                        score = std::pow(1.0f - float(v.cachePosition - 3) / (CACHE_SIZE - 3), 1.5f);
+                }
 
-        uint32 start = 0, ti = 0, destcount = 0;
+                // Boost vertices with only a few triangles left
+                return score + 2.0f / std::sqrt(float(v.remaining));
+            }
 
-        bool found = false;
-        for (i = 0; i < nTriangles; ++i)
-        {
-            if (found)
-                found = false;
-            else
+            float triangleScore(size_t t) const
             {
-                while (visited[start++]);
-                ti = start - 1;
+                const uint32* tri = mIndices + t * 3;
+                return mVertices[tri[0]].score + mVertices[tri[1]].score + mVertices[tri[2]].score;
             }
 
-            destlist[destcount++] = ti;
-            visited[ti] = 1;
+            size_t findBestUnadded(size_t& cursor) const
+            {
+                // Only reached when the cache has run dry, the next triangle
+                // in submission order is a good enough restart point
+                while (cursor < mTriangleCount && mTriangleAdded[cursor])
+                    ++cursor;
+                return cursor < mTriangleCount ? cursor : INVALID;
+            }
 
-            for (j = start; j < nTriangles; ++j)
+            /// Adds the triangle, updates the cache and returns the next best candidate
+            size_t addTriangle(size_t t)
             {
-                if (visited[j]) continue;
-                
-                if (triangles[ti].sharesEdge(triangles[j]))
+                mTriangleAdded[t] = true;
+                const uint32* tri = mIndices + t * 3;
+
+                // Remove the triangle from the adjacency of its vertices
+                for (size_t k = 0; k < 3; ++k)
                 {
-                    found = true;
-                    ti = static_cast<uint32>(j);
-                    break;
+                    Vertex& v = mVertices[tri[k]];
+                    uint32* adj = &mAdjacency[v.firstTriangle];
+                    for (uint32 i = 0; i < v.remaining; ++i)
+                    {
+                        if (adj[i] == t)
+                        {
+                            std::swap(adj[i], adj[v.remaining - 1]);
+                            --v.remaining;
+                            break;
+                        }
+                    }
                 }
-            }
-        }
 
-        if (indexBuffer->getType() == HardwareIndexBuffer::IT_16BIT)
-        {
-            // reorder the indexbuffer
-            j = 0;
-            for (i = 0; i < nTriangles; ++i)
-            {
-                Triangle *t = &triangles[destlist[i]];
-                if(source)
+                // Move the vertices to the front of the LRU cache
+                mNewCache.clear();
+                mNewCache.reserve(mCache.size() + 3);
+                for (size_t k = 0; k < 3; ++k)
                 {
-                    source[j++] = (uint16)t->a;
-                    source[j++] = (uint16)t->b;
-                    source[j++] = (uint16)t->c;
+                    if (std::find(mNewCache.begin(), mNewCache.end(), tri[k]) == mNewCache.end())
+                        mNewCache.push_back(tri[k]);
                 }
+                std::vector<uint32>::iterator triEnd = mNewCache.end();
+                for (size_t i = 0; i < mCache.size(); ++i)
+                {
+                    if (std::find(mNewCache.begin(), triEnd, mCache[i]) == triEnd)
+                        mNewCache.push_back(mCache[i]);
+                }
+                mCache.swap(mNewCache);
+
+                // Update vertex scores, evicting what does not fit
+                for (size_t i = 0; i < mCache.size(); ++i)
+                {
+                    Vertex& v = mVertices[mCache[i]];
+                    v.cachePosition = i < size_t(CACHE_SIZE) ? int(i) : -1;
+                    v.score = vertexScore(v);
+                }
+
+                // Rescore the triangles touching the cache and pick the best one
+                size_t best = INVALID;
+                float bestScore = -1.0f;
+                for (size_t i = 0; i < mCache.size(); ++i)
+                {
+                    const Vertex& v = mVertices[mCache[i]];
+                    const uint32* adj = v.remaining ? &mAdjacency[v.firstTriangle] : 0;
+                    for (uint32 j = 0; j < v.remaining; ++j)
+                    {
+                        float score = triangleScore(adj[j]);
+                        if (score > bestScore)
+                        {
+                            bestScore = score;
+                            best = adj[j];
+                        }
+                    }
+                }
+
+                if (mCache.size() > size_t(CACHE_SIZE))
+                    mCache.resize(CACHE_SIZE);
+
+                return best;
             }
-            OGRE_FREE(triangles, MEMCATEGORY_GEOMETRY);
+
+            const uint32* mIndices;
+            size_t mTriangleCount;
+            std::vector<Vertex> mVertices;
+            std::vector<uint32> mAdjacency;
+            std::vector<bool> mTriangleAdded;
+            std::vector<uint32> mCache;
+            std::vector<uint32> mNewCache;
+        };
+    }
+    //-----------------------------------------------------------------------
+    void IndexData::optimiseVertexCacheTriList(void)
+    {
+        if (indexBuffer->isLocked() || indexCount < 6) return;
+
+        size_t nTriangles = indexCount / 3;
+        size_t nIndexes = nTriangles * 3;
+        bool use32bit = indexBuffer->getType() == HardwareIndexBuffer::IT_32BIT;
+
+        HardwareBufferLockGuard indexLock(indexBuffer,
+                                          indexStart * indexBuffer->getIndexSize(),
+                                          nIndexes * indexBuffer->getIndexSize(),
+                                          HardwareBuffer::HBL_NORMAL);
+
+        std::vector<uint32> indices(nIndexes);
+        uint32 vertexCount = 0;
+        if (use32bit)
+        {
+            memcpy(&indices[0], indexLock.pData, nIndexes * sizeof(uint32));
         }
         else
         {
-            uint32 *reflist = OGRE_ALLOC_T(uint32, nTriangles, MEMCATEGORY_GEOMETRY);
-
-            // fill the referencebuffer
-            for (i = 0; i < nTriangles; ++i)
-                reflist[destlist[i]] = static_cast<uint32>(i);
-            
-            // reorder the indexbuffer
-            for (i = 0; i < nTriangles; ++i)
-            {
-                j = destlist[i];
-                if (i == j) continue; // do not move triangle
-
-                // swap triangles
+            const uint16* source = static_cast<const uint16*>(indexLock.pData);
+            std::copy(source, source + nIndexes, indices.begin());
+        }
+        for (size_t i = 0; i < nIndexes; ++i)
+            vertexCount = std::max(vertexCount, indices[i] + 1);
 
-                Triangle t = triangles[i];
-                triangles[i] = triangles[j];
-                triangles[j] = t;
+        std::vector<uint32> order;
+        ForsythOptimiser(&indices[0], nTriangles, vertexCount).optimise(order);
 
-                // change reference
-                destlist[reflist[i]] = static_cast<uint32>(j);
-                // destlist[i] = i; // not needed, it will not be used
+        // write back the triangles in their new order
+        if (use32bit)
+        {
+            uint32* dest = static_cast<uint32*>(indexLock.pData);
+            for (size_t i = 0; i < nTriangles; ++i, dest += 3)
+                memcpy(dest, &indices[order[i] * 3], 3 * sizeof(uint32));
+        }
+        else
+        {
+            uint16* dest = static_cast<uint16*>(indexLock.pData);
+            for (size_t i = 0; i < nTriangles; ++i)
+            {
+                const uint32* tri = &indices[order[i] * 3];
+                *dest++ = static_cast<uint16>(tri[0]);
+                *dest++ = static_cast<uint16>(tri[1]);
+                *dest++ = static_cast<uint16>(tri[2]);
             }
-
-            OGRE_FREE(reflist, MEMCATEGORY_GEOMETRY);
         }
-
-        OGRE_FREE(destlist, MEMCATEGORY_GEOMETRY);
-        OGRE_FREE(visited, MEMCATEGORY_GEOMETRY);
-                    
-        indexBuffer->unlock();
     }
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
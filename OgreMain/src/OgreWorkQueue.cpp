@@ -43,6 +43,75 @@ namespace Ogre {
         return i->second;
     }
     //---------------------------------------------------------------------
+    void WorkQueue::parallelFor(size_t count, const std::function<void(size_t)>& func)
+    {
+        if (count < 2 || OGRE_THREAD_HARDWARE_CONCURRENCY < 2)
+        {
+            for (size_t i = 0; i < count; ++i)
+                func(i);
+            return;
+        }
+
+        // shared with the helper tasks, which may only start after we returned
+        struct State
+        {
+            std::function<void(size_t)> func;
+            size_t count;
+            AtomicScalar<size_t> next;
+            AtomicScalar<size_t> done;
+            std::exception_ptr error;
+            OGRE_WQ_MUTEX(mutex);
+            OGRE_WQ_THREAD_SYNCHRONISER(sync);
+
+            void run()
+            {
+                size_t i;
+                while ((i = next++) < count)
+                {
+                    try
+                    {
+                        func(i);
+                    }
+                    catch (...)
+                    {
+                        OGRE_WQ_LOCK_MUTEX(mutex);
+                        if (!error)
+                            error = std::current_exception();
+                    }
+
+                    if (++done == count)
+                    {
+                        OGRE_WQ_LOCK_MUTEX(mutex);
+                        OGRE_THREAD_NOTIFY_ALL(sync);
+                    }
+                }
+            }
+        };
+        std::shared_ptr<State> state = std::make_shared<State>();
+        state->func = func;
+        state->count = count;
+        state->next = 0;
+        state->done = 0;
+
+        size_t numHelpers = std::min<size_t>(count, OGRE_THREAD_HARDWARE_CONCURRENCY) - 1;
+        for (size_t i = 0; i < numHelpers; ++i)
+            addTask([state]() { state->run(); });
+
+        // help out, so we finish even if all workers are busy
+        state->run();
+
+#if OGRE_THREAD_SUPPORT
+        {
+            OGRE_WQ_LOCK_MUTEX_NAMED(state->mutex, lock);
+            while (state->done < count)
+                OGRE_THREAD_WAIT(state->sync, state->mutex, lock);
+        }
+#endif
+
+        if (state->error)
+            std::rethrow_exception(state->error);
+    }
+    //---------------------------------------------------------------------
     WorkQueue::Request::Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid)
         : mChannel(channel), mType(rtype), mData(rData), mRetryCount(retry), mID(rid), mAborted(false)
     {
@@ -81,6 +150,7 @@ namespace Ogre {
         , mIdleThreadRunning(false)
         , mIdleProcessed(0)
     {
+        mTaskChannel = getChannel("Ogre/Task");
     }
     //---------------------------------------------------------------------
     const String& DefaultWorkQueueBase::getName() const
@@ -237,6 +307,21 @@ namespace Ogre {
 
     }
     //---------------------------------------------------------------------
+    void DefaultWorkQueueBase::addTask(std::function<void()> task)
+    {
+#if OGRE_THREAD_SUPPORT
+        if (mIsRunning && mWorkerThreadCount > 0)
+        {
+            TaskRequest treq;
+            treq.task = task;
+            if (addRequest(mTaskChannel, 0, Any(treq)))
+                return;
+        }
+#endif
+        // no workers to run it or requests are not accepted
+        task();
+    }
+    //---------------------------------------------------------------------
     void DefaultWorkQueueBase::addRequestWithRID(WorkQueue::RequestID rid, uint16 channel, 
         uint16 requestType, const Any& rData, uint8 retryCount)
     {
@@ -579,7 +664,7 @@ namespace Ogre {
         }
         else
         {
-            if (!r->getAborted())
+            if (!r->getAborted() && r->getChannel() != mTaskChannel)
             {
             // no response, delete request
             LogManager::getSingleton().stream(LML_WARNING) <<
@@ -633,6 +718,14 @@ namespace Ogre {
     //---------------------------------------------------------------------
     WorkQueue::Response* DefaultWorkQueueBase::processRequest(Request* r)
     {
+        if (r->getChannel() == mTaskChannel)
+        {
+            // tasks do not have handlers or responses
+            if (!r->getAborted())
+                any_cast<TaskRequest>(r->getData()).task();
+            return 0;
+        }
+
         RequestHandlerListByChannel handlerListCopy;
         {
             // lock the list only to make a copy of it, to maximise parallelism
@@ -28,35 +28,105 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 
 #if OGRE_NO_ZIP_ARCHIVE == 0
-// workaround for Wundef in zzip/conf.h
-#ifndef __GNUC_MINOR_
-#define __GNUC_MINOR_ 0
-#endif
 
-#include <zzip/zzip.h>
-#include <zzip/plugin.h>
+#include "OgreZip.h"
+#include "OgreFileSystem.h"
 
-#ifdef _OGRE_FILESYSTEM_ARCHIVE_UNICODE
-#   define WIN32_LEAN_AND_MEAN
-#   include <windows.h>
-#   include <stringapiset.h>
-#endif
+#include <zlib.h>
 
 namespace Ogre {
 namespace {
+    /** Buffers for inflated files, reused once the stream using them is closed.
+        Uses the WorkQueue mutex, as streams may be closed on worker threads.
+    */
+    class ZipBufferPool
+    {
+        struct Buffer
+        {
+            uchar* data;
+            size_t capacity;
+        };
+        std::vector<Buffer> mFree;
+        OGRE_WQ_MUTEX(mMutex);
+    public:
+        ~ZipBufferPool()
+        {
+            for (size_t i = 0; i < mFree.size(); i++)
+                OGRE_FREE(mFree[i].data, MEMCATEGORY_GENERAL);
+        }
+
+        uchar* acquire(size_t size, size_t& capacity)
+        {
+            {
+                OGRE_WQ_LOCK_MUTEX(mMutex);
+                // smallest buffer that fits
+                size_t best = mFree.size();
+                for (size_t i = 0; i < mFree.size(); i++)
+                {
+                    if (mFree[i].capacity >= size &&
+                        (best == mFree.size() || mFree[i].capacity < mFree[best].capacity))
+                        best = i;
+                }
+                if (best != mFree.size())
+                {
+                    Buffer b = mFree[best];
+                    mFree[best] = mFree.back();
+                    mFree.pop_back();
+                    capacity = b.capacity;
+                    return b.data;
+                }
+            }
+            capacity = std::max<size_t>(size, 1);
+            return OGRE_ALLOC_T(uchar, capacity, MEMCATEGORY_GENERAL);
+        }
+
+        void release(uchar* data, size_t capacity)
+        {
+            {
+                // keep a few buffers of moderate size around
+                OGRE_WQ_LOCK_MUTEX(mMutex);
+                if (mFree.size() < 8 && capacity <= 16 * 1024 * 1024)
+                {
+                    Buffer b = {data, capacity};
+                    mFree.push_back(b);
+                    return;
+                }
+            }
+            OGRE_FREE(data, MEMCATEGORY_GENERAL);
+        }
+    };
+    typedef std::shared_ptr<ZipBufferPool> ZipBufferPoolPtr;
+
     class ZipArchive : public Archive
     {
     protected:
-        /// Handle to root zip file
-        ZZIP_DIR* mZzipDir;
-        /// File list (since zziplib seems to only allow scanning of dir tree once)
-        FileInfoList mFileList;
-        /// A pointer to file io alternative implementation
-        const zzip_plugin_io_handlers* mPluginIo;
+        /// Location of an entry in the archive memory
+        struct Entry
+        {
+            size_t headerOffset;
+            uint16 method;
+            uint16 flags;
+        };
 
+        /// the whole archive, either a mapping of the file or embedded memory
+        DataStreamPtr mData;
+        /// File list in central directory order
+        FileInfoList mFileList;
+        /// Per file entries of mFileList, same order
+        std::vector<Entry> mEntries;
+        /// Lookup of files (not folders) into mFileList
+        std::unordered_map<String, size_t> mIndex;
+        ZipBufferPoolPtr mBufferPool;
+        /// Read from embedded memory registered with EmbeddedZipArchiveFactory
+        bool mEmbedded;
+
+        /// open() and the listing methods only read the index, this guards load and unload
         OGRE_AUTO_MUTEX;
+
+        void parseCentralDirectory(const uchar* data, size_t size);
+        const FileInfo* findEntry(const String& filename, const Entry*& entry) const;
     public:
-        ZipArchive(const String& name, const String& archType, const zzip_plugin_io_handlers* pluginIo);
+        ZipArchive(const String& name, const String& archType, bool embedded);
         ~ZipArchive();
         /// @copydoc Archive::isCaseSensitive
         bool isCaseSensitive(void) const { return OGRE_RESOURCEMANAGER_STRICT != 0; }
@@ -96,112 +166,86 @@ namespace {
         time_t getModifiedTime(const String& filename) const;
     };
 
-    /** Specialisation of DataStream to handle streaming data from zip archives. */
-    class ZipDataStream : public DataStream
+    /** Stored file served straight from the archive memory.
+        Keeps the archive memory alive, so it may outlive the archive.
+    */
+    class ZipStoredDataStream : public MemoryDataStream
     {
-    protected:
-        ZZIP_FILE* mZzipFile;
-        /// We need caching because sometimes serializers step back in data stream and zziplib behaves slow
-        StaticCache<2 * OGRE_STREAM_TEMP_SIZE> mCache;
+        DataStreamPtr mArchiveData;
     public:
-        /// Constructor for creating named streams
-        ZipDataStream(const String& name, ZZIP_FILE* zzipFile, size_t uncompressedSize);
-        ~ZipDataStream();
-        /// @copydoc DataStream::read
-        size_t read(void* buf, size_t count);
-        /// @copydoc DataStream::write
-        size_t write(const void* buf, size_t count);
-        /// @copydoc DataStream::skip
-        void skip(long count);
-        /// @copydoc DataStream::seek
-        void seek( size_t pos );
-        /// @copydoc DataStream::seek
-        size_t tell(void) const;
-        /// @copydoc DataStream::eof
-        bool eof(void) const;
-        /// @copydoc DataStream::close
-        void close(void);
+        ZipStoredDataStream(const String& name, const DataStreamPtr& archiveData, const uchar* pMem, size_t size)
+            : MemoryDataStream(name, const_cast<uchar*>(pMem), size, false, true), mArchiveData(archiveData)
+        {
+        }
+
+        void close(void)
+        {
+            MemoryDataStream::close();
+            mArchiveData.reset();
+        }
     };
 
-    /// Utility method to format out zzip errors
-    static String getErrorDescription(zzip_error_t zzipError, const String& file)
+    /// Inflated file in a buffer of the archive pool
+    class ZipInflatedDataStream : public MemoryDataStream
     {
-        const char* errorMsg = "";
-        switch (zzipError)
+        ZipBufferPoolPtr mPool;
+        size_t mCapacity;
+    public:
+        ZipInflatedDataStream(const String& name, const ZipBufferPoolPtr& pool, uchar* pMem, size_t size,
+                              size_t capacity)
+            : MemoryDataStream(name, pMem, size, false, true), mPool(pool), mCapacity(capacity)
         {
-        case ZZIP_NO_ERROR:
-            break;
-        case ZZIP_OUTOFMEM:
-            errorMsg = "Out of memory";
-            break;            
-        case ZZIP_DIR_OPEN:
-            errorMsg = "Unable to open zip file";
-            break;
-        case ZZIP_DIR_STAT: 
-        case ZZIP_DIR_SEEK:
-        case ZZIP_DIR_READ:
-            errorMsg = "Unable to read zip file";
-            break;            
-        case ZZIP_UNSUPP_COMPR:
-            errorMsg = "Unsupported compression format";
-            break;            
-        case ZZIP_CORRUPTED:
-            errorMsg = "Corrupted archive";
-            break;
-        case ZZIP_DIR_TOO_SHORT:
-            errorMsg = "Zip file is too short";
-            break;
-        case ZZIP_DIR_EDH_MISSING:
-            errorMsg = "Zip-file's central directory record missing. Is this a 7z file";
-            break;
-        case ZZIP_ENOENT:
-            errorMsg = "File not in archive";
-            break;
-        default:
-            errorMsg = "Unknown error";
-            break;            
-        };
+        }
 
-        return StringUtil::format("%s '%s'", errorMsg, file.c_str());
-    }
+        ~ZipInflatedDataStream() { close(); }
 
-#ifdef _OGRE_FILESYSTEM_ARCHIVE_UNICODE
-    int wopen_wrapper(const char* filename, int oflag, ...)
-    {
-        int utf16Length = ::MultiByteToWideChar(CP_UTF8, 0, filename, (int)strlen(filename), NULL, 0);
-        if (utf16Length > 0)
+        void close(void)
         {
-            std::wstring wt;
-            wt.resize(utf16Length);
-            if (0 != ::MultiByteToWideChar(CP_UTF8, 0, filename, (int)strlen(filename), &wt[0],
-                                           (int)wt.size()))
-                return _wopen(wt.c_str(), oflag);
+            if (mData)
+            {
+                mPool->release(mData, mCapacity);
+                mData = 0;
+            }
+            MemoryDataStream::close();
         }
+    };
 
-        return -1;
-    }
-#endif
+    // zip fields are little endian and unaligned
+    uint16 readUInt16(const uchar* p) { return uint16(p[0] | (p[1] << 8)); }
+    uint32 readUInt32(const uchar* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (uint32(p[3]) << 24); }
+    uint64 readUInt64(const uchar* p) { return readUInt32(p) | (uint64(readUInt32(p + 4)) << 32); }
 
-    const zzip_plugin_io_handlers* getDefaultIO()
-    {
-        static zzip_plugin_io_handlers defaultIO;
-        static bool isInit = false;
+    const uint32 ZIP_LOCAL_HEADER = 0x04034b50;
+    const uint32 ZIP_CENTRAL_HEADER = 0x02014b50;
+    const uint32 ZIP_END_OF_DIR = 0x06054b50;
+    const uint32 ZIP64_END_OF_DIR = 0x06064b50;
+    const uint32 ZIP64_END_OF_DIR_LOCATOR = 0x07064b50;
 
-        if (!isInit)
-        {
-            zzip_init_io(&defaultIO, 1);
-#ifdef _OGRE_FILESYSTEM_ARCHIVE_UNICODE
-            defaultIO.fd.open = wopen_wrapper;
-#endif
-            isInit = true;
-        }
+    const uint16 ZIP_STORED = 0;
+    const uint16 ZIP_DEFLATED = 8;
 
-        return &defaultIO;
-    }
+    /// A type for a map between the file names to file index
+    typedef std::map<String, int> FileNameToIndexMap;
+    typedef FileNameToIndexMap::iterator FileNameToIndexMapIter;
+
+    /// a struct to hold embedded file data
+    struct EmbeddedFileData
+    {
+        const uint8 * fileData;
+        size_t fileSize;
+        EmbeddedZipArchiveFactory::DecryptEmbeddedZipFileFunc decryptFunc;
+    };
+    /// A type to store the embedded files data
+    typedef std::vector<EmbeddedFileData> EmbbedFileDataList;
+
+    /// A static map between the file names to file index
+    FileNameToIndexMap * EmbeddedZipArchiveFactory_mFileNameToIndexMap;
+    /// A static list to store the embedded files data
+    EmbbedFileDataList * EmbeddedZipArchiveFactory_mEmbbedFileDataList;
 }
     //-----------------------------------------------------------------------
-    ZipArchive::ZipArchive(const String& name, const String& archType, const zzip_plugin_io_handlers* pluginIo)
-        : Archive(name, archType), mZzipDir(0), mPluginIo(pluginIo)
+    ZipArchive::ZipArchive(const String& name, const String& archType, bool embedded)
+        : Archive(name, archType), mBufferPool(std::make_shared<ZipBufferPool>()), mEmbedded(embedded)
     {
     }
     //-----------------------------------------------------------------------
@@ -213,102 +257,280 @@ namespace {
     void ZipArchive::load()
     {
         OGRE_LOCK_AUTO_MUTEX;
-        if (!mZzipDir)
+        if (mData)
+            return;
+
+        DataStreamPtr data;
+        if (mEmbedded)
         {
-            zzip_error_t zzipError;
-            mZzipDir = zzip_dir_open_ext_io(mName.c_str(), &zzipError, 0, mPluginIo);
-            if (zzipError)
-                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, getErrorDescription(zzipError, mName));
-
-            // Cache names
-            ZZIP_DIRENT zzipEntry;
-            while (zzip_dir_read(mZzipDir, &zzipEntry))
+            FileNameToIndexMapIter it;
+            if (!EmbeddedZipArchiveFactory_mFileNameToIndexMap ||
+                (it = EmbeddedZipArchiveFactory_mFileNameToIndexMap->find(mName)) ==
+                    EmbeddedZipArchiveFactory_mFileNameToIndexMap->end())
             {
-                FileInfo info;
-                info.archive = this;
-                // Get basename / path
-                StringUtil::splitFilename(zzipEntry.d_name, info.basename, info.path);
-                info.filename = zzipEntry.d_name;
-                // Get sizes
-                info.compressedSize = static_cast<size_t>(zzipEntry.d_csize);
-                info.uncompressedSize = static_cast<size_t>(zzipEntry.st_size);
-                // folder entries
-                if (info.basename.empty())
+                OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "Unable to open zip file '" + mName + "'");
+            }
+
+            const EmbeddedFileData& embedded = (*EmbeddedZipArchiveFactory_mEmbbedFileDataList)[it->second - 1];
+            if (embedded.decryptFunc)
+            {
+                // decrypt a copy once, instead of on every read
+                MemoryDataStream* copy = OGRE_NEW MemoryDataStream(mName, embedded.fileSize, true, true);
+                data.reset(copy);
+                memcpy(copy->getPtr(), embedded.fileData, embedded.fileSize);
+                if (!embedded.decryptFunc(0, copy->getPtr(), embedded.fileSize))
+                    OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Unable to decrypt zip file '" + mName + "'");
+            }
+            else
+            {
+                data.reset(OGRE_NEW MemoryDataStream(mName, const_cast<uint8*>(embedded.fileData),
+                                                     embedded.fileSize, false, true));
+            }
+        }
+        else
+        {
+            data = _openMappedFile(mName);
+            if (!data) // mapping not possible here, read it into memory instead
+            {
+                DataStreamPtr file = _openFileStream(mName, std::ios::in | std::ios::binary);
+                data.reset(OGRE_NEW MemoryDataStream(file, true, true));
+            }
+        }
+
+        MemoryDataStream* mem = static_cast<MemoryDataStream*>(data.get());
+        parseCentralDirectory(mem->getPtr(), mem->size());
+        mData = data;
+    }
+    //-----------------------------------------------------------------------
+    void ZipArchive::parseCentralDirectory(const uchar* data, size_t size)
+    {
+        String corrupted = "Corrupted archive '" + mName + "'";
+
+        // end of central directory record, followed by a comment of up to 64k
+        const size_t eocdSize = 22;
+        if (size < eocdSize)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Zip file is too short '" + mName + "'");
+
+        size_t eocd = size - eocdSize;
+        size_t searchEnd = size > eocdSize + 0xFFFF ? size - eocdSize - 0xFFFF : 0;
+        while (readUInt32(data + eocd) != ZIP_END_OF_DIR)
+        {
+            if (eocd == searchEnd)
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
+                            "Zip-file's central directory record missing. Is this a 7z file '" + mName + "'");
+            eocd--;
+        }
+
+        uint64 numEntries = readUInt16(data + eocd + 10);
+        uint64 dirSize = readUInt32(data + eocd + 12);
+        uint64 dirOffset = readUInt32(data + eocd + 16);
+
+        if ((numEntries == 0xFFFF || dirSize == 0xFFFFFFFF || dirOffset == 0xFFFFFFFF) && eocd >= 20 &&
+            readUInt32(data + eocd - 20) == ZIP64_END_OF_DIR_LOCATOR)
+        {
+            uint64 eocd64 = readUInt64(data + eocd - 20 + 8);
+            if (eocd64 + 56 > size || readUInt32(data + eocd64) != ZIP64_END_OF_DIR)
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, corrupted);
+            numEntries = readUInt64(data + eocd64 + 32);
+            dirSize = readUInt64(data + eocd64 + 40);
+            dirOffset = readUInt64(data + eocd64 + 48);
+        }
+
+        if (dirOffset + dirSize > size || numEntries > dirSize / 46)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, corrupted);
+
+        mFileList.clear();
+        mEntries.clear();
+        mIndex.clear();
+        mFileList.reserve(size_t(numEntries));
+        mEntries.reserve(size_t(numEntries));
+        mIndex.reserve(size_t(numEntries));
+
+        const uchar* p = data + dirOffset;
+        const uchar* end = p + dirSize;
+        for (uint64 i = 0; i < numEntries; i++)
+        {
+            if (p + 46 > end || readUInt32(p) != ZIP_CENTRAL_HEADER)
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, corrupted);
+
+            Entry entry;
+            entry.flags = readUInt16(p + 8);
+            entry.method = readUInt16(p + 10);
+            uint64 compressedSize = readUInt32(p + 20);
+            uint64 uncompressedSize = readUInt32(p + 24);
+            uint16 nameLen = readUInt16(p + 28);
+            uint16 extraLen = readUInt16(p + 30);
+            uint16 commentLen = readUInt16(p + 32);
+            uint64 headerOffset = readUInt32(p + 42);
+
+            const uchar* name = p + 46;
+            const uchar* extra = name + nameLen;
+            p = extra + extraLen + commentLen;
+            if (p > end)
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, corrupted);
+
+            // zip64 extended information, only holds the fields that overflowed
+            for (const uchar* e = extra; e + 4 <= extra + extraLen; e += 4 + readUInt16(e + 2))
+            {
+                if (readUInt16(e) != 0x0001)
+                    continue;
+
+                const uchar* field = e + 4;
+                const uchar* fieldEnd = std::min(field + readUInt16(e + 2), extra + extraLen);
+                if (uncompressedSize == 0xFFFFFFFF && field + 8 <= fieldEnd)
                 {
-                    info.filename = info.filename.substr (0, info.filename.length () - 1);
-                    StringUtil::splitFilename(info.filename, info.basename, info.path);
-                    // Set compressed size to -1 for folders; anyway nobody will check
-                    // the compressed size of a folder, and if he does, its useless anyway
-                    info.compressedSize = size_t (-1);
+                    uncompressedSize = readUInt64(field);
+                    field += 8;
                 }
-#if !OGRE_RESOURCEMANAGER_STRICT
-                else
+                if (compressedSize == 0xFFFFFFFF && field + 8 <= fieldEnd)
                 {
-                    info.filename = info.basename;
+                    compressedSize = readUInt64(field);
+                    field += 8;
                 }
+                if (headerOffset == 0xFFFFFFFF && field + 8 <= fieldEnd)
+                    headerOffset = readUInt64(field);
+                break;
+            }
+            entry.headerOffset = size_t(headerOffset);
+
+            FileInfo info;
+            info.archive = this;
+            info.filename.assign(reinterpret_cast<const char*>(name), nameLen);
+            // Get basename / path
+            StringUtil::splitFilename(info.filename, info.basename, info.path);
+            // Get sizes
+            info.compressedSize = size_t(compressedSize);
+            info.uncompressedSize = size_t(uncompressedSize);
+            // folder entries
+            if (info.basename.empty())
+            {
+                info.filename = info.filename.substr (0, info.filename.length () - 1);
+                StringUtil::splitFilename(info.filename, info.basename, info.path);
+                // Set compressed size to -1 for folders; anyway nobody will check
+                // the compressed size of a folder, and if he does, its useless anyway
+                info.compressedSize = size_t (-1);
+            }
+            else
+            {
+#if OGRE_RESOURCEMANAGER_STRICT
+                mIndex[info.filename] = mFileList.size();
+#else
+                String key = info.filename;
+                StringUtil::toLowerCase(key);
+                mIndex[key] = mFileList.size();
+
+                // lookup by basename, unless it is ambiguous
+                key = info.basename;
+                StringUtil::toLowerCase(key);
+                std::pair<std::unordered_map<String, size_t>::iterator, bool> ret =
+                    mIndex.insert(std::make_pair(key, mFileList.size()));
+                if (!ret.second && ret.first->second != mFileList.size())
+                    ret.first->second = size_t(-1);
+
+                info.filename = info.basename;
 #endif
-                mFileList.push_back(info);
-
             }
-
+            mFileList.push_back(info);
+            mEntries.push_back(entry);
         }
     }
     //-----------------------------------------------------------------------
     void ZipArchive::unload()
     {
         OGRE_LOCK_AUTO_MUTEX;
-        if (mZzipDir)
+        // open streams keep the memory alive
+        mData.reset();
+        mFileList.clear();
+        mEntries.clear();
+        mIndex.clear();
+    }
+    //-----------------------------------------------------------------------
+    const FileInfo* ZipArchive::findEntry(const String& filename, const Entry*& entry) const
+    {
+#if OGRE_RESOURCEMANAGER_STRICT
+        std::unordered_map<String, size_t>::const_iterator it = mIndex.find(filename);
+#else
+        String key = filename;
+        StringUtil::toLowerCase(key);
+        std::unordered_map<String, size_t>::const_iterator it = mIndex.find(key);
+        if (it == mIndex.end()) // Try if we find the file
         {
-            zzip_dir_close(mZzipDir);
-            mZzipDir = 0;
-            mFileList.clear();
+            String basename, path;
+            StringUtil::splitFilename(key, basename, path);
+            it = mIndex.find(basename);
         }
-    
+#endif
+        if (it == mIndex.end() || it->second == size_t(-1))
+            return NULL;
+
+        entry = &mEntries[it->second];
+        return &mFileList[it->second];
     }
     //-----------------------------------------------------------------------
     DataStreamPtr ZipArchive::open(const String& filename, bool readOnly) const
     {
-        // zziplib is not threadsafe
-        OGRE_LOCK_AUTO_MUTEX;
-        String lookUpFileName = filename;
+        // the index does not change once loaded, so concurrent opens need no lock
+        const Entry* entry = NULL;
+        const FileInfo* info = findEntry(filename, entry);
+        if (!info)
+        {
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "File not in archive '" + filename + "'");
+        }
 
-#if OGRE_RESOURCEMANAGER_STRICT
-        const int flags = 0;
-#else
-        const int flags = ZZIP_CASELESS;
-#endif
+        String corrupted = "Corrupted archive '" + mName + "'";
+        MemoryDataStream* mem = static_cast<MemoryDataStream*>(mData.get());
+        const uchar* data = mem->getPtr();
+        size_t size = mem->size();
+
+        // the local header may have a different extra field than the central directory
+        size_t offset = entry->headerOffset;
+        if (offset + 30 > size || readUInt32(data + offset) != ZIP_LOCAL_HEADER)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, corrupted);
+        offset += 30 + readUInt16(data + offset + 26) + readUInt16(data + offset + 28);
+        if (offset > size || info->compressedSize > size - offset)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, corrupted);
 
-        // Format not used here (always binary)
-        ZZIP_FILE* zzipFile =
-            zzip_file_open(mZzipDir, lookUpFileName.c_str(), ZZIP_ONLYZIP | flags);
+        if (entry->flags & 1)
+            OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "Encrypted file '" + filename + "' in '" + mName + "'");
 
-#if !OGRE_RESOURCEMANAGER_STRICT
-        if (!zzipFile) // Try if we find the file
+        String lookUpFileName = info->path + info->basename;
+        if (entry->method == ZIP_STORED)
         {
-            String basename, path;
-            StringUtil::splitFilename(lookUpFileName, basename, path);
-            const FileInfoListPtr fileNfo = findFileInfo(basename, true);
-            if (fileNfo->size() == 1) // If there are more files with the same do not open anyone
-            {
-                Ogre::FileInfo info = fileNfo->at(0);
-                lookUpFileName = info.path + info.basename;
-                zzipFile = zzip_file_open(mZzipDir, lookUpFileName.c_str(), ZZIP_ONLYZIP | flags); // When an error happens here we will catch it below
-            }
+            if (info->compressedSize != info->uncompressedSize)
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, corrupted);
+            return DataStreamPtr(OGRE_NEW ZipStoredDataStream(lookUpFileName, mData, data + offset,
+                                                              info->uncompressedSize));
         }
-#endif
 
-        if (!zzipFile)
+        if (entry->method != ZIP_DEFLATED)
+            OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "Unsupported compression format '" + filename + "'");
+
+        // sizes are known, so inflate in one go
+        size_t capacity;
+        uchar* buffer = mBufferPool->acquire(info->uncompressedSize, capacity);
+
+        z_stream zs;
+        memset(&zs, 0, sizeof(zs));
+        zs.next_in = const_cast<uchar*>(data + offset);
+        zs.avail_in = uInt(info->compressedSize);
+        zs.next_out = buffer;
+        zs.avail_out = uInt(info->uncompressedSize);
+
+        int ret = inflateInit2(&zs, -MAX_WBITS);
+        if (ret == Z_OK)
         {
-            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, getErrorDescription((zzip_error_t)zzip_error(mZzipDir), mName));
+            ret = inflate(&zs, Z_FINISH);
+            inflateEnd(&zs);
         }
 
-        // Get uncompressed size too
-        ZZIP_STAT zstat;
-        zzip_dir_stat(mZzipDir, lookUpFileName.c_str(), &zstat, flags);
-
-        // Construct & return stream
-        return DataStreamPtr(OGRE_NEW ZipDataStream(lookUpFileName, zzipFile, static_cast<size_t>(zstat.st_size)));
+        if (ret != Z_STREAM_END || zs.total_out != info->uncompressedSize)
+        {
+            mBufferPool->release(buffer, capacity);
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, corrupted);
+        }
 
+        return DataStreamPtr(OGRE_NEW ZipInflatedDataStream(lookUpFileName, mBufferPool, buffer,
+                                                            info->uncompressedSize, capacity));
     }
     //---------------------------------------------------------------------
     DataStreamPtr ZipArchive::create(const String& filename)
@@ -328,7 +550,6 @@ namespace {
     //-----------------------------------------------------------------------
     StringVectorPtr ZipArchive::list(bool recursive, bool dirs) const
     {
-        OGRE_LOCK_AUTO_MUTEX;
         StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
 
         FileInfoList::const_iterator i, iend;
@@ -343,7 +564,6 @@ namespace {
     //-----------------------------------------------------------------------
     FileInfoListPtr ZipArchive::listFileInfo(bool recursive, bool dirs) const
     {
-        OGRE_LOCK_AUTO_MUTEX;
         FileInfoList* fil = OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)();
         FileInfoList::const_iterator i, iend;
         iend = mFileList.end();
@@ -357,7 +577,6 @@ namespace {
     //-----------------------------------------------------------------------
     StringVectorPtr ZipArchive::find(const String& pattern, bool recursive, bool dirs) const
     {
-        OGRE_LOCK_AUTO_MUTEX;
         StringVectorPtr ret = StringVectorPtr(OGRE_NEW_T(StringVector, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
         // If pattern contains a directory name, do a full match
         bool full_match = (pattern.find ('/') != String::npos) ||
@@ -379,7 +598,6 @@ namespace {
     FileInfoListPtr ZipArchive::findFileInfo(const String& pattern, 
         bool recursive, bool dirs) const
     {
-        OGRE_LOCK_AUTO_MUTEX;
         FileInfoListPtr ret = FileInfoListPtr(OGRE_NEW_T(FileInfoList, MEMCATEGORY_GENERAL)(), SPFM_DELETE_T);
         // If pattern contains a directory name, do a full match
         bool full_match = (pattern.find ('/') != String::npos) ||
@@ -398,32 +616,15 @@ namespace {
         return ret;
     }
     //-----------------------------------------------------------------------
-    struct FileNameCompare : public std::binary_function<FileInfo, String, bool>
-    {
-        bool operator()(const Ogre::FileInfo& lhs, const String& filename) const
-        {
-            return lhs.filename == filename;
-        }
-    };
-    //-----------------------------------------------------------------------
     bool ZipArchive::exists(const String& filename) const
-    {       
-        OGRE_LOCK_AUTO_MUTEX;
-        String cleanName = filename;
-#if !OGRE_RESOURCEMANAGER_STRICT
-        if(filename.rfind('/') != String::npos)
-        {
-            StringVector tokens = StringUtil::split(filename, "/");
-            cleanName = tokens[tokens.size() - 1];
-        }
-#endif
-
-        return std::find_if (mFileList.begin(), mFileList.end(), std::bind2nd<FileNameCompare>(FileNameCompare(), cleanName)) != mFileList.end();
+    {
+        const Entry* entry;
+        return findEntry(filename, entry) != NULL;
     }
     //---------------------------------------------------------------------
     time_t ZipArchive::getModifiedTime(const String& filename) const
     {
-        // Zziplib doesn't yet support getting the modification time of individual files
+        // DOS times of entries have a two second resolution and no time zone,
         // so just check the mod time of the zip itself
         struct stat tagStat;
         bool ret = (stat(mName.c_str(), &tagStat) == 0);
@@ -439,98 +640,6 @@ namespace {
 
     }
     //-----------------------------------------------------------------------
-    ZipDataStream::ZipDataStream(const String& name, ZZIP_FILE* zzipFile, size_t uncompressedSize)
-        :DataStream(name), mZzipFile(zzipFile)
-    {
-        mSize = uncompressedSize;
-    }
-    //-----------------------------------------------------------------------
-    ZipDataStream::~ZipDataStream()
-    {
-        close();
-    }
-    //-----------------------------------------------------------------------
-    size_t ZipDataStream::read(void* buf, size_t count)
-    {
-        size_t was_avail = mCache.read(buf, count);
-        zzip_ssize_t r = 0;
-        if (was_avail < count)
-        {
-            r = zzip_file_read(mZzipFile, (char*)buf + was_avail, count - was_avail);
-            if (r<0) {
-                ZZIP_DIR *dir = zzip_dirhandle(mZzipFile);
-                String msg = zzip_strerror_of(dir);
-                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR,
-                    mName+" - error from zziplib: "+msg,
-                    "ZipDataStream::read");
-            }
-            mCache.cacheData((char*)buf + was_avail, (size_t)r);
-        }
-        return was_avail + (size_t)r;
-    }
-    //---------------------------------------------------------------------
-    size_t ZipDataStream::write(const void* buf, size_t count)
-    {
-        // not supported
-        return 0;
-    }
-    //-----------------------------------------------------------------------
-    void ZipDataStream::skip(long count)
-    {
-        long was_avail = static_cast<long>(mCache.avail());
-        if (count > 0)
-        {
-            if (!mCache.ff(count))
-                zzip_seek(mZzipFile, static_cast<zzip_off_t>(count - was_avail), SEEK_CUR);
-        }
-        else if (count < 0)
-        {
-            if (!mCache.rewind((size_t)(-count)))
-                zzip_seek(mZzipFile, static_cast<zzip_off_t>(count + was_avail), SEEK_CUR);
-        }
-    }
-    //-----------------------------------------------------------------------
-    void ZipDataStream::seek( size_t pos )
-    {
-        zzip_off_t newPos = static_cast<zzip_off_t>(pos);
-        zzip_off_t prevPos = static_cast<zzip_off_t>(tell());
-        if (prevPos < 0)
-        {
-            // seek set after invalid pos
-            mCache.clear();
-            zzip_seek(mZzipFile, newPos, SEEK_SET);
-        }
-        else
-        {
-            // everything is going all right, relative seek
-            skip((long)(newPos - prevPos));
-        }
-    }
-    //-----------------------------------------------------------------------
-    size_t ZipDataStream::tell(void) const
-    {
-        zzip_off_t pos = zzip_tell(mZzipFile);
-        if (pos<0)
-            return (size_t)(-1);
-        return static_cast<size_t>(pos) - mCache.avail();
-    }
-    //-----------------------------------------------------------------------
-    bool ZipDataStream::eof(void) const
-    {
-        return (tell() >= mSize);
-    }
-    //-----------------------------------------------------------------------
-    void ZipDataStream::close(void)
-    {
-        mAccess = 0;
-        if (mZzipFile != 0)
-        {
-            zzip_file_close(mZzipFile);
-            mZzipFile = 0;
-        }
-        mCache.clear();
-    }
-    //-----------------------------------------------------------------------
     //  ZipArchiveFactory
     //-----------------------------------------------------------------------
     Archive *ZipArchiveFactory::createInstance( const String& name, bool readOnly )
@@ -538,7 +647,7 @@ namespace {
         if(!readOnly)
             return NULL;
 
-        return OGRE_NEW ZipArchive(name, getType(), getDefaultIO());
+        return OGRE_NEW ZipArchive(name, getType(), false);
     }
     //-----------------------------------------------------------------------
     const String& ZipArchiveFactory::getType(void) const
@@ -551,205 +660,12 @@ namespace {
     //  EmbeddedZipArchiveFactory
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
-    /// a struct to hold embedded file data
-    struct EmbeddedFileData
-    {
-        const uint8 * fileData;
-        zzip_size_t fileSize;
-        zzip_size_t curPos;
-        bool isFileOpened;
-        EmbeddedZipArchiveFactory::DecryptEmbeddedZipFileFunc decryptFunc;
-    };
-    //-----------------------------------------------------------------------
-    /// A type for a map between the file names to file index
-    typedef std::map<String, int> FileNameToIndexMap;
-    typedef FileNameToIndexMap::iterator FileNameToIndexMapIter;
-    /// A type to store the embedded files data
-    typedef std::vector<EmbeddedFileData> EmbbedFileDataList;
-
-    namespace {
-    /// A static map between the file names to file index
-    FileNameToIndexMap * EmbeddedZipArchiveFactory_mFileNameToIndexMap;
-    /// A static list to store the embedded files data
-    EmbbedFileDataList * EmbeddedZipArchiveFactory_mEmbbedFileDataList;
-    #define EMBED_IO_BAD_FILE_HANDLE (-1)
-    #define EMBED_IO_SUCCESS (0)
-    //-----------------------------------------------------------------------
-    /// functions for embedded zzip_plugin_io_handlers implementation 
-    /// The functions are here and not as static members because they 
-    /// use types that I don't want to define in the header like zzip_char_t,
-    //  zzip_ssize_t and such.
-    //-----------------------------------------------------------------------
-    // get file date by index
-    EmbeddedFileData & getEmbeddedFileDataByIndex(int fd)
-    {
-        return (*EmbeddedZipArchiveFactory_mEmbbedFileDataList)[fd-1];
-    }
-    //-----------------------------------------------------------------------
-    // opens the file
-    int EmbeddedZipArchiveFactory_open(zzip_char_t* name, int flags, ...)
-    {
-        String nameAsString = name;
-        FileNameToIndexMapIter foundIter = EmbeddedZipArchiveFactory_mFileNameToIndexMap->find(nameAsString);
-        if (foundIter != EmbeddedZipArchiveFactory_mFileNameToIndexMap->end())
-        {
-            int fd = foundIter->second;
-            EmbeddedFileData & curEmbeddedFileData = getEmbeddedFileDataByIndex(fd);
-            if(curEmbeddedFileData.isFileOpened)
-            {
-               // file is opened - return an error handle
-               return EMBED_IO_BAD_FILE_HANDLE;
-            }
-            
-            curEmbeddedFileData.isFileOpened = true;
-            return fd;
-        }
-        else
-        {
-           // not found - return an error handle
-           return EMBED_IO_BAD_FILE_HANDLE;
-        }
-    }
-    //-----------------------------------------------------------------------
-    // Closes a file.
-    // Return Value - On success, close returns 0. 
-    int EmbeddedZipArchiveFactory_close(int fd)
-    {
-        if (fd == EMBED_IO_BAD_FILE_HANDLE)
-        {
-            // bad index - return an error
-            return -1;
-        }
-
-        EmbeddedFileData & curEmbeddedFileData = getEmbeddedFileDataByIndex(fd);
-
-        if(curEmbeddedFileData.isFileOpened == false)
-        {
-           // file is opened - return an error handle
-           return -1;
-        }
-        else
-        {
-            // success
-            curEmbeddedFileData.isFileOpened = false;
-            curEmbeddedFileData.curPos = 0;
-            return 0;
-        }
-
-    }
-       
-    //-----------------------------------------------------------------------
-    // reads data from the file
-    zzip_ssize_t EmbeddedZipArchiveFactory_read(int fd, void* buf, zzip_size_t len)
-    {
-        if (fd == EMBED_IO_BAD_FILE_HANDLE)
-        {
-            // bad index - return an error size - negative
-            return -1;
-        }
-        // get the current buffer in file;
-        EmbeddedFileData & curEmbeddedFileData = getEmbeddedFileDataByIndex(fd);
-        const uint8 * curFileData = curEmbeddedFileData.fileData;
-        if (len + curEmbeddedFileData.curPos > curEmbeddedFileData.fileSize)
-        {
-            len = curEmbeddedFileData.fileSize - curEmbeddedFileData.curPos;
-        }
-        curFileData += curEmbeddedFileData.curPos;
-        
-        // copy to out buffer
-        memcpy(buf, curFileData, len);
-
-        if( curEmbeddedFileData.decryptFunc != NULL )
-        {
-            if (!curEmbeddedFileData.decryptFunc(curEmbeddedFileData.curPos, buf, len))
-            {
-                // decrypt failed - return an error size - negative
-                return -1;
-            }
-        }
-
-        // move the cursor to the new pos
-        curEmbeddedFileData.curPos += len;
-        
-        return len;
-    }
-    //-----------------------------------------------------------------------
-    // Moves file pointer.
-    zzip_off_t EmbeddedZipArchiveFactory_seeks(int fd, zzip_off_t offset, int whence)
-    {
-        if (fd == EMBED_IO_BAD_FILE_HANDLE)
-        {
-            // bad index - return an error - nonzero value.
-            return -1;
-        }
-        
-        zzip_size_t newPos = -1;
-        // get the current buffer in file;
-        EmbeddedFileData & curEmbeddedFileData = getEmbeddedFileDataByIndex(fd);
-        switch(whence)
-        {
-            case SEEK_CUR:
-                newPos = (zzip_size_t)(curEmbeddedFileData.curPos + offset);
-                break;
-            case SEEK_END:
-                newPos = (zzip_size_t)(curEmbeddedFileData.fileSize - offset);
-                break;
-            case SEEK_SET:
-                newPos = (zzip_size_t)offset;
-                break;
-            default:
-                // bad whence - return an error - nonzero value.
-                return -1;
-                break;
-        };
-        if (newPos >= curEmbeddedFileData.fileSize)
-        {
-            // bad whence - return an error - nonzero value.
-            return -1;
-        }
-
-        curEmbeddedFileData.curPos = newPos;
-        return newPos;
-    }
-    //-----------------------------------------------------------------------
-    // returns the file size
-    zzip_off_t EmbeddedZipArchiveFactory_filesize(int fd)
-    {
-        if (fd == EMBED_IO_BAD_FILE_HANDLE)
-        {
-            // bad index - return an error - nonzero value.
-            return -1;
-        }
-                // get the current buffer in file;
-        EmbeddedFileData & curEmbeddedFileData = getEmbeddedFileDataByIndex(fd);
-        return curEmbeddedFileData.fileSize;
-    }
-    //-----------------------------------------------------------------------
-    // writes data to the file
-    zzip_ssize_t EmbeddedZipArchiveFactory_write(int fd, _zzip_const void* buf, zzip_size_t len)
-    {
-        // the files in this case are read only - return an error  - nonzero value.
-        return -1;
-    }
-
-    /// A static pointer to file io alternative implementation for the embedded files
-    const zzip_plugin_io_handlers* getEmbeddedZipIO()
-    {
-        static zzip_plugin_io_handlers embeddedZipIO = {
-            {EmbeddedZipArchiveFactory_open, EmbeddedZipArchiveFactory_close,
-             EmbeddedZipArchiveFactory_read, EmbeddedZipArchiveFactory_seeks,
-             EmbeddedZipArchiveFactory_filesize, 1, 1, EmbeddedZipArchiveFactory_write}};
-        return &embeddedZipIO;
-    }
-
-    } // namespace {
-    //-----------------------------------------------------------------------
     EmbeddedZipArchiveFactory::EmbeddedZipArchiveFactory() {}
     EmbeddedZipArchiveFactory::~EmbeddedZipArchiveFactory() {}
     //-----------------------------------------------------------------------
     Archive *EmbeddedZipArchiveFactory::createInstance( const String& name, bool readOnly )
     {
-        ZipArchive * resZipArchive = OGRE_NEW ZipArchive(name, getType(), getEmbeddedZipIO());
+        ZipArchive * resZipArchive = OGRE_NEW ZipArchive(name, getType(), true);
         return resZipArchive;
     }
     //-----------------------------------------------------------------------
@@ -780,8 +696,6 @@ namespace {
         }
 
         EmbeddedFileData newEmbeddedFileData;
-        newEmbeddedFileData.curPos = 0;
-        newEmbeddedFileData.isFileOpened = false;
         newEmbeddedFileData.fileData = fileData;
         newEmbeddedFileData.fileSize = fileSize;
         newEmbeddedFileData.decryptFunc = decryptFunc;
@@ -347,6 +347,18 @@ namespace Ogre
             return DXGI_FORMAT_R8G8B8A8_UINT;
         case VET_UBYTE4_NORM:
             return DXGI_FORMAT_R8G8B8A8_UNORM;
+
+        // there is no signed normalised 10:10:10:2 format, R10G10B10A2_UNORM
+        // would decode the normals wrongly
+        case VET_INT_10_10_10_2_NORM:
+            OGRE_EXCEPT(Exception::ERR_RENDERINGAPI_ERROR,
+                        "VET_INT_10_10_10_2_NORM is not supported by Direct3D 11",
+                        "D3D11Mappings::get");
+
+        case VET_HALF2:
+            return DXGI_FORMAT_R16G16_FLOAT;
+        case VET_HALF4:
+            return DXGI_FORMAT_R16G16B16A16_FLOAT;
         }
         // to keep compiler happy
         return DXGI_FORMAT_R32G32B32_FLOAT;
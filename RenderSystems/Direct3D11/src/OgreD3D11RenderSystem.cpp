@@ -890,6 +890,8 @@ namespace Ogre
 
         rsc->setCapability(RSC_USER_CLIP_PLANES);
         rsc->setCapability(RSC_VERTEX_FORMAT_UBYTE4);
+        // there is no signed normalised 10:10:10:2 format
+        rsc->setCapability(RSC_VERTEX_FORMAT_HALF);
 
         rsc->setCapability(RSC_RTT_MAIN_DEPTHBUFFER_ATTACHABLE);
 
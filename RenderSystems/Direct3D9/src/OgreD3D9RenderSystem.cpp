@@ -971,6 +971,8 @@ namespace Ogre
         rsc->setCapability(RSC_USER_CLIP_PLANES);           
         rsc->setCapability(RSC_32BIT_INDEX);            
         rsc->setCapability(RSC_VERTEX_FORMAT_UBYTE4);           
+        rsc->setCapability(RSC_VERTEX_FORMAT_INT_10_10_10_2);
+        rsc->setCapability(RSC_VERTEX_FORMAT_HALF);
         rsc->setCapability(RSC_TEXTURE_1D);         
         rsc->setCapability(RSC_TEXTURE_3D);         
         rsc->setCapability(RSC_NON_POWER_OF_2_TEXTURES);
@@ -1072,6 +1074,14 @@ namespace Ogre
             if ((rkCurCaps.DeclTypes & D3DDTCAPS_UBYTE4) == 0)          
                 rsc->unsetCapability(RSC_VERTEX_FORMAT_UBYTE4); 
 
+            // DEC3N type?
+            if ((rkCurCaps.DeclTypes & D3DDTCAPS_DEC3N) == 0)
+                rsc->unsetCapability(RSC_VERTEX_FORMAT_INT_10_10_10_2);
+
+            // FLOAT16 types?
+            if ((rkCurCaps.DeclTypes & (D3DDTCAPS_FLOAT16_2 | D3DDTCAPS_FLOAT16_4)) != (D3DDTCAPS_FLOAT16_2 | D3DDTCAPS_FLOAT16_4))
+                rsc->unsetCapability(RSC_VERTEX_FORMAT_HALF);
+
             // Check cube map support.
             if ((rkCurCaps.TextureCaps & D3DPTEXTURECAPS_CUBEMAP) == 0)
                 has_level_9_1 = false;
@@ -159,6 +159,11 @@ namespace Ogre {
             case VET_USHORT2_NORM:
             case VET_USHORT4_NORM:
                 return GL_UNSIGNED_SHORT;
+            case VET_INT_10_10_10_2_NORM:
+                return GL_INT_2_10_10_10_REV;
+            case VET_HALF2:
+            case VET_HALF4:
+                return GL_HALF_FLOAT_ARB;
             default:
                 return 0;
         };
@@ -631,6 +631,15 @@ namespace Ogre {
         // UBYTE4 always supported
         rsc->setCapability(RSC_VERTEX_FORMAT_UBYTE4);
 
+        if (GLEW_VERSION_3_3 || GLEW_ARB_vertex_type_2_10_10_10_rev)
+        {
+            rsc->setCapability(RSC_VERTEX_FORMAT_INT_10_10_10_2);
+        }
+        if (GLEW_VERSION_3_0 || GLEW_ARB_half_float_vertex)
+        {
+            rsc->setCapability(RSC_VERTEX_FORMAT_HALF);
+        }
+
         // Infinite far plane always supported
         rsc->setCapability(RSC_INFINITE_FAR_PLANE);
 
@@ -3269,6 +3278,7 @@ namespace Ogre {
             case VET_USHORT2_NORM:
             case VET_SHORT4_NORM:
             case VET_USHORT4_NORM:
+            case VET_INT_10_10_10_2_NORM:
                 normalised = GL_TRUE;
                 break;
             default:
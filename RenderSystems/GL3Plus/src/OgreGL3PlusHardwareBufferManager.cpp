@@ -211,6 +211,11 @@ namespace Ogre {
         case VET_BYTE4:
         case VET_BYTE4_NORM:
             return GL_BYTE;
+        case VET_INT_10_10_10_2_NORM:
+            return GL_INT_2_10_10_10_REV;
+        case VET_HALF2:
+        case VET_HALF4:
+            return GL_HALF_FLOAT;
         };
 
         OgreAssert(false, "unknown Vertex Element Type");
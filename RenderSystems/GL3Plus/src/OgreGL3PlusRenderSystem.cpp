@@ -331,6 +331,11 @@ namespace Ogre {
         // UBYTE4 always supported
         rsc->setCapability(RSC_VERTEX_FORMAT_UBYTE4);
 
+        if (hasMinGLVersion(3, 3) || checkExtension("GL_ARB_vertex_type_2_10_10_10_rev"))
+            rsc->setCapability(RSC_VERTEX_FORMAT_INT_10_10_10_2);
+        // half float vertices are core since 3.0
+        rsc->setCapability(RSC_VERTEX_FORMAT_HALF);
+
         // Infinite far plane always supported
         rsc->setCapability(RSC_INFINITE_FAR_PLANE);
 
@@ -2180,6 +2185,7 @@ namespace Ogre {
         case VET_USHORT2_NORM:
         case VET_SHORT4_NORM:
         case VET_USHORT4_NORM:
+        case VET_INT_10_10_10_2_NORM:
             normalised = GL_TRUE;
             break;
         default:
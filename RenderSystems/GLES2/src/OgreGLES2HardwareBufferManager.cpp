@@ -163,6 +163,12 @@ namespace Ogre {
             case VET_DOUBLE3:
             case VET_DOUBLE4:
                 return 0;
+            // both need OpenGL ES 3.0
+            case VET_INT_10_10_10_2_NORM:
+                return GL_INT_2_10_10_10_REV;
+            case VET_HALF2:
+            case VET_HALF4:
+                return GL_HALF_FLOAT;
         };
 
         OgreAssert(false, "unknown Vertex Element Type");
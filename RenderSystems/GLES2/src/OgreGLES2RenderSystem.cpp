@@ -394,6 +394,13 @@ namespace Ogre {
         // UBYTE4 always supported
         rsc->setCapability(RSC_VERTEX_FORMAT_UBYTE4);
 
+        // packed and half float vertices need ES 3.0
+        if(hasMinGLVersion(3, 0))
+        {
+            rsc->setCapability(RSC_VERTEX_FORMAT_INT_10_10_10_2);
+            rsc->setCapability(RSC_VERTEX_FORMAT_HALF);
+        }
+
         // Infinite far plane always supported
         rsc->setCapability(RSC_INFINITE_FAR_PLANE);
 
@@ -2135,6 +2142,7 @@ namespace Ogre {
             case VET_USHORT2_NORM:
             case VET_SHORT4_NORM:
             case VET_USHORT4_NORM:
+            case VET_INT_10_10_10_2_NORM:
                 normalised = GL_TRUE;
                 break;
             default:
@@ -20,6 +20,14 @@
 #include "OgreRenderWindow.h"
 #include "OgreLodConfigSerializer.h"
 #include "OgreWorkQueue.h"
+#include "OgreHardwareBufferManager.h"
+#include "OgreLogManager.h"
+#include "OgreStringConverter.h"
+#include "OgreTimer.h"
+#include "OgreLodData.h"
+
+#include <map>
+#include <random>
 
 using namespace Ogre;
 
@@ -34,6 +42,7 @@ public:
     void blockedWaitForLodGeneration(const MeshPtr& mesh);
     void addProfile(LodConfig& config);
     void setTestLodConfig(LodConfig& config);
+    MeshPtr createGridMesh(const String& name, size_t size);
 };
 
 //--------------------------------------------------------------------------
@@ -188,6 +197,49 @@ TEST_F(MeshLodTests,QuadricError)
     gen.generateLodLevels(config, LodCollapseCostPtr(new LodCollapseCostQuadric()));
 }
 //--------------------------------------------------------------------------
+namespace
+{
+    /// Counts the vertices added to the collapse cost heap
+    class CountingCollapseCost : public LodCollapseCostQuadric
+    {
+    public:
+        size_t initialized;
+        CountingCollapseCost() : initialized(0) {}
+        void initVertexCollapseCost(LodData* data, LodData::Vertex* vertex)
+        {
+            ++initialized;
+            LodCollapseCostQuadric::initVertexCollapseCost(data, vertex);
+        }
+    };
+
+    std::vector<size_t> getLodIndexCounts(const MeshPtr& mesh)
+    {
+        std::vector<size_t> counts;
+        for (unsigned short i = 0; i < mesh->getNumSubMeshes(); ++i)
+        {
+            const SubMesh::LODFaceList& faces = mesh->getSubMesh(i)->mLodFaceList;
+            for (size_t j = 0; j < faces.size(); ++j)
+                counts.push_back(faces[j]->indexCount);
+        }
+        return counts;
+    }
+}
+TEST_F(MeshLodTests,InitVertexCollapseCostOverride)
+{
+    LodConfig config;
+    setTestLodConfig(config);
+    MeshLodGenerator& gen = MeshLodGenerator::getSingleton();
+    gen.generateLodLevels(config, LodCollapseCostPtr(new LodCollapseCostQuadric()));
+    std::vector<size_t> expected = getLodIndexCounts(mMesh);
+
+    // The costs are computed in parallel, but the override still sees every used vertex.
+    CountingCollapseCost* cost = new CountingCollapseCost();
+    LodCollapseCostPtr costPtr(cost);
+    gen.generateLodLevels(config, costPtr);
+    EXPECT_GT(cost->initialized, 0u);
+    EXPECT_EQ(expected, getLodIndexCounts(mMesh));
+}
+//--------------------------------------------------------------------------
 void MeshLodTests::setTestLodConfig(LodConfig& config)
 {
     config.mesh = mMesh;
@@ -202,3 +254,231 @@ void MeshLodTests::setTestLodConfig(LodConfig& config)
     config.advanced.useBackgroundQueue = false;
 }
 //--------------------------------------------------------------------------
+MeshPtr MeshLodTests::createGridMesh(const String& name, size_t size)
+{
+    // A bumpy height field with size * size quads and shared vertices.
+    MeshPtr mesh = MeshManager::getSingleton().createManual(name, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    SubMesh* sub = mesh->createSubMesh();
+    sub->useSharedVertices = false;
+    sub->vertexData = OGRE_NEW VertexData();
+    size_t vertexCount = (size + 1) * (size + 1);
+    sub->vertexData->vertexCount = vertexCount;
+    sub->vertexData->vertexDeclaration->addElement(0, 0, VET_FLOAT3, VES_POSITION);
+    HardwareVertexBufferSharedPtr vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        sizeof(float) * 3, vertexCount, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    sub->vertexData->vertexBufferBinding->setBinding(0, vbuf);
+    float* pos = static_cast<float*>(vbuf->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t z = 0; z <= size; z++) {
+        for (size_t x = 0; x <= size; x++) {
+            *pos++ = (float)x;
+            *pos++ = 4 * Math::Sin(x * 0.15f) * Math::Cos(z * 0.1f) + Math::Sin((x + z) * 0.7f) * 0.25f;
+            *pos++ = (float)z;
+        }
+    }
+    vbuf->unlock();
+
+    sub->indexData->indexCount = size * size * 6;
+    sub->indexData->indexBuffer = HardwareBufferManager::getSingleton().createIndexBuffer(
+        HardwareIndexBuffer::IT_32BIT, sub->indexData->indexCount, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    uint32* index = static_cast<uint32*>(sub->indexData->indexBuffer->lock(HardwareBuffer::HBL_DISCARD));
+    for (size_t z = 0; z < size; z++) {
+        for (size_t x = 0; x < size; x++) {
+            uint32 i0 = static_cast<uint32>(z * (size + 1) + x);
+            uint32 i1 = i0 + 1;
+            uint32 i2 = i0 + static_cast<uint32>(size + 1);
+            uint32 i3 = i2 + 1;
+            *index++ = i0; *index++ = i2; *index++ = i1;
+            *index++ = i1; *index++ = i2; *index++ = i3;
+        }
+    }
+    sub->indexData->indexBuffer->unlock();
+
+    mesh->_setBounds(AxisAlignedBox(0, -5, 0, (Real)size, 5, (Real)size));
+    mesh->_setBoundingSphereRadius((Real)size);
+    mesh->load();
+    return mesh;
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshLodTests,LargeMeshBenchmark)
+{
+    mRoot->getWorkQueue()->startup();
+
+    const size_t meshCount = 3;
+    std::vector<LodConfig> configs(meshCount);
+    for (size_t i = 0; i < meshCount; i++) {
+        LodConfig& config = configs[i];
+        config.mesh = createGridMesh("LodBenchmarkGrid" + StringConverter::toString(i), 192);
+        config.strategy = PixelCountLodStrategy::getSingletonPtr();
+        config.createGeneratedLodLevel(10, 0.25);
+        config.createGeneratedLodLevel(9, 0.5);
+        config.createGeneratedLodLevel(8, 0.75);
+        config.advanced.useCompression = false;
+    }
+
+    MeshLodGenerator& gen = MeshLodGenerator::getSingleton();
+    Timer timer;
+    unsigned long start = timer.getMilliseconds();
+    LodConfig single(configs[0]);
+    gen.generateLodLevels(single);
+    unsigned long singleTime = timer.getMilliseconds() - start;
+
+    start = timer.getMilliseconds();
+    gen.generateLodLevels(configs);
+    unsigned long batchTime = timer.getMilliseconds() - start;
+
+    LogManager::getSingleton().stream() << "LargeMeshBenchmark: " << configs[0].mesh->getSubMesh(0)->indexData->indexCount / 3
+        << " triangles, one mesh " << singleTime << "ms, batch of " << meshCount << " meshes " << batchTime << "ms on "
+        << OGRE_THREAD_HARDWARE_CONCURRENCY << " threads";
+
+    // The concurrent batch has to produce the same Lod levels as the serial path.
+    for (size_t i = 0; i < meshCount; i++) {
+        ASSERT_EQ(single.levels.size(), configs[i].levels.size());
+        EXPECT_EQ(4u, configs[i].mesh->getNumLodLevels());
+        for (size_t n = 0; n < single.levels.size(); n++) {
+            EXPECT_EQ(single.levels[n].outSkipped, configs[i].levels[n].outSkipped);
+            EXPECT_EQ(single.levels[n].outUniqueVertexCount, configs[i].levels[n].outUniqueVertexCount);
+        }
+        MeshManager::getSingleton().remove(configs[i].mesh);
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshLodTests,CollapseCostHeapBenchmark)
+{
+    // Replays the access pattern of LodCollapser: take the cheapest vertex and
+    // update the costs of some neighbours. The reference is the std::multimap
+    // with an iterator per vertex which LodData used before.
+    typedef std::multimap<Real, LodData::Vertex*> CostMap;
+    const size_t vertexCount = 50000;
+    const size_t updatesPerCollapse = 6;
+
+    std::vector<LodData::Vertex> vertices(vertexCount);
+    std::vector<CostMap::iterator> positions(vertexCount);
+    std::vector<Real> initialCosts(vertexCount);
+    std::vector<std::pair<size_t, Real> > updates;
+    std::mt19937 rng(11);
+    // Few distinct costs, so the order of equal costs matters.
+    std::uniform_int_distribution<int> cost(0, 1000);
+    std::uniform_int_distribution<size_t> vertex(0, vertexCount - 1);
+    for (size_t i = 0; i < vertexCount; i++)
+        initialCosts[i] = (Real)cost(rng);
+    for (size_t i = 0; i < vertexCount * updatesPerCollapse; i++)
+        updates.push_back(std::make_pair(vertex(rng), (Real)cost(rng)));
+
+    Timer timer;
+    std::vector<LodData::Vertex*> mapOrder;
+    mapOrder.reserve(vertexCount);
+    unsigned long start = timer.getMicroseconds();
+    {
+        CostMap map;
+        for (size_t i = 0; i < vertexCount; i++)
+            positions[i] = map.insert(std::make_pair(initialCosts[i], &vertices[i]));
+        size_t u = 0;
+        while (!map.empty()) {
+            LodData::Vertex* top = map.begin()->second;
+            mapOrder.push_back(top);
+            positions[top - &vertices[0]] = map.end();
+            map.erase(map.begin());
+            for (size_t k = 0; k < updatesPerCollapse; k++, u++) {
+                size_t i = updates[u].first;
+                if (positions[i] != map.end()) {
+                    map.erase(positions[i]);
+                    positions[i] = map.insert(std::make_pair(updates[u].second, &vertices[i]));
+                }
+            }
+        }
+    }
+    unsigned long mapTime = timer.getMicroseconds() - start;
+
+    std::vector<LodData::Vertex*> heapOrder;
+    heapOrder.reserve(vertexCount);
+    start = timer.getMicroseconds();
+    {
+        LodData::CollapseCostHeap heap;
+        heap.reserve(vertexCount);
+        for (size_t i = 0; i < vertexCount; i++)
+            heap.push(&vertices[i], initialCosts[i]);
+        size_t u = 0;
+        while (!heap.empty()) {
+            LodData::Vertex* top = heap.top().vertex;
+            heapOrder.push_back(top);
+            heap.erase(top);
+            for (size_t k = 0; k < updatesPerCollapse; k++, u++) {
+                LodData::Vertex* v = &vertices[updates[u].first];
+                if (heap.contains(v))
+                    heap.update(v, updates[u].second);
+            }
+        }
+    }
+    unsigned long heapTime = timer.getMicroseconds() - start;
+
+    LogManager::getSingleton().stream() << "CollapseCostHeapBenchmark: " << vertexCount << " vertices, std::multimap "
+        << mapTime / 1000 << "ms, CollapseCostHeap " << heapTime / 1000 << "ms";
+
+    // The heap has to collapse in exactly the same order to keep the generated Lods.
+    EXPECT_TRUE(mapOrder == heapOrder);
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshLodTests,VertexCacheOptimisation)
+{
+    struct Triangles
+    {
+        typedef std::vector<float> Corner;
+
+        // Triangle corner positions, rotated to start with the smallest corner and sorted
+        static std::vector<std::vector<Corner> > get(const SubMesh* sub)
+        {
+            const IndexData* indexData = sub->indexData;
+            const VertexData* vertexData = sub->vertexData;
+            HardwareBufferLockGuard indexLock(indexData->indexBuffer, HardwareBuffer::HBL_READ_ONLY);
+            HardwareBufferLockGuard vertexLock(vertexData->vertexBufferBinding->getBuffer(0), HardwareBuffer::HBL_READ_ONLY);
+            const uint32* indices = static_cast<const uint32*>(indexLock.pData);
+            const float* positions = static_cast<const float*>(vertexLock.pData);
+
+            std::vector<std::vector<Corner> > triangles(indexData->indexCount / 3);
+            for (size_t t = 0; t < triangles.size(); t++) {
+                for (size_t k = 0; k < 3; k++) {
+                    const float* pos = positions + indices[t * 3 + k] * 3;
+                    triangles[t].push_back(Corner(pos, pos + 3));
+                }
+                std::rotate(triangles[t].begin(), std::min_element(triangles[t].begin(), triangles[t].end()), triangles[t].end());
+            }
+            std::sort(triangles.begin(), triangles.end());
+            return triangles;
+        }
+    };
+
+    MeshPtr mesh = createGridMesh("VertexCacheGrid", 64);
+    SubMesh* sub = mesh->getSubMesh(0);
+    std::vector<std::vector<Triangles::Corner> > trianglesBefore = Triangles::get(sub);
+    VertexCacheProfiler before;
+    before.profile(sub->indexData->indexBuffer);
+
+    LodConfig config(mesh, PixelCountLodStrategy::getSingletonPtr());
+    config.createGeneratedLodLevel(10, 0.5);
+    config.advanced.useCompression = false;
+    config.advanced.optimiseVertexCache = true;
+    MeshLodGenerator::getSingleton().generateLodLevels(config);
+    EXPECT_EQ(2u, mesh->getNumLodLevels());
+
+    // Same triangles with the same winding, but fewer cache misses
+    EXPECT_EQ(trianglesBefore, Triangles::get(sub));
+    VertexCacheProfiler after;
+    after.profile(sub->indexData->indexBuffer);
+    EXPECT_EQ(before.getHits() + before.getMisses(), after.getHits() + after.getMisses());
+    EXPECT_LT(after.getMisses(), before.getMisses() * 3 / 4);
+
+    // Vertices are stored in order of first use
+    HardwareBufferLockGuard indexLock(sub->indexData->indexBuffer, HardwareBuffer::HBL_READ_ONLY);
+    const uint32* indices = static_cast<const uint32*>(indexLock.pData);
+    uint32 nextVertex = 0;
+    for (size_t i = 0; i < sub->indexData->indexCount; i++) {
+        ASSERT_LE(indices[i], nextVertex);
+        if (indices[i] == nextVertex)
+            nextVertex++;
+    }
+    EXPECT_EQ(sub->vertexData->vertexCount, nextVertex);
+    indexLock.unlock();
+
+    MeshManager::getSingleton().remove(mesh);
+}
+//--------------------------------------------------------------------------
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include "OgreRoot.h"
 #include "OgrePageManager.h"
 #include "OgreGrid2DPageStrategy.h"
+#include "OgrePredictiveGrid2DPageStrategy.h"
 #include "OgreFileSystemLayer.h"
 #include "OgreBuildSettings.h"
 
@@ -37,6 +38,12 @@ THE SOFTWARE.
 #include "OgreStaticPluginLoader.h"
 #include "OgrePaging.h"
 #include "OgreLogManager.h"
+#include "OgreSceneNode.h"
+#include "OgreCamera.h"
+#include "OgreTimer.h"
+#include "OgrePage.h"
+#include "OgreDefaultHardwareBufferManager.h"
+#include "OgreMaterialManager.h"
 
 using namespace Ogre;
 
@@ -46,6 +53,7 @@ public:
     Root* mRoot;
     PageManager* mPageManager;
     SceneManager* mSceneMgr;
+    HardwareBufferManager* mHBM;
     FileSystemLayer* mFSLayer;
 
 #ifdef OGRE_STATIC_LIB
@@ -70,6 +78,9 @@ void PageCoreTests::SetUp()
     mRoot = OGRE_NEW Root(pluginsPath);
 #endif
 
+    // cameras need a buffer manager and the default material for their frustum geometry
+    mHBM = OGRE_NEW DefaultHardwareBufferManager();
+    MaterialManager::getSingleton().initialise();
     mPageManager = OGRE_NEW PageManager();
 
     // make certain the resource location is NOT read-only
@@ -83,6 +94,7 @@ void PageCoreTests::TearDown()
 {
     OGRE_DELETE mPageManager;
     OGRE_DELETE mRoot;
+    OGRE_DELETE mHBM;
     OGRE_DELETE_T(mFSLayer, FileSystemLayer, Ogre::MEMCATEGORY_GENERAL);
 }
 //--------------------------------------------------------------------------
@@ -116,4 +128,268 @@ TEST_F(PageCoreTests,SimpleCreateSaveLoadWorld)
     EXPECT_TRUE(section != 0);
 }
 //--------------------------------------------------------------------------
+TEST_F(PageCoreTests,PredictiveGrid2DStrategy)
+{
+    PagedWorld* world = mPageManager->createWorld("PredictiveWorld");
+    PagedWorldSection* section = world->createSection("PredictiveGrid2D", mSceneMgr, "Section1");
+    PredictiveGrid2DPageStrategyData* data =
+        static_cast<PredictiveGrid2DPageStrategyData*>(section->getStrategyData());
+    data->setCellSize(100);
+    data->setLoadRadius(150);
+    data->setHoldRadius(300);
+    data->setLookAheadTime(2);
+    data->setPageBudget(1);
+
+    Camera* cam = mSceneMgr->createCamera("PagingCam");
+    SceneNode* camNode = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+    camNode->attachObject(cam);
+
+    // stationary camera requests the same 5x5 load range as Grid2D
+    section->frameStart(0.1f);
+    section->notifyCamera(cam);
+    EXPECT_EQ(25u, data->getFrameStats().pagesRequested);
+    // nothing processes the work queue, so every page is still pending
+    EXPECT_EQ(25u, data->getFrameStats().pagesLoadedLate);
+    EXPECT_TRUE(section->getPage(data->calculatePageID(-2, 0)) != 0);
+    EXPECT_TRUE(section->getPage(data->calculatePageID(3, 0)) == 0);
+    section->frameEnd(0.1f);
+
+    // move along +X at 5 cells per second
+    for (int i = 1; i <= 3; ++i)
+    {
+        camNode->setPosition(50.0f * i, 0, 0);
+        section->frameStart(0.1f);
+        section->notifyCamera(cam);
+        section->frameEnd(0.1f);
+    }
+    EXPECT_GT(data->getCameraVelocity(cam).x, 0);
+    EXPECT_EQ(0.0f, data->getCameraVelocity(cam).y);
+
+    // pages well beyond the hold range ahead of the camera have been requested
+    EXPECT_TRUE(section->getPage(data->calculatePageID(8, 0)) != 0);
+    // but not behind or to the side of it
+    EXPECT_TRUE(section->getPage(data->calculatePageID(2, 3)) == 0);
+    // pages left behind were evicted to stay within budget, least recently used first
+    EXPECT_GT(data->getFrameStats().pagesEvicted, 0u);
+    EXPECT_TRUE(section->getPage(data->calculatePageID(-2, 0)) == 0);
+    EXPECT_TRUE(section->getPage(data->calculatePageID(2, 0)) != 0);
+}
+//--------------------------------------------------------------------------
+TEST_F(PageCoreTests,PredictiveGrid2DStrategyDiscontinuities)
+{
+    PagedWorld* world = mPageManager->createWorld("PredictiveWorld");
+    PagedWorldSection* section = world->createSection("PredictiveGrid2D", mSceneMgr, "Section1");
+    PredictiveGrid2DPageStrategyData* data =
+        static_cast<PredictiveGrid2DPageStrategyData*>(section->getStrategyData());
+    data->setCellSize(100);
+    data->setLoadRadius(150);
+    data->setHoldRadius(300);
+    data->setLookAheadTime(2);
+
+    Camera* cam = mSceneMgr->createCamera("PagingCam");
+    SceneNode* camNode = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+    camNode->attachObject(cam);
+
+    section->frameStart(0.01f);
+    section->notifyCamera(cam);
+    section->frameEnd(0.01f);
+
+    // a teleport does not predict any motion
+    camNode->setPosition(100000, 0, 0);
+    section->frameStart(0.01f);
+    section->notifyCamera(cam);
+    section->frameEnd(0.01f);
+    EXPECT_EQ(Vector2::ZERO, data->getCameraVelocity(cam));
+    EXPECT_EQ(25u, data->getFrameStats().pagesRequested);
+
+    // very fast motion, 250 cells per second
+    for (int i = 1; i <= 3; ++i)
+    {
+        camNode->setPosition(100000 + 250.0f * i, 0, 0);
+        section->frameStart(0.01f);
+        section->notifyCamera(cam);
+        section->frameEnd(0.01f);
+        EXPECT_LE(data->getFrameStats().pagesRequested, 25u + data->getMaxSweptPages());
+    }
+    EXPECT_GT(data->getCameraVelocity(cam).x, 0);
+    // the look-ahead is clamped
+    EXPECT_TRUE(section->getPage(data->calculatePageID(1008 + 10, 0)) != 0);
+    EXPECT_TRUE(section->getPage(data->calculatePageID(1008 + 20, 0)) == 0);
+}
+//--------------------------------------------------------------------------
+namespace
+{
+    /// Procedural pages which take a fixed time to finalise in the main thread
+    class FlyThroughPageProvider : public PageProvider
+    {
+        Timer mTimer;
+    public:
+        size_t pagesFinalised;
+        std::map<PagedWorldSection*, size_t> sectionPagesFinalised;
+
+        FlyThroughPageProvider() : pagesFinalised(0) {}
+
+        bool prepareProceduralPage(Page* page, PagedWorldSection* section) { return true; }
+        bool loadProceduralPage(Page* page, PagedWorldSection* section)
+        {
+            // simulate uploading page content to the GPU
+            unsigned long start = mTimer.getMicroseconds();
+            while (mTimer.getMicroseconds() - start < 2000) {}
+            ++pagesFinalised;
+            ++sectionPagesFinalised[section];
+            return true;
+        }
+    };
+}
+//--------------------------------------------------------------------------
+TEST_F(PageCoreTests,FlyThroughBenchmark)
+{
+    mRoot->getWorkQueue()->startup();
+
+    FlyThroughPageProvider provider;
+    mPageManager->setPageProvider(&provider);
+    mPageManager->setPageRequestLimit(4);
+    mPageManager->setPageFinaliseTimeBudget(3);
 
+    Camera* cam = mSceneMgr->createCamera("FlyThroughCam");
+    SceneNode* camNode = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+    camNode->attachObject(cam);
+    mPageManager->addCamera(cam);
+
+    const char* strategies[] = {"Grid2D", "PredictiveGrid2D"};
+    for (const char* strategy : strategies)
+    {
+        PagedWorld* world = mPageManager->createWorld();
+        PagedWorldSection* section = world->createSection(strategy, mSceneMgr);
+        Grid2DPageStrategyData* data = static_cast<Grid2DPageStrategyData*>(section->getStrategyData());
+        data->setCellSize(100);
+        data->setLoadRadius(300);
+        data->setHoldRadius(500);
+
+        size_t pagesBefore = provider.pagesFinalised;
+        size_t maxFinalisedPerFrame = 0;
+        size_t pagesNotReady = 0;
+        unsigned long worstFrame = 0;
+
+        FrameEvent evt;
+        evt.timeSinceLastEvent = evt.timeSinceLastFrame = 1 / 60.0f;
+        Timer timer;
+        unsigned long start = timer.getMilliseconds();
+        // fly along +X at 6 cells per second
+        for (int frame = 0; frame < 300; ++frame)
+        {
+            camNode->setPosition(frame * 10.0f, 0, 0);
+
+            size_t finalised = provider.pagesFinalised;
+            unsigned long frameStart = timer.getMicroseconds();
+            mRoot->_fireFrameStarted(evt);
+            mRoot->_fireFrameRenderingQueued(evt);
+            mRoot->_fireFrameEnded(evt);
+            worstFrame = std::max(worstFrame, timer.getMicroseconds() - frameStart);
+            maxFinalisedPerFrame = std::max(maxFinalisedPerFrame, provider.pagesFinalised - finalised);
+
+            // pages within the load range which can't be displayed yet
+            Vector2 gridPos;
+            int32 x, y;
+            data->convertWorldToGridSpace(camNode->getPosition(), gridPos);
+            data->determineGridLocation(gridPos, &x, &y);
+            for (int32 cy = y - 3; cy <= y + 3; ++cy)
+            {
+                for (int32 cx = x - 3; cx <= x + 3; ++cx)
+                {
+                    Page* page = section->getPage(data->calculatePageID(cx, cy));
+                    if (!page || page->isLoadPending() || page->isDeferredProcessInProgress())
+                        ++pagesNotReady;
+                }
+            }
+        }
+
+        LogManager::getSingleton().stream() << "FlyThroughBenchmark " << strategy << ": "
+            << (provider.pagesFinalised - pagesBefore) << " pages finalised, "
+            << pagesNotReady << " page-frames not ready, worst frame "
+            << worstFrame / 1000.0f << "ms, total " << timer.getMilliseconds() - start << "ms";
+
+        // the frames above don't wait for the WorkQueue, so keep pumping until the
+        // page under the camera is there, in case the worker threads lagged behind
+        Vector2 gridPos;
+        int32 x, y;
+        data->convertWorldToGridSpace(camNode->getPosition(), gridPos);
+        data->determineGridLocation(gridPos, &x, &y);
+        PageID camPage = data->calculatePageID(x, y);
+        for (int i = 0; i < 1000; ++i)
+        {
+            Page* page = section->getPage(camPage);
+            if (page && !page->isLoadPending() && !page->isDeferredProcessInProgress() &&
+                provider.pagesFinalised > pagesBefore)
+                break;
+
+            size_t finalised = provider.pagesFinalised;
+            mRoot->_fireFrameStarted(evt);
+            mRoot->_fireFrameRenderingQueued(evt);
+            mRoot->_fireFrameEnded(evt);
+            maxFinalisedPerFrame = std::max(maxFinalisedPerFrame, provider.pagesFinalised - finalised);
+            OGRE_THREAD_SLEEP(1);
+        }
+
+        // each page takes 2ms to finalise, so a 3ms budget allows 2 per frame
+        EXPECT_LE(maxFinalisedPerFrame, 2u);
+        EXPECT_GT(provider.pagesFinalised, pagesBefore);
+
+        mPageManager->destroyWorld(world);
+    }
+
+    mPageManager->removeCamera(cam);
+    mPageManager->setPageProvider(0);
+}
+//--------------------------------------------------------------------------
+TEST_F(PageCoreTests,PageFinaliseTimeBudgetIsShared)
+{
+    mRoot->getWorkQueue()->startup();
+
+    FlyThroughPageProvider provider;
+    mPageManager->setPageProvider(&provider);
+    mPageManager->setPageRequestLimit(4);
+    // less than a single page takes
+    mPageManager->setPageFinaliseTimeBudget(1);
+
+    Camera* cam = mSceneMgr->createCamera("BudgetCam");
+    mSceneMgr->getRootSceneNode()->createChildSceneNode()->attachObject(cam);
+    mPageManager->addCamera(cam);
+
+    PagedWorld* worlds[2];
+    PagedWorldSection* sections[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        worlds[i] = mPageManager->createWorld();
+        sections[i] = worlds[i]->createSection("Grid2D", mSceneMgr);
+        Grid2DPageStrategyData* data = static_cast<Grid2DPageStrategyData*>(sections[i]->getStrategyData());
+        data->setCellSize(100);
+        data->setLoadRadius(300);
+        data->setHoldRadius(500);
+    }
+
+    // the first section uses up the budget every frame, the second one still progresses
+    FrameEvent evt;
+    evt.timeSinceLastEvent = evt.timeSinceLastFrame = 1 / 60.0f;
+    size_t framesBoth = 0;
+    for (int frame = 0; frame < 1000 && framesBoth < 10; ++frame)
+    {
+        size_t before[2] = {provider.sectionPagesFinalised[sections[0]], provider.sectionPagesFinalised[sections[1]]};
+        size_t finalised = provider.pagesFinalised;
+        mRoot->_fireFrameStarted(evt);
+        mRoot->_fireFrameRenderingQueued(evt);
+        mRoot->_fireFrameEnded(evt);
+        EXPECT_LE(provider.pagesFinalised - finalised, 2u);
+        if (provider.sectionPagesFinalised[sections[0]] > before[0] &&
+            provider.sectionPagesFinalised[sections[1]] > before[1])
+            ++framesBoth;
+        OGRE_THREAD_SLEEP(1);
+    }
+    EXPECT_EQ(10u, framesBoth);
+
+    for (int i = 0; i < 2; ++i)
+        mPageManager->destroyWorld(worlds[i]);
+    mPageManager->removeCamera(cam);
+    mPageManager->setPageProvider(0);
+}
+//--------------------------------------------------------------------------
@@ -77,6 +77,39 @@ TEST_F(RTShaderSystem, createShaderBasedTechnique)
     EXPECT_TRUE(shaderGen.removeShaderBasedTechnique(mat->getTechniques()[0], "MyScheme"));
 }
 
+TEST_F(RTShaderSystem, ValidateSchemeParallel)
+{
+    auto& shaderGen = RTShader::ShaderGenerator::getSingleton();
+
+    std::vector<MaterialPtr> materials;
+    for (int i = 0; i < 16; i++)
+    {
+        auto mat = MaterialManager::getSingleton().create("TestMat" + StringConverter::toString(i), RGN_DEFAULT);
+        if (i % 2)
+            mat->getTechniques()[0]->getPasses()[0]->setVertexColourTracking(TVC_DIFFUSE);
+        EXPECT_TRUE(shaderGen.createShaderBasedTechnique(mat->getTechniques()[0], "MyScheme"));
+        materials.push_back(mat);
+    }
+
+    shaderGen.validateScheme("MyScheme");
+
+    for (size_t i = 0; i < materials.size(); i++)
+    {
+        ASSERT_EQ(materials[i]->getTechniques().size(), size_t(2));
+        auto pass = materials[i]->getTechniques()[1]->getPasses()[0];
+        EXPECT_TRUE(pass->hasGpuProgram(GPT_VERTEX_PROGRAM));
+        EXPECT_TRUE(pass->hasGpuProgram(GPT_FRAGMENT_PROGRAM));
+
+        // identical passes share their programs
+        auto other = materials[i % 2]->getTechniques()[1]->getPasses()[0];
+        EXPECT_EQ(pass->getGpuProgram(GPT_VERTEX_PROGRAM), other->getGpuProgram(GPT_VERTEX_PROGRAM));
+        EXPECT_EQ(pass->getGpuProgram(GPT_FRAGMENT_PROGRAM), other->getGpuProgram(GPT_FRAGMENT_PROGRAM));
+    }
+
+    EXPECT_NE(materials[0]->getTechniques()[1]->getPasses()[0]->getGpuProgram(GPT_VERTEX_PROGRAM),
+              materials[1]->getTechniques()[1]->getPasses()[0]->getGpuProgram(GPT_VERTEX_PROGRAM));
+}
+
 TEST_F(RTShaderSystem, MaterialSerializer)
 {
     auto& shaderGen = RTShader::ShaderGenerator::getSingleton();
@@ -36,6 +36,7 @@ THE SOFTWARE.
 #include "OgreConfigFile.h"
 #include "OgreResourceGroupManager.h"
 #include "OgreLogManager.h"
+#include "OgreStreamSerialiser.h"
 
 using namespace Ogre;
 
@@ -122,3 +123,221 @@ TEST_F(TerrainTests, create)
     OGRE_DELETE t;
 }
 //--------------------------------------------------------------------------
+TEST_F(TerrainTests, heightDeltas)
+{
+    Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+
+    // ridges on every odd column, which the first LOD collapses
+    std::vector<float> heights(129 * 129);
+    for (size_t y = 0; y < 129; ++y)
+        for (size_t x = 0; x < 129; ++x)
+            heights[y * 129 + x] = x % 2 ? 1.0f : 0.0f;
+
+    Terrain::ImportData imp;
+    imp.inputFloat = heights.data();
+    imp.terrainSize = 129;
+    imp.worldSize = 1000;
+    imp.minBatchSize = 17;
+    imp.maxBatchSize = 33;
+    ASSERT_TRUE(t->prepare(imp));
+
+    EXPECT_FLOAT_EQ(*t->getDeltaData(1, 0), -1.0f);
+    EXPECT_FLOAT_EQ(*t->getDeltaData(127, 126), -1.0f);
+    EXPECT_FLOAT_EQ(*t->getDeltaData(2, 1), 0.0f);
+    EXPECT_FLOAT_EQ(*t->getDeltaData(0, 0), 0.0f);
+
+    OGRE_DELETE t;
+}
+//--------------------------------------------------------------------------
+TEST_F(TerrainTests, lightmapShadows)
+{
+    mTerrainOpts->setLightMapSize(128);
+    mTerrainOpts->setLightMapDirection(Vector3(1, -1, 0).normalisedCopy());
+    Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+
+    // a wall along the terrain y axis, casting its shadow towards +x
+    std::vector<float> heights(129 * 129, 0.0f);
+    for (size_t y = 0; y < 129; ++y)
+        for (size_t x = 60; x <= 64; ++x)
+            heights[y * 129 + x] = 200.0f;
+
+    Terrain::ImportData imp;
+    imp.inputFloat = heights.data();
+    imp.terrainSize = 129;
+    imp.worldSize = 1000;
+    imp.minBatchSize = 17;
+    imp.maxBatchSize = 33;
+    ASSERT_TRUE(t->prepare(imp));
+
+    Rect all(0, 0, 129, 129), finalRect;
+    PixelBox* lightmap = t->calculateLightmap(all, Rect(), finalRect);
+    ASSERT_EQ(finalRect, Rect(0, 0, 128, 128));
+
+    // rows are stored bottom up
+    EXPECT_EQ(lightmap->data[63 * 128 + 40], 255);
+    EXPECT_EQ(lightmap->data[63 * 128 + 79], 0);
+    EXPECT_EQ(lightmap->data[63 * 128 + 110], 255);
+
+    OGRE_FREE(lightmap->data, MEMCATEGORY_GENERAL);
+    OGRE_DELETE lightmap;
+    OGRE_DELETE t;
+}
+//--------------------------------------------------------------------------
+TEST_F(TerrainTests, rayIntersects)
+{
+    Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+
+    // a wall along the terrain y axis
+    std::vector<float> heights(129 * 129, 0.0f);
+    for (size_t y = 0; y < 129; ++y)
+        for (size_t x = 60; x <= 64; ++x)
+            heights[y * 129 + x] = 200.0f;
+
+    Terrain::ImportData imp;
+    imp.inputFloat = heights.data();
+    imp.terrainSize = 129;
+    imp.worldSize = 1024;
+    imp.minBatchSize = 17;
+    imp.maxBatchSize = 33;
+    ASSERT_TRUE(t->prepare(imp));
+
+    // straight down onto the ground
+    std::pair<bool, Vector3> hit = t->rayIntersects(Ray(Vector3(100, 500, -100), Vector3::NEGATIVE_UNIT_Y));
+    ASSERT_TRUE(hit.first);
+    EXPECT_TRUE(hit.second.positionEquals(Vector3(100, 0, -100), 1e-3f));
+
+    // horizontally against the slope of the wall, halfway between vertex 64 and 65
+    hit = t->rayIntersects(Ray(Vector3(300, 100, 10), Vector3::NEGATIVE_UNIT_X));
+    ASSERT_TRUE(hit.first);
+    EXPECT_TRUE(hit.second.positionEquals(Vector3(64.5f * 8 - 512, 100, 10), 1e-2f));
+
+    // above everything
+    EXPECT_FALSE(t->rayIntersects(Ray(Vector3(300, 250, 10), Vector3::NEGATIVE_UNIT_X)).first);
+
+    OGRE_DELETE t;
+}
+//--------------------------------------------------------------------------
+TEST_F(TerrainTests, rayIntersectsDistantShallowRay)
+{
+    Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+
+    Terrain::ImportData imp;
+    imp.terrainSize = 513;
+    imp.worldSize = 12000;
+    imp.minBatchSize = 33;
+    imp.maxBatchSize = 65;
+    ASSERT_TRUE(t->prepare(imp));
+
+    // far outside the terrain and almost parallel to it, the ray reaches the
+    // flat ground right at the centre
+    Vector3 dir = Vector3(-1, -0.01f, -1).normalisedCopy();
+    std::pair<bool, Vector3> hit = t->rayIntersects(Ray(Vector3(100000, 1000, 100000), dir));
+    ASSERT_TRUE(hit.first);
+    EXPECT_TRUE(hit.second.positionEquals(Vector3::ZERO, 0.5f));
+
+    // and misses it when starting a little higher
+    EXPECT_FALSE(t->rayIntersects(Ray(Vector3(100000, 1100, 100000), dir)).first);
+
+    OGRE_DELETE t;
+}
+//--------------------------------------------------------------------------
+TEST_F(TerrainTests, batchHeights)
+{
+    Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+    Image img;
+    img.load("terrain.png", ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+
+    Terrain::ImportData imp;
+    imp.inputImage = &img;
+    imp.inputScale = 600;
+    imp.terrainSize = 129;
+    imp.worldSize = 1000;
+    imp.minBatchSize = 17;
+    imp.maxBatchSize = 33;
+    ASSERT_TRUE(t->prepare(imp));
+
+    std::vector<Vector2> positions;
+    for (int i = 0; i <= 100; ++i)
+        positions.push_back(Vector2(i / 100.0f, Math::Abs(Math::Sin(i * 0.37f))));
+
+    std::vector<float> heights(positions.size());
+    std::vector<Vector3> normals(positions.size());
+    t->getHeightsAtTerrainPositions(&positions[0], positions.size(), &heights[0], &normals[0]);
+
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        EXPECT_NEAR(heights[i], t->getHeightAtTerrainPosition(positions[i].x, positions[i].y), 1e-2f);
+        EXPECT_NEAR(normals[i].length(), 1.0f, 1e-4f);
+        EXPECT_GT(normals[i].y, 0.0f); // ALIGN_X_Z
+    }
+
+    OGRE_DELETE t;
+}
+//--------------------------------------------------------------------------
+TEST_F(TerrainTests, lodDataRoundTrip)
+{
+    Terrain* t = OGRE_NEW Terrain(mSceneMgr);
+    std::vector<float> heights(129 * 129);
+    for (size_t y = 0; y < 129; ++y)
+        for (size_t x = 0; x < 129; ++x)
+            heights[y * 129 + x] = Math::Sin(x * 0.3f) * 20 + y * 0.5f;
+
+    Terrain::ImportData imp;
+    imp.inputFloat = heights.data();
+    imp.terrainSize = 129;
+    imp.worldSize = 1000;
+    imp.minBatchSize = 17;
+    imp.maxBatchSize = 33;
+    ASSERT_TRUE(t->prepare(imp));
+
+    String path = "./lodDataRoundTrip.dat";
+    // deflating needs zlib
+    for (int compress = OGRE_NO_ZIP_ARCHIVE ? 0 : 1; compress >= 0; --compress)
+    {
+        // version 1 chunks are deflated, version 2 chunks are raw
+        mTerrainOpts->setCompressLodData(compress != 0);
+        {
+            // Terrain::save always deflates the layer data, so write the LOD data only
+            DataStreamPtr out = Root::createFileStream(path);
+            StreamSerialiser ser(out);
+            ser.writeChunkBegin(Terrain::TERRAIN_CHUNK_ID, Terrain::TERRAIN_CHUNK_VERSION);
+            ser.writeChunkBegin(Terrain::TERRAINGENERALINFO_CHUNK_ID, Terrain::TERRAINGENERALINFO_CHUNK_VERSION);
+            ser.writeChunkEnd(Terrain::TERRAINGENERALINFO_CHUNK_ID);
+            TerrainLodManager::saveLodData(ser, t);
+            ser.writeChunkEnd(Terrain::TERRAIN_CHUNK_ID);
+        }
+
+        // streamed from the file and, for raw chunks, used in place from memory
+        for (int inMemory = 0; inMemory < 2; ++inMemory)
+        {
+            DataStreamPtr stream = Root::openFileStream(path);
+            if (inMemory)
+                stream.reset(OGRE_NEW MemoryDataStream(stream));
+
+            Terrain* loaded = OGRE_NEW Terrain(mSceneMgr);
+            Terrain::ImportData flat(imp);
+            flat.inputFloat = 0;
+            ASSERT_TRUE(loaded->prepare(flat));
+            ASSERT_EQ(loaded->getNumLodLevels(), t->getNumLodLevels());
+            {
+                TerrainLodManager lodMgr(loaded, stream);
+                lodMgr.readLodData(loaded->getNumLodLevels() - 1, 0);
+            }
+
+            for (long y = 0; y < 129; ++y)
+            {
+                for (long x = 0; x < 129; ++x)
+                {
+                    ASSERT_EQ(*loaded->getHeightData(x, y), *t->getHeightData(x, y))
+                        << "compress " << compress << " inMemory " << inMemory << " at " << x << ", " << y;
+                    ASSERT_EQ(*loaded->getDeltaData(x, y), *t->getDeltaData(x, y));
+                }
+            }
+            OGRE_DELETE loaded;
+        }
+    }
+    FileSystemLayer::removeFile(path);
+
+    OGRE_DELETE t;
+}
+//--------------------------------------------------------------------------
@@ -0,0 +1,323 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+
+#include "RootWithoutRenderSystemFixture.h"
+#include "OgreVolumeCSGSource.h"
+#include "OgreVolumeCacheSource.h"
+#include "OgreVolumeBrickGridSource.h"
+#include "OgreVolumeHalfFloatGridSource.h"
+#include "OgreVolumeChunk.h"
+#include "OgreVolumeMeshBuilder.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreWorkQueue.h"
+#include "OgreBitwise.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+using namespace Ogre;
+using namespace Ogre::Volume;
+
+typedef RootWithoutRenderSystemFixture VolumeTests;
+//--------------------------------------------------------------------------
+namespace
+{
+    /// Checks that the batch functions of a source give the same results as sampling one by one
+    void expectBatchEqualsSingle(const Source& src, const std::vector<Vector3>& positions)
+    {
+        std::vector<Vector4> batchGradients(positions.size());
+        std::vector<Real> batchValues(positions.size());
+        src.getValuesAndGradients(&positions[0], &batchGradients[0], positions.size());
+        src.getValues(&positions[0], &batchValues[0], positions.size());
+
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+            Vector4 single = src.getValueAndGradient(positions[i]);
+            ASSERT_EQ(single, batchGradients[i]) << "at " << positions[i];
+            ASSERT_EQ(src.getValue(positions[i]), batchValues[i]) << "at " << positions[i];
+        }
+    }
+
+    /// Exposes the brick encoding of BrickGridSource
+    class BrickCodec : public BrickGridSource
+    {
+    public:
+        BrickCodec(const Source *src, BrickFormat format, bool compress) :
+            BrickGridSource(src, Vector3(16), BRICK_SIZE, BRICK_SIZE, BRICK_SIZE, 0, format, compress)
+        {
+        }
+
+        /// Encodes and decodes the first brick, returns whether it got run length compressed
+        bool roundTrip(const std::vector<float>& values, std::vector<float>& decoded)
+        {
+            decoded.resize(BRICK_VOXELS);
+            encodeBrick(0, &values[0]);
+            decodeBrick(mBricks[0], &decoded[0]);
+            return mBricks[0].mCompressed;
+        }
+    };
+
+    /// Remembers the latest triangle count of every chunk and which chunks got built
+    class ChunkRecorder : public MeshBuilderCallback
+    {
+    public:
+        std::map<const SimpleRenderable*, size_t> indices;
+        std::set<const SimpleRenderable*> built;
+
+        void ready(const SimpleRenderable *simpleRenderable, const VecVertex &vertices, const VecIndices &ind, size_t level, int inProcess)
+        {
+            indices[simpleRenderable] = ind.size();
+            built.insert(simpleRenderable);
+        }
+
+        size_t totalIndices() const
+        {
+            size_t total = 0;
+            for (std::map<const SimpleRenderable*, size_t>::const_iterator it = indices.begin(); it != indices.end(); ++it)
+            {
+                total += it->second;
+            }
+            return total;
+        }
+    };
+}
+//--------------------------------------------------------------------------
+TEST_F(VolumeTests, BatchedEvaluation)
+{
+    // more positions than the block size of the CSG nodes, with a partial last block
+    std::minstd_rand rng(1);
+    std::uniform_real_distribution<float> dist(-12, 12);
+    std::vector<Vector3> positions(1500);
+    for (size_t i = 0; i < positions.size(); ++i)
+        positions[i] = Vector3(dist(rng), dist(rng), dist(rng));
+
+    CSGSphereSource sphere(8, Vector3(1, 0, -1));
+    CSGPlaneSource plane(1, Vector3(0.3f, 1, 0).normalisedCopy());
+    CSGCubeSource cube(Vector3(-6, -4, -5), Vector3(5, 6, 4));
+    CSGIntersectionSource intersection(&sphere, &cube);
+    CSGUnionSource csgUnion(&sphere, &plane);
+    CSGDifferenceSource difference(&plane, &sphere);
+    CSGNegateSource negate(&intersection);
+    CSGScaleSource scale(&difference, 1.5f);
+    Real frequencies[] = {0.1f, 0.4f};
+    Real amplitudes[] = {2.0f, 0.5f};
+    CSGNoiseSource noise(&csgUnion, frequencies, amplitudes, 2, 42);
+
+    expectBatchEqualsSingle(sphere, positions);
+    expectBatchEqualsSingle(plane, positions);
+    expectBatchEqualsSingle(cube, positions);
+    expectBatchEqualsSingle(intersection, positions);
+    expectBatchEqualsSingle(csgUnion, positions);
+    expectBatchEqualsSingle(difference, positions);
+    expectBatchEqualsSingle(negate, positions);
+    expectBatchEqualsSingle(scale, positions);
+    expectBatchEqualsSingle(noise, positions);
+
+    // grids with all filter combinations
+    for (int filter = 0; filter < 8; ++filter)
+    {
+        BrickGridSource grid(&noise, Vector3(16), 32, 32, 32, 0, BrickGridSource::BF_HALF_FLOAT, true, 2048,
+                             (filter & 1) != 0, (filter & 2) != 0, (filter & 4) != 0);
+        std::vector<Vector3> gridPositions(positions);
+        for (size_t i = 0; i < gridPositions.size(); ++i)
+            gridPositions[i] = positions[i] * 0.6f + Vector3(8);
+        expectBatchEqualsSingle(grid, gridPositions);
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(VolumeTests, CacheSource)
+{
+    // Chunks and batches of dual cells are evaluated from the threads of the work queue.
+    mRoot->getWorkQueue()->startup();
+
+    CSGSphereSource sphere(20, Vector3(32));
+    CacheSource cache(&sphere);
+    std::vector<Vector3> positions;
+    for (int z = 0; z < 16; ++z)
+        for (int y = 0; y < 16; ++y)
+            for (int x = 0; x < 16; ++x)
+                positions.push_back(Vector3(x, y, z) * 4.1f);
+
+    // each position is looked up and stored by several threads at once
+    std::vector<Vector4> results(positions.size() * 4);
+    mRoot->getWorkQueue()->parallelFor(results.size(), [&](size_t i) {
+        results[i] = cache.getValueAndGradient(positions[i / 4]);
+    });
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        ASSERT_EQ(sphere.getValueAndGradient(positions[i / 4]), results[i]) << "at " << positions[i / 4];
+    }
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        ASSERT_EQ(sphere.getValueAndGradient(positions[i]).w, cache.getValue(positions[i]));
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(VolumeTests, IncrementalUpdate)
+{
+    // A synchronous chunk load waits for the work queue.
+    mRoot->getWorkQueue()->startup();
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+
+    CSGSphereSource sphere(20, Vector3(32));
+    CSGSphereSource nothing(1, Vector3(-1000));
+    CSGSphereSource bump(4, Vector3(32, 52, 32));
+    CSGUnionSource src(&sphere, &nothing);
+
+    const Vector3 from(0), to(64);
+    const size_t level = 3;
+
+    // The same tree, once updated incrementally and once rebuilt for comparison.
+    ChunkRecorder recorders[2];
+    Chunk* chunks[2];
+    SceneNode* nodes[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        ChunkParameters parameters;
+        parameters.sceneManager = sceneMgr;
+        parameters.src = &src;
+        parameters.baseError = 1.0;
+        parameters.errorMultiplicator = 0.9;
+        parameters.lodCallback = &recorders[i];
+        parameters.incrementalUpdates = i == 0;
+
+        nodes[i] = sceneMgr->getRootSceneNode()->createChildSceneNode();
+        chunks[i] = OGRE_NEW Chunk();
+        chunks[i]->load(nodes[i], from, to, level, &parameters);
+    }
+    size_t initiallyBuilt = recorders[0].built.size();
+    ASSERT_GT(initiallyBuilt, 0u);
+    EXPECT_EQ(recorders[1].built.size(), initiallyBuilt);
+    EXPECT_EQ(recorders[0].totalIndices(), recorders[1].totalIndices());
+
+    // Add the bump on top of the sphere and update its area only.
+    src.setSourceB(&bump);
+    for (int i = 0; i < 2; ++i)
+    {
+        recorders[i].built.clear();
+        ChunkParameters* parameters = chunks[i]->getChunkParameters();
+        parameters->updateFrom = Vector3(26, 46, 26);
+        parameters->updateTo = Vector3(38, 58, 38);
+        chunks[i]->load(nodes[i], from, to, level, parameters);
+    }
+
+    EXPECT_GT(recorders[0].built.size(), 0u);
+    EXPECT_LT(recorders[0].built.size(), initiallyBuilt);
+    EXPECT_EQ(recorders[0].built.size(), recorders[1].built.size());
+    EXPECT_EQ(recorders[0].totalIndices(), recorders[1].totalIndices());
+
+    for (int i = 0; i < 2; ++i)
+    {
+        OGRE_DELETE chunks[i];
+    }
+    mRoot->destroySceneManager(sceneMgr);
+}
+//--------------------------------------------------------------------------
+TEST_F(VolumeTests, BrickEncodingRoundTrip)
+{
+    const size_t voxels = BrickGridSource::BRICK_VOXELS;
+    CSGSphereSource sphere(4, Vector3(8));
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-10, 10);
+
+    // Runs longer than a single control byte can describe, runs mixed with
+    // literals, incompressible noise and a constant brick.
+    std::vector<float> runs(voxels), mixed(voxels), noise(voxels), constant(voxels, 2.5f);
+    for (size_t i = 0; i < voxels; ++i)
+    {
+        runs[i] = (float)(i / 300);
+        mixed[i] = i % 7 < 3 ? 1.5f : (float)(i % 13) - 6;
+        noise[i] = dist(rng);
+    }
+    const std::vector<float>* patterns[] = {&runs, &mixed, &noise, &constant};
+    const bool compressible[] = {true, true, false, false};
+
+    std::vector<float> decoded;
+    for (int compress = 0; compress < 2; ++compress)
+    {
+        BrickCodec halfCodec(&sphere, BrickGridSource::BF_HALF_FLOAT, compress != 0);
+        BrickCodec quantisedCodec(&sphere, BrickGridSource::BF_QUANTISED_8, compress != 0);
+        for (size_t p = 0; p < 4; ++p)
+        {
+            const std::vector<float>& values = *patterns[p];
+            EXPECT_EQ(compress && compressible[p], halfCodec.roundTrip(values, decoded)) << "pattern " << p;
+            for (size_t i = 0; i < voxels; ++i)
+            {
+                ASSERT_EQ(Bitwise::halfToFloat(Bitwise::floatToHalf(values[i])), decoded[i]) << "pattern " << p << " at " << i;
+            }
+
+            quantisedCodec.roundTrip(values, decoded);
+            float minValue = *std::min_element(values.begin(), values.end());
+            float maxValue = *std::max_element(values.begin(), values.end());
+            float tolerance = (maxValue - minValue) / 255.0f * 0.5f + 1e-4f;
+            for (size_t i = 0; i < voxels; ++i)
+            {
+                ASSERT_NEAR(values[i], decoded[i], tolerance) << "pattern " << p << " at " << i;
+            }
+        }
+    }
+}
+//--------------------------------------------------------------------------
+TEST_F(VolumeTests, BrickGridEqualsHalfFloatGrid)
+{
+    mRoot->getWorkQueue()->startup();
+
+    // Not a multiple of the brick size, so the border bricks are partial.
+    CSGSphereSource sphere(15, Vector3(20, 18, 21));
+    sphere.serialize(Vector3::ZERO, Vector3(40), 1, 4, "./brickGridSource.dat");
+
+    HalfFloatGridSource reference("./brickGridSource.dat", true, true, false);
+    // A tiny cache makes the threads evict and decode bricks all the time.
+    BrickGridSource bricks("./brickGridSource.dat", BrickGridSource::BF_HALF_FLOAT, true, 2, true, true, false);
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<Real> dist(0, 39);
+    std::vector<Vector3> positions;
+    for (int x = 0; x < 40; x += 3)
+        for (int y = 0; y < 40; y += 3)
+            for (int z = 0; z < 40; z += 3)
+                positions.push_back(Vector3((Real)x, (Real)y, (Real)z));
+    for (int i = 0; i < 2000; ++i)
+        positions.push_back(Vector3(dist(rng), dist(rng), dist(rng)));
+
+    std::vector<Vector4> sampled(positions.size());
+    mRoot->getWorkQueue()->parallelFor(positions.size(), [&](size_t i) {
+        sampled[i] = bricks.getValueAndGradient(positions[i]);
+    });
+
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        Vector4 expected = reference.getValueAndGradient(positions[i]);
+        ASSERT_EQ(expected, sampled[i]) << "at " << positions[i];
+        ASSERT_EQ(expected, bricks.getValueAndGradient(positions[i])) << "at " << positions[i];
+    }
+    EXPECT_LT(bricks.getConstantBrickCount(), bricks.getBrickCount());
+}
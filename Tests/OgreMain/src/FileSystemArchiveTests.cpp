@@ -263,6 +263,29 @@ TEST_F(FileSystemArchiveTests,FileRead)
     EXPECT_TRUE(stream->eof());
 }
 //--------------------------------------------------------------------------
+TEST_F(FileSystemArchiveTests,FileReadMapped)
+{
+    FileSystemArchiveFactory::setMemoryMapping(true);
+    DataStreamPtr stream = mArch->open("rootfile.txt");
+    DataStreamPtr writeable = mArch->open("rootfile.txt", false);
+    FileSystemArchiveFactory::setMemoryMapping(false);
+
+    EXPECT_TRUE(dynamic_cast<MemoryDataStream*>(stream.get()));
+    EXPECT_FALSE(stream->isWriteable());
+    EXPECT_EQ((size_t)mFileSizeRoot1, stream->size());
+    EXPECT_EQ(String("this is line 1 in file 1"), stream->getLine());
+    EXPECT_EQ(String("this is line 2 in file 1"), stream->getLine());
+    EXPECT_EQ(String("this is line 3 in file 1"), stream->getLine());
+    EXPECT_EQ(String("this is line 4 in file 1"), stream->getLine());
+    EXPECT_EQ(String("this is line 5 in file 1"), stream->getLine());
+    EXPECT_EQ(BLANKSTRING, stream->getLine()); // blank at end of file
+    EXPECT_TRUE(stream->eof());
+    stream->close();
+
+    // files opened for writing are never mapped
+    EXPECT_FALSE(dynamic_cast<MemoryDataStream*>(writeable.get()));
+}
+//--------------------------------------------------------------------------
 TEST_F(FileSystemArchiveTests,ReadInterleave)
 {
     // Test overlapping reads from same archive
@@ -30,6 +30,8 @@ THE SOFTWARE.
 #include "OgreRoot.h"
 #include "OgreSceneNode.h"
 #include "OgreEntity.h"
+#include "OgreSubEntity.h"
+#include "OgreSubMesh.h"
 #include "OgreCamera.h"
 #include "RootWithoutRenderSystemFixture.h"
 #include "OgreStaticPluginLoader.h"
@@ -43,9 +45,18 @@ THE SOFTWARE.
 #include "OgreHighLevelGpuProgramManager.h"
 #include "OgreMeshManager.h"
 #include "OgreMesh.h"
+#include "OgreMeshSerializer.h"
+#include "OgrePose.h"
+#include "OgreEdgeListBuilder.h"
 #include "OgreSkeletonManager.h"
 #include "OgreCompositorManager.h"
 #include "OgreTextureManager.h"
+#include "OgreScriptCompiler.h"
+#include "OgreGpuProgramManager.h"
+#include "OgreFileSystemLayer.h"
+#include "OgreStaticGeometry.h"
+#include "OgreTimer.h"
+#include "OgreLogManager.h"
 
 #include <random>
 using std::minstd_rand;
@@ -288,4 +299,426 @@ TEST_F(TextureTests, Blank)
     EXPECT_EQ(tus->getIsAlpha(), false);
     EXPECT_EQ(tus->getGamma(), 1.0f);
     EXPECT_EQ(tus->isHardwareGammaEnabled(), false);
-}
\ No newline at end of file
+}
+
+typedef RootWithoutRenderSystemFixture StaticGeometryTests;
+TEST_F(StaticGeometryTests, InstancedGeometryBucket)
+{
+    MeshPtr mesh = MeshManager::getSingleton().createPlane("StaticPlane", RGN_DEFAULT, Plane(Vector3::UNIT_Z, 0),
+                                                           10, 10, 2, 2);
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    Entity* ent = sceneMgr->createEntity(mesh);
+
+    StaticGeometry* geom = sceneMgr->createStaticGeometry("Static");
+    geom->addEntity(ent, Vector3(100, 0, 100));
+    geom->build();
+    StaticGeometry::RegionIterator regions = geom->getRegionIterator();
+    ASSERT_TRUE(regions.hasMoreElements());
+    StaticGeometry::Region* region = regions.getNext();
+
+    // referencing a range of a shared vertex buffer
+    SubMesh* sm = mesh->getSubMesh(0);
+    VertexData* vertexData = mesh->sharedVertexData->clone(false);
+    vertexData->vertexStart = 3;
+    vertexData->vertexCount = 6;
+    StaticGeometry::SubMeshLodGeometryLink link = {vertexData, sm->indexData};
+
+    // there is no RenderSystem, so build the bucket by hand
+    EXPECT_FALSE(StaticGeometry::InstancedGeometryBucket::isSupported(&link));
+    StaticGeometry::LODBucket lod(region, 0, 0);
+    StaticGeometry::MaterialBucket mat(&lod, "BaseWhite");
+    StaticGeometry::InstancedGeometryBucket bucket(&mat, "", vertexData, sm->indexData);
+
+    StaticGeometry::QueuedGeometry instances[2];
+    instances[0].geometry = &link;
+    instances[0].position = Vector3(120, 5, 80);
+    instances[0].orientation = Quaternion::IDENTITY;
+    instances[0].scale = Vector3::UNIT_SCALE;
+    instances[1].geometry = &link;
+    instances[1].position = Vector3(-300, 0, 40);
+    instances[1].orientation = Quaternion(Degree(90), Vector3::UNIT_Y);
+    instances[1].scale = Vector3(2);
+    EXPECT_TRUE(bucket.assign(&instances[0]));
+    EXPECT_TRUE(bucket.assign(&instances[1]));
+    bucket.build(false);
+
+    RenderOperation op;
+    bucket.getRenderOperation(op);
+    EXPECT_EQ(op.numberOfInstances, 2u);
+    EXPECT_EQ(op.vertexData->vertexStart, 3u);
+    EXPECT_EQ(op.vertexData->vertexCount, 6u);
+
+    Matrix4 world;
+    bucket.getWorldTransforms(&world);
+    EXPECT_EQ(world.getTrans(), region->getCentre());
+
+    // instance matrices are relative to the region, so both combine to the queued transform
+    HardwareVertexBufferSharedPtr vbuf =
+        op.vertexData->vertexBufferBinding->getBuffer(op.vertexData->vertexDeclaration->getMaxSource());
+    EXPECT_TRUE(vbuf->isInstanceData());
+    ASSERT_EQ(vbuf->getNumVertices(), 2u);
+    HardwareBufferLockGuard lock(vbuf, HardwareBuffer::HBL_READ_ONLY);
+    const float* pData = static_cast<const float*>(lock.pData);
+    for (int i = 0; i < 2; i++)
+    {
+        Affine3 xform(pData[0], pData[1], pData[2], pData[3],
+                      pData[4], pData[5], pData[6], pData[7],
+                      pData[8], pData[9], pData[10], pData[11]);
+        pData += 12;
+        Affine3 expected(instances[i].position, instances[i].orientation, instances[i].scale);
+        Vector3 p = Affine3(world) * xform * Vector3(1, 2, 3);
+        EXPECT_TRUE(p.positionEquals(expected * Vector3(1, 2, 3), 1e-3f)) << p;
+    }
+    lock.unlock();
+
+    OGRE_DELETE vertexData;
+}
+
+typedef RootWithoutRenderSystemFixture MeshletTests;
+TEST_F(MeshletTests, FrustumCulling)
+{
+    MeshPtr mesh = MeshManager::getSingleton().createPlane("Meshlets", RGN_DEFAULT, Plane(Vector3::UNIT_Z, 0),
+                                                           1000, 1000, 64, 64);
+    SubMesh* sm = mesh->getSubMesh(0);
+    size_t indexCount = sm->indexData->indexCount;
+    sm->generateMeshlets(64);
+    EXPECT_GE(sm->meshlets.size(), indexCount / (64 * 3));
+
+    SceneManager* sceneMgr = mRoot->createSceneManager();
+    Entity* ent = sceneMgr->createEntity(mesh);
+    sceneMgr->getRootSceneNode()->attachObject(ent);
+
+    // look at a corner of the plane, so most meshlets are outside of the frustum
+    Camera* cam = sceneMgr->createCamera("Camera");
+    SceneNode* camNode = sceneMgr->getRootSceneNode()->createChildSceneNode(Vector3(450, 450, 150));
+    camNode->attachObject(cam);
+    sceneMgr->_updateSceneGraph(cam);
+
+    RenderOperation op;
+    ent->_notifyCurrentCamera(cam);
+    ent->getSubEntity(0)->getRenderOperation(op);
+    EXPECT_GT(op.indexData->indexCount, 0u);
+    EXPECT_LT(op.indexData->indexCount, indexCount / 4);
+
+    ent->setMeshletCullingEnabled(false);
+    ent->_notifyCurrentCamera(cam);
+    ent->getSubEntity(0)->getRenderOperation(op);
+    EXPECT_EQ(op.indexData->indexCount, indexCount);
+}
+
+typedef RootWithoutRenderSystemFixture MeshSerializerParallel;
+static int ownerOf(const MeshPtr& mesh, const VertexData* vertexData)
+{
+    for (ushort i = 0; i < mesh->getNumSubMeshes(); i++)
+    {
+        if (!mesh->getSubMesh(i)->useSharedVertices && mesh->getSubMesh(i)->vertexData == vertexData)
+            return i;
+    }
+    return mesh->sharedVertexData == vertexData ? -1 : -2;
+}
+TEST_F(MeshSerializerParallel, PosesAndEdgeLists)
+{
+    // Mesh::load reads from memory, which decodes poses and edge lists in parallel
+    MeshPtr mesh = MeshManager::getSingleton().load("facial.mesh", RGN_DEFAULT);
+
+    // a file stream is read sequentially
+    MeshPtr ref = MeshManager::getSingleton().createManual("facial_sequential.mesh", RGN_DEFAULT);
+    DataStreamPtr stream = ResourceGroupManager::getSingleton().openResource("facial.mesh", RGN_DEFAULT);
+    MeshSerializer().importMesh(stream, ref.get());
+
+    ASSERT_GT(mesh->getPoseCount(), 1u);
+    ASSERT_EQ(ref->getPoseCount(), mesh->getPoseCount());
+    for (ushort i = 0; i < mesh->getPoseCount(); i++)
+    {
+        EXPECT_EQ(ref->getPose(i)->getName(), mesh->getPose(i)->getName());
+        EXPECT_EQ(ref->getPose(i)->getTarget(), mesh->getPose(i)->getTarget());
+        EXPECT_EQ(ref->getPose(i)->getVertexOffsets(), mesh->getPose(i)->getVertexOffsets());
+        EXPECT_EQ(ref->getPose(i)->getNormals(), mesh->getPose(i)->getNormals());
+    }
+
+    EdgeData* a = ref->getEdgeList();
+    EdgeData* b = mesh->getEdgeList();
+    ASSERT_TRUE(a && b);
+    ASSERT_EQ(a->triangles.size(), b->triangles.size());
+    ASSERT_EQ(a->edgeGroups.size(), b->edgeGroups.size());
+    for (size_t i = 0; i < a->triangles.size(); i++)
+    {
+        EXPECT_EQ(a->triangles[i].vertIndex[0], b->triangles[i].vertIndex[0]);
+        EXPECT_EQ(a->triangles[i].sharedVertIndex[2], b->triangles[i].sharedVertIndex[2]);
+        EXPECT_EQ(a->triangleFaceNormals[i], b->triangleFaceNormals[i]);
+    }
+    for (size_t i = 0; i < a->edgeGroups.size(); i++)
+    {
+        EXPECT_EQ(a->edgeGroups[i].edges.size(), b->edgeGroups[i].edges.size());
+        EXPECT_EQ(a->edgeGroups[i].vertexSet, b->edgeGroups[i].vertexSet);
+        EXPECT_EQ(ownerOf(ref, a->edgeGroups[i].vertexData),
+                  ownerOf(mesh, b->edgeGroups[i].vertexData));
+    }
+}
+
+typedef RootWithoutRenderSystemFixture MeshQuantisation;
+TEST_F(MeshQuantisation, NormalsAndTexCoords)
+{
+    float n[3] = {0.5f, -0.25f, 1.0f};
+    uint32 packed;
+    float decoded[4];
+    VertexElement::convertValue(VET_FLOAT3, n, VET_INT_10_10_10_2_NORM, &packed);
+    VertexElement::convertValue(VET_INT_10_10_10_2_NORM, &packed, VET_FLOAT4, decoded);
+    EXPECT_NEAR(decoded[0], n[0], 1.0f / 511);
+    EXPECT_NEAR(decoded[1], n[1], 1.0f / 511);
+    EXPECT_NEAR(decoded[2], n[2], 1.0f / 511);
+    EXPECT_EQ(decoded[3], 1.0f);
+
+    Plane plane(Vector3(1, 2, 3).normalisedCopy(), 0);
+    MeshPtr ref = MeshManager::getSingleton().createPlane("QuantisedRef", RGN_DEFAULT, plane, 10, 10, 4, 4,
+                                                          true, 1, 2, 3);
+    MeshPtr mesh = MeshManager::getSingleton().createPlane("Quantised", RGN_DEFAULT, plane, 10, 10, 4, 4,
+                                                           true, 1, 2, 3);
+    mesh->quantiseVertexData();
+
+    VertexData* vertexData = mesh->sharedVertexData;
+    VertexDeclaration* decl = vertexData->vertexDeclaration;
+    const VertexElement* normal = decl->findElementBySemantic(VES_NORMAL);
+    const VertexElement* uv = decl->findElementBySemantic(VES_TEXTURE_COORDINATES);
+    ASSERT_TRUE(normal && uv);
+    EXPECT_EQ(normal->getType(), VET_INT_10_10_10_2_NORM);
+    EXPECT_EQ(uv->getType(), VET_HALF2); // tiled, so outside of 0..1
+    EXPECT_EQ(decl->findElementBySemantic(VES_POSITION)->getType(), VET_FLOAT3);
+    EXPECT_LT(decl->getVertexSize(0), ref->sharedVertexData->vertexDeclaration->getVertexSize(0));
+
+    VertexData* refData = ref->sharedVertexData;
+    const VertexElement* refNormal = refData->vertexDeclaration->findElementBySemantic(VES_NORMAL);
+    const VertexElement* refUV = refData->vertexDeclaration->findElementBySemantic(VES_TEXTURE_COORDINATES);
+    HardwareVertexBufferSharedPtr buf = vertexData->vertexBufferBinding->getBuffer(0);
+    HardwareVertexBufferSharedPtr refBuf = refData->vertexBufferBinding->getBuffer(0);
+    ASSERT_EQ(vertexData->vertexCount, refData->vertexCount);
+    {
+        HardwareBufferLockGuard lock(buf, HardwareBuffer::HBL_READ_ONLY);
+        HardwareBufferLockGuard refLock(refBuf, HardwareBuffer::HBL_READ_ONLY);
+        for (size_t i = 0; i < vertexData->vertexCount; i++)
+        {
+            uchar* v = static_cast<uchar*>(lock.pData) + i * buf->getVertexSize();
+            uchar* r = static_cast<uchar*>(refLock.pData) + i * refBuf->getVertexSize();
+            float a[3], b[3];
+            VertexElement::convertValue(normal->getType(), v + normal->getOffset(), VET_FLOAT3, a);
+            VertexElement::convertValue(VET_FLOAT3, r + refNormal->getOffset(), VET_FLOAT3, b);
+            EXPECT_LT(Vector3(a).distance(Vector3(b)), 0.005f);
+            VertexElement::convertValue(uv->getType(), v + uv->getOffset(), VET_FLOAT2, a);
+            VertexElement::convertValue(VET_FLOAT2, r + refUV->getOffset(), VET_FLOAT2, b);
+            EXPECT_NEAR(a[0], b[0], 0.002f);
+            EXPECT_NEAR(a[1], b[1], 0.002f);
+        }
+    }
+
+    // consumers decode the packed data
+    mesh->buildEdgeList();
+    ASSERT_TRUE(mesh->getEdgeList());
+    EXPECT_EQ(mesh->getEdgeList()->triangles.size(), 32u);
+
+    unsigned short src, dst;
+    mesh->suggestTangentVectorBuildParams(VES_TANGENT, src, dst);
+    mesh->buildTangentVectors(VES_TANGENT, src, dst);
+    EXPECT_TRUE(decl->findElementBySemantic(VES_TANGENT));
+}
+
+TEST(ScriptCompilerManager, ScriptCache)
+{
+    Root root;
+    DefaultTextureManager texMgr;
+    ScriptCompilerManager& mgr = ScriptCompilerManager::getSingleton();
+
+    String str = "material CachedMaterial\n"
+                 "{\n"
+                 "    technique { pass { ambient 0 1 0 \n texture_unit Named { texture tex.png } } }\n"
+                 "}\n";
+
+    mgr.setScriptCaching(true);
+    DataStreamPtr stream = std::make_shared<MemoryDataStream>("cached.material", &str[0], str.size());
+    mgr.parseScript(stream, RGN_DEFAULT);
+    EXPECT_TRUE(mgr.isScriptCacheDirty());
+
+    DataStreamPtr cache(OGRE_NEW MemoryDataStream(size_t(4096), true, false));
+    mgr.saveScriptCache(cache);
+
+    mgr.setScriptCaching(false);
+    MaterialManager::getSingleton().remove("CachedMaterial", RGN_DEFAULT);
+    cache->seek(0);
+    mgr.loadScriptCache(cache);
+    EXPECT_FALSE(mgr.isScriptCacheDirty());
+
+    // restored from the cache, with the name of the new source
+    ConcreteNodeListPtr nodes = mgr._parse(str, "other.material");
+    EXPECT_FALSE(mgr.isScriptCacheDirty());
+    ASSERT_EQ(1u, nodes->size());
+    EXPECT_EQ("material", nodes->front()->token);
+    EXPECT_EQ("other.material", nodes->front()->children.front()->file);
+    EXPECT_EQ(nodes->front().get(), nodes->front()->children.front()->parent);
+
+    stream = std::make_shared<MemoryDataStream>("cached.material", &str[0], str.size());
+    mgr.parseScript(stream, RGN_DEFAULT);
+    EXPECT_FALSE(mgr.isScriptCacheDirty());
+
+    auto mat = MaterialManager::getSingleton().getByName("CachedMaterial", RGN_DEFAULT);
+    ASSERT_TRUE(mat);
+    Pass* pass = mat->getTechniques()[0]->getPasses()[0];
+    EXPECT_EQ(ColourValue::Green, pass->getAmbient());
+    EXPECT_EQ("tex.png", pass->getTextureUnitState("Named")->getTextureName());
+
+    // changed content misses the cache and is parsed again
+    str = StringUtil::replaceAll(str, "ambient 0 1 0", "ambient 1 0 0");
+    MaterialManager::getSingleton().remove("CachedMaterial", RGN_DEFAULT);
+    stream = std::make_shared<MemoryDataStream>("cached.material", &str[0], str.size());
+    mgr.parseScript(stream, RGN_DEFAULT);
+    EXPECT_TRUE(mgr.isScriptCacheDirty());
+
+    mat = MaterialManager::getSingleton().getByName("CachedMaterial", RGN_DEFAULT);
+    ASSERT_TRUE(mat);
+    EXPECT_EQ(ColourValue::Red, mat->getTechniques()[0]->getPasses()[0]->getAmbient());
+
+    // entries not used since loading are dropped when saving
+    String oldStr = StringUtil::replaceAll(str, "ambient 1 0 0", "ambient 0 1 0");
+    for (int i = 0; i < 2; i++)
+    {
+        cache->seek(0);
+        mgr.saveScriptCache(cache);
+        cache->seek(0);
+        mgr.loadScriptCache(cache);
+        mgr._parse(str, "cached.material");
+        EXPECT_FALSE(mgr.isScriptCacheDirty());
+    }
+    mgr._parse(oldStr, "cached.material");
+    EXPECT_TRUE(mgr.isScriptCacheDirty());
+}
+
+TEST(ScriptCompilerManager, ScriptCacheBenchmark)
+{
+    Root root("");
+    ScriptCompilerManager& mgr = ScriptCompilerManager::getSingleton();
+
+    String str;
+    for (int i = 0; i < 2000; i++)
+    {
+        str += "material Bench" + StringConverter::toString(i) + " : BaseMaterial\n"
+               "{\n"
+               "    technique\n    {\n        pass\n        {\n"
+               "            ambient 0.1 0.2 0.3 1\n            diffuse 1 1 1 1\n"
+               "            texture_unit { texture bench" + StringConverter::toString(i % 16) + ".png\n"
+               "                tex_address_mode clamp\n filtering trilinear }\n"
+               "        }\n    }\n}\n";
+    }
+
+    Timer timer;
+    unsigned long start = timer.getMicroseconds();
+    ConcreteNodeListPtr parsed = mgr._parse(str, "bench.material");
+    unsigned long parseTime = timer.getMicroseconds() - start;
+
+    mgr.setScriptCaching(true);
+    mgr._parse(str, "bench.material");
+    DataStreamPtr cache(OGRE_NEW MemoryDataStream(size_t(16 << 20), true, false));
+    mgr.saveScriptCache(cache);
+    size_t cacheSize = cache->tell();
+    cache->seek(0);
+    mgr.loadScriptCache(cache);
+
+    start = timer.getMicroseconds();
+    ConcreteNodeListPtr cached = mgr._parse(str, "bench.material");
+    unsigned long cachedTime = timer.getMicroseconds() - start;
+    EXPECT_FALSE(mgr.isScriptCacheDirty());
+
+    LogManager::getSingleton().stream() << "ScriptCacheBenchmark: " << str.size() << " bytes of script, parsed in "
+        << parseTime << "us, restored from a " << cacheSize << " byte cache in " << cachedTime << "us";
+
+    ASSERT_EQ(parsed->size(), cached->size());
+    EXPECT_EQ(parsed->back()->children.size(), cached->back()->children.size());
+}
+
+TEST(GpuProgramManager, MicrocodeCacheLocation)
+{
+    const String location = "MicrocodeCacheTest";
+    // no render system, so the driver part of the names is zero
+    const String file1 = location + "/0000000000000001.bin";
+    const String file2 = location + "/0000000000000002.bin";
+    const String file3 = location + "/0000000000000003.bin";
+
+    {
+        Root root("");
+        GpuProgramManager mgr;
+        mgr.setMicrocodeCacheLocation(location);
+        GpuProgramManager::Microcode microcode = mgr.createMicrocode(64);
+        memset(microcode->getPtr(), 42, 64);
+        mgr.addMicrocodeToCache(1, microcode);
+        mgr.addMicrocodeToCache(2, microcode);
+    }
+    EXPECT_TRUE(FileSystemLayer::fileExists(file1));
+
+    // truncate one of the files
+    std::ofstream(file2.c_str(), std::ios::binary) << "OGPF";
+
+    {
+        Root root("");
+        GpuProgramManager mgr;
+        mgr.setMicrocodeCacheLocation(location);
+
+        ASSERT_TRUE(mgr.isMicrocodeAvailableInCache(1));
+        const GpuProgramManager::Microcode& microcode = mgr.getMicrocodeFromCache(1);
+        ASSERT_EQ(64u, microcode->size());
+        EXPECT_EQ(42, microcode->getPtr()[63]);
+
+        // invalid files are removed
+        EXPECT_FALSE(mgr.isMicrocodeAvailableInCache(2));
+        EXPECT_FALSE(FileSystemLayer::fileExists(file2));
+
+        // files are accounted with their size on disk, whether found at startup or written
+        size_t fileSize = size_t(std::ifstream(file1.c_str(), std::ios::binary | std::ios::ate).tellg());
+        mgr.setMicrocodeCacheMaxSize(2 * fileSize);
+        mgr.addMicrocodeToCache(3, microcode);
+        EXPECT_TRUE(FileSystemLayer::fileExists(file1));
+        EXPECT_TRUE(FileSystemLayer::fileExists(file3));
+
+        // the least recently used files are removed once the limit is exceeded
+        mgr.setMicrocodeCacheMaxSize(2 * fileSize - 1);
+        EXPECT_FALSE(FileSystemLayer::fileExists(file1));
+        EXPECT_TRUE(FileSystemLayer::fileExists(file3));
+    }
+
+    FileSystemLayer::removeFile(file3);
+    FileSystemLayer::removeDirectory(location);
+}
+
+TEST_F(MeshQuantisation, FlippedEndianRoundTrip)
+{
+#if OGRE_ENDIAN == OGRE_ENDIAN_BIG
+    const MeshSerializer::Endian flipped = MeshSerializer::ENDIAN_LITTLE;
+#else
+    const MeshSerializer::Endian flipped = MeshSerializer::ENDIAN_BIG;
+#endif
+    Plane plane(Vector3(1, 2, 3).normalisedCopy(), 0);
+    const VertexElementType normalTypes[] = {VET_INT_10_10_10_2_NORM, VET_SHORT4_NORM};
+    for (int t = 0; t < 2; t++)
+    {
+        String name = "QuantisedEndian" + StringConverter::toString(t);
+        MeshPtr mesh = MeshManager::getSingleton().createPlane(name, RGN_DEFAULT, plane, 10, 10, 4, 4,
+                                                               true, 1, 2, 3);
+        mesh->quantiseVertexData(normalTypes[t], VET_HALF2);
+
+        DataStreamPtr stream(OGRE_NEW MemoryDataStream(size_t(65536), true, false));
+        MeshSerializer().exportMesh(mesh.get(), stream, flipped);
+        stream->seek(0);
+        MeshPtr loaded = MeshManager::getSingleton().createManual(name + "Loaded", RGN_DEFAULT);
+        MeshSerializer().importMesh(stream, loaded.get());
+
+        // the packed elements have to be swapped as a whole, the halfs one by one
+        VertexData* vertexData = mesh->sharedVertexData;
+        VertexData* loadedData = loaded->sharedVertexData;
+        ASSERT_TRUE(loadedData);
+        ASSERT_EQ(vertexData->vertexCount, loadedData->vertexCount);
+        EXPECT_EQ(normalTypes[t], loadedData->vertexDeclaration->findElementBySemantic(VES_NORMAL)->getType());
+        EXPECT_EQ(VET_HALF2, loadedData->vertexDeclaration->findElementBySemantic(VES_TEXTURE_COORDINATES)->getType());
+        HardwareVertexBufferSharedPtr buf = vertexData->vertexBufferBinding->getBuffer(0);
+        HardwareVertexBufferSharedPtr loadedBuf = loadedData->vertexBufferBinding->getBuffer(0);
+        ASSERT_EQ(buf->getSizeInBytes(), loadedBuf->getSizeInBytes());
+        HardwareBufferLockGuard lock(buf, HardwareBuffer::HBL_READ_ONLY);
+        HardwareBufferLockGuard loadedLock(loadedBuf, HardwareBuffer::HBL_READ_ONLY);
+        EXPECT_EQ(0, memcmp(lock.pData, loadedLock.pData, buf->getSizeInBytes()));
+    }
+}
@@ -64,6 +64,8 @@ THE SOFTWARE.
 #include "OgreLodConfig.h"
 #endif
 
+#include <fstream>
+
 // Register the test suite
 
 //--------------------------------------------------------------------------
@@ -197,9 +199,89 @@ TEST_F(MeshSerializerTests,Skeleton_Version_1_0)
     }
 }
 //--------------------------------------------------------------------------
-TEST_F(MeshSerializerTests,Mesh_Version_1_10)
+TEST_F(MeshSerializerTests,Mesh_Version_1_12)
 {
     testMesh(MESH_VERSION_LATEST);
+
+    // aligned data read through a file stream instead of from memory
+    MeshPtr mesh = MeshManager::getSingleton().createManual(mMesh->getName() + ".streamed.mesh", mMesh->getGroup());
+    std::ifstream file(mMeshFullPath.c_str(), std::ios::in | std::ios::binary);
+    DataStreamPtr stream(OGRE_NEW FileStreamDataStream(&file, false));
+    MeshSerializer().importMesh(stream, mesh.get());
+    assertMeshClone(mOrigMesh.get(), mesh.get());
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_Version_1_11)
+{
+    testMesh(MESH_VERSION_1_11);
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_Version_1_10)
+{
+    testMesh(MESH_VERSION_1_10);
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_Meshlets)
+{
+    for (size_t i = 0; i < mOrigMesh->getNumSubMeshes(); i++) {
+        SubMesh* sm = mOrigMesh->getSubMesh(i);
+        if (sm->operationType == RenderOperation::OT_TRIANGLE_LIST && sm->indexData->indexCount)
+            sm->generateMeshlets(64);
+    }
+
+    MeshSerializer serializer;
+    serializer.exportMesh(mOrigMesh.get(), mMeshFullPath);
+    mMesh->reload();
+
+    for (size_t i = 0; i < mOrigMesh->getNumSubMeshes(); i++) {
+        const SubMesh::MeshletList& a = mOrigMesh->getSubMesh(i)->meshlets;
+        const SubMesh::MeshletList& b = mMesh->getSubMesh(i)->meshlets;
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t n = 0; n < a.size(); n++) {
+            EXPECT_EQ(a[n].indexStart, b[n].indexStart);
+            EXPECT_EQ(a[n].indexCount, b[n].indexCount);
+            EXPECT_LE(a[n].indexCount, 64u * 3);
+            EXPECT_TRUE(a[n].center.positionEquals(b[n].center));
+            EXPECT_FLOAT_EQ(a[n].radius, b[n].radius);
+            EXPECT_TRUE(a[n].coneAxis.positionEquals(b[n].coneAxis));
+            EXPECT_FLOAT_EQ(a[n].coneCutoff, b[n].coneCutoff);
+        }
+    }
+
+    // v1.100 has no meshlet chunk
+    serializer.exportMesh(mOrigMesh.get(), mMeshFullPath, MESH_VERSION_1_10);
+    mMesh->reload();
+    for (size_t i = 0; i < mMesh->getNumSubMeshes(); i++)
+        EXPECT_TRUE(mMesh->getSubMesh(i)->meshlets.empty());
+}
+//--------------------------------------------------------------------------
+TEST_F(MeshSerializerTests,Mesh_Meshlets_InvalidSubMesh)
+{
+    SubMesh* sm = mOrigMesh->getSubMesh(0);
+    ASSERT_EQ(sm->operationType, RenderOperation::OT_TRIANGLE_LIST);
+    sm->generateMeshlets(64);
+
+    MeshSerializer serializer;
+    serializer.exportMesh(mOrigMesh.get(), mMeshFullPath);
+
+    std::ifstream file(mMeshFullPath.c_str(), std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    // find the meshlet chunk of submesh 0 and point it at a submesh that does not exist
+    uint16 chunkId = 0xE100;
+    uint32 chunkSize = 6 + 2 + 4 + uint32(sm->meshlets.size()) * 40;
+    char header[6];
+    memcpy(header, &chunkId, 2);
+    memcpy(header + 2, &chunkSize, 4);
+    auto chunk = std::search(data.begin(), data.end(), header, header + 6);
+    ASSERT_TRUE(chunk != data.end());
+    uint16 invalidIndex = mOrigMesh->getNumSubMeshes();
+    memcpy(&*chunk + 6, &invalidIndex, 2);
+
+    DataStreamPtr stream(OGRE_NEW MemoryDataStream(&data[0], data.size()));
+    MeshPtr mesh = MeshManager::getSingleton().createManual("Meshlets_InvalidSubMesh", RGN_DEFAULT);
+    EXPECT_THROW(serializer.importMesh(stream, mesh.get()), InvalidParametersException);
+    MeshManager::getSingleton().remove(mesh);
 }
 //--------------------------------------------------------------------------
 TEST_F(MeshSerializerTests,Mesh_Version_1_8)
@@ -248,6 +330,8 @@ TEST_F(MeshSerializerTests,Mesh_Version_1_2)
             }
             mOrigMesh = mMesh->clone(mMesh->getName() + ".orig.mesh", mMesh->getGroup());
             testMesh_XML();
+            testMesh(MESH_VERSION_1_12);
+            testMesh(MESH_VERSION_1_11);
             testMesh(MESH_VERSION_1_10);
             testMesh(MESH_VERSION_1_8);
             testMesh(MESH_VERSION_1_7);
@@ -0,0 +1,180 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+(Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+#include <gtest/gtest.h>
+#include "OgrePack.h"
+#include "OgreFileSystem.h"
+#include "OgreConfigFile.h"
+#include "OgreFileSystemLayer.h"
+#include "OgreStringConverter.h"
+#include "OgreException.h"
+
+using namespace Ogre;
+
+struct PackArchiveTests : public ::testing::Test
+{
+    String mSourcePath;
+    String mPackPath;
+
+    void SetUp()
+    {
+        ConfigFile cf;
+        cf.load(FileSystemLayer(OGRE_VERSION_NAME).getConfigFilePath("resources.cfg"));
+        mSourcePath = cf.getSettings("Tests").begin()->second + "/misc/ArchiveTest";
+        mPackPath = "PackArchiveTests.pack";
+    }
+
+    void TearDown() { ::remove(mPackPath.c_str()); }
+};
+
+TEST_F(PackArchiveTests, RoundTrip)
+{
+    Archive* source = FileSystemArchiveFactory().createInstance(mSourcePath, true);
+    source->load();
+
+    PackArchiveWriter writer;
+    writer.setAlignment(64);
+    writer.addArchive(source);
+    writer.write(mPackPath);
+
+    Archive* pack = PackArchiveFactory().createInstance(mPackPath, true);
+    pack->load();
+
+    StringVectorPtr files = source->list(true);
+    EXPECT_EQ(files->size(), pack->list(true)->size());
+    EXPECT_EQ(size_t(2), pack->list(false)->size());
+    EXPECT_EQ(size_t(4), pack->find("*.material")->size());
+    EXPECT_EQ(size_t(2), pack->find("level1/materials/scripts/*")->size());
+#if OGRE_RESOURCEMANAGER_STRICT
+    EXPECT_FALSE(pack->exists("file.material"));
+#endif
+
+    for (size_t i = 0; i < files->size(); i++)
+    {
+        const String& name = files->at(i);
+        ASSERT_TRUE(pack->exists(name)) << name;
+
+        DataStreamPtr stream = pack->open(name);
+        EXPECT_EQ(source->open(name)->getAsString(), stream->getAsString());
+
+        // stored files point into the mapping, at the requested alignment
+        uchar* ptr = static_cast<MemoryDataStream*>(stream.get())->getPtr();
+        EXPECT_EQ(size_t(0), size_t(ptr) % 64) << name;
+    }
+
+    OGRE_DELETE pack;
+    OGRE_DELETE source;
+}
+
+TEST_F(PackArchiveTests, CompressedBlocksAndDeduplication)
+{
+    String text;
+    for (int i = 0; i < 1000; i++)
+        text += "material Test" + StringConverter::toString(i % 7) + " {}\n";
+
+    size_t packSize[2];
+    for (int dedup = 0; dedup < 2; dedup++)
+    {
+        PackArchiveWriter writer;
+#if OGRE_NO_ZIP_ARCHIVE == 0
+        writer.setCodec(PackArchiveWriter::CODEC_DEFLATE);
+#endif
+        writer.setBlockSize(1024);
+        writer.setDeduplicate(dedup != 0);
+        writer.addFile("a.material", DataStreamPtr(OGRE_NEW MemoryDataStream((void*)text.data(), text.size())));
+        writer.addFile("sub/b.material", DataStreamPtr(OGRE_NEW MemoryDataStream((void*)text.data(), text.size())));
+        writer.addFile("empty.txt", DataStreamPtr(OGRE_NEW MemoryDataStream((void*)text.data(), 0)));
+        packSize[dedup] = writer.write(mPackPath);
+
+        Archive* pack = PackArchiveFactory().createInstance(mPackPath, true);
+        pack->load();
+
+        FileInfoListPtr infos = pack->listFileInfo();
+        ASSERT_EQ(size_t(3), infos->size());
+        for (size_t i = 0; i < infos->size(); i++)
+        {
+            const FileInfo& info = infos->at(i);
+            EXPECT_EQ(info.filename == "empty.txt" ? 0 : text.size(), info.uncompressedSize);
+#if OGRE_NO_ZIP_ARCHIVE == 0
+            if (info.uncompressedSize)
+                EXPECT_LT(info.compressedSize, info.uncompressedSize);
+#endif
+        }
+
+        EXPECT_EQ(text, pack->open("a.material")->getAsString());
+        EXPECT_EQ(text, pack->open("sub/b.material")->getAsString());
+        EXPECT_EQ(size_t(0), pack->open("empty.txt")->size());
+#if OGRE_RESOURCEMANAGER_STRICT
+        EXPECT_THROW(pack->open("b.material"), FileNotFoundException);
+#endif
+
+        OGRE_DELETE pack;
+    }
+
+    EXPECT_LT(packSize[1], packSize[0]);
+}
+
+TEST_F(PackArchiveTests, DuplicateName)
+{
+    PackArchiveWriter writer;
+    writer.addFile("a.txt", DataStreamPtr(OGRE_NEW MemoryDataStream(size_t(4))));
+    writer.addFile("a.txt", DataStreamPtr(OGRE_NEW MemoryDataStream(size_t(4))));
+    EXPECT_THROW(writer.write(mPackPath), ItemIdentityException);
+}
+
+TEST_F(PackArchiveTests, LooseLookup)
+{
+    PackArchiveWriter writer;
+    writer.addFile("Textures/Rock.png", DataStreamPtr(OGRE_NEW MemoryDataStream(size_t(4))));
+    writer.addFile("a/Same.txt", DataStreamPtr(OGRE_NEW MemoryDataStream(size_t(4))));
+    writer.addFile("b/Same.txt", DataStreamPtr(OGRE_NEW MemoryDataStream(size_t(8))));
+    writer.write(mPackPath);
+
+    Archive* pack = PackArchiveFactory().createInstance(mPackPath, true);
+    pack->load();
+
+    EXPECT_TRUE(pack->exists("Textures/Rock.png"));
+    EXPECT_EQ(size_t(8), pack->open("b/Same.txt")->size());
+    EXPECT_EQ(size_t(1), pack->find("Textures/*")->size());
+#if OGRE_RESOURCEMANAGER_STRICT
+    EXPECT_TRUE(pack->isCaseSensitive());
+    EXPECT_FALSE(pack->exists("textures/rock.png"));
+    EXPECT_FALSE(pack->exists("Rock.png"));
+    EXPECT_EQ(size_t(0), pack->find("textures/*")->size());
+#else
+    // like Zip and FileSystem: case insensitive, with lookup by basename
+    EXPECT_FALSE(pack->isCaseSensitive());
+    EXPECT_TRUE(pack->exists("textures/rock.png"));
+    EXPECT_TRUE(pack->exists("rock.PNG"));
+    EXPECT_EQ(size_t(4), pack->open("A/same.txt")->size());
+    // ambiguous basenames are not resolved
+    EXPECT_FALSE(pack->exists("Same.txt"));
+    EXPECT_EQ(size_t(1), pack->find("textures/*")->size());
+#endif
+
+    OGRE_DELETE pack;
+}
@@ -32,6 +32,10 @@ THE SOFTWARE.
 #include "RootWithoutRenderSystemFixture.h"
 
 #include "OgreArchiveManager.h"
+#include "OgreMaterialManager.h"
+#include "OgrePass.h"
+#include "OgreTechnique.h"
+#include "OgreStringConverter.h"
 
 TEST(ResourceGroupLocationTest, ResourceLocationPriority)
 {
@@ -56,4 +60,213 @@ TEST(ResourceGroupLocationTest, ResourceLocationPriority)
 
     resGrpMgr.removeResourceLocation("ResourceLocationPriority0");
     resGrpMgr.removeResourceLocation("ResourceLocationPriority1");
-}
\ No newline at end of file
+}
+namespace {
+// counts how often an archive was scanned
+class CountingArchive : public DummyArchive
+{
+public:
+    static int scanCount;
+
+    CountingArchive(const Ogre::String& name, const Ogre::String& archType) : DummyArchive(name, archType) {}
+
+    Ogre::StringVectorPtr find(const Ogre::String& pattern, bool recursive = true, bool dirs = false) const
+    {
+        scanCount++;
+        return DummyArchive::find(pattern, recursive, dirs);
+    }
+};
+int CountingArchive::scanCount = 0;
+
+class CountingArchiveFactory : public DummyArchiveFactory
+{
+public:
+    Ogre::Archive* createInstance(const Ogre::String& name, bool)
+    {
+        return OGRE_NEW CountingArchive(name, getType());
+    }
+};
+}
+
+TEST(ResourceGroupLocationTest, LocationIndexCache)
+{
+    CountingArchiveFactory fact;
+    Ogre::Root root("");
+    Ogre::ArchiveManager::getSingleton().addArchiveFactory(&fact);
+
+    Ogre::ResourceGroupManager& resGrpMgr = Ogre::ResourceGroupManager::getSingleton();
+    resGrpMgr.setLocationIndexCaching(true);
+    resGrpMgr.addResourceLocation("LocationIndexCache0", "DummyArchive", "IndexCacheTest");
+    resGrpMgr.addResourceLocation("LocationIndexCache1", "DummyArchive", "IndexCacheTest");
+    EXPECT_TRUE(resGrpMgr.resourceExists("IndexCacheTest", "dummyArchiveTest"));
+    EXPECT_EQ(2, CountingArchive::scanCount);
+
+    Ogre::DataStreamPtr stream(OGRE_NEW Ogre::MemoryDataStream(size_t(4096), true, false));
+    resGrpMgr.saveLocationIndexCache(stream);
+    resGrpMgr.destroyResourceGroup("IndexCacheTest");
+
+    // archives with unchanged modification times are not scanned again
+    resGrpMgr.setLocationIndexCaching(false);
+    stream->seek(0);
+    resGrpMgr.loadLocationIndexCache(stream);
+    resGrpMgr.addResourceLocation("LocationIndexCache1", "DummyArchive", "IndexCacheTest");
+    resGrpMgr.addResourceLocation("LocationIndexCache2", "DummyArchive", "IndexCacheTest");
+    EXPECT_TRUE(resGrpMgr.resourceExists("IndexCacheTest", "dummyArchiveTest"));
+    EXPECT_EQ(3, CountingArchive::scanCount);
+
+    // the location added first still takes precedence
+    unsigned char contents = 0;
+    resGrpMgr.openResource("dummyArchiveTest", "IndexCacheTest")->read(&contents, 1);
+    unsigned char expected = 0;
+    Ogre::ArchiveManager::getSingleton().load("LocationIndexCache1", "DummyArchive", true)->open("dummyArchiveTest")->read(&expected, 1);
+    EXPECT_EQ(expected, contents);
+}
+
+namespace {
+// loads fine, but fails to list its files
+class BrokenArchive : public DummyArchive
+{
+public:
+    BrokenArchive(const Ogre::String& name, const Ogre::String& archType) : DummyArchive(name, archType) {}
+
+    Ogre::StringVectorPtr find(const Ogre::String& pattern, bool recursive = true, bool dirs = false) const
+    {
+        if (getName() == "BrokenLocation")
+            OGRE_EXCEPT(Ogre::Exception::ERR_INTERNAL_ERROR, "corrupt index");
+        return DummyArchive::find(pattern, recursive, dirs);
+    }
+};
+
+class BrokenArchiveFactory : public DummyArchiveFactory
+{
+public:
+    Ogre::Archive* createInstance(const Ogre::String& name, bool)
+    {
+        return OGRE_NEW BrokenArchive(name, getType());
+    }
+};
+}
+
+TEST(ResourceGroupLocationTest, BrokenLocation)
+{
+    BrokenArchiveFactory fact;
+    Ogre::Root root("");
+    Ogre::ArchiveManager::getSingleton().addArchiveFactory(&fact);
+
+    // the archive loads, so adding it succeeds
+    Ogre::ResourceGroupManager& resGrpMgr = Ogre::ResourceGroupManager::getSingleton();
+    resGrpMgr.addResourceLocation("BrokenLocation", "DummyArchive", "BrokenTest");
+    resGrpMgr.addResourceLocation("GoodLocation", "DummyArchive", "BrokenTest");
+    EXPECT_TRUE(resGrpMgr.resourceLocationExists("BrokenLocation", "BrokenTest"));
+
+    // scanning throws once and drops the broken location
+    EXPECT_THROW(resGrpMgr.initialiseResourceGroup("BrokenTest"), Ogre::InternalErrorException);
+    EXPECT_FALSE(resGrpMgr.resourceLocationExists("BrokenLocation", "BrokenTest"));
+    EXPECT_TRUE(resGrpMgr.resourceLocationExists("GoodLocation", "BrokenTest"));
+
+    EXPECT_NO_THROW(resGrpMgr.initialiseResourceGroup("BrokenTest"));
+    EXPECT_TRUE(resGrpMgr.isResourceGroupInitialised("BrokenTest"));
+    EXPECT_TRUE(resGrpMgr.resourceExists("BrokenTest", "dummyArchiveTest"));
+}
+
+namespace {
+// serves material scripts, each defining one material
+class ScriptArchive : public DummyArchive
+{
+public:
+    static const int scriptCount = 200;
+
+    ScriptArchive(const Ogre::String& name, const Ogre::String& archType) : DummyArchive(name, archType) {}
+
+    Ogre::FileInfoListPtr findFileInfo(const Ogre::String& pattern, bool recursive = true,
+                                       bool dirs = false) const
+    {
+        Ogre::FileInfoListPtr results = std::make_shared<Ogre::FileInfoList>();
+        if (dirs) return results;
+        for (int i = 0; i < scriptCount; i++)
+        {
+            Ogre::String name = scriptName(i);
+            if (Ogre::StringUtil::match(name, pattern))
+                results->push_back(Ogre::FileInfo{this, name, "/", name, 0, 0});
+        }
+        return results;
+    }
+
+    Ogre::StringVectorPtr list(bool recursive = true, bool dirs = false) const
+    {
+        Ogre::StringVectorPtr results = std::make_shared<Ogre::StringVector>();
+        if (dirs) return results;
+        for (int i = 0; i < scriptCount; i++)
+            results->push_back(scriptName(i));
+        return results;
+    }
+
+    Ogre::DataStreamPtr open(const Ogre::String& filename, bool readOnly = true) const
+    {
+        Ogre::String str = "material " + Ogre::StringUtil::replaceAll(filename, ".material", "") +
+                           "\n{\n technique { pass { ambient 0 1 0 } }\n}\n";
+        Ogre::MemoryDataStream source(&str[0], str.size());
+        return std::make_shared<Ogre::MemoryDataStream>(filename, source);
+    }
+
+    static Ogre::String scriptName(int i) { return "Script" + Ogre::StringConverter::toString(i) + ".material"; }
+};
+
+class ScriptArchiveFactory : public DummyArchiveFactory
+{
+public:
+    Ogre::Archive* createInstance(const Ogre::String& name, bool)
+    {
+        return OGRE_NEW ScriptArchive(name, getType());
+    }
+};
+
+// records the script events, skipping one script
+class ScriptEventListener : public Ogre::ResourceGroupListener
+{
+public:
+    Ogre::StringVector started, ended;
+    bool paired = true;
+
+    void scriptParseStarted(const Ogre::String& scriptName, bool& skipThisScript)
+    {
+        skipThisScript = scriptName == ScriptArchive::scriptName(1);
+        paired = paired && started.size() == ended.size();
+        started.push_back(scriptName);
+    }
+    void scriptParseEnded(const Ogre::String& scriptName, bool skipped)
+    {
+        paired = paired && !started.empty() && started.back() == scriptName;
+        ended.push_back(scriptName);
+    }
+};
+}
+
+TEST(ResourceGroupLocationTest, ParallelScriptParsing)
+{
+    ScriptArchiveFactory fact;
+    Ogre::Root root("");
+    Ogre::ArchiveManager::getSingleton().addArchiveFactory(&fact);
+
+    ScriptEventListener listener;
+    Ogre::ResourceGroupManager& resGrpMgr = Ogre::ResourceGroupManager::getSingleton();
+    resGrpMgr.addResourceGroupListener(&listener);
+    resGrpMgr.addResourceLocation("ParallelScripts", "DummyArchive", "ScriptTest");
+    resGrpMgr.initialiseResourceGroup("ScriptTest");
+    resGrpMgr.removeResourceGroupListener(&listener);
+
+    // events and compilation follow the order of the files, each start directly followed by its end
+    ASSERT_EQ(size_t(ScriptArchive::scriptCount), listener.started.size());
+    EXPECT_EQ(listener.started, listener.ended);
+    EXPECT_TRUE(listener.paired);
+
+    Ogre::MaterialManager& matMgr = Ogre::MaterialManager::getSingleton();
+    EXPECT_FALSE(matMgr.getByName("Script1", "ScriptTest"));
+    for (int i = 0; i < ScriptArchive::scriptCount; i++)
+    {
+        if (i == 1) continue;
+        Ogre::MaterialPtr mat = matMgr.getByName("Script" + Ogre::StringConverter::toString(i), "ScriptTest");
+        ASSERT_TRUE(mat);
+        EXPECT_EQ(Ogre::ColourValue::Green, mat->getTechniques()[0]->getPasses()[0]->getAmbient());
+    }
+}
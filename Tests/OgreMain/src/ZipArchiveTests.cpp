@@ -31,6 +31,10 @@ THE SOFTWARE.
 #include "OgreConfigFile.h"
 #include "OgreFileSystemLayer.h"
 
+#include <atomic>
+#include <fstream>
+#include <thread>
+
 using namespace Ogre;
 
 static String fileId(const String& path) {
@@ -250,3 +254,57 @@ TEST_F(ZipArchiveTests,ReadInterleave)
     EXPECT_TRUE(stream2->eof());
 }
 //--------------------------------------------------------------------------
+//--------------------------------------------------------------------------
+TEST_F(ZipArchiveTests,ParallelOpen)
+{
+    std::vector<std::thread> threads;
+    std::atomic<int> failures(0);
+    for (int t = 0; t < 4; t++)
+    {
+        threads.push_back(std::thread([this, t, &failures]() {
+            for (int i = 0; i < 100; i++)
+            {
+                bool first = (i + t) % 2 == 0;
+                DataStreamPtr stream = arch->open(first ? "rootfile.txt" : "rootfile2.txt");
+                if (stream->getLine() != (first ? "this is line 1 in file 1" : "this is line 1 in file 2"))
+                    failures++;
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+    EXPECT_EQ(0, failures);
+
+    // stored entry
+    DataStreamPtr stream = arch->open(fileId("level1/materials/scripts/file.material"));
+    EXPECT_EQ((size_t)0, stream->size());
+}
+//--------------------------------------------------------------------------
+TEST_F(ZipArchiveTests,StreamOutlivesArchive)
+{
+    DataStreamPtr stream = arch->open("rootfile2.txt");
+    arch->unload();
+    EXPECT_EQ(String("this is line 1 in file 2"), stream->getLine());
+    EXPECT_EQ((size_t)156, stream->size());
+}
+//--------------------------------------------------------------------------
+TEST(EmbeddedZipArchiveTests,FileRead)
+{
+    Ogre::ConfigFile cf;
+    cf.load(Ogre::FileSystemLayer(OGRE_VERSION_NAME).getConfigFilePath("resources.cfg"));
+    Ogre::String testPath = cf.getSettings("Tests").begin()->second+"/misc/ArchiveTest.zip";
+
+    std::ifstream file(testPath.c_str(), std::ios::binary);
+    std::vector<uint8> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    ASSERT_FALSE(data.empty());
+    EmbeddedZipArchiveFactory::addEmbbeddedFile("ArchiveTest.zip", data.data(), data.size(), NULL);
+
+    EmbeddedZipArchiveFactory factory;
+    Archive* arch = factory.createInstance("ArchiveTest.zip", true);
+    arch->load();
+    EXPECT_EQ((size_t)6, arch->list(true)->size());
+    DataStreamPtr stream = arch->open("rootfile.txt");
+    EXPECT_EQ(String("this is line 1 in file 1"), stream->getLine());
+    factory.destroyInstance(arch);
+    EmbeddedZipArchiveFactory::removeEmbbeddedFile("ArchiveTest.zip");
+}
@@ -72,8 +72,11 @@ void help(void)
     cout << "-srcgl     = Interpret ambiguous colours as GL style" << endl;
     cout << "-E endian  = Set endian mode 'big' 'little' or 'native' (default)" << endl;
     cout << "-b         = Recalculate bounding box (static meshes only)" << endl;
+    cout << "-vc        = Optimise triangle and vertex order for the vertex cache" << endl;
+    cout << "-ml        = Split triangle lists into meshlets for per meshlet culling" << endl;
+    cout << "-q         = Quantise normals, tangents (10:10:10:2) and texture coordinates (half)" << endl;
     cout << "-V version = Specify OGRE version format to write instead of latest" << endl;
-    cout << "             Options are: 1.10, 1.8, 1.7, 1.4, 1.0" << endl;
+    cout << "             Options are: 1.12, 1.11, 1.10, 1.8, 1.7, 1.4, 1.0" << endl;
     cout << "sourcefile = name of file to convert" << endl;
     cout << "destfile   = optional name of file to write to. If you don't" << endl;
     cout << "             specify this OGRE overwrites the existing file." << endl;
@@ -102,6 +105,9 @@ struct UpgradeOptions {
     bool usePercent;
     Serializer::Endian endian;
     bool recalcBounds;
+    bool optimiseVertexCache;
+    bool generateMeshlets;
+    bool quantise;
     MeshVersion targetVersion;
 
 };
@@ -143,6 +149,9 @@ void parseOpts(UnaryOptionList& unOpts, BinaryOptionList& binOpts)
     opts.numLods = 0;
     opts.usePercent = true;
     opts.recalcBounds = false;
+    opts.optimiseVertexCache = false;
+    opts.generateMeshlets = false;
+    opts.quantise = false;
     opts.targetVersion = MESH_VERSION_LATEST;
 
 
@@ -186,6 +195,12 @@ void parseOpts(UnaryOptionList& unOpts, BinaryOptionList& binOpts)
     if (ui->second) {
         opts.recalcBounds = true;
     }
+    ui = unOpts.find("-vc");
+    opts.optimiseVertexCache = ui->second;
+    ui = unOpts.find("-ml");
+    opts.generateMeshlets = ui->second;
+    ui = unOpts.find("-q");
+    opts.quantise = ui->second;
 
 
     BinaryOptionList::iterator bi = binOpts.find("-l");
@@ -238,7 +253,11 @@ void parseOpts(UnaryOptionList& unOpts, BinaryOptionList& binOpts)
     
     bi = binOpts.find("-V");
     if (!bi->second.empty()) {
-        if (bi->second == "1.10") {
+        if (bi->second == "1.12") {
+            opts.targetVersion = MESH_VERSION_1_12;
+        } else if (bi->second == "1.11") {
+            opts.targetVersion = MESH_VERSION_1_11;
+        } else if (bi->second == "1.10") {
             opts.targetVersion = MESH_VERSION_1_10;
         } else if (bi->second == "1.8") {
             opts.targetVersion = MESH_VERSION_1_8;
@@ -1031,6 +1050,9 @@ int main(int numargs, char** args)
         unOptList["-srcd3d"] = false;
         unOptList["-autogen"] = false;
         unOptList["-b"] = false;
+        unOptList["-vc"] = false;
+        unOptList["-ml"] = false;
+        unOptList["-q"] = false;
         binOptList["-l"] = "";
         binOptList["-d"] = "";
         binOptList["-p"] = "";
@@ -1086,6 +1108,23 @@ int main(int numargs, char** args)
         
         buildLod(meshPtr);
 
+        if (opts.generateMeshlets) {
+            cout << "\nGenerating meshlets...";
+            for (unsigned short i = 0; i < mesh->getNumSubMeshes(); ++i)
+            {
+                SubMesh* sm = mesh->getSubMesh(i);
+                if (sm->operationType == RenderOperation::OT_TRIANGLE_LIST && sm->indexData->indexCount)
+                    sm->generateMeshlets();
+            }
+            cout << "success\n";
+        }
+
+        if (opts.optimiseVertexCache) {
+            cout << "\nOptimising vertex cache order...";
+            mesh->optimiseVertexCache();
+            cout << "success\n";
+        }
+
         if (opts.interactive) {
             do {
                 std::cout << "\nWould you like to (b)uild/(r)emove/(k)eep Edge lists? (b/r/k) ";
@@ -1171,6 +1210,12 @@ int main(int numargs, char** args)
             recalcBounds(mesh);
         }
 
+        if (opts.quantise) {
+            cout << "\nQuantising vertex data...";
+            mesh->quantiseVertexData();
+            cout << "success\n";
+        }
+
         meshSerializer->exportMesh(mesh, dest, opts.targetVersion, opts.endian);
     
     }
@@ -0,0 +1,113 @@
+/*
+-----------------------------------------------------------------------------
+This source file is part of OGRE
+    (Object-oriented Graphics Rendering Engine)
+For the latest info, see http://www.ogre3d.org/
+
+Copyright (c) 2000-2014 Torus Knot Software Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+-----------------------------------------------------------------------------
+*/
+
+#include "Ogre.h"
+#include "OgreFileSystem.h"
+#include "OgrePack.h"
+
+#include <iostream>
+
+using namespace std;
+using namespace Ogre;
+
+namespace {
+
+void help(void)
+{
+    // Print help message
+    cout << endl << "OgreResourcePacker: Packs a folder into an archive for the 'Pack' resource location type." << endl;
+    cout << "Usage: OgreResourcePacker [opts] sourcedir destfile " << endl;
+    cout << "-c codec      = Compression: 'stored' (default) or 'deflate'" << endl;
+    cout << "-b blocksize  = Compress in independent blocks of this many KiB, 0 for whole files (default 256)" << endl;
+    cout << "-a alignment  = Alignment of file data in bytes, a power of two (default 16)" << endl;
+    cout << "-nd           = DON'T share data between files with the same content" << endl;
+    cout << "sourcedir     = folder to pack, including subfolders" << endl;
+    cout << "destfile      = name of the pack to write" << endl;
+    cout << endl;
+}
+
+}
+
+int main(int numargs, char** args)
+{
+    if (numargs < 3) {
+        help();
+        return -1;
+    }
+
+    int retCode = 0;
+    LogManager logMgr;
+    logMgr.createLog("OgreResourcePacker.log", true, false);
+
+    try
+    {
+        UnaryOptionList unOptList;
+        BinaryOptionList binOptList;
+
+        unOptList["-nd"] = false;
+        binOptList["-c"] = "stored";
+        binOptList["-b"] = "256";
+        binOptList["-a"] = "16";
+
+        int startIdx = findCommandLineOpts(numargs, args, unOptList, binOptList);
+        if (numargs - startIdx < 2) {
+            help();
+            return -1;
+        }
+
+        String source(args[startIdx]);
+        String dest(args[startIdx + 1]);
+
+        PackArchiveWriter writer;
+        if (binOptList["-c"] == "deflate")
+            writer.setCodec(PackArchiveWriter::CODEC_DEFLATE);
+        else if (binOptList["-c"] != "stored")
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "Unknown codec '" + binOptList["-c"] + "'");
+        writer.setBlockSize(StringConverter::parseUnsignedInt(binOptList["-b"]) * 1024);
+        writer.setAlignment(StringConverter::parseUnsignedInt(binOptList["-a"]));
+        writer.setDeduplicate(!unOptList["-nd"]);
+
+        FileSystemArchiveFactory fsFactory;
+        Archive* arch = fsFactory.createInstance(source, true);
+        arch->load();
+        writer.addArchive(arch);
+        size_t files = arch->list()->size();
+
+        size_t bytes = writer.write(dest);
+        fsFactory.destroyInstance(arch);
+
+        cout << "Packed " << files << " files into " << dest << " (" << bytes << " bytes)" << endl;
+    }
+    catch (Exception& e)
+    {
+        cout << "Exception caught: " << e.getDescription();
+        retCode = 1;
+    }
+
+    return retCode;
+}